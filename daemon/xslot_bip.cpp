@@ -0,0 +1,1502 @@
+/**
+ * @file xslot_bip.cpp
+ * @brief BACnet/IP 网关
+ *
+ * 把每个边缘节点映射为一台虚拟 BACnet/IP 设备，供 BMS 前端直接访问:
+ * - 网关作为路由器，边缘节点位于虚拟网络 (默认 1000)，
+ *   MAC 为 2 字节 X-Slot 地址，设备实例号 = 基数 + 地址
+ * - ReadProperty/ReadPropertyMultiple 直接读取汇聚节点共享内存中的
+ *   对象当前值 (见 xslot_shm.h)，读操作不产生任何无线流量
+ * - SubscribeCOV 订阅的对象在共享内存槽位更新时发送
+ *   UnconfirmedCOVNotification
+ * - WriteProperty 写 Present_Value 经 xslotd 转发，同一节点在
+ *   合并窗口内的多次写入合并为一个 WRITE_MULTI 帧
+ *
+ * 依赖运行中的 xslotd (-m 开启共享内存发布)。
+ *
+ * 用法: xslot_bip [-s 套接字路径] [-m 共享内存名] [-p UDP 端口]
+ *                 [-n 虚拟网络号] [-d 设备实例基数] [-v 厂商 ID]
+ */
+#include "../src/bip/bip_codec.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <xslot/xslot_client.h>
+#include <xslot/xslot_shm.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define BIP_MAX_POINTS 256        /**< 每台虚拟设备最大对象数 */
+#define BIP_MAX_COV_SUBS 128      /**< COV 订阅表容量 */
+#define BIP_MAX_PENDING_WRITES 256
+#define BIP_WRITE_WINDOW_MS 50 /**< 写入合并窗口 */
+#define BIP_POLL_MS 20         /**< 主循环间隔 (COV 检查周期) */
+#define BIP_RETRY_MS 1000      /**< 共享内存/xslotd 重连间隔 */
+#define BIP_ARRAY_ALL 0xFFFFFFFFu
+#define BIP_WILDCARD_INSTANCE 4194303u
+
+/* 对象类型 (0-5 与 xslot_object_type_t 一致) */
+#define OBJECT_DEVICE 8
+
+/* 属性标识 */
+#define PROP_APPLICATION_SOFTWARE_VERSION 12
+#define PROP_APDU_TIMEOUT 11
+#define PROP_DEVICE_ADDRESS_BINDING 30
+#define PROP_EVENT_STATE 36
+#define PROP_FIRMWARE_REVISION 44
+#define PROP_MAX_APDU_LENGTH_ACCEPTED 62
+#define PROP_MODEL_NAME 70
+#define PROP_NUMBER_OF_APDU_RETRIES 73
+#define PROP_OBJECT_IDENTIFIER 75
+#define PROP_OBJECT_LIST 76
+#define PROP_OBJECT_NAME 77
+#define PROP_OBJECT_TYPE 79
+#define PROP_OPTIONAL 80
+#define PROP_OUT_OF_SERVICE 81
+#define PROP_POLARITY 84
+#define PROP_PRESENT_VALUE 85
+#define PROP_OBJECT_TYPES_SUPPORTED 96
+#define PROP_SERVICES_SUPPORTED 97
+#define PROP_PROTOCOL_VERSION 98
+#define PROP_RELIABILITY 103
+#define PROP_REQUIRED 105
+#define PROP_SEGMENTATION_SUPPORTED 107
+#define PROP_STATUS_FLAGS 111
+#define PROP_SYSTEM_STATUS 112
+#define PROP_UNITS 117
+#define PROP_VENDOR_IDENTIFIER 120
+#define PROP_VENDOR_NAME 121
+#define PROP_PROTOCOL_REVISION 139
+#define PROP_DATABASE_REVISION 155
+#define PROP_ALL 8
+
+/* 服务 */
+#define SERVICE_SUBSCRIBE_COV 5
+#define SERVICE_READ_PROPERTY 12
+#define SERVICE_READ_PROPERTY_MULTIPLE 14
+#define SERVICE_WRITE_PROPERTY 15
+#define SERVICE_I_AM 0
+#define SERVICE_UNCONFIRMED_COV 2
+#define SERVICE_WHO_IS 8
+
+/* 服务支持位 (BACnetServicesSupported) */
+#define SUPPORTED_I_AM 26
+#define SUPPORTED_UNCONFIRMED_COV 28
+#define SUPPORTED_WHO_IS 34
+#define SUPPORTED_SERVICE_BITS 41
+#define SUPPORTED_OBJECT_TYPE_BITS 9
+
+/* 错误类/错误码 */
+#define ERROR_CLASS_DEVICE 0
+#define ERROR_CLASS_OBJECT 1
+#define ERROR_CLASS_PROPERTY 2
+#define ERROR_CLASS_RESOURCES 3
+#define ERROR_CLASS_SERVICES 5
+#define ERROR_CODE_INVALID_DATA_TYPE 9
+#define ERROR_CODE_NO_SPACE_TO_ADD_LIST_ELEMENT 19
+#define ERROR_CODE_OPERATIONAL_PROBLEM 25
+#define ERROR_CODE_UNKNOWN_OBJECT 31
+#define ERROR_CODE_UNKNOWN_PROPERTY 32
+#define ERROR_CODE_VALUE_OUT_OF_RANGE 37
+#define ERROR_CODE_WRITE_ACCESS_DENIED 40
+#define ERROR_CODE_INVALID_ARRAY_INDEX 42
+#define ERROR_CODE_OPTIONAL_FUNCTIONALITY_NOT_SUPPORTED 45
+#define ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY 50
+
+#define REJECT_INVALID_TAG 4
+#define REJECT_MISSING_REQUIRED_PARAMETER 5
+#define REJECT_UNRECOGNIZED_SERVICE 9
+#define ABORT_SEGMENTATION_NOT_SUPPORTED 4
+
+/* 枚举值 */
+#define EVENT_STATE_NORMAL 0
+#define EVENT_STATE_OFFNORMAL 2
+#define RELIABILITY_NO_FAULT 0
+#define RELIABILITY_COMMUNICATION_FAILURE 12
+#define SYSTEM_STATUS_OPERATIONAL 0
+#define SYSTEM_STATUS_NON_OPERATIONAL 4
+#define SEGMENTATION_NONE 3
+#define UNITS_NO_UNITS 95
+
+/**
+ * @brief 虚拟设备中的对象
+ */
+struct bip_point {
+  int slot; /**< 共享内存槽位索引 */
+  uint8_t type;
+  uint16_t id;
+};
+
+/**
+ * @brief 虚拟设备 (一个边缘节点)
+ */
+struct bip_device {
+  uint16_t addr;
+  bool online;
+  uint16_t point_count;
+  bip_point points[BIP_MAX_POINTS];
+};
+
+/**
+ * @brief 请求方地址 (应答按此路由)
+ */
+struct bip_peer {
+  struct sockaddr_in addr; /**< B/IP 地址 */
+  uint16_t net;            /**< 请求方所在远程网络 (0=本地网络) */
+  uint8_t mac_len;
+  uint8_t mac[BIP_MAX_MAC_LEN];
+};
+
+/**
+ * @brief 已定位的对象
+ */
+struct bip_object {
+  uint16_t type;
+  uint32_t instance;
+  int slot;                /**< 设备对象为 -1 */
+  xslot_shm_object_t data; /**< 点对象当前值快照 */
+};
+
+/**
+ * @brief COV 订阅
+ */
+struct cov_sub {
+  bool used;
+  bool pending; /**< 需发送初始通知 */
+  bip_peer peer;
+  uint32_t process_id;
+  uint16_t addr;
+  uint8_t type;
+  uint16_t id;
+  int slot;           /**< -1 表示待重新定位 */
+  uint32_t expire_ms; /**< 0=永久 */
+  uint32_t last_seq;
+  uint8_t last_status;
+  xslot_bacnet_object_t last;
+};
+
+/**
+ * @brief 待发送写入
+ */
+struct pending_write {
+  uint16_t addr;
+  xslot_bacnet_object_t obj;
+};
+
+/* 配置 */
+static const char *g_socket_path = XSLOT_CLIENT_DEFAULT_PATH;
+static const char *g_shm_name = nullptr;
+static uint16_t g_vnet = 1000;
+static uint32_t g_device_base = 100000;
+static uint16_t g_vendor_id = 0;
+
+/* 运行状态 */
+static int g_sock = -1;
+static xslot_shm_reader_t g_shm;
+static uint32_t g_shm_retry_ms;
+static xslot_client_t g_client;
+static uint32_t g_client_retry_ms;
+static volatile sig_atomic_t g_running = 1;
+
+static bip_device g_devices[XSLOT_MAX_NODES];
+static int g_device_count;
+static int g_scanned_slots; /**< 已扫描的共享内存槽位数 */
+
+static cov_sub g_subs[BIP_MAX_COV_SUBS];
+
+static pending_write g_writes[BIP_MAX_PENDING_WRITES];
+static int g_write_count;
+static uint32_t g_write_since_ms;
+
+static const char *const k_type_names[] = {"AI", "AO", "AV",
+                                           "BI", "BO", "BV"};
+
+static void on_signal(int sig) {
+  (void)sig;
+  g_running = 0;
+}
+
+static uint32_t now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+static bool is_analog(uint8_t type) {
+  return type <= XSLOT_OBJ_ANALOG_VALUE;
+}
+
+/* ============================================================================
+ * 对象缓存 (共享内存)
+ * ============================================================================
+ */
+
+static bip_device *find_device(uint16_t addr, bool create) {
+  for (int i = 0; i < g_device_count; i++) {
+    if (g_devices[i].addr == addr)
+      return &g_devices[i];
+  }
+  if (!create || g_device_count >= XSLOT_MAX_NODES)
+    return nullptr;
+
+  bip_device *dev = &g_devices[g_device_count++];
+  std::memset(dev, 0, sizeof(*dev));
+  dev->addr = addr;
+  return dev;
+}
+
+static void reset_cache(void) {
+  g_device_count = 0;
+  g_scanned_slots = 0;
+  for (int i = 0; i < BIP_MAX_COV_SUBS; i++) {
+    g_subs[i].slot = -1;
+  }
+}
+
+/**
+ * @brief 打开或重新打开共享内存 (汇聚节点重启后槽位全部失效)
+ */
+static void ensure_shm(uint32_t now) {
+  if (g_shm && !xslot_shm_is_alive(g_shm)) {
+    xslot_shm_close(g_shm);
+    g_shm = nullptr;
+    reset_cache();
+  }
+  if (g_shm || now - g_shm_retry_ms < BIP_RETRY_MS)
+    return;
+
+  g_shm_retry_ms = now;
+  g_shm = xslot_shm_open(g_shm_name);
+  if (g_shm)
+    reset_cache();
+}
+
+/**
+ * @brief 同步节点在线状态并登记新分配的槽位
+ *
+ * 槽位一经分配不再改变，只需扫描上次之后新增的部分。槽位类型即节点上报的
+ * 对象类型 (旧版节点未携带类型的增量上报不分配槽位)，可直接映射为 BACnet 对象。
+ */
+static void refresh_devices(void) {
+  if (!g_shm)
+    return;
+
+  xslot_node_info_t nodes[XSLOT_MAX_NODES];
+  int n = xslot_shm_get_nodes(g_shm, nodes, XSLOT_MAX_NODES);
+  for (int i = 0; i < n; i++) {
+    bip_device *dev = find_device(nodes[i].addr, true);
+    if (dev)
+      dev->online = nodes[i].online;
+  }
+
+  int count = xslot_shm_object_count(g_shm);
+  while (g_scanned_slots < count) {
+    xslot_shm_object_t slot;
+    if (xslot_shm_read_object(g_shm, g_scanned_slots, &slot) != XSLOT_OK)
+      break;
+
+    bip_device *dev = find_device(slot.addr, true);
+    if (dev && dev->point_count < BIP_MAX_POINTS &&
+        slot.object.object_type <= XSLOT_OBJ_BINARY_VALUE) {
+      bip_point *pt = &dev->points[dev->point_count++];
+      pt->slot = g_scanned_slots;
+      pt->type = slot.object.object_type;
+      pt->id = slot.object.object_id;
+    }
+    g_scanned_slots++;
+  }
+}
+
+/**
+ * @brief 定位虚拟设备中的对象并读取当前值
+ */
+static bool find_object(const bip_device *dev, uint16_t type,
+                        uint32_t instance, bip_object *obj) {
+  obj->type = type;
+  obj->instance = instance;
+  obj->slot = -1;
+
+  if (type == OBJECT_DEVICE) {
+    if (instance == BIP_WILDCARD_INSTANCE)
+      obj->instance = g_device_base + dev->addr;
+    return obj->instance == g_device_base + dev->addr;
+  }
+
+  if (!g_shm || type > XSLOT_OBJ_BINARY_VALUE || instance > 0xFFFF)
+    return false;
+
+  obj->slot = xslot_shm_find_object(g_shm, dev->addr, (uint8_t)type,
+                                    (uint16_t)instance);
+  if (obj->slot < 0)
+    return false;
+
+  return xslot_shm_read_object(g_shm, obj->slot, &obj->data) == XSLOT_OK;
+}
+
+/**
+ * @brief Status_Flags 位 (高 4 位: in-alarm, fault, overridden, OOS)
+ *
+ * 槽位标志为节点最近一次完整格式上报的状态，常规增量上报不会清除。
+ */
+static uint8_t status_flags(const xslot_bacnet_object_t *obj, bool online) {
+  uint8_t bits = 0;
+  if (obj->flags & XSLOT_FLAG_IN_ALARM)
+    bits |= 0x80;
+  if (!online)
+    bits |= 0x40;
+  if (obj->flags & XSLOT_FLAG_OUT_OF_SERVICE)
+    bits |= 0x10;
+  return bits;
+}
+
+/* ============================================================================
+ * 属性
+ * ============================================================================
+ */
+
+static const uint32_t k_device_props[] = {
+    PROP_OBJECT_IDENTIFIER,
+    PROP_OBJECT_NAME,
+    PROP_OBJECT_TYPE,
+    PROP_SYSTEM_STATUS,
+    PROP_VENDOR_NAME,
+    PROP_VENDOR_IDENTIFIER,
+    PROP_MODEL_NAME,
+    PROP_FIRMWARE_REVISION,
+    PROP_APPLICATION_SOFTWARE_VERSION,
+    PROP_PROTOCOL_VERSION,
+    PROP_PROTOCOL_REVISION,
+    PROP_SERVICES_SUPPORTED,
+    PROP_OBJECT_TYPES_SUPPORTED,
+    PROP_OBJECT_LIST,
+    PROP_MAX_APDU_LENGTH_ACCEPTED,
+    PROP_SEGMENTATION_SUPPORTED,
+    PROP_APDU_TIMEOUT,
+    PROP_NUMBER_OF_APDU_RETRIES,
+    PROP_DEVICE_ADDRESS_BINDING,
+    PROP_DATABASE_REVISION,
+};
+
+static const uint32_t k_analog_props[] = {
+    PROP_OBJECT_IDENTIFIER, PROP_OBJECT_NAME,   PROP_OBJECT_TYPE,
+    PROP_PRESENT_VALUE,     PROP_STATUS_FLAGS,  PROP_EVENT_STATE,
+    PROP_OUT_OF_SERVICE,    PROP_UNITS,
+};
+
+static const uint32_t k_binary_io_props[] = {
+    PROP_OBJECT_IDENTIFIER, PROP_OBJECT_NAME,  PROP_OBJECT_TYPE,
+    PROP_PRESENT_VALUE,     PROP_STATUS_FLAGS, PROP_EVENT_STATE,
+    PROP_OUT_OF_SERVICE,    PROP_POLARITY,
+};
+
+static const uint32_t k_binary_value_props[] = {
+    PROP_OBJECT_IDENTIFIER, PROP_OBJECT_NAME,  PROP_OBJECT_TYPE,
+    PROP_PRESENT_VALUE,     PROP_STATUS_FLAGS, PROP_EVENT_STATE,
+    PROP_OUT_OF_SERVICE,
+};
+
+static const uint32_t k_point_optional_props[] = {PROP_RELIABILITY};
+
+/**
+ * @brief 获取对象的必选/可选属性列表
+ */
+static int property_list(uint16_t type, bool required,
+                         const uint32_t **list) {
+  if (!required) {
+    if (type == OBJECT_DEVICE)
+      return 0;
+    *list = k_point_optional_props;
+    return 1;
+  }
+
+  switch (type) {
+  case OBJECT_DEVICE:
+    *list = k_device_props;
+    return sizeof(k_device_props) / sizeof(k_device_props[0]);
+  case XSLOT_OBJ_BINARY_INPUT:
+  case XSLOT_OBJ_BINARY_OUTPUT:
+    *list = k_binary_io_props;
+    return sizeof(k_binary_io_props) / sizeof(k_binary_io_props[0]);
+  case XSLOT_OBJ_BINARY_VALUE:
+    *list = k_binary_value_props;
+    return sizeof(k_binary_value_props) / sizeof(k_binary_value_props[0]);
+  default:
+    *list = k_analog_props;
+    return sizeof(k_analog_props) / sizeof(k_analog_props[0]);
+  }
+}
+
+static bool has_property(uint16_t type, uint32_t prop) {
+  const uint32_t *list = nullptr;
+  for (int pass = 0; pass < 2; pass++) {
+    int n = property_list(type, pass == 0, &list);
+    for (int i = 0; i < n; i++) {
+      if (list[i] == prop)
+        return true;
+    }
+  }
+  return false;
+}
+
+static int encode_device_property(const bip_device *dev, uint32_t instance,
+                                  uint32_t prop, uint32_t index, uint8_t *buf,
+                                  uint8_t *error_code) {
+  char text[32];
+
+  if (prop == PROP_OBJECT_LIST) {
+    if (index == 0)
+      return bip_encode_app_unsigned(buf, dev->point_count + 1u);
+    if (index != BIP_ARRAY_ALL) {
+      if (index > dev->point_count + 1u) {
+        *error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
+        return -1;
+      }
+      if (index == 1)
+        return bip_encode_app_object_id(buf, OBJECT_DEVICE, instance);
+      const bip_point *pt = &dev->points[index - 2];
+      return bip_encode_app_object_id(buf, pt->type, pt->id);
+    }
+
+    int n = bip_encode_app_object_id(buf, OBJECT_DEVICE, instance);
+    for (uint16_t i = 0; i < dev->point_count; i++) {
+      n += bip_encode_app_object_id(buf + n, dev->points[i].type,
+                                    dev->points[i].id);
+    }
+    return n;
+  }
+
+  if (index != BIP_ARRAY_ALL) {
+    *error_code = has_property(OBJECT_DEVICE, prop)
+                      ? ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY
+                      : ERROR_CODE_UNKNOWN_PROPERTY;
+    return -1;
+  }
+
+  switch (prop) {
+  case PROP_OBJECT_IDENTIFIER:
+    return bip_encode_app_object_id(buf, OBJECT_DEVICE, instance);
+  case PROP_OBJECT_NAME:
+    std::snprintf(text, sizeof(text), "xslot-%04X", dev->addr);
+    return bip_encode_app_char_string(buf, text);
+  case PROP_OBJECT_TYPE:
+    return bip_encode_app_enumerated(buf, OBJECT_DEVICE);
+  case PROP_SYSTEM_STATUS:
+    return bip_encode_app_enumerated(buf, dev->online
+                                              ? SYSTEM_STATUS_OPERATIONAL
+                                              : SYSTEM_STATUS_NON_OPERATIONAL);
+  case PROP_VENDOR_NAME:
+    return bip_encode_app_char_string(buf, "X-Slot");
+  case PROP_VENDOR_IDENTIFIER:
+    return bip_encode_app_unsigned(buf, g_vendor_id);
+  case PROP_MODEL_NAME:
+    return bip_encode_app_char_string(buf, "X-Slot Edge");
+  case PROP_FIRMWARE_REVISION:
+  case PROP_APPLICATION_SOFTWARE_VERSION:
+    std::snprintf(text, sizeof(text), "%d.%d.%d", XSLOT_VERSION_MAJOR,
+                  XSLOT_VERSION_MINOR, XSLOT_VERSION_PATCH);
+    return bip_encode_app_char_string(buf, text);
+  case PROP_PROTOCOL_VERSION:
+    return bip_encode_app_unsigned(buf, 1);
+  case PROP_PROTOCOL_REVISION:
+    return bip_encode_app_unsigned(buf, 10);
+  case PROP_SERVICES_SUPPORTED: {
+    uint8_t bits[(SUPPORTED_SERVICE_BITS + 7) / 8] = {0};
+    const uint8_t services[] = {SERVICE_SUBSCRIBE_COV,
+                                SERVICE_READ_PROPERTY,
+                                SERVICE_READ_PROPERTY_MULTIPLE,
+                                SERVICE_WRITE_PROPERTY,
+                                SUPPORTED_I_AM,
+                                SUPPORTED_UNCONFIRMED_COV,
+                                SUPPORTED_WHO_IS};
+    for (uint8_t s : services) {
+      bits[s / 8] |= (uint8_t)(0x80 >> (s % 8));
+    }
+    return bip_encode_app_bit_string(buf, bits, SUPPORTED_SERVICE_BITS);
+  }
+  case PROP_OBJECT_TYPES_SUPPORTED: {
+    /* AI/AO/AV/BI/BO/BV (0-5) 与 Device (8) */
+    const uint8_t bits[2] = {0xFC, 0x80};
+    return bip_encode_app_bit_string(buf, bits, SUPPORTED_OBJECT_TYPE_BITS);
+  }
+  case PROP_MAX_APDU_LENGTH_ACCEPTED:
+    return bip_encode_app_unsigned(buf, BIP_MAX_APDU);
+  case PROP_SEGMENTATION_SUPPORTED:
+    return bip_encode_app_enumerated(buf, SEGMENTATION_NONE);
+  case PROP_APDU_TIMEOUT:
+    return bip_encode_app_unsigned(buf, 3000);
+  case PROP_NUMBER_OF_APDU_RETRIES:
+    return bip_encode_app_unsigned(buf, 3);
+  case PROP_DEVICE_ADDRESS_BINDING:
+    return 0; /* 空列表 */
+  case PROP_DATABASE_REVISION:
+    return bip_encode_app_unsigned(buf, dev->point_count);
+  default:
+    *error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+    return -1;
+  }
+}
+
+static int encode_point_property(const bip_device *dev, const bip_object *obj,
+                                 uint32_t prop, uint32_t index, uint8_t *buf,
+                                 uint8_t *error_code) {
+  const xslot_bacnet_object_t *value = &obj->data.object;
+  char text[16];
+
+  if (!has_property(obj->type, prop)) {
+    *error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+    return -1;
+  }
+  if (index != BIP_ARRAY_ALL) {
+    *error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
+    return -1;
+  }
+
+  switch (prop) {
+  case PROP_OBJECT_IDENTIFIER:
+    return bip_encode_app_object_id(buf, obj->type, obj->instance);
+  case PROP_OBJECT_NAME:
+    std::snprintf(text, sizeof(text), "%s%u", k_type_names[obj->type],
+                  (unsigned)obj->instance);
+    return bip_encode_app_char_string(buf, text);
+  case PROP_OBJECT_TYPE:
+    return bip_encode_app_enumerated(buf, obj->type);
+  case PROP_PRESENT_VALUE:
+    if (is_analog(obj->type))
+      return bip_encode_app_real(buf, value->present_value.analog);
+    return bip_encode_app_enumerated(buf, value->present_value.binary ? 1 : 0);
+  case PROP_STATUS_FLAGS: {
+    uint8_t bits = status_flags(value, dev->online);
+    return bip_encode_app_bit_string(buf, &bits, 4);
+  }
+  case PROP_EVENT_STATE:
+    return bip_encode_app_enumerated(buf, (value->flags & XSLOT_FLAG_IN_ALARM)
+                                              ? EVENT_STATE_OFFNORMAL
+                                              : EVENT_STATE_NORMAL);
+  case PROP_OUT_OF_SERVICE:
+    return bip_encode_app_boolean(
+        buf, (value->flags & XSLOT_FLAG_OUT_OF_SERVICE) != 0);
+  case PROP_UNITS:
+    return bip_encode_app_enumerated(buf, UNITS_NO_UNITS);
+  case PROP_POLARITY:
+    return bip_encode_app_enumerated(buf, 0);
+  case PROP_RELIABILITY:
+    /* 节点离线时值来自缓存，以通信故障标示 */
+    return bip_encode_app_enumerated(
+        buf, dev->online ? RELIABILITY_NO_FAULT
+                         : RELIABILITY_COMMUNICATION_FAILURE);
+  default:
+    *error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+    return -1;
+  }
+}
+
+/**
+ * @brief 编码属性值
+ * @return 编码长度，失败返回 -1 (错误类固定为 PROPERTY)
+ */
+static int encode_property(const bip_device *dev, const bip_object *obj,
+                           uint32_t prop, uint32_t index, uint8_t *buf,
+                           uint8_t *error_code) {
+  if (obj->type == OBJECT_DEVICE) {
+    return encode_device_property(dev, obj->instance, prop, index, buf,
+                                  error_code);
+  }
+  return encode_point_property(dev, obj, prop, index, buf, error_code);
+}
+
+/* ============================================================================
+ * 发送
+ * ============================================================================
+ */
+
+/**
+ * @brief 发送 NPDU
+ * @param peer 目标
+ * @param src_addr 源虚拟设备地址 (0 表示由路由器本身发出)
+ * @param control NPDU 控制位
+ */
+static void send_npdu(const bip_peer *peer, uint16_t src_addr,
+                      uint8_t control, const uint8_t *payload, uint16_t len) {
+  uint8_t tx[BIP_MAX_MPDU];
+  bip_npdu_t npdu;
+  std::memset(&npdu, 0, sizeof(npdu));
+  npdu.control = control;
+
+  if (peer->net) {
+    npdu.control |= NPDU_DNET_PRESENT;
+    npdu.dnet = peer->net;
+    npdu.dlen = peer->mac_len;
+    std::memcpy(npdu.dadr, peer->mac, peer->mac_len);
+    npdu.hop_count = 255;
+  }
+  if (src_addr) {
+    npdu.control |= NPDU_SNET_PRESENT;
+    npdu.snet = g_vnet;
+    npdu.slen = 2;
+    npdu.sadr[0] = (uint8_t)(src_addr >> 8);
+    npdu.sadr[1] = (uint8_t)src_addr;
+  }
+
+  int n = 4 + bip_encode_npdu(tx + 4, &npdu);
+  if (n + len > BIP_MAX_MPDU)
+    return;
+  std::memcpy(tx + n, payload, len);
+  n += len;
+
+  tx[0] = BVLC_TYPE_BIP;
+  tx[1] = BVLC_ORIGINAL_UNICAST;
+  tx[2] = (uint8_t)(n >> 8);
+  tx[3] = (uint8_t)n;
+
+  sendto(g_sock, tx, n, 0, (const struct sockaddr *)&peer->addr,
+         sizeof(peer->addr));
+}
+
+static void send_i_am(const bip_peer *peer, const bip_device *dev) {
+  uint8_t apdu[32];
+  int n = 0;
+  apdu[n++] = PDU_UNCONFIRMED_REQUEST;
+  apdu[n++] = SERVICE_I_AM;
+  n += bip_encode_app_object_id(apdu + n, OBJECT_DEVICE,
+                                g_device_base + dev->addr);
+  n += bip_encode_app_unsigned(apdu + n, BIP_MAX_APDU);
+  n += bip_encode_app_enumerated(apdu + n, SEGMENTATION_NONE);
+  n += bip_encode_app_unsigned(apdu + n, g_vendor_id);
+  send_npdu(peer, dev->addr, 0, apdu, n);
+}
+
+/**
+ * @brief 应答 Who-Is-Router-To-Network (网络层消息只在本地网络应答)
+ */
+static void send_i_am_router(const bip_peer *peer) {
+  uint8_t tx[16];
+  bip_npdu_t npdu;
+  std::memset(&npdu, 0, sizeof(npdu));
+  npdu.control = NPDU_NETWORK_MSG;
+  npdu.msg_type = NPDU_I_AM_ROUTER;
+
+  int n = 4 + bip_encode_npdu(tx + 4, &npdu);
+  tx[n++] = (uint8_t)(g_vnet >> 8);
+  tx[n++] = (uint8_t)g_vnet;
+
+  tx[0] = BVLC_TYPE_BIP;
+  tx[1] = BVLC_ORIGINAL_UNICAST;
+  tx[2] = (uint8_t)(n >> 8);
+  tx[3] = (uint8_t)n;
+  sendto(g_sock, tx, n, 0, (const struct sockaddr *)&peer->addr,
+         sizeof(peer->addr));
+}
+
+static int encode_simple_ack(uint8_t *apdu, uint8_t invoke, uint8_t service) {
+  apdu[0] = PDU_SIMPLE_ACK;
+  apdu[1] = invoke;
+  apdu[2] = service;
+  return 3;
+}
+
+static int encode_error(uint8_t *apdu, uint8_t invoke, uint8_t service,
+                        uint8_t error_class, uint8_t error_code) {
+  int n = 0;
+  apdu[n++] = PDU_ERROR;
+  apdu[n++] = invoke;
+  apdu[n++] = service;
+  n += bip_encode_app_enumerated(apdu + n, error_class);
+  n += bip_encode_app_enumerated(apdu + n, error_code);
+  return n;
+}
+
+static int encode_reject(uint8_t *apdu, uint8_t invoke, uint8_t reason) {
+  apdu[0] = PDU_REJECT;
+  apdu[1] = invoke;
+  apdu[2] = reason;
+  return 3;
+}
+
+static int encode_abort(uint8_t *apdu, uint8_t invoke, uint8_t reason) {
+  apdu[0] = PDU_ABORT | 0x01; /* 服务端发起 */
+  apdu[1] = invoke;
+  apdu[2] = reason;
+  return 3;
+}
+
+/* ============================================================================
+ * 写入合并
+ * ============================================================================
+ */
+
+static bool ensure_client(uint32_t now) {
+  if (g_client)
+    return true;
+  if (now - g_client_retry_ms < BIP_RETRY_MS)
+    return false;
+
+  g_client_retry_ms = now;
+  g_client = xslot_client_connect(g_socket_path);
+  return g_client != nullptr;
+}
+
+/**
+ * @brief 按节点分组发送待写入对象
+ * @param force 忽略合并窗口立即发送
+ */
+static void flush_writes(uint32_t now, bool force) {
+  if (g_write_count == 0)
+    return;
+  if (!force && now - g_write_since_ms < BIP_WRITE_WINDOW_MS)
+    return;
+
+  bool done[BIP_MAX_PENDING_WRITES] = {false};
+  for (int i = 0; i < g_write_count; i++) {
+    if (done[i])
+      continue;
+
+    uint16_t addr = g_writes[i].addr;
+    xslot_bacnet_object_t objects[BIP_MAX_PENDING_WRITES];
+    uint8_t count = 0;
+    for (int j = i; j < g_write_count && count < 255; j++) {
+      if (!done[j] && g_writes[j].addr == addr) {
+        objects[count++] = g_writes[j].obj;
+        done[j] = true;
+      }
+    }
+
+    int ret = g_client ? xslot_client_write_objects(g_client, addr, objects,
+                                                    count)
+                       : XSLOT_ERR_OFFLINE;
+    if (ret != XSLOT_OK) {
+      std::fprintf(stderr, "xslot_bip: write to %04X failed (%d)\n", addr,
+                   ret);
+      if (ret == XSLOT_ERR_OFFLINE && g_client) {
+        xslot_client_close(g_client);
+        g_client = nullptr;
+      }
+    }
+  }
+
+  g_write_count = 0;
+}
+
+/**
+ * @brief 加入写入队列 (同一对象只保留最新值)
+ */
+static void queue_write(uint16_t addr, const xslot_bacnet_object_t *obj,
+                        uint32_t now) {
+  for (int i = 0; i < g_write_count; i++) {
+    pending_write *w = &g_writes[i];
+    if (w->addr == addr && w->obj.object_type == obj->object_type &&
+        w->obj.object_id == obj->object_id) {
+      w->obj = *obj;
+      return;
+    }
+  }
+
+  if (g_write_count >= BIP_MAX_PENDING_WRITES)
+    flush_writes(now, true);
+  if (g_write_count == 0)
+    g_write_since_ms = now;
+
+  g_writes[g_write_count].addr = addr;
+  g_writes[g_write_count].obj = *obj;
+  g_write_count++;
+}
+
+/* ============================================================================
+ * 服务处理
+ * ============================================================================
+ */
+
+static int handle_read_property(const bip_device *dev, uint8_t invoke,
+                                const uint8_t *req, uint16_t len,
+                                uint8_t *rsp) {
+  uint16_t type;
+  uint32_t instance, prop, index = BIP_ARRAY_ALL;
+
+  int n = bip_decode_ctx_object_id(req, len, 0, &type, &instance);
+  if (n <= 0)
+    return encode_reject(rsp, invoke, REJECT_MISSING_REQUIRED_PARAMETER);
+  int m = bip_decode_ctx_unsigned(req + n, len - n, 1, &prop);
+  if (m <= 0)
+    return encode_reject(rsp, invoke, REJECT_MISSING_REQUIRED_PARAMETER);
+  n += m;
+  if (bip_decode_ctx_unsigned(req + n, len - n, 2, &index) < 0)
+    return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+
+  bip_object obj;
+  if (!find_object(dev, type, instance, &obj)) {
+    return encode_error(rsp, invoke, SERVICE_READ_PROPERTY,
+                        ERROR_CLASS_OBJECT, ERROR_CODE_UNKNOWN_OBJECT);
+  }
+
+  uint8_t value[BIP_MAX_APDU];
+  uint8_t error_code = 0;
+  int vlen = encode_property(dev, &obj, prop, index, value, &error_code);
+  if (vlen < 0) {
+    return encode_error(rsp, invoke, SERVICE_READ_PROPERTY,
+                        ERROR_CLASS_PROPERTY, error_code);
+  }
+
+  n = 0;
+  rsp[n++] = PDU_COMPLEX_ACK;
+  rsp[n++] = invoke;
+  rsp[n++] = SERVICE_READ_PROPERTY;
+  n += bip_encode_ctx_object_id(rsp + n, 0, obj.type, obj.instance);
+  n += bip_encode_ctx_unsigned(rsp + n, 1, prop);
+  if (index != BIP_ARRAY_ALL)
+    n += bip_encode_ctx_unsigned(rsp + n, 2, index);
+  if (n + vlen + 2 > BIP_MAX_APDU)
+    return encode_abort(rsp, invoke, ABORT_SEGMENTATION_NOT_SUPPORTED);
+  n += bip_encode_opening_tag(rsp + n, 3);
+  std::memcpy(rsp + n, value, vlen);
+  n += vlen;
+  n += bip_encode_closing_tag(rsp + n, 3);
+  return n;
+}
+
+/**
+ * @brief 追加一个 ReadAccessResult 元素
+ * @return false=超出 APDU 容量
+ */
+static bool append_result(uint8_t *rsp, int *pos, const bip_device *dev,
+                          const bip_object *obj, bool found, uint32_t prop,
+                          uint32_t index) {
+  uint8_t value[BIP_MAX_APDU];
+  uint8_t error_class = ERROR_CLASS_PROPERTY;
+  uint8_t error_code = 0;
+
+  int vlen = -1;
+  if (!found) {
+    error_class = ERROR_CLASS_OBJECT;
+    error_code = ERROR_CODE_UNKNOWN_OBJECT;
+  } else {
+    vlen = encode_property(dev, obj, prop, index, value, &error_code);
+  }
+  if (vlen < 0) {
+    vlen = bip_encode_opening_tag(value, 5);
+    vlen += bip_encode_app_enumerated(value + vlen, error_class);
+    vlen += bip_encode_app_enumerated(value + vlen, error_code);
+    vlen += bip_encode_closing_tag(value + vlen, 5);
+  } else {
+    /* 值放入 [4] 开闭标签内: 右移 1 字节腾出开标签 */
+    if (vlen + 2 > BIP_MAX_APDU)
+      return false;
+    std::memmove(value + 1, value, vlen);
+    bip_encode_opening_tag(value, 4);
+    vlen += 1;
+    vlen += bip_encode_closing_tag(value + vlen, 4);
+  }
+
+  /* [2] 属性标识 (最多 6 字节) + [3] 数组下标 (最多 6 字节) */
+  if (*pos + 12 + vlen > BIP_MAX_APDU)
+    return false;
+  *pos += bip_encode_ctx_unsigned(rsp + *pos, 2, prop);
+  if (index != BIP_ARRAY_ALL)
+    *pos += bip_encode_ctx_unsigned(rsp + *pos, 3, index);
+  std::memcpy(rsp + *pos, value, vlen);
+  *pos += vlen;
+  return true;
+}
+
+static int handle_read_property_multiple(const bip_device *dev,
+                                         uint8_t invoke, const uint8_t *req,
+                                         uint16_t len, uint8_t *rsp) {
+  int pos = 0;
+  rsp[pos++] = PDU_COMPLEX_ACK;
+  rsp[pos++] = invoke;
+  rsp[pos++] = SERVICE_READ_PROPERTY_MULTIPLE;
+
+  int n = 0;
+  while (n < len) {
+    uint16_t type;
+    uint32_t instance;
+    int m = bip_decode_ctx_object_id(req + n, len - n, 0, &type, &instance);
+    if (m <= 0)
+      return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+    n += m;
+    m = bip_decode_opening_tag(req + n, len - n, 1);
+    if (m <= 0)
+      return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+    n += m;
+
+    /* 同一对象的所有属性取自同一快照 */
+    bip_object obj;
+    bool found = find_object(dev, type, instance, &obj);
+
+    if (pos + 7 > BIP_MAX_APDU)
+      return encode_abort(rsp, invoke, ABORT_SEGMENTATION_NOT_SUPPORTED);
+    pos += bip_encode_ctx_object_id(rsp + pos, 0, obj.type, obj.instance);
+    pos += bip_encode_opening_tag(rsp + pos, 1);
+
+    for (;;) {
+      m = bip_decode_closing_tag(req + n, len - n, 1);
+      if (m < 0)
+        return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+      if (m > 0) {
+        n += m;
+        break;
+      }
+
+      uint32_t prop, index = BIP_ARRAY_ALL;
+      m = bip_decode_ctx_unsigned(req + n, len - n, 0, &prop);
+      if (m <= 0)
+        return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+      n += m;
+      m = bip_decode_ctx_unsigned(req + n, len - n, 1, &index);
+      if (m < 0)
+        return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+      n += m;
+
+      bool ok = true;
+      if (found && (prop == PROP_ALL || prop == PROP_REQUIRED ||
+                    prop == PROP_OPTIONAL)) {
+        for (int pass = 0; pass < 2 && ok; pass++) {
+          bool required = pass == 0;
+          if ((prop == PROP_REQUIRED && !required) ||
+              (prop == PROP_OPTIONAL && required))
+            continue;
+          const uint32_t *list = nullptr;
+          int count = property_list(obj.type, required, &list);
+          for (int i = 0; i < count && ok; i++) {
+            ok = append_result(rsp, &pos, dev, &obj, true, list[i],
+                               BIP_ARRAY_ALL);
+          }
+        }
+      } else {
+        ok = append_result(rsp, &pos, dev, &obj, found, prop, index);
+      }
+      if (!ok)
+        return encode_abort(rsp, invoke, ABORT_SEGMENTATION_NOT_SUPPORTED);
+    }
+
+    if (pos + 1 > BIP_MAX_APDU)
+      return encode_abort(rsp, invoke, ABORT_SEGMENTATION_NOT_SUPPORTED);
+    pos += bip_encode_closing_tag(rsp + pos, 1);
+  }
+
+  return pos;
+}
+
+static int handle_write_property(const bip_device *dev, uint8_t invoke,
+                                 const uint8_t *req, uint16_t len,
+                                 uint8_t *rsp, uint32_t now) {
+  uint16_t type;
+  uint32_t instance, prop, index = BIP_ARRAY_ALL;
+  bip_value_t value;
+
+  int n = bip_decode_ctx_object_id(req, len, 0, &type, &instance);
+  if (n <= 0)
+    return encode_reject(rsp, invoke, REJECT_MISSING_REQUIRED_PARAMETER);
+  int m = bip_decode_ctx_unsigned(req + n, len - n, 1, &prop);
+  if (m <= 0)
+    return encode_reject(rsp, invoke, REJECT_MISSING_REQUIRED_PARAMETER);
+  n += m;
+  m = bip_decode_ctx_unsigned(req + n, len - n, 2, &index);
+  if (m < 0)
+    return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+  n += m;
+  m = bip_decode_opening_tag(req + n, len - n, 3);
+  if (m <= 0)
+    return encode_reject(rsp, invoke, REJECT_MISSING_REQUIRED_PARAMETER);
+  n += m;
+  m = bip_decode_app_value(req + n, len - n, &value);
+  if (m < 0) {
+    return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                        ERROR_CLASS_PROPERTY, ERROR_CODE_INVALID_DATA_TYPE);
+  }
+  /* 优先级 [4] 忽略: 写入直接下发边缘节点，不维护优先级数组 */
+
+  bip_object obj;
+  if (!find_object(dev, type, instance, &obj)) {
+    return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                        ERROR_CLASS_OBJECT, ERROR_CODE_UNKNOWN_OBJECT);
+  }
+  if (!has_property(type, prop)) {
+    return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                        ERROR_CLASS_PROPERTY, ERROR_CODE_UNKNOWN_PROPERTY);
+  }
+  if (prop != PROP_PRESENT_VALUE || type == OBJECT_DEVICE ||
+      type == XSLOT_OBJ_ANALOG_INPUT || type == XSLOT_OBJ_BINARY_INPUT) {
+    return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                        ERROR_CLASS_PROPERTY, ERROR_CODE_WRITE_ACCESS_DENIED);
+  }
+
+  xslot_bacnet_object_t write = obj.data.object;
+  write.flags = 0;
+  if (is_analog((uint8_t)type)) {
+    if (value.tag == BIP_TAG_REAL)
+      write.present_value.analog = value.type.real;
+    else if (value.tag == BIP_TAG_UNSIGNED)
+      write.present_value.analog = (float)value.type.unsigned_value;
+    else if (value.tag == BIP_TAG_SIGNED)
+      write.present_value.analog = (float)value.type.signed_value;
+    else
+      return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                          ERROR_CLASS_PROPERTY, ERROR_CODE_INVALID_DATA_TYPE);
+  } else {
+    if (value.tag != BIP_TAG_ENUMERATED && value.tag != BIP_TAG_UNSIGNED)
+      return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                          ERROR_CLASS_PROPERTY, ERROR_CODE_INVALID_DATA_TYPE);
+    if (value.type.unsigned_value > 1)
+      return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                          ERROR_CLASS_PROPERTY, ERROR_CODE_VALUE_OUT_OF_RANGE);
+    write.present_value.binary = (uint8_t)value.type.unsigned_value;
+  }
+
+  if (!ensure_client(now)) {
+    return encode_error(rsp, invoke, SERVICE_WRITE_PROPERTY,
+                        ERROR_CLASS_DEVICE, ERROR_CODE_OPERATIONAL_PROBLEM);
+  }
+
+  queue_write(dev->addr, &write, now);
+  return encode_simple_ack(rsp, invoke, SERVICE_WRITE_PROPERTY);
+}
+
+static int handle_subscribe_cov(const bip_device *dev, const bip_peer *peer,
+                                uint8_t invoke, const uint8_t *req,
+                                uint16_t len, uint8_t *rsp, uint32_t now) {
+  uint32_t process_id, instance, lifetime = 0;
+  uint16_t type;
+  bool confirmed = false;
+
+  int n = bip_decode_ctx_unsigned(req, len, 0, &process_id);
+  if (n <= 0)
+    return encode_reject(rsp, invoke, REJECT_MISSING_REQUIRED_PARAMETER);
+  int m = bip_decode_ctx_object_id(req + n, len - n, 1, &type, &instance);
+  if (m <= 0)
+    return encode_reject(rsp, invoke, REJECT_MISSING_REQUIRED_PARAMETER);
+  n += m;
+  int has_confirmed = bip_decode_ctx_boolean(req + n, len - n, 2, &confirmed);
+  if (has_confirmed < 0)
+    return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+  n += has_confirmed;
+  int has_lifetime = bip_decode_ctx_unsigned(req + n, len - n, 3, &lifetime);
+  if (has_lifetime < 0)
+    return encode_reject(rsp, invoke, REJECT_INVALID_TAG);
+
+  bip_object obj;
+  if (!find_object(dev, type, instance, &obj)) {
+    return encode_error(rsp, invoke, SERVICE_SUBSCRIBE_COV,
+                        ERROR_CLASS_OBJECT, ERROR_CODE_UNKNOWN_OBJECT);
+  }
+  if (obj.slot < 0) {
+    return encode_error(rsp, invoke, SERVICE_SUBSCRIBE_COV,
+                        ERROR_CLASS_OBJECT,
+                        ERROR_CODE_OPTIONAL_FUNCTIONALITY_NOT_SUPPORTED);
+  }
+
+  /* 订阅以 (订阅方, 进程号, 对象) 标识 */
+  cov_sub *sub = nullptr;
+  cov_sub *free_sub = nullptr;
+  for (int i = 0; i < BIP_MAX_COV_SUBS; i++) {
+    cov_sub *s = &g_subs[i];
+    if (!s->used) {
+      if (!free_sub)
+        free_sub = s;
+      continue;
+    }
+    if (s->process_id == process_id && s->addr == dev->addr &&
+        s->type == type && s->id == instance &&
+        s->peer.addr.sin_addr.s_addr == peer->addr.sin_addr.s_addr &&
+        s->peer.addr.sin_port == peer->addr.sin_port &&
+        s->peer.net == peer->net) {
+      sub = s;
+      break;
+    }
+  }
+
+  /* 两个可选参数都不带表示取消订阅 */
+  if (!has_confirmed && !has_lifetime) {
+    if (sub)
+      sub->used = false;
+    return encode_simple_ack(rsp, invoke, SERVICE_SUBSCRIBE_COV);
+  }
+
+  if (confirmed) {
+    return encode_error(rsp, invoke, SERVICE_SUBSCRIBE_COV,
+                        ERROR_CLASS_SERVICES,
+                        ERROR_CODE_OPTIONAL_FUNCTIONALITY_NOT_SUPPORTED);
+  }
+
+  if (!sub) {
+    sub = free_sub;
+    if (!sub) {
+      return encode_error(rsp, invoke, SERVICE_SUBSCRIBE_COV,
+                          ERROR_CLASS_RESOURCES,
+                          ERROR_CODE_NO_SPACE_TO_ADD_LIST_ELEMENT);
+    }
+    std::memset(sub, 0, sizeof(*sub));
+    sub->used = true;
+    sub->peer = *peer;
+    sub->process_id = process_id;
+    sub->addr = dev->addr;
+    sub->type = (uint8_t)type;
+    sub->id = (uint16_t)instance;
+  }
+
+  sub->slot = obj.slot;
+  sub->expire_ms = lifetime ? now + lifetime * 1000 : 0;
+  if (sub->expire_ms == 0 && lifetime)
+    sub->expire_ms = 1;
+  sub->pending = true; /* 订阅成功后立即发送一次当前值 */
+
+  return encode_simple_ack(rsp, invoke, SERVICE_SUBSCRIBE_COV);
+}
+
+static void send_cov_notification(const cov_sub *sub,
+                                  const xslot_bacnet_object_t *value,
+                                  uint8_t status, uint32_t now) {
+  uint8_t apdu[64];
+  int n = 0;
+  apdu[n++] = PDU_UNCONFIRMED_REQUEST;
+  apdu[n++] = SERVICE_UNCONFIRMED_COV;
+  n += bip_encode_ctx_unsigned(apdu + n, 0, sub->process_id);
+  n += bip_encode_ctx_object_id(apdu + n, 1, OBJECT_DEVICE,
+                                g_device_base + sub->addr);
+  n += bip_encode_ctx_object_id(apdu + n, 2, sub->type, sub->id);
+  uint32_t remaining =
+      sub->expire_ms ? (sub->expire_ms - now + 999) / 1000 : 0;
+  n += bip_encode_ctx_unsigned(apdu + n, 3, remaining);
+
+  n += bip_encode_opening_tag(apdu + n, 4);
+  n += bip_encode_ctx_unsigned(apdu + n, 0, PROP_PRESENT_VALUE);
+  n += bip_encode_opening_tag(apdu + n, 2);
+  if (is_analog(sub->type))
+    n += bip_encode_app_real(apdu + n, value->present_value.analog);
+  else
+    n += bip_encode_app_enumerated(apdu + n, value->present_value.binary);
+  n += bip_encode_closing_tag(apdu + n, 2);
+  n += bip_encode_ctx_unsigned(apdu + n, 0, PROP_STATUS_FLAGS);
+  n += bip_encode_opening_tag(apdu + n, 2);
+  n += bip_encode_app_bit_string(apdu + n, &status, 4);
+  n += bip_encode_closing_tag(apdu + n, 2);
+  n += bip_encode_closing_tag(apdu + n, 4);
+
+  send_npdu(&sub->peer, sub->addr, 0, apdu, n);
+}
+
+/**
+ * @brief 检查订阅对象的槽位变化并发送 COV 通知
+ *
+ * 槽位序号每次写入都会变化，序号不变时无需比较取值。
+ */
+static void check_cov(uint32_t now) {
+  if (!g_shm)
+    return;
+
+  for (int i = 0; i < BIP_MAX_COV_SUBS; i++) {
+    cov_sub *sub = &g_subs[i];
+    if (!sub->used)
+      continue;
+    if (sub->expire_ms && (int32_t)(now - sub->expire_ms) >= 0) {
+      sub->used = false;
+      continue;
+    }
+    if (sub->slot < 0) {
+      sub->slot = xslot_shm_find_object(g_shm, sub->addr, sub->type, sub->id);
+      if (sub->slot < 0)
+        continue;
+      sub->pending = true;
+    }
+
+    xslot_shm_object_t slot;
+    if (xslot_shm_read_object(g_shm, sub->slot, &slot) != XSLOT_OK)
+      continue;
+
+    const bip_device *dev = find_device(sub->addr, false);
+    uint8_t status = status_flags(&slot.object, dev && dev->online);
+
+    bool changed = sub->pending || status != sub->last_status;
+    if (!changed && slot.seq != sub->last_seq) {
+      if (is_analog(sub->type))
+        changed = std::memcmp(&slot.object.present_value.analog,
+                              &sub->last.present_value.analog, 4) != 0;
+      else
+        changed = slot.object.present_value.binary !=
+                  sub->last.present_value.binary;
+    }
+    sub->last_seq = slot.seq;
+    if (!changed)
+      continue;
+
+    sub->pending = false;
+    sub->last = slot.object;
+    sub->last_status = status;
+    send_cov_notification(sub, &slot.object, status, now);
+  }
+}
+
+/* ============================================================================
+ * 报文分发
+ * ============================================================================
+ */
+
+static void handle_who_is(const bip_peer *peer, const bip_device *target,
+                          const uint8_t *req, uint16_t len) {
+  uint32_t low = 0, high = BIP_WILDCARD_INSTANCE;
+  int n = bip_decode_ctx_unsigned(req, len, 0, &low);
+  if (n > 0 && bip_decode_ctx_unsigned(req + n, len - n, 1, &high) <= 0)
+    return;
+
+  for (int i = 0; i < g_device_count; i++) {
+    const bip_device *dev = &g_devices[i];
+    if (target && dev != target)
+      continue;
+    uint32_t instance = g_device_base + dev->addr;
+    if (instance >= low && instance <= high)
+      send_i_am(peer, dev);
+  }
+}
+
+static void handle_confirmed(const bip_peer *peer, const bip_device *dev,
+                             const uint8_t *apdu, uint16_t len, uint32_t now) {
+  static const uint16_t k_max_apdu[] = {50, 128, 206, 480, 1024, 1476};
+
+  if (len < 4)
+    return;
+
+  uint8_t invoke = apdu[2];
+  uint8_t max_index = apdu[1] & 0x0F;
+  uint16_t max_apdu = max_index < 6 ? k_max_apdu[max_index] : 50;
+  uint8_t rsp[BIP_MAX_APDU];
+  int rlen;
+
+  if (apdu[0] & 0x08) {
+    /* 不支持分段请求 */
+    rlen = encode_abort(rsp, invoke, ABORT_SEGMENTATION_NOT_SUPPORTED);
+    send_npdu(peer, dev->addr, 0, rsp, rlen);
+    return;
+  }
+
+  uint8_t service = apdu[3];
+  const uint8_t *req = apdu + 4;
+  uint16_t req_len = len - 4;
+
+  switch (service) {
+  case SERVICE_READ_PROPERTY:
+    rlen = handle_read_property(dev, invoke, req, req_len, rsp);
+    break;
+  case SERVICE_READ_PROPERTY_MULTIPLE:
+    rlen = handle_read_property_multiple(dev, invoke, req, req_len, rsp);
+    break;
+  case SERVICE_WRITE_PROPERTY:
+    rlen = handle_write_property(dev, invoke, req, req_len, rsp, now);
+    break;
+  case SERVICE_SUBSCRIBE_COV:
+    rlen = handle_subscribe_cov(dev, peer, invoke, req, req_len, rsp, now);
+    break;
+  default:
+    rlen = encode_reject(rsp, invoke, REJECT_UNRECOGNIZED_SERVICE);
+    break;
+  }
+
+  if (rlen > max_apdu)
+    rlen = encode_abort(rsp, invoke, ABORT_SEGMENTATION_NOT_SUPPORTED);
+  send_npdu(peer, dev->addr, 0, rsp, rlen);
+}
+
+static void handle_npdu(bip_peer *peer, const uint8_t *buf, uint16_t len,
+                        uint32_t now) {
+  bip_npdu_t npdu;
+  int n = bip_decode_npdu(buf, len, &npdu);
+  if (n < 0)
+    return;
+
+  if (npdu.control & NPDU_SNET_PRESENT) {
+    peer->net = npdu.snet;
+    peer->mac_len = npdu.slen;
+    std::memcpy(peer->mac, npdu.sadr, npdu.slen);
+  }
+
+  if (npdu.control & NPDU_NETWORK_MSG) {
+    if (npdu.msg_type == NPDU_WHO_IS_ROUTER) {
+      uint16_t net = len >= n + 2 ? (uint16_t)((buf[n] << 8) | buf[n + 1]) : 0;
+      if (net == 0 || net == g_vnet)
+        send_i_am_router(peer);
+    }
+    return;
+  }
+
+  /* 目标: 本地/全局广播或虚拟网络中的某台设备 */
+  const bip_device *target = nullptr;
+  if (npdu.control & NPDU_DNET_PRESENT) {
+    if (npdu.dnet != BIP_NET_BROADCAST && npdu.dnet != g_vnet)
+      return;
+    if (npdu.dnet == g_vnet && npdu.dlen == 2) {
+      target = find_device((uint16_t)((npdu.dadr[0] << 8) | npdu.dadr[1]),
+                           false);
+      if (!target)
+        return;
+    }
+  }
+
+  const uint8_t *apdu = buf + n;
+  uint16_t apdu_len = len - n;
+  if (apdu_len < 2)
+    return;
+
+  uint8_t pdu_type = apdu[0] & 0xF0;
+  if (pdu_type == PDU_UNCONFIRMED_REQUEST && apdu[1] == SERVICE_WHO_IS) {
+    handle_who_is(peer, target, apdu + 2, apdu_len - 2);
+  } else if (pdu_type == PDU_CONFIRMED_REQUEST && target) {
+    handle_confirmed(peer, target, apdu, apdu_len, now);
+  }
+}
+
+static void handle_datagram(const uint8_t *buf, uint16_t len,
+                            const struct sockaddr_in *from, uint32_t now) {
+  if (len < 4 || buf[0] != BVLC_TYPE_BIP)
+    return;
+  uint16_t bvlc_len = (uint16_t)((buf[2] << 8) | buf[3]);
+  if (bvlc_len > len)
+    return;
+
+  bip_peer peer;
+  std::memset(&peer, 0, sizeof(peer));
+  peer.addr = *from;
+
+  switch (buf[1]) {
+  case BVLC_ORIGINAL_UNICAST:
+  case BVLC_ORIGINAL_BROADCAST:
+    handle_npdu(&peer, buf + 4, bvlc_len - 4, now);
+    break;
+
+  case BVLC_FORWARDED_NPDU:
+    /* BBMD 转发: 直接应答原始发送方 */
+    if (bvlc_len < 10)
+      return;
+    std::memcpy(&peer.addr.sin_addr.s_addr, buf + 4, 4);
+    std::memcpy(&peer.addr.sin_port, buf + 8, 2);
+    handle_npdu(&peer, buf + 10, bvlc_len - 10, now);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/* ============================================================================
+ * 主程序
+ * ============================================================================
+ */
+
+static int open_socket(uint16_t port) {
+  int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+  if (fd < 0)
+    return -1;
+
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+  struct sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static void usage(const char *prog) {
+  std::fprintf(stderr,
+               "Usage: %s [-s socket_path] [-m shm_name] [-p udp_port] "
+               "[-n vnet] [-d device_base] [-v vendor_id]\n",
+               prog);
+}
+
+int main(int argc, char *argv[]) {
+  uint16_t port = BIP_DEFAULT_PORT;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "s:m:p:n:d:v:h")) != -1) {
+    switch (opt) {
+    case 's':
+      g_socket_path = optarg;
+      break;
+    case 'm':
+      g_shm_name = optarg;
+      break;
+    case 'p':
+      port = (uint16_t)std::strtoul(optarg, nullptr, 0);
+      break;
+    case 'n':
+      g_vnet = (uint16_t)std::strtoul(optarg, nullptr, 0);
+      break;
+    case 'd':
+      g_device_base = (uint32_t)std::strtoul(optarg, nullptr, 0);
+      break;
+    case 'v':
+      g_vendor_id = (uint16_t)std::strtoul(optarg, nullptr, 0);
+      break;
+    default:
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (g_vnet == 0 || g_vnet == BIP_NET_BROADCAST ||
+      g_device_base + 0xFFFF >= BIP_WILDCARD_INSTANCE) {
+    std::fprintf(stderr, "xslot_bip: invalid network or device base\n");
+    return 1;
+  }
+
+  g_sock = open_socket(port);
+  if (g_sock < 0) {
+    std::fprintf(stderr, "xslot_bip: cannot bind UDP port %u\n", port);
+    return 1;
+  }
+
+  std::signal(SIGINT, on_signal);
+  std::signal(SIGTERM, on_signal);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  uint32_t now = now_ms();
+  g_shm_retry_ms = now - BIP_RETRY_MS;
+  g_client_retry_ms = now - BIP_RETRY_MS;
+
+  std::printf("xslot_bip: port %u, network %u, device base %u\n", port,
+              g_vnet, g_device_base);
+
+  while (g_running) {
+    struct pollfd pfd = {g_sock, POLLIN, 0};
+    int ready = poll(&pfd, 1, BIP_POLL_MS);
+    if (ready < 0 && errno != EINTR)
+      break;
+
+    now = now_ms();
+    ensure_shm(now);
+    refresh_devices();
+
+    if (ready > 0) {
+      uint8_t rx[BIP_MAX_MPDU];
+      struct sockaddr_in from;
+      socklen_t from_len = sizeof(from);
+      ssize_t n;
+      while ((n = recvfrom(g_sock, rx, sizeof(rx), 0,
+                           (struct sockaddr *)&from, &from_len)) > 0) {
+        handle_datagram(rx, (uint16_t)n, &from, now);
+        from_len = sizeof(from);
+      }
+    }
+
+    check_cov(now);
+    flush_writes(now, false);
+  }
+
+  flush_writes(now_ms(), true);
+  if (g_client)
+    xslot_client_close(g_client);
+  if (g_shm)
+    xslot_shm_close(g_shm);
+  close(g_sock);
+  return 0;
+}
@@ -0,0 +1,660 @@
+/**
+ * @file xslotd.cpp
+ * @brief X-Slot 本地守护进程
+ *
+ * 独占串口/无线模组，通过 Unix 域套接字向本机多个客户端提供
+ * X-Slot API (协议见 src/ipc/ipc_protocol.h，客户端见 xslot_client.h)。
+ *
+ * 单线程事件循环: 套接字请求到达即处理并立即应答；无线侧接收到的
+ * 事件按客户端订阅过滤后先写入各自的批缓冲区，每轮循环末尾
+ * 每个客户端只发送一次。
+ *
+ * 可选集群模式: 与同一小区另一汇聚节点的 xslotd 建立复制链路
+ * (src/cluster/cluster_link.h)，互相转发无线侧收到的帧，并按节点归属
+ * 分担下行发送。
+ *
+ * 用法: xslotd [-p 串口] [-b 波特率] [-a 本地地址] [-s 套接字路径]
+ *              [-m 共享内存名] [-g 汇聚节点组] [-L 集群监听端点]
+ *              [-P 集群对端端点]
+ */
+#include "../src/cluster/cluster_link.h"
+#include "../src/ipc/ipc_protocol.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot.h>
+#include <xslot/xslot_client.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define XSLOTD_MAX_CLIENTS 32
+#define XSLOTD_OUT_SIZE 65536 /**< 每客户端发送缓冲区 */
+#define XSLOTD_POLL_MS 1      /**< 套接字空闲时的无线侧轮询间隔 */
+#define XSLOTD_MAX_SUB_ADDRS 32
+
+struct client_conn {
+  int fd;
+
+  /* 订阅 */
+  uint8_t mask;
+  uint8_t addr_count;
+  uint16_t addrs[XSLOTD_MAX_SUB_ADDRS];
+
+  /* 请求接收缓冲区 */
+  uint8_t in[IPC_HEADER_SIZE + IPC_MAX_PAYLOAD];
+  uint32_t in_len;
+
+  /* 当前通知批 ([COUNT:2] + 事件) */
+  uint8_t batch[IPC_MAX_PAYLOAD];
+  uint16_t batch_len;
+  uint16_t batch_count;
+
+  /* 发送缓冲区 */
+  uint8_t out[XSLOTD_OUT_SIZE];
+  uint32_t out_len;
+  uint32_t dropped; /**< 客户端读取过慢而丢弃的通知批数 */
+};
+
+static xslot_handle_t g_handle;
+static client_conn *g_clients[XSLOTD_MAX_CLIENTS];
+static cluster_link_t g_cluster;
+static volatile sig_atomic_t g_running = 1;
+
+static void on_signal(int sig) {
+  (void)sig;
+  g_running = 0;
+}
+
+/* ============================================================================
+ * 发送缓冲
+ * ============================================================================
+ */
+
+/**
+ * @brief 追加一条消息到发送缓冲区
+ * @return false=缓冲区满
+ */
+static bool out_append(client_conn *c, uint8_t type, uint8_t seq,
+                       const uint8_t *payload, uint16_t len) {
+  if (c->out_len + IPC_HEADER_SIZE + len > XSLOTD_OUT_SIZE)
+    return false;
+
+  ipc_header_t hdr = {len, type, seq};
+  std::memcpy(c->out + c->out_len, &hdr, sizeof(hdr));
+  std::memcpy(c->out + c->out_len + IPC_HEADER_SIZE, payload, len);
+  c->out_len += IPC_HEADER_SIZE + len;
+  return true;
+}
+
+/**
+ * @brief 结束当前通知批并放入发送缓冲区
+ */
+static void batch_finish(client_conn *c) {
+  if (c->batch_count == 0)
+    return;
+
+  std::memcpy(c->batch, &c->batch_count, 2);
+  if (!out_append(c, IPC_NOTIFY_BATCH, 0, c->batch, c->batch_len))
+    c->dropped++;
+
+  c->batch_count = 0;
+  c->batch_len = 0;
+}
+
+/**
+ * @brief 尽量发送缓冲区中的数据 (非阻塞)
+ * @return false=连接已断开
+ */
+static bool out_flush(client_conn *c) {
+  while (c->out_len > 0) {
+    ssize_t n = send(c->fd, c->out, c->out_len, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return true;
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    std::memmove(c->out, c->out + n, c->out_len - n);
+    c->out_len -= n;
+  }
+  return true;
+}
+
+/* ============================================================================
+ * 通知
+ * ============================================================================
+ */
+
+static bool subscribed(const client_conn *c, uint8_t kind, uint16_t from) {
+  if (!(c->mask & kind))
+    return false;
+  if (c->addr_count == 0)
+    return true;
+  for (uint8_t i = 0; i < c->addr_count; i++) {
+    if (c->addrs[i] == from)
+      return true;
+  }
+  return false;
+}
+
+static void notify_sub(uint8_t kind, uint16_t from, uint8_t sub,
+                       const void *body, uint16_t len) {
+  ipc_event_header_t eh = {kind, sub, from, len};
+
+  for (int i = 0; i < XSLOTD_MAX_CLIENTS; i++) {
+    client_conn *c = g_clients[i];
+    if (!c || !subscribed(c, kind, from))
+      continue;
+
+    if (c->batch_len == 0)
+      c->batch_len = 2; /* 预留 COUNT */
+    if (c->batch_len + sizeof(eh) + len > IPC_MAX_PAYLOAD) {
+      batch_finish(c);
+      c->batch_len = 2;
+    }
+
+    std::memcpy(c->batch + c->batch_len, &eh, sizeof(eh));
+    std::memcpy(c->batch + c->batch_len + sizeof(eh), body, len);
+    c->batch_len += sizeof(eh) + len;
+    c->batch_count++;
+  }
+}
+
+static void notify(uint8_t kind, uint16_t from, const void *body,
+                   uint16_t len) {
+  notify_sub(kind, from, 0, body, len);
+}
+
+static void on_data(uint16_t from, const uint8_t *data, uint8_t len) {
+  notify(XSLOT_CLIENT_EV_DATA, from, data, len);
+}
+
+static void on_node(uint16_t addr, bool online) {
+  uint8_t body = online ? 1 : 0;
+  notify(XSLOT_CLIENT_EV_NODE, addr, &body, 1);
+}
+
+static void on_write(uint16_t from, const xslot_bacnet_object_t *obj) {
+  notify(XSLOT_CLIENT_EV_WRITE, from, obj, sizeof(*obj));
+}
+
+static void on_report(uint16_t from, const xslot_bacnet_object_t *objects,
+                      uint8_t count) {
+  notify(XSLOT_CLIENT_EV_REPORT, from, objects, count * sizeof(*objects));
+}
+
+static void on_alarm(const xslot_alarm_event_t *event) {
+  notify(XSLOT_CLIENT_EV_ALARM, event->addr, event, sizeof(*event));
+}
+
+static void on_property(uint16_t from, const xslot_property_set_t *props,
+                        uint8_t count) {
+  notify(XSLOT_CLIENT_EV_PROPERTY, from, props, count * sizeof(*props));
+}
+
+static void on_history(uint16_t from, const xslot_history_sample_t *samples,
+                       uint16_t count) {
+  /* 按单条通知消息的容量分段 */
+  const uint16_t chunk = 64;
+  for (uint16_t i = 0; i < count; i += chunk) {
+    uint16_t n = count - i < chunk ? count - i : chunk;
+    notify(XSLOT_CLIENT_EV_HISTORY, from, &samples[i], n * sizeof(*samples));
+  }
+}
+
+static void on_sub_report(uint16_t from, uint8_t sub,
+                          const xslot_bacnet_object_t *objects, uint8_t count) {
+  notify_sub(XSLOT_CLIENT_EV_REPORT, from, sub, objects,
+             count * sizeof(*objects));
+}
+
+static void on_sub_property(uint16_t from, uint8_t sub,
+                            const xslot_property_set_t *props, uint8_t count) {
+  notify_sub(XSLOT_CLIENT_EV_PROPERTY, from, sub, props,
+             count * sizeof(*props));
+}
+
+/* ============================================================================
+ * 请求处理
+ * ============================================================================
+ */
+
+static void respond(client_conn *c, uint8_t seq, int32_t code,
+                    const void *data, uint16_t len) {
+  uint8_t payload[4 + XSLOT_MAX_NODES * sizeof(xslot_node_info_t)];
+  std::memcpy(payload, &code, 4);
+  if (len > 0)
+    std::memcpy(payload + 4, data, len);
+
+  /* 先发出之前的通知，保持事件与应答的先后顺序 */
+  batch_finish(c);
+  out_append(c, IPC_RSP_RESULT, seq, payload, 4 + len);
+}
+
+static void handle_request(client_conn *c, const ipc_header_t *hdr,
+                           const uint8_t *p) {
+  uint16_t len = hdr->len;
+  int32_t code = XSLOT_ERR_PARAM;
+
+  switch (hdr->type) {
+  case IPC_REQ_SUBSCRIBE:
+    if (len >= 2 && p[1] <= XSLOTD_MAX_SUB_ADDRS && len >= 2 + p[1] * 2) {
+      c->mask = p[0];
+      c->addr_count = p[1];
+      std::memcpy(c->addrs, p + 2, p[1] * 2);
+      code = XSLOT_OK;
+    }
+    break;
+
+  case IPC_REQ_REPORT:
+    if (len >= 1 && p[0] > 0 &&
+        len >= 1 + p[0] * sizeof(xslot_bacnet_object_t)) {
+      xslot_bacnet_object_t objects[255];
+      std::memcpy(objects, p + 1, p[0] * sizeof(xslot_bacnet_object_t));
+      code = xslot_report_objects(g_handle, objects, p[0]);
+    }
+    break;
+
+  case IPC_REQ_WRITE:
+    if (len >= 2 + sizeof(xslot_bacnet_object_t)) {
+      uint16_t target;
+      xslot_bacnet_object_t obj;
+      std::memcpy(&target, p, 2);
+      std::memcpy(&obj, p + 2, sizeof(obj));
+      code = xslot_write_object(g_handle, target, &obj);
+    }
+    break;
+
+  case IPC_REQ_WRITE_MULTI:
+    if (len >= 3 && p[2] > 0 &&
+        len >= 3 + p[2] * sizeof(xslot_bacnet_object_t)) {
+      uint16_t target;
+      xslot_bacnet_object_t objects[255];
+      std::memcpy(&target, p, 2);
+      std::memcpy(objects, p + 3, p[2] * sizeof(xslot_bacnet_object_t));
+      code = xslot_write_objects(g_handle, target, objects, p[2]);
+    }
+    break;
+
+  case IPC_REQ_QUERY:
+    if (len >= 3 && p[2] > 0 && len >= 3 + p[2] * 2) {
+      uint16_t target;
+      uint16_t ids[255];
+      std::memcpy(&target, p, 2);
+      std::memcpy(ids, p + 3, p[2] * 2);
+      code = xslot_query_objects(g_handle, target, ids, p[2]);
+    }
+    break;
+
+  case IPC_REQ_QUERY_PROP:
+    if (len >= 4 && p[3] > 0 &&
+        len >= 4 + p[3] * sizeof(xslot_object_ref_t)) {
+      uint16_t target;
+      xslot_object_ref_t refs[255];
+      std::memcpy(&target, p, 2);
+      std::memcpy(refs, p + 4, p[3] * sizeof(xslot_object_ref_t));
+      code = xslot_query_properties(g_handle, target, p[2], refs, p[3]);
+    }
+    break;
+
+  case IPC_REQ_PING:
+    if (len >= 2) {
+      uint16_t target;
+      std::memcpy(&target, p, 2);
+      code = xslot_send_ping(g_handle, target);
+    }
+    break;
+
+  case IPC_REQ_GET_NODES: {
+    xslot_node_info_t nodes[XSLOT_MAX_NODES];
+    int n = xslot_get_nodes(g_handle, nodes, XSLOT_MAX_NODES);
+    if (n >= 0) {
+      respond(c, hdr->seq, XSLOT_OK, nodes, n * sizeof(xslot_node_info_t));
+      return;
+    }
+    code = n;
+    break;
+  }
+
+  case IPC_REQ_GET_MODE:
+    code = xslot_get_run_mode(g_handle);
+    break;
+
+  default:
+    break;
+  }
+
+  respond(c, hdr->seq, code, nullptr, 0);
+}
+
+/**
+ * @brief 读取客户端数据并处理完整请求
+ * @return false=连接已断开
+ */
+static bool client_read(client_conn *c) {
+  ssize_t n = recv(c->fd, c->in + c->in_len, sizeof(c->in) - c->in_len,
+                   MSG_DONTWAIT);
+  if (n == 0)
+    return false;
+  if (n < 0)
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  c->in_len += n;
+
+  uint32_t pos = 0;
+  while (c->in_len - pos >= IPC_HEADER_SIZE) {
+    ipc_header_t hdr;
+    std::memcpy(&hdr, c->in + pos, sizeof(hdr));
+    if (hdr.len > IPC_MAX_PAYLOAD)
+      return false; /* 协议错误 */
+    if (c->in_len - pos < (uint32_t)IPC_HEADER_SIZE + hdr.len)
+      break;
+
+    handle_request(c, &hdr, c->in + pos + IPC_HEADER_SIZE);
+    pos += IPC_HEADER_SIZE + hdr.len;
+  }
+
+  std::memmove(c->in, c->in + pos, c->in_len - pos);
+  c->in_len -= pos;
+  return true;
+}
+
+/* ============================================================================
+ * 连接管理
+ * ============================================================================
+ */
+
+static int listen_socket(const char *path) {
+  struct sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (std::strlen(path) >= sizeof(addr.sun_path))
+    return -1;
+  std::strcpy(addr.sun_path, path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+  if (fd < 0)
+    return -1;
+
+  unlink(path);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+      listen(fd, XSLOTD_MAX_CLIENTS) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static void client_accept(int listen_fd) {
+  for (;;) {
+    int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+    if (fd < 0)
+      return;
+
+    int slot = -1;
+    for (int i = 0; i < XSLOTD_MAX_CLIENTS; i++) {
+      if (!g_clients[i]) {
+        slot = i;
+        break;
+      }
+    }
+    if (slot < 0) {
+      close(fd);
+      continue;
+    }
+
+    client_conn *c = (client_conn *)std::calloc(1, sizeof(client_conn));
+    if (!c) {
+      close(fd);
+      continue;
+    }
+
+    c->fd = fd;
+    g_clients[slot] = c;
+  }
+}
+
+static void client_close(int slot) {
+  client_conn *c = g_clients[slot];
+  close(c->fd);
+  std::free(c);
+  g_clients[slot] = nullptr;
+}
+
+/* ============================================================================
+ * 集群
+ * ============================================================================
+ */
+
+static void cluster_on_uplink(void *ctx, const uint8_t *frame, uint16_t len) {
+  cluster_link_uplink((cluster_link_t)ctx, frame, len);
+}
+
+static int cluster_on_downlink(void *ctx, const uint8_t *frame, uint16_t len,
+                               bool confirmed) {
+  return cluster_link_downlink((cluster_link_t)ctx, frame, len, confirmed);
+}
+
+static void cluster_peer(void *ctx, uint16_t addr) {
+  (void)ctx;
+  if (addr == 0) {
+    std::printf("xslotd: cluster peer down\n");
+    xslot_cluster_attach(g_handle, nullptr);
+    return;
+  }
+
+  xslot_cluster_ops_t ops;
+  ops.on_uplink = cluster_on_uplink;
+  ops.on_downlink = cluster_on_downlink;
+  ops.ctx = g_cluster;
+  ops.peer_addr = addr;
+  xslot_cluster_attach(g_handle, &ops);
+  std::printf("xslotd: cluster peer 0x%04X up\n", addr);
+}
+
+static void cluster_uplink(void *ctx, const uint8_t *frame, uint16_t len) {
+  (void)ctx;
+  xslot_cluster_inject(g_handle, frame, len);
+}
+
+static void cluster_downlink(void *ctx, const uint8_t *frame, uint16_t len,
+                             bool confirmed) {
+  (void)ctx;
+  xslot_cluster_transmit(g_handle, frame, len, confirmed);
+}
+
+/* ============================================================================
+ * 主程序
+ * ============================================================================
+ */
+
+static void usage(const char *prog) {
+  std::fprintf(stderr,
+               "Usage: %s [-p port] [-b baudrate] [-a local_addr] "
+               "[-s socket_path] [-m shm_name] [-g hub,hub,...] "
+               "[-L cluster_listen] [-P cluster_peer]\n",
+               prog);
+}
+
+int main(int argc, char *argv[]) {
+  xslot_config_t config;
+  std::memset(&config, 0, sizeof(config));
+  config.local_addr = XSLOT_ADDR_HUB;
+  config.uart_baudrate = 115200;
+  std::snprintf(config.uart_port, sizeof(config.uart_port), "/dev/ttyUSB0");
+
+  const char *socket_path = XSLOT_CLIENT_DEFAULT_PATH;
+  const char *shm_name = nullptr;
+  uint16_t hubs[XSLOT_MAX_HUBS];
+  uint8_t hub_count = 0;
+  const char *cluster_listen = nullptr;
+  const char *cluster_peer_ep = nullptr;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "p:b:a:s:m:g:L:P:h")) != -1) {
+    switch (opt) {
+    case 'p':
+      std::snprintf(config.uart_port, sizeof(config.uart_port), "%s", optarg);
+      break;
+    case 'b':
+      config.uart_baudrate = (uint32_t)std::strtoul(optarg, nullptr, 0);
+      break;
+    case 'a':
+      config.local_addr = (uint16_t)std::strtoul(optarg, nullptr, 16);
+      break;
+    case 's':
+      socket_path = optarg;
+      break;
+    case 'm':
+      shm_name = optarg;
+      break;
+    case 'g': {
+      /* 汇聚节点组: 逗号分隔的十六进制地址 */
+      char *p = optarg;
+      while (*p && hub_count < XSLOT_MAX_HUBS) {
+        char *end;
+        unsigned long addr = std::strtoul(p, &end, 16);
+        if (end == p)
+          break;
+        hubs[hub_count++] = (uint16_t)addr;
+        p = *end == ',' ? end + 1 : end;
+      }
+      break;
+    }
+    case 'L':
+      cluster_listen = optarg;
+      break;
+    case 'P':
+      cluster_peer_ep = optarg;
+      break;
+    default:
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  g_handle = xslot_init(&config);
+  if (!g_handle) {
+    std::fprintf(stderr, "xslotd: xslot_init failed\n");
+    return 1;
+  }
+
+  xslot_set_data_callback(g_handle, on_data);
+  xslot_set_node_callback(g_handle, on_node);
+  xslot_set_write_callback(g_handle, on_write);
+  xslot_set_report_callback(g_handle, on_report);
+  xslot_set_alarm_callback(g_handle, on_alarm);
+  xslot_set_property_callback(g_handle, on_property);
+  xslot_set_history_callback(g_handle, on_history);
+  xslot_set_sub_report_callback(g_handle, on_sub_report);
+  xslot_set_sub_property_callback(g_handle, on_sub_property);
+  if (hub_count > 0) {
+    xslot_set_hub_group(g_handle, hubs, hub_count);
+  }
+
+  int ret = xslot_start(g_handle);
+  if (ret != XSLOT_OK) {
+    std::fprintf(stderr, "xslotd: xslot_start failed (%s)\n",
+                 xslot_strerror((xslot_error_t)ret));
+    xslot_deinit(g_handle);
+    return 1;
+  }
+
+  if (shm_name) {
+    xslot_enable_shm_publish(g_handle, shm_name);
+  }
+
+  int listen_fd = listen_socket(socket_path);
+  if (listen_fd < 0) {
+    std::fprintf(stderr, "xslotd: cannot listen on %s\n", socket_path);
+    xslot_deinit(g_handle);
+    return 1;
+  }
+
+  if (cluster_listen || cluster_peer_ep) {
+    cluster_handlers_t handlers = {cluster_peer, cluster_uplink,
+                                   cluster_downlink, nullptr};
+    g_cluster = cluster_link_create(cluster_listen, cluster_peer_ep,
+                                    config.local_addr, &handlers);
+    if (!g_cluster) {
+      std::fprintf(stderr, "xslotd: cannot open cluster link\n");
+      close(listen_fd);
+      xslot_deinit(g_handle);
+      return 1;
+    }
+  }
+
+  std::signal(SIGINT, on_signal);
+  std::signal(SIGTERM, on_signal);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  std::printf("xslotd: mode=%d, listening on %s\n",
+              xslot_get_run_mode(g_handle), socket_path);
+
+  struct pollfd pfds[1 + XSLOTD_MAX_CLIENTS + 2];
+  int slots[1 + XSLOTD_MAX_CLIENTS];
+
+  while (g_running) {
+    int n = 0;
+    pfds[n].fd = listen_fd;
+    pfds[n].events = POLLIN;
+    slots[n++] = -1;
+    for (int i = 0; i < XSLOTD_MAX_CLIENTS; i++) {
+      if (!g_clients[i])
+        continue;
+      pfds[n].fd = g_clients[i]->fd;
+      pfds[n].events = POLLIN | (g_clients[i]->out_len ? POLLOUT : 0);
+      slots[n++] = i;
+    }
+    int cluster_base = n;
+    n += cluster_link_pollfds(g_cluster, &pfds[n], 2);
+
+    int ready = poll(pfds, n, XSLOTD_POLL_MS);
+    if (ready < 0 && errno != EINTR)
+      break;
+
+    for (int i = 0; ready > 0 && i < cluster_base; i++) {
+      if (!pfds[i].revents)
+        continue;
+      if (slots[i] < 0) {
+        client_accept(listen_fd);
+      } else if ((pfds[i].revents & (POLLIN | POLLHUP | POLLERR)) &&
+                 !client_read(g_clients[slots[i]])) {
+        client_close(slots[i]);
+      }
+    }
+    cluster_link_process(g_cluster, &pfds[cluster_base], n - cluster_base);
+
+    /* 无线侧: 只取走已到达的数据，不阻塞套接字处理 */
+    xslot_poll(g_handle, 0);
+    cluster_link_flush(g_cluster);
+
+    for (int i = 0; i < XSLOTD_MAX_CLIENTS; i++) {
+      if (!g_clients[i])
+        continue;
+      batch_finish(g_clients[i]);
+      if (!out_flush(g_clients[i]))
+        client_close(i);
+    }
+  }
+
+  for (int i = 0; i < XSLOTD_MAX_CLIENTS; i++) {
+    if (g_clients[i])
+      client_close(i);
+  }
+  close(listen_fd);
+  unlink(socket_path);
+
+  xslot_cluster_attach(g_handle, nullptr);
+  cluster_link_destroy(g_cluster);
+
+  xslot_stop(g_handle);
+  xslot_deinit(g_handle);
+  return 0;
+}
@@ -125,6 +125,9 @@ int main(int argc, char *argv[]) {
   case XSLOT_MODE_HMI:
     printf("Warning: Running in HMI mode (expected WIRELESS)\n");
     break;
+  case XSLOT_MODE_SOCKET:
+    printf("Running in SOCKET mode (%s)\n", config.uart_port);
+    break;
   case XSLOT_MODE_NONE:
     printf("Error: No device detected\n");
     xslot_deinit(handle);
@@ -153,6 +156,9 @@ int main(int argc, char *argv[]) {
       xslot_from_di(&di_objects[i], &objects[obj_count++]);
     }
 
+    /* 同时发布给直连的 HMI (无订阅者时只更新缓存) */
+    xslot_stream_publish(handle, objects, obj_count);
+
     /* 上报 */
     ret = xslot_report_objects(handle, objects, obj_count);
     if (ret == XSLOT_OK) {
@@ -168,12 +174,10 @@ int main(int argc, char *argv[]) {
       printf("Report failed: %d\n", ret);
     }
 
-    /* 等待下一个上报周期 (30秒) */
-#ifdef _WIN32
-    Sleep(30000);
-#else
-    sleep(30);
-#endif
+    /* 等待下一个上报周期 (30秒)，期间处理写入请求 */
+    for (int i = 0; i < 30; i++) {
+      xslot_poll(handle, 1000);
+    }
   }
 
   /* 清理 */
@@ -3,7 +3,7 @@
  * @brief HMI 直连模式示例
  *
  * 演示如何使用 X-Slot SDK 实现 HMI 客户端，
- * 通过串口直连 DDC 查询和控制对象。
+ * 通过串口直连 DDC 订阅对象的流式推送。
  */
 #include <cstdio>
 #include <cstring>
@@ -19,50 +19,48 @@
 /* 目标 DDC 地址 */
 #define TARGET_DDC_ADDR 0xFFFE
 
+/* 允许未确认的推送帧数 */
+#define STREAM_WINDOW 4
+
 /**
- * @brief 原始数据回调 (查询响应)
+ * @brief 推送回调 (订阅后的快照和变化)
  */
-void on_data_received(uint16_t from, const uint8_t *data, uint8_t len) {
-  printf("[HMI] Response from 0x%04X, %d bytes\n", from, len);
-
-  /* 反序列化对象 */
-  xslot_bacnet_object_t objects[16];
-  int count = xslot_deserialize_objects(data, len, objects, 16);
-
-  if (count > 0) {
-    printf("  Objects:\n");
-    for (int i = 0; i < count; i++) {
-      const xslot_bacnet_object_t *obj = &objects[i];
-
-      const char *type_name = "?";
-      switch (obj->object_type) {
-      case XSLOT_OBJ_ANALOG_INPUT:
-        type_name = "AI";
-        break;
-      case XSLOT_OBJ_ANALOG_OUTPUT:
-        type_name = "AO";
-        break;
-      case XSLOT_OBJ_ANALOG_VALUE:
-        type_name = "AV";
-        break;
-      case XSLOT_OBJ_BINARY_INPUT:
-        type_name = "BI";
-        break;
-      case XSLOT_OBJ_BINARY_OUTPUT:
-        type_name = "BO";
-        break;
-      case XSLOT_OBJ_BINARY_VALUE:
-        type_name = "BV";
-        break;
-      }
-
-      if (obj->object_type <= XSLOT_OBJ_ANALOG_VALUE) {
-        printf("    %s%d = %.2f\n", type_name, obj->object_id,
-               obj->present_value.analog);
-      } else {
-        printf("    %s%d = %d\n", type_name, obj->object_id,
-               obj->present_value.binary);
-      }
+void on_report_received(uint16_t from, const xslot_bacnet_object_t *objects,
+                        uint8_t count) {
+  printf("[HMI] Push from 0x%04X, %d objects\n", from, count);
+
+  printf("  Objects:\n");
+  for (int i = 0; i < count; i++) {
+    const xslot_bacnet_object_t *obj = &objects[i];
+
+    const char *type_name = "?";
+    switch (obj->object_type) {
+    case XSLOT_OBJ_ANALOG_INPUT:
+      type_name = "AI";
+      break;
+    case XSLOT_OBJ_ANALOG_OUTPUT:
+      type_name = "AO";
+      break;
+    case XSLOT_OBJ_ANALOG_VALUE:
+      type_name = "AV";
+      break;
+    case XSLOT_OBJ_BINARY_INPUT:
+      type_name = "BI";
+      break;
+    case XSLOT_OBJ_BINARY_OUTPUT:
+      type_name = "BO";
+      break;
+    case XSLOT_OBJ_BINARY_VALUE:
+      type_name = "BV";
+      break;
+    }
+
+    if (obj->object_type <= XSLOT_OBJ_ANALOG_VALUE) {
+      printf("    %s%d = %.2f\n", type_name, obj->object_id,
+             obj->present_value.analog);
+    } else {
+      printf("    %s%d = %d\n", type_name, obj->object_id,
+             obj->present_value.binary);
     }
   }
 }
@@ -96,7 +94,7 @@ int main(int argc, char *argv[]) {
   }
 
   /* 注册回调 */
-  xslot_set_data_callback(handle, on_data_received);
+  xslot_set_report_callback(handle, on_report_received);
 
   /* 启动 */
   int ret = xslot_start(handle);
@@ -115,6 +113,9 @@ int main(int argc, char *argv[]) {
   case XSLOT_MODE_WIRELESS:
     printf("Warning: Running in WIRELESS mode (expected HMI)\n");
     break;
+  case XSLOT_MODE_SOCKET:
+    printf("Running in SOCKET mode (%s)\n", config.uart_port);
+    break;
   case XSLOT_MODE_NONE:
     printf("Error: No device detected\n");
     xslot_deinit(handle);
@@ -123,39 +124,22 @@ int main(int argc, char *argv[]) {
 
   printf("HMI started, target DDC: 0x%04X\n\n", TARGET_DDC_ADDR);
 
-  /* 主循环: 周期性查询数据 */
-  int query_count = 0;
-  while (1) {
-    query_count++;
-    printf("[%d] Querying AI0-3, BI0-3...\n", query_count);
-
-    /* 查询 AI 对象 */
-    uint16_t ai_ids[] = {0, 1, 2, 3};
-    ret = xslot_query_objects(handle, TARGET_DDC_ADDR, ai_ids, 4);
-    if (ret != XSLOT_OK) {
-      printf("Query AI failed: %d\n", ret);
-    }
-
-    /* 等待响应 */
-#ifdef _WIN32
-    Sleep(500);
-#else
-    usleep(500000);
-#endif
-
-    /* 查询 BI 对象 */
-    uint16_t bi_ids[] = {0, 1, 2, 3};
-    ret = xslot_query_objects(handle, TARGET_DDC_ADDR, bi_ids, 4);
-    if (ret != XSLOT_OK) {
-      printf("Query BI failed: %d\n", ret);
-    }
+  /* 订阅 AI0-3、BI0-3: DDC 先推送快照，之后只推送变化 */
+  xslot_object_ref_t refs[8];
+  for (int i = 0; i < 4; i++) {
+    refs[i].object_id = i;
+    refs[i].object_type = XSLOT_OBJ_ANALOG_INPUT;
+    refs[4 + i].object_id = i;
+    refs[4 + i].object_type = XSLOT_OBJ_BINARY_INPUT;
+  }
+  ret = xslot_stream_subscribe(handle, TARGET_DDC_ADDR, refs, 8, STREAM_WINDOW);
+  if (ret != XSLOT_OK) {
+    printf("Subscribe failed: %d\n", ret);
+  }
 
-    /* 等待下一个查询周期 (5秒) */
-#ifdef _WIN32
-    Sleep(4500);
-#else
-    sleep(4);
-#endif
+  /* 主循环: 接收推送 (协议栈自动归还信用、DDC 重启后重新订阅) */
+  while (1) {
+    xslot_poll(handle, 1000);
   }
 
   /* 清理 */
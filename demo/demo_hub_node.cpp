@@ -115,6 +115,8 @@ int main(int argc, char *argv[]) {
     return -1;
   } else if (mode == XSLOT_MODE_HMI) {
     printf("Warning: Hub should run in WIRELESS mode, but detected HMI\n");
+  } else if (mode == XSLOT_MODE_SOCKET) {
+    printf("Hub node started in SOCKET mode (%s)\n", config.uart_port);
   } else {
     printf("Hub node started in WIRELESS mode\n");
   }
@@ -140,11 +142,8 @@ int main(int argc, char *argv[]) {
       printf("\n");
     }
 
-#ifdef _WIN32
-    Sleep(1000);
-#else
-    sleep(1);
-#endif
+    /* 接收处理 (最多等待 1 秒) */
+    xslot_poll(handle, 1000);
   }
 
   /* 清理 */
@@ -47,6 +47,19 @@ int xslot_start(xslot_handle_t handle);
  */
 void xslot_stop(xslot_handle_t handle);
 
+/**
+ * @brief 接收处理 (需在主循环或独立线程中周期调用)
+ * @param handle 句柄
+ * @param timeout_ms 无数据时的最长等待时间 (0=不等待)
+ * @return 本次处理的帧数，失败返回负数错误码；配置了 I/O 线程
+ *         (XSLOT_THREAD_IO) 时返回 XSLOT_ERR_BUSY
+ *
+ * 读取传输层数据并在调用线程内分发回调，同时检查节点心跳超时
+ * 和告警延时。I/O 线程模型下由协议栈线程完成同样的处理，回调在该
+ * 线程中执行，其他 API 可在任意线程调用。
+ */
+int xslot_poll(xslot_handle_t handle, uint32_t timeout_ms);
+
 /**
  * @brief 获取当前运行模式 (在 start 成功后调用)
  * @param handle 句柄
@@ -85,6 +98,19 @@ int xslot_report_objects(xslot_handle_t handle,
 int xslot_write_object(xslot_handle_t handle, uint16_t target,
                        const xslot_bacnet_object_t *obj);
 
+/**
+ * @brief 批量远程写入 (汇聚节点使用)
+ * @param handle 句柄
+ * @param target 目标节点地址
+ * @param objects 对象数组
+ * @param count 对象数量
+ * @return 错误码
+ *
+ * 多个对象合并为 WRITE_MULTI 帧发送，单帧装不下时自动拆分。
+ */
+int xslot_write_objects(xslot_handle_t handle, uint16_t target,
+                        const xslot_bacnet_object_t *objects, uint8_t count);
+
 /**
  * @brief 查询节点对象数据 (HMI 使用)
  * @param handle 句柄
@@ -96,6 +122,21 @@ int xslot_write_object(xslot_handle_t handle, uint16_t target,
 int xslot_query_objects(xslot_handle_t handle, uint16_t target,
                         const uint16_t *object_ids, uint8_t count);
 
+/**
+ * @brief 按属性选择查询对象 (结果经属性回调返回)
+ * @param handle 句柄
+ * @param target 目标节点地址
+ * @param mask 请求的属性 (XSLOT_PROP_*)
+ * @param objects 对象引用数组
+ * @param count 对象数量 (单帧最多 42 个)
+ * @return 错误码
+ *
+ * 只请求需要的属性，例如仅 XSLOT_PROP_STATUS_FLAGS 可快速巡检故障状态。
+ */
+int xslot_query_properties(xslot_handle_t handle, uint16_t target,
+                           uint8_t mask, const xslot_object_ref_t *objects,
+                           uint8_t count);
+
 /* =============================================================================
  * 节点管理
  * =============================================================================
@@ -148,6 +189,17 @@ void xslot_set_data_callback(xslot_handle_t handle,
 void xslot_set_node_callback(xslot_handle_t handle,
                              xslot_node_online_cb callback);
 
+/**
+ * @brief 设置节点状态变化批量回调
+ * @param handle 句柄
+ * @param callback 回调函数
+ *
+ * 一次 xslot_poll() 内的全部上下线 (如中继故障时成批离线) 在 poll 结束时
+ * 经一次回调交付。与 xslot_set_node_callback() 相互独立，通常只设置其一。
+ */
+void xslot_set_node_batch_callback(xslot_handle_t handle,
+                                   xslot_node_batch_cb callback);
+
 /**
  * @brief 设置写入请求回调 (边缘节点使用)
  * @param handle 句柄
@@ -164,6 +216,174 @@ void xslot_set_write_callback(xslot_handle_t handle,
 void xslot_set_report_callback(xslot_handle_t handle,
                                xslot_report_received_cb callback);
 
+/**
+ * @brief 设置带采样时间的上报回调 (汇聚节点使用)
+ * @param handle 句柄
+ * @param callback 回调函数
+ *
+ * 样本的 age_ms 为采样时刻距回调时刻的毫秒数 (边缘节点开启
+ * config.report_time 并完成对时后有效，否则为 0)，可用于历史库排序和
+ * 统计采样到入库的延迟。与 xslot_set_report_callback() 相互独立。
+ */
+void xslot_set_timed_report_callback(xslot_handle_t handle,
+                                     xslot_history_cb callback);
+
+/**
+ * @brief 设置告警事件回调 (汇聚节点使用)
+ * @param handle 句柄
+ * @param callback 回调函数
+ */
+void xslot_set_alarm_callback(xslot_handle_t handle, xslot_alarm_cb callback);
+
+/**
+ * @brief 设置属性读取回调 (被查询节点使用)
+ * @param handle 句柄
+ * @param callback 回调函数，NULL 时 QUERY_PROP 交给原始数据回调
+ */
+void xslot_set_property_read_callback(xslot_handle_t handle,
+                                      xslot_property_read_cb callback);
+
+/**
+ * @brief 设置属性查询响应回调 (查询方使用)
+ * @param handle 句柄
+ * @param callback 回调函数
+ */
+void xslot_set_property_callback(xslot_handle_t handle,
+                                 xslot_property_response_cb callback);
+
+/* =============================================================================
+ * 告警评估 (汇聚节点)
+ * =============================================================================
+ */
+
+/**
+ * @brief 设置告警点限值 (新增或更新)
+ * @param handle 句柄
+ * @param addr 节点地址
+ * @param limit 限值配置
+ * @return 错误码
+ *
+ * 配置后汇聚节点在收到上报时即评估高限/低限/死区/延时。
+ */
+int xslot_set_alarm_limit(xslot_handle_t handle, uint16_t addr,
+                          const xslot_alarm_limit_t *limit);
+
+/**
+ * @brief 移除告警点
+ * @param handle 句柄
+ * @param addr 节点地址
+ * @param object_type 对象类型
+ * @param object_id 对象实例号
+ */
+void xslot_remove_alarm_limit(xslot_handle_t handle, uint16_t addr,
+                              uint8_t object_type, uint16_t object_id);
+
+/* =============================================================================
+ * 逻辑子设备 (一个模组/地址承载多个逻辑设备)
+ *
+ * 子设备号 1..XSLOT_MAX_SUB_DEVICES，0 表示节点本身 (使用上面的普通接口)。
+ * 子设备消息封装在 MUX 帧中，多个子设备共用一帧。
+ * =============================================================================
+ */
+
+/**
+ * @brief 注册子设备处理器 (边缘节点使用)
+ * @param handle 句柄
+ * @param sub 子设备号
+ * @param dev 处理器 (内容被复制)，NULL 表示注销
+ * @return 错误码
+ */
+int xslot_register_sub_device(xslot_handle_t handle, uint8_t sub,
+                              const xslot_sub_device_t *dev);
+
+/**
+ * @brief 上报子设备对象 (边缘节点使用)
+ * @param handle 句柄
+ * @param sub 子设备号
+ * @param objects 对象数组
+ * @param count 对象数量
+ * @return 错误码
+ *
+ * 对象只入队，下次 xslot_poll() 时与其他子设备的上报合并发送，
+ * 应用可依次采集各子设备后再调用 poll。
+ */
+int xslot_report_sub_objects(xslot_handle_t handle, uint8_t sub,
+                             const xslot_bacnet_object_t *objects,
+                             uint8_t count);
+
+/**
+ * @brief 远程写入子设备对象 (汇聚节点使用)
+ * @param handle 句柄
+ * @param target 物理节点地址
+ * @param sub 子设备号
+ * @param objects 对象数组
+ * @param count 对象数量
+ * @return 错误码
+ */
+int xslot_write_sub_objects(xslot_handle_t handle, uint16_t target,
+                            uint8_t sub, const xslot_bacnet_object_t *objects,
+                            uint8_t count);
+
+/**
+ * @brief 按属性选择查询子设备对象 (结果经子设备属性回调返回)
+ * @param count 对象数量 (单帧最多 41 个)
+ * @return 错误码
+ */
+int xslot_query_sub_properties(xslot_handle_t handle, uint16_t target,
+                               uint8_t sub, uint8_t mask,
+                               const xslot_object_ref_t *objects,
+                               uint8_t count);
+
+/**
+ * @brief 设置子设备数据上报回调 (汇聚节点使用)
+ */
+void xslot_set_sub_report_callback(xslot_handle_t handle,
+                                   xslot_sub_report_cb callback);
+
+/**
+ * @brief 设置子设备属性查询响应回调 (汇聚节点使用)
+ */
+void xslot_set_sub_property_callback(xslot_handle_t handle,
+                                     xslot_sub_property_cb callback);
+
+/* =============================================================================
+ * 流式推送 (HMI 直连)
+ *
+ * HMI 订阅后，DDC 先推送订阅对象的全量快照，之后只推送变化的对象，HMI
+ * 无需周期性 QUERY。推送帧为 REPORT，经数据上报回调交付。HMI 每处理完
+ * 半个窗口的推送帧归还信用，DDC 未确认的推送帧达到窗口时暂停，期间同一
+ * 对象多次变化只推送最新值。
+ * =============================================================================
+ */
+
+/**
+ * @brief 发布对象最新值 (DDC 使用)
+ * @param handle 句柄
+ * @param objects 对象数组
+ * @param count 对象数量
+ * @return 错误码，缓存已满 (超过 128 个对象) 返回 XSLOT_ERR_NO_MEM
+ *
+ * 可在每个扫描周期发布全部对象，值与标志未变化的对象不会推送。
+ * 没有订阅者时只更新缓存。
+ */
+int xslot_stream_publish(xslot_handle_t handle,
+                         const xslot_bacnet_object_t *objects, uint8_t count);
+
+/**
+ * @brief 订阅 DDC 的流式推送 (HMI 使用)
+ * @param handle 句柄
+ * @param target DDC 地址
+ * @param objects 订阅的对象，count=0 表示全部对象
+ * @param count 对象数量 (最多 42 个)
+ * @param window 允许未确认的推送帧数，0 表示取消订阅
+ * @return 错误码
+ *
+ * 再次调用替换原订阅并重新推送快照。DDC 重启后由协议栈自动重新订阅。
+ */
+int xslot_stream_subscribe(xslot_handle_t handle, uint16_t target,
+                           const xslot_object_ref_t *objects, uint8_t count,
+                           uint8_t window);
+
 /* =============================================================================
  * 运行时配置 (可选)
  * =============================================================================
@@ -179,6 +399,158 @@ void xslot_set_report_callback(xslot_handle_t handle,
 int xslot_update_wireless_config(xslot_handle_t handle, uint8_t cell_id,
                                  int8_t power_dbm);
 
+/**
+ * @brief 将节点表和对象当前值发布到共享内存 (汇聚节点, Linux)
+ * @param handle 句柄
+ * @param name 共享内存名 (NULL 使用 XSLOT_SHM_DEFAULT_NAME)
+ * @return 错误码，平台不支持返回 XSLOT_ERR_NOT_SUPPORT
+ *
+ * 本机其他进程通过 <xslot/xslot_shm.h> 读取接口访问。
+ */
+int xslot_enable_shm_publish(xslot_handle_t handle, const char *name);
+
+/* =============================================================================
+ * 多汇聚节点
+ *
+ * 边缘节点的上报目标由 xslot_config_t.hub_addr 指定，设为 XSLOT_ADDR_ANY_HUB
+ * 时由模组发往跳数最少的汇聚节点。也可配置汇聚节点组，按节点地址划分归属。
+ * =============================================================================
+ */
+
+/**
+ * @brief 配置汇聚节点组 (边缘节点和汇聚节点配置相同列表)
+ * @param handle 句柄
+ * @param hubs 汇聚节点地址数组
+ * @param count 数量 (最多 XSLOT_MAX_HUBS，0 表示取消)
+ * @return 错误码
+ *
+ * 节点归属 hubs[addr % count]。边缘节点向归属的汇聚节点上报，发送失败时
+ * 依次切换到组内下一个，一段时间后回到归属的汇聚节点。汇聚节点配置后
+ * 同时接收发往 XSLOT_ADDR_ANY_HUB 的帧。
+ */
+int xslot_set_hub_group(xslot_handle_t handle, const uint16_t *hubs,
+                        uint8_t count);
+
+/**
+ * @brief 查询节点归属的汇聚节点
+ * @return 汇聚节点地址 (未配置组时为上报目标)
+ */
+uint16_t xslot_get_hub_owner(xslot_handle_t handle, uint16_t addr);
+
+/**
+ * @brief 当前服务本节点的汇聚节点 (边缘节点)
+ * @return 汇聚节点地址，发往任意汇聚节点且路由尚未建立时返回 0
+ *
+ * 发往任意汇聚节点时由模组的路由建立通知 (+ROUTE:CREATE) 得知。
+ */
+uint16_t xslot_get_serving_hub(xslot_handle_t handle);
+
+/* =============================================================================
+ * 汇聚节点集群 (两个汇聚节点同时工作，互相复制状态)
+ *
+ * 本机收到的帧经 on_uplink 交给对端，对端以 xslot_cluster_inject() 注入，
+ * 节点表和对象值随之一致。同一帧两端都收到时只处理一次。每个节点的下行
+ * (命令与应答) 只由一个汇聚节点发出: 最近只有一端收到该节点的帧时归属
+ * 该端，两端都收到时归属地址小者；归属对端时下行命令经 on_downlink 转交。
+ * =============================================================================
+ */
+
+/**
+ * @brief 接入集群链路
+ * @param handle 句柄
+ * @param ops 复制接口 (内容被复制)，NULL 表示断开
+ * @return 错误码
+ */
+int xslot_cluster_attach(xslot_handle_t handle, const xslot_cluster_ops_t *ops);
+
+/**
+ * @brief 注入对端收到的帧
+ * @return 错误码，重复帧返回 XSLOT_OK 且不处理
+ */
+int xslot_cluster_inject(xslot_handle_t handle, const uint8_t *frame,
+                         uint16_t len);
+
+/**
+ * @brief 经本机模组发送对端转交的下行帧
+ * @return 错误码
+ */
+int xslot_cluster_transmit(xslot_handle_t handle, const uint8_t *frame,
+                           uint16_t len, bool confirmed);
+
+/**
+ * @brief 节点的下行是否归属本机
+ */
+bool xslot_cluster_is_owner(xslot_handle_t handle, uint16_t addr);
+
+/* =============================================================================
+ * 断线缓存 (边缘节点缓存、汇聚节点接收补发)
+ * =============================================================================
+ */
+
+/**
+ * @brief 启用断线缓存 (边缘节点)
+ * @param handle 句柄
+ * @param config 缓存配置
+ * @return 错误码
+ *
+ * 上报发送失败后对象连同采样时间写入缓存，汇聚节点恢复后在 xslot_poll()
+ * 中按 replay_interval_ms 限速分片补发，汇聚节点经历史样本回调收到。
+ * 汇聚节点不可达期间 xslot_report_objects() 返回 XSLOT_OK (缓存满覆盖旧
+ * 记录时返回 XSLOT_ERR_NO_MEM)。
+ */
+int xslot_enable_store_forward(xslot_handle_t handle,
+                               const xslot_store_config_t *config);
+
+/**
+ * @brief 断线缓存中待补发的记录数
+ */
+uint32_t xslot_store_forward_pending(xslot_handle_t handle);
+
+/**
+ * @brief 设置历史样本回调 (汇聚节点使用)
+ * @param handle 句柄
+ * @param callback 回调函数
+ */
+void xslot_set_history_callback(xslot_handle_t handle,
+                                xslot_history_cb callback);
+
+/* =============================================================================
+ * 趋势日志 (边缘节点高频采样本地缓存、整块上传)
+ * =============================================================================
+ */
+
+/**
+ * @brief 配置趋势日志 (边缘节点)
+ * @param handle 句柄
+ * @param config 记录的对象及上传间隔
+ * @return 错误码
+ *
+ * 每个对象一个环形样本缓存。xslot_poll() 中每 upload_interval_ms (或任一
+ * 对象缓存过半时) 将所有待发送样本差分压缩为一个数据块分片上传，整块
+ * 发送成功后才从缓存删除。重新配置会丢弃未上传的样本。
+ */
+int xslot_trend_configure(xslot_handle_t handle,
+                          const xslot_trend_config_t *config);
+
+/**
+ * @brief 记录趋势样本 (边缘节点)
+ * @param handle 句柄
+ * @param objects 对象数组 (未配置的对象忽略)
+ * @param count 对象数量
+ * @return 错误码，缓存满覆盖旧样本时返回 XSLOT_ERR_NO_MEM
+ *
+ * 样本时间取调用时刻，只写本地缓存，不发送上报帧。
+ */
+int xslot_trend_record(xslot_handle_t handle,
+                       const xslot_bacnet_object_t *objects, uint8_t count);
+
+/**
+ * @brief 设置趋势日志回调 (汇聚节点使用)
+ * @param handle 句柄
+ * @param callback 回调函数，每个对象的样本调用一次
+ */
+void xslot_set_trend_callback(xslot_handle_t handle, xslot_trend_cb callback);
+
 /* =============================================================================
  * 工具函数
  * =============================================================================
@@ -196,6 +568,23 @@ int xslot_deserialize_objects(const uint8_t *data, uint8_t len,
                               xslot_bacnet_object_t *objects,
                               uint8_t max_count);
 
+/**
+ * @brief 时间序列窗口聚合 (降采样)
+ * @param series 输入序列数组 (每个点一条)
+ * @param series_count 点数量
+ * @param start_ms 第一个窗口起始时间
+ * @param bucket_ms 窗口宽度 (如 60000 = 1 分钟)
+ * @param bucket_count 窗口数量
+ * @param out 输出列数组 (与 series 一一对应)
+ * @return 非空窗口总数，失败返回负数错误码
+ *
+ * 各点之间独立计算，可由调用方按点切分后多线程并行调用。
+ */
+int xslot_series_downsample(const xslot_series_t *series,
+                            uint32_t series_count, uint64_t start_ms,
+                            uint32_t bucket_ms, uint32_t bucket_count,
+                            const xslot_series_columns_t *out);
+
 #ifdef __cplusplus
 }
 #endif
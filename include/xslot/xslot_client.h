@@ -0,0 +1,147 @@
+/**
+ * @file xslot_client.h
+ * @brief xslotd 客户端接口
+ *
+ * 串口只能由一个进程占用。xslotd 守护进程独占传输层，
+ * 本机多个工具 (调试、诊断、BMS 驱动) 通过本接口经 Unix 域套接字
+ * 共享同一无线模组。
+ *
+ * 请求接口为同步调用；等待响应期间到达的通知会先分发给事件回调。
+ * 通知按订阅过滤后批量下发，一次回调可包含多个事件。
+ */
+#ifndef XSLOT_CLIENT_H
+#define XSLOT_CLIENT_H
+
+#include "xslot_error.h"
+#include "xslot_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XSLOT_CLIENT_DEFAULT_PATH "/tmp/xslotd.sock" /**< 默认套接字路径 */
+
+/* 订阅事件掩码 */
+#define XSLOT_CLIENT_EV_DATA 0x01     /**< 原始数据 (查询/响应) */
+#define XSLOT_CLIENT_EV_NODE 0x02     /**< 节点上下线 */
+#define XSLOT_CLIENT_EV_WRITE 0x04    /**< 写入请求 */
+#define XSLOT_CLIENT_EV_REPORT 0x08   /**< 对象上报 */
+#define XSLOT_CLIENT_EV_ALARM 0x10    /**< 告警事件 */
+#define XSLOT_CLIENT_EV_PROPERTY 0x20 /**< 属性查询响应 */
+#define XSLOT_CLIENT_EV_HISTORY 0x40  /**< 断线补发的历史样本 */
+#define XSLOT_CLIENT_EV_ALL 0x7F
+
+/**
+ * @brief 通知事件
+ *
+ * 指针指向客户端接收缓冲区，仅在回调期间有效。
+ */
+typedef struct {
+  uint8_t kind;  /**< 事件类型 (XSLOT_CLIENT_EV_*) */
+  uint8_t sub;   /**< 子设备号 (0=节点本身，REPORT/PROPERTY 事件有效) */
+  uint16_t from; /**< 源地址 */
+  union {
+    struct {
+      const uint8_t *data;
+      uint16_t len;
+    } raw;                        /**< EV_DATA */
+    bool online;                  /**< EV_NODE */
+    xslot_bacnet_object_t object; /**< EV_WRITE */
+    struct {
+      const xslot_bacnet_object_t *objects;
+      uint8_t count;
+    } report;                  /**< EV_REPORT */
+    xslot_alarm_event_t alarm; /**< EV_ALARM */
+    struct {
+      const xslot_property_set_t *props;
+      uint8_t count;
+    } property; /**< EV_PROPERTY */
+    struct {
+      const xslot_history_sample_t *samples;
+      uint16_t count;
+    } history; /**< EV_HISTORY (age_ms 相对 xslotd 回调时刻) */
+  } u;
+} xslot_client_event_t;
+
+/**
+ * @brief 事件批回调
+ * @param ctx 用户上下文
+ * @param events 事件数组
+ * @param count 事件数量
+ */
+typedef void (*xslot_client_event_cb)(void *ctx,
+                                      const xslot_client_event_t *events,
+                                      int count);
+
+/**
+ * @brief 客户端句柄
+ */
+typedef struct xslot_client *xslot_client_t;
+
+/**
+ * @brief 连接 xslotd
+ * @param path 套接字路径 (NULL 使用 XSLOT_CLIENT_DEFAULT_PATH)
+ * @return 句柄，失败返回 NULL
+ */
+xslot_client_t xslot_client_connect(const char *path);
+
+/**
+ * @brief 断开连接
+ */
+void xslot_client_close(xslot_client_t client);
+
+/**
+ * @brief 获取套接字描述符 (用于集成到调用方的 poll/select 循环)
+ */
+int xslot_client_fd(xslot_client_t client);
+
+/**
+ * @brief 设置事件回调
+ */
+void xslot_client_set_event_callback(xslot_client_t client,
+                                     xslot_client_event_cb cb, void *ctx);
+
+/**
+ * @brief 订阅事件
+ * @param client 句柄
+ * @param mask 事件掩码 (XSLOT_CLIENT_EV_*)，0=取消订阅
+ * @param addrs 关注的节点地址 (NULL 表示全部节点)
+ * @param count 地址数量 (最多 32)
+ * @return 错误码
+ */
+int xslot_client_subscribe(xslot_client_t client, uint8_t mask,
+                           const uint16_t *addrs, uint8_t count);
+
+/**
+ * @brief 读取并分发通知
+ * @param client 句柄
+ * @param timeout_ms 无数据时的最长等待时间 (0=不等待)
+ * @return 分发的事件数，连接断开返回 XSLOT_ERR_OFFLINE
+ */
+int xslot_client_dispatch(xslot_client_t client, uint32_t timeout_ms);
+
+/* 以下接口与 xslot.h 中同名接口语义一致 */
+
+int xslot_client_report(xslot_client_t client,
+                        const xslot_bacnet_object_t *objects, uint8_t count);
+int xslot_client_write(xslot_client_t client, uint16_t target,
+                       const xslot_bacnet_object_t *obj);
+int xslot_client_write_objects(xslot_client_t client, uint16_t target,
+                               const xslot_bacnet_object_t *objects,
+                               uint8_t count);
+int xslot_client_query(xslot_client_t client, uint16_t target,
+                       const uint16_t *object_ids, uint8_t count);
+int xslot_client_query_properties(xslot_client_t client, uint16_t target,
+                                  uint8_t mask,
+                                  const xslot_object_ref_t *objects,
+                                  uint8_t count);
+int xslot_client_ping(xslot_client_t client, uint16_t target);
+int xslot_client_get_nodes(xslot_client_t client, xslot_node_info_t *nodes,
+                           int max_count);
+xslot_run_mode_t xslot_client_get_run_mode(xslot_client_t client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XSLOT_CLIENT_H */
@@ -0,0 +1,141 @@
+/**
+ * @file xslot_shm.h
+ * @brief X-Slot 汇聚节点共享内存发布 (布局定义与读取接口)
+ *
+ * 汇聚节点可将节点表和对象当前值发布到 POSIX 共享内存段，
+ * 本机其他进程 (BACnet/IP 服务、Web 界面、历史库) 通过读取接口
+ * 无锁访问，无需经由套接字和 JSON 转发。
+ *
+ * 一致性由序号锁 (seqlock) 保证: 写入前后各递增一次序号，
+ * 序号为奇数表示正在写入，读取前后序号不一致则重读。
+ * 读取端只映射只读页面，不会阻塞汇聚节点。
+ */
+#ifndef XSLOT_SHM_H
+#define XSLOT_SHM_H
+
+#include "xslot_error.h"
+#include "xslot_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * 布局定义
+ * =============================================================================
+ */
+
+/* 版本 2: 槽位类型总是节点上报的真实类型，增量上报不再清除状态标志
+ * (版本 1 的发布端会为 AO/AV 建立推断为 AI 的槽位，读取端拒绝打开) */
+#define XSLOT_SHM_MAGIC 0x4D485358u         /**< "XSHM" */
+#define XSLOT_SHM_VERSION 2                 /**< 布局版本 */
+#define XSLOT_SHM_DEFAULT_NAME "/xslot_hub" /**< 默认共享内存名 */
+#define XSLOT_SHM_MAX_OBJECTS 4096          /**< 最大对象槽位数 */
+
+/**
+ * @brief 段头 (位于共享内存起始处)
+ */
+typedef struct {
+  uint32_t magic;          /**< XSLOT_SHM_MAGIC */
+  uint16_t version;        /**< XSLOT_SHM_VERSION */
+  uint16_t header_size;    /**< sizeof(xslot_shm_header_t) */
+  uint16_t node_size;      /**< sizeof(xslot_node_info_t) */
+  uint16_t object_size;    /**< sizeof(xslot_shm_object_t) */
+  uint32_t max_nodes;      /**< 节点槽位数 */
+  uint32_t max_objects;    /**< 对象槽位数 */
+  uint32_t nodes_offset;   /**< 节点数组偏移 (字节) */
+  uint32_t objects_offset; /**< 对象数组偏移 (字节) */
+  uint32_t writer_alive;   /**< 1=汇聚节点运行中, 0=已关闭 (需重新打开) */
+  uint32_t node_seq;       /**< 节点表序号锁 */
+  uint32_t node_count;     /**< 有效节点数 (受 node_seq 保护) */
+  uint32_t object_count;   /**< 已分配对象槽位数 (只增不减) */
+  uint32_t update_ms;      /**< 最近一次更新时间 (ms) */
+  uint32_t reserved[3];
+} xslot_shm_header_t;
+
+/**
+ * @brief 对象槽位
+ *
+ * 槽位一经分配，addr/object_type/object_id 不再改变，
+ * 读取端可缓存槽位索引，之后只需读取当前值。
+ *
+ * object.flags 为最近一次完整格式上报的状态标志 (OOS/InAlarm)，常规的增量
+ * 上报只更新 present_value 和 update_ms。
+ */
+typedef struct {
+  uint32_t seq;                 /**< 槽位序号锁 (奇数=写入中) */
+  uint16_t addr;                /**< 节点地址 */
+  uint16_t reserved;
+  uint32_t update_ms;           /**< 最近一次上报时间 (ms) */
+  xslot_bacnet_object_t object; /**< 对象当前值 */
+} xslot_shm_object_t;
+
+/* =============================================================================
+ * 读取接口
+ * =============================================================================
+ */
+
+/**
+ * @brief 读取端句柄
+ */
+typedef struct xslot_shm_reader *xslot_shm_reader_t;
+
+/**
+ * @brief 打开共享内存段 (只读)
+ * @param name 共享内存名 (NULL 使用 XSLOT_SHM_DEFAULT_NAME)
+ * @return 句柄，段不存在或版本不兼容返回 NULL
+ */
+xslot_shm_reader_t xslot_shm_open(const char *name);
+
+/**
+ * @brief 关闭共享内存段
+ */
+void xslot_shm_close(xslot_shm_reader_t reader);
+
+/**
+ * @brief 汇聚节点是否仍在发布
+ * @return false 时应关闭后重新打开 (汇聚节点已重启或退出)
+ */
+bool xslot_shm_is_alive(xslot_shm_reader_t reader);
+
+/**
+ * @brief 读取节点表快照
+ * @param reader 句柄
+ * @param nodes 节点信息数组 (输出)
+ * @param max_count 数组最大容量
+ * @return 节点数量，失败返回负数错误码
+ */
+int xslot_shm_get_nodes(xslot_shm_reader_t reader, xslot_node_info_t *nodes,
+                        int max_count);
+
+/**
+ * @brief 已分配的对象槽位数
+ */
+int xslot_shm_object_count(xslot_shm_reader_t reader);
+
+/**
+ * @brief 查找对象槽位
+ * @param reader 句柄
+ * @param addr 节点地址
+ * @param object_type 对象类型
+ * @param object_id 对象实例号
+ * @return 槽位索引，未找到返回负数错误码
+ */
+int xslot_shm_find_object(xslot_shm_reader_t reader, uint16_t addr,
+                          uint8_t object_type, uint16_t object_id);
+
+/**
+ * @brief 读取对象槽位的一致快照
+ * @param reader 句柄
+ * @param index 槽位索引
+ * @param out 输出
+ * @return 错误码
+ */
+int xslot_shm_read_object(xslot_shm_reader_t reader, int index,
+                          xslot_shm_object_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XSLOT_SHM_H */
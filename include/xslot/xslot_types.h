@@ -20,12 +20,19 @@ extern "C" {
 #define XSLOT_VERSION_MINOR 0
 #define XSLOT_VERSION_PATCH 0
 
-#define XSLOT_MAX_DATA_LEN 128 /**< 最大数据长度 */
-#define XSLOT_MAX_NODES 64     /**< 最大节点数 */
-#define XSLOT_SYNC_BYTE 0xAA   /**< 同步字节 */
+#define XSLOT_MAX_DATA_LEN 128      /**< 最大数据长度 */
+#define XSLOT_MAX_NODES 64          /**< 最大节点数 */
+#define XSLOT_MAX_ALARM_POINTS 1024 /**< 汇聚节点最大告警点数 */
+#define XSLOT_MAX_SUB_DEVICES 16    /**< 单节点最大逻辑子设备数 */
+#define XSLOT_MAX_HUBS 8            /**< 汇聚节点组最大成员数 */
+#define XSLOT_MAX_BUS_SLAVES 32     /**< RS-485 总线最大从站数 */
+#define XSLOT_MAX_AUX_LINKS 2       /**< 附加链路最大数量 */
+#define XSLOT_MAX_TREND_OBJECTS 8   /**< 趋势日志最大对象数 */
+#define XSLOT_SYNC_BYTE 0xAA        /**< 同步字节 */
 
 /* 地址定义 */
 #define XSLOT_ADDR_HUB 0xFFFE       /**< 汇聚节点地址 */
+#define XSLOT_ADDR_ANY_HUB 0xFFFF   /**< 任意汇聚节点 (模组选择跳数最少的) */
 #define XSLOT_ADDR_HMI 0xFF00       /**< HMI 固定地址 */
 #define XSLOT_ADDR_EDGE_MIN 0xFFBE  /**< 边缘节点最小地址 */
 #define XSLOT_ADDR_EDGE_MAX 0xFFFD  /**< 边缘节点最大地址 */
@@ -42,20 +49,30 @@ extern "C" {
 typedef enum {
   XSLOT_MODE_NONE = 0,     /**< 未检测到设备 (空闲/异常) */
   XSLOT_MODE_WIRELESS = 1, /**< TP1107 Mesh 无线模式 */
-  XSLOT_MODE_HMI = 2       /**< HMI 串口直连模式 */
+  XSLOT_MODE_HMI = 2,      /**< HMI 串口直连模式 */
+  XSLOT_MODE_SOCKET = 3    /**< 套接字 (UDP/TCP/Unix) 模式 */
 } xslot_run_mode_t;
 
 /**
  * @brief 命令类型
  */
 typedef enum {
-  XSLOT_CMD_PING = 0x01,     /**< 心跳请求 */
-  XSLOT_CMD_PONG = 0x02,     /**< 心跳响应 */
-  XSLOT_CMD_REPORT = 0x10,   /**< 数据上报 (边缘→汇聚) */
-  XSLOT_CMD_QUERY = 0x11,    /**< 数据查询 (HMI→汇聚) */
-  XSLOT_CMD_RESPONSE = 0x12, /**< 查询响应 (汇聚→HMI) */
-  XSLOT_CMD_WRITE = 0x20,    /**< 远程写入 (汇聚→边缘) */
-  XSLOT_CMD_WRITE_ACK = 0x21 /**< 写入确认 (边缘→汇聚) */
+  XSLOT_CMD_PING = 0x01,          /**< 心跳请求 */
+  XSLOT_CMD_PONG = 0x02,          /**< 心跳响应 */
+  XSLOT_CMD_BUS_TOKEN = 0x03,     /**< 总线令牌 (RS-485 多点总线链路层) */
+  XSLOT_CMD_FRAMING = 0x04,       /**< 串口帧格式协商 (直连传输链路层) */
+  XSLOT_CMD_REPORT = 0x10,        /**< 数据上报 (边缘→汇聚) */
+  XSLOT_CMD_QUERY = 0x11,         /**< 数据查询 (HMI→汇聚) */
+  XSLOT_CMD_RESPONSE = 0x12,      /**< 查询响应 (汇聚→HMI) */
+  XSLOT_CMD_QUERY_PROP = 0x13,    /**< 属性选择查询 */
+  XSLOT_CMD_PROP_RESPONSE = 0x14, /**< 属性查询响应 (TLV) */
+  XSLOT_CMD_SUBSCRIBE = 0x15,     /**< 流式推送订阅 (HMI→DDC) */
+  XSLOT_CMD_CREDIT = 0x16,        /**< 流式推送信用 (双向) */
+  XSLOT_CMD_WRITE = 0x20,         /**< 远程写入 (汇聚→边缘) */
+  XSLOT_CMD_WRITE_ACK = 0x21,     /**< 写入确认 (边缘→汇聚) */
+  XSLOT_CMD_WRITE_MULTI = 0x22,   /**< 批量写入 (汇聚→边缘) */
+  XSLOT_CMD_MUX = 0x30,           /**< 逻辑子设备复用 (双向) */
+  XSLOT_CMD_FRAGMENT = 0x40       /**< 分片传输的数据块 (边缘→汇聚) */
 } xslot_cmd_t;
 
 /**
@@ -70,6 +87,15 @@ typedef enum {
   XSLOT_OBJ_BINARY_VALUE = 5   /**< BV */
 } xslot_object_type_t;
 
+/**
+ * @brief 告警状态 (与 DDC ALARMHIGH/ALARMLOW 取值一致)
+ */
+typedef enum {
+  XSLOT_ALARM_NORMAL = 0,     /**< 正常 */
+  XSLOT_ALARM_HIGH_LIMIT = 1, /**< 高限告警 */
+  XSLOT_ALARM_LOW_LIMIT = 2   /**< 低限告警 */
+} xslot_alarm_state_t;
+
 /* =============================================================================
  * 数据结构
  * =============================================================================
@@ -81,7 +107,7 @@ typedef enum {
 typedef struct {
   uint16_t object_id;  /**< 对象实例号 */
   uint8_t object_type; /**< 对象类型 (xslot_object_type_t) */
-  uint8_t flags;       /**< 标志位: bit0=Changed, bit1=OutOfService */
+  uint8_t flags;       /**< 标志位: bit0=Changed, bit1=OOS, bit2=InAlarm */
   union {
     float analog;    /**< 模拟值 (AI/AO/AV) */
     uint8_t binary;  /**< 二进制值 (BI/BO/BV): 0 或 1 */
@@ -92,6 +118,88 @@ typedef struct {
 /** 标志位定义 */
 #define XSLOT_FLAG_CHANGED 0x01
 #define XSLOT_FLAG_OUT_OF_SERVICE 0x02
+#define XSLOT_FLAG_IN_ALARM 0x04
+
+/** 属性选择掩码 (QUERY_PROP) */
+#define XSLOT_PROP_PRESENT_VALUE 0x01
+#define XSLOT_PROP_STATUS_FLAGS 0x02
+#define XSLOT_PROP_RELIABILITY 0x04
+#define XSLOT_PROP_UNITS 0x08
+#define XSLOT_PROP_DESCRIPTION 0x10
+#define XSLOT_PROP_ALL 0x1F
+
+/** Status_Flags 位 (同 BACnet) */
+#define XSLOT_STATUS_IN_ALARM 0x01
+#define XSLOT_STATUS_FAULT 0x02
+#define XSLOT_STATUS_OVERRIDDEN 0x04
+#define XSLOT_STATUS_OUT_OF_SERVICE 0x08
+
+#define XSLOT_MAX_DESCRIPTION 32 /**< 描述最大长度 (字节, 不含结束符) */
+
+/**
+ * @brief 对象引用
+ */
+typedef struct {
+  uint16_t object_id;  /**< 对象实例号 */
+  uint8_t object_type; /**< 对象类型 (xslot_object_type_t) */
+} xslot_object_ref_t;
+
+/**
+ * @brief 对象属性集 (属性选择查询的结果)
+ *
+ * 只有 mask 中置位的字段有效，mask=0 表示对象不存在。
+ */
+typedef struct {
+  uint16_t object_id;  /**< 对象实例号 */
+  uint8_t object_type; /**< 对象类型 (xslot_object_type_t) */
+  uint8_t mask;        /**< 有效属性 (XSLOT_PROP_*) */
+  union {
+    float analog;   /**< 模拟值 (AI/AO/AV) */
+    uint8_t binary; /**< 二进制值 (BI/BO/BV) */
+  } present_value;
+  uint8_t status_flags; /**< XSLOT_STATUS_* */
+  uint8_t reliability;  /**< BACnet Reliability 枚举 (0=no-fault-detected) */
+  uint16_t units;       /**< BACnet Engineering Units 枚举 */
+  char description[XSLOT_MAX_DESCRIPTION + 1]; /**< UTF-8 描述 */
+} xslot_property_set_t;
+
+/**
+ * @brief 历史样本 (断线期间缓存、恢复后补发的上报)
+ */
+typedef struct {
+  uint32_t age_ms; /**< 采样时刻距回调时刻的毫秒数 */
+  xslot_bacnet_object_t object;
+} xslot_history_sample_t;
+
+/**
+ * @brief 断线缓存配置 (边缘节点)
+ */
+typedef struct {
+  const char *path;            /**< 缓存文件路径，NULL 表示仅内存 */
+  uint32_t capacity;           /**< 最大记录数 (满后覆盖最旧记录) */
+  uint32_t conflate_ms;        /**< 同一对象的合并窗口 (0=保留每个样本) */
+  uint32_t replay_interval_ms; /**< 补发分片的最小间隔 (限速，0=默认) */
+  uint16_t batch_size;         /**< 每个补发数据块的最大记录数 (0=默认) */
+} xslot_store_config_t;
+
+/**
+ * @brief 趋势日志对象 (边缘节点)
+ */
+typedef struct {
+  uint16_t object_id;  /**< 对象实例号 */
+  uint8_t object_type; /**< 对象类型 (模拟量或二进制) */
+  uint16_t capacity;   /**< 本地缓存的样本数 (满后覆盖最旧样本) */
+  float resolution;    /**< 值的量化精度 (0=无损，按浮点位差分) */
+} xslot_trend_object_t;
+
+/**
+ * @brief 趋势日志配置 (边缘节点)
+ */
+typedef struct {
+  const xslot_trend_object_t *objects; /**< 记录的对象 */
+  uint8_t count; /**< 对象数量 (最多 XSLOT_MAX_TREND_OBJECTS) */
+  uint32_t upload_interval_ms; /**< 上传间隔 (0=默认)，缓存过半时提前上传 */
+} xslot_trend_config_t;
 
 /**
  * @brief 节点信息
@@ -102,8 +210,83 @@ typedef struct {
   int8_t rssi;          /**< 信号强度 (dBm) */
   bool online;          /**< 在线状态 */
   uint8_t object_count; /**< 对象数量 */
+  uint32_t interval_ms; /**< 学习到的平均到达间隔 (ms，0=尚未学习) */
+  uint32_t timeout_ms;  /**< 最后一帧后多久判为离线 (ms，0=不判定) */
 } xslot_node_info_t;
 
+/**
+ * @brief 离线判定 (全零为所有节点使用 heartbeat_timeout_ms)
+ *
+ * 按节点学习帧到达间隔的 EWMA 均值 μ 与方差 σ²，超过 μ + k·σ 未收到帧
+ * 判为离线。电池节点 (几分钟一帧) 不再误报离线，常供电节点可更快发现
+ * 离线。学习完成前仍使用 heartbeat_timeout_ms。
+ *
+ * offline_misses / online_frames 为上下线迟滞，抑制链路抖动引起的
+ * 反复上下线。
+ */
+typedef struct {
+  float sigma_k;          /**< 置信系数 k (0=关闭自适应，建议 3-5) */
+  uint8_t warmup;         /**< 学习多少个间隔后启用 (0=默认 4) */
+  uint8_t offline_misses; /**< 连续几个判定时间未收到帧才离线 (0=1) */
+  uint8_t online_frames;  /**< 离线/新节点连续几帧间隔正常才上线 (0=1) */
+  uint32_t min_ms;        /**< 判定时间下限 (ms，0=不限制) */
+  uint32_t max_ms;        /**< 判定时间上限 (ms，0=不限制) */
+} xslot_liveness_config_t;
+
+/**
+ * @brief 线程模型
+ */
+typedef enum {
+  XSLOT_THREAD_INLINE = 0, /**< 调用者线程周期调用 xslot_poll (默认) */
+  XSLOT_THREAD_IO = 1,     /**< 协议栈自建 I/O 线程收发帧并分发回调 */
+} xslot_thread_model_t;
+
+/**
+ * @brief 线程配置 (全零为调用者线程模型)
+ *
+ * I/O 线程模型下回调在 I/O 线程中执行，API 可从任意线程调用。
+ */
+typedef struct {
+  uint8_t model;     /**< xslot_thread_model_t */
+  uint8_t priority;  /**< I/O 线程 SCHED_FIFO 优先级 1-99 (0=普通调度) */
+  uint32_t cpu_mask; /**< I/O 线程可运行的 CPU 核位图 (0=不绑定) */
+  char name[16];     /**< I/O 线程名 (空为 "xslot-io") */
+} xslot_thread_config_t;
+
+/**
+ * @brief RS-485 总线角色
+ */
+typedef enum {
+  XSLOT_BUS_POINT = 0,  /**< 点对点直连 (默认) */
+  XSLOT_BUS_MASTER = 1, /**< 多点总线主站 (HMI)，依次向从站发放令牌 */
+  XSLOT_BUS_SLAVE = 2,  /**< 多点总线从站 (DDC)，持有令牌时才发送 */
+} xslot_bus_role_t;
+
+/**
+ * @brief 多点总线配置 (HMI 直连传输，全零为点对点)
+ *
+ * 主站轮询仲裁: 主站在没有发出令牌时直接发送，并按 slaves 顺序向从站
+ * 发放令牌；从站平时只缓存待发帧，收到令牌后发出缓存的帧并交回令牌。
+ * 从站丢弃发往其他地址的帧，不做 CRC 校验。
+ */
+typedef struct {
+  uint8_t role;              /**< xslot_bus_role_t */
+  uint8_t turnaround_ms;     /**< 收到最后一个字节后多久才发送 (0=默认 2) */
+  uint16_t reply_timeout_ms; /**< 主站: 从站静默多久视为无应答 (0=默认 50) */
+  uint16_t cycle_ms;         /**< 主站: 每轮令牌的最小间隔 (0=默认 20) */
+  uint8_t slave_count;       /**< 主站: 从站数量 */
+  /** 主站: 从站地址 (令牌发放顺序) */
+  uint16_t slaves[XSLOT_MAX_BUS_SLAVES];
+} xslot_bus_config_t;
+
+/**
+ * @brief 串口帧格式 (HMI 直连传输)
+ */
+typedef enum {
+  XSLOT_FRAMING_RAW = 0,  /**< 以 SYNC 字节定界 (默认，兼容旧版本) */
+  XSLOT_FRAMING_COBS = 1, /**< COBS 编码，0x00 定界，探测时与对端协商 */
+} xslot_framing_t;
+
 /**
  * @brief 配置结构
  */
@@ -115,9 +298,91 @@ typedef struct {
   uint32_t uart_baudrate;         /**< 串口波特率 (默认 115200) */
   uint32_t heartbeat_interval_ms; /**< 心跳间隔 (建议 30000-60000 ms) */
   uint32_t heartbeat_timeout_ms;  /**< 心跳超时 (ms) */
-  char uart_port[64]; /**< 串口设备名 (如 "COM3" 或 "/dev/ttyUSB0") */
+  char uart_port[64]; /**< 串口设备名 ("COM3"、"/dev/ttyUSB0") 或套接字端点 */
+  uint8_t alarm_confirm; /**< 告警/状态变化上报使用 AM 端到端确认 (0=关闭) */
+  uint16_t hub_addr;     /**< 上报目标 (0=XSLOT_ADDR_HUB，可为 XSLOT_ADDR_ANY_HUB) */
+  /** 线程模型 (全零为调用者线程周期调用 xslot_poll) */
+  xslot_thread_config_t thread;
+  /** 离线判定 (全零为固定 heartbeat_timeout_ms) */
+  xslot_liveness_config_t liveness;
+  /** 上报携带采样时间 (边缘节点，0=关闭)，经 PING/PONG 与汇聚节点对时 */
+  uint8_t report_time;
+  /** RS-485 多点总线 (HMI 直连传输，全零为点对点) */
+  xslot_bus_config_t bus;
+  /** 串口帧格式 (xslot_framing_t)，对端不支持 COBS 时保持 RAW */
+  uint8_t framing;
+  /**
+   * 附加链路 (如本地 HMI 维护口)，与主传输同时运行，空串为不使用。
+   * 串口按 HMI 直连打开 (不探测)，也可为套接字端点。
+   * 传输层只能各自等待: 使用附加链路时主传输每次最多等待 10ms，附加链路
+   * 的帧最多延迟 10ms 交付，空闲时协议栈也约每秒唤醒 100 次。
+   */
+  char aux_ports[XSLOT_MAX_AUX_LINKS][64];
+  /**
+   * 中继 (汇聚节点，0=关闭): 附加链路与主传输之间转发发往已知节点的请求，
+   * 只校验帧头和 CRC，应答按 SEQ 映射回请求方
+   */
+  uint8_t relay;
 } xslot_config_t;
 
+/** 告警限值使能位 (同 BACnet Limit_Enable) */
+#define XSLOT_ALARM_ENABLE_LOW 0x01
+#define XSLOT_ALARM_ENABLE_HIGH 0x02
+
+/**
+ * @brief 告警限值配置 (模拟量对象)
+ */
+typedef struct {
+  uint16_t object_id;     /**< 对象实例号 */
+  uint8_t object_type;    /**< 对象类型 (AI/AO/AV) */
+  uint8_t limit_enable;   /**< 使能位: XSLOT_ALARM_ENABLE_LOW/HIGH */
+  uint8_t priority;       /**< 事件优先级 (0 最高) */
+  float high_limit;       /**< 高限 */
+  float low_limit;        /**< 低限 */
+  float deadband;         /**< 死区 */
+  uint32_t time_delay_ms; /**< 状态保持多久才产生事件 (ms) */
+} xslot_alarm_limit_t;
+
+/**
+ * @brief 告警事件
+ */
+typedef struct {
+  uint16_t addr;       /**< 节点地址 */
+  uint16_t object_id;  /**< 对象实例号 */
+  uint8_t object_type; /**< 对象类型 */
+  uint8_t from_state;  /**< 原状态 (xslot_alarm_state_t) */
+  uint8_t to_state;    /**< 新状态 (xslot_alarm_state_t) */
+  uint8_t priority;    /**< 事件优先级 */
+  float value;         /**< 触发时的值 */
+  float limit;         /**< 相关限值 */
+  uint32_t timestamp;  /**< 事件时间 (ms) */
+} xslot_alarm_event_t;
+
+/**
+ * @brief 时间序列 (列式存储, 时间戳升序)
+ *
+ * 时间戳为 64 位毫秒 (通常为 UTC 纪元毫秒)，长期历史不会回绕。
+ */
+typedef struct {
+  const uint64_t *timestamps; /**< 采样时间戳 (ms) */
+  const float *values;        /**< 采样值 */
+  uint32_t count;             /**< 样本数量 */
+} xslot_series_t;
+
+/**
+ * @brief 窗口聚合输出列
+ *
+ * 每列容量需不小于窗口数量，不需要的列置 NULL。
+ * 空窗口 count=0，其余列为 NaN。
+ */
+typedef struct {
+  float *min;      /**< 窗口最小值 */
+  float *max;      /**< 窗口最大值 */
+  float *avg;      /**< 窗口平均值 */
+  float *last;     /**< 窗口最后值 */
+  uint32_t *count; /**< 窗口样本数 */
+} xslot_series_columns_t;
+
 /**
  * @brief 协议栈句柄
  */
@@ -144,6 +409,23 @@ typedef void (*xslot_data_received_cb)(uint16_t from, const uint8_t *data,
  */
 typedef void (*xslot_node_online_cb)(uint16_t addr, bool online);
 
+/**
+ * @brief 节点状态变化
+ */
+typedef struct {
+  uint16_t addr;      /**< 节点地址 */
+  bool online;        /**< true=上线, false=离线 */
+  uint32_t last_seen; /**< 最后收到帧的时间 (ms) */
+} xslot_node_transition_t;
+
+/**
+ * @brief 节点状态变化批量回调
+ * @param list 一次 poll 内的全部状态变化 (按发生顺序)
+ * @param count 变化数
+ */
+typedef void (*xslot_node_batch_cb)(const xslot_node_transition_t *list,
+                                    uint16_t count);
+
 /**
  * @brief 写入请求回调
  * @param from 源地址
@@ -162,6 +444,107 @@ typedef void (*xslot_report_received_cb)(uint16_t from,
                                          const xslot_bacnet_object_t *objects,
                                          uint8_t count);
 
+/**
+ * @brief 告警事件回调 (汇聚节点使用)
+ * @param event 告警事件
+ *
+ * 同一次上报产生的多个事件按优先级从高到低依次回调。
+ */
+typedef void (*xslot_alarm_cb)(const xslot_alarm_event_t *event);
+
+/**
+ * @brief 属性读取回调 (被查询节点使用)
+ * @param object_type 对象类型
+ * @param object_id 对象实例号
+ * @param mask 请求的属性 (XSLOT_PROP_*)
+ * @param props 输出，填写可提供的属性并在 props->mask 中置位
+ * @return false=对象不存在
+ *
+ * 协议栈收到 QUERY_PROP 时逐个对象回调，并自动回复 PROP_RESPONSE。
+ */
+typedef bool (*xslot_property_read_cb)(uint8_t object_type, uint16_t object_id,
+                                       uint8_t mask,
+                                       xslot_property_set_t *props);
+
+/**
+ * @brief 属性查询响应回调 (查询方使用)
+ * @param from 源地址
+ * @param props 属性集数组
+ * @param count 数量
+ */
+typedef void (*xslot_property_response_cb)(uint16_t from,
+                                           const xslot_property_set_t *props,
+                                           uint8_t count);
+
+/**
+ * @brief 历史样本回调 (汇聚节点使用)
+ * @param from 源地址
+ * @param samples 样本数组 (按采样时间先后)
+ * @param count 数量
+ */
+typedef void (*xslot_history_cb)(uint16_t from,
+                                 const xslot_history_sample_t *samples,
+                                 uint16_t count);
+
+/**
+ * @brief 趋势日志回调 (汇聚节点使用)
+ * @param from 源地址
+ * @param object_type 对象类型
+ * @param object_id 对象实例号
+ * @param series 样本 (时间戳为 UTC 毫秒，未对时为本机 hal 毫秒时钟；升序)
+ */
+typedef void (*xslot_trend_cb)(uint16_t from, uint8_t object_type,
+                               uint16_t object_id,
+                               const xslot_series_t *series);
+
+/**
+ * @brief 集群复制接口 (同一小区两个汇聚节点同时工作)
+ *
+ * 由链路实现方 (如 xslotd) 提供，协议栈只负责去重和下行归属。
+ */
+typedef struct {
+  /** 本机无线侧收到的帧 (已编码)，应转发给对端 */
+  void (*on_uplink)(void *ctx, const uint8_t *frame, uint16_t len);
+  /** 归属对端的节点的下行帧，应交给对端经其模组发送，返回错误码 */
+  int (*on_downlink)(void *ctx, const uint8_t *frame, uint16_t len,
+                     bool confirmed);
+  void *ctx;
+  uint16_t peer_addr; /**< 对端汇聚节点地址 (两端都收到时地址小者归属) */
+} xslot_cluster_ops_t;
+
+/**
+ * @brief 逻辑子设备处理器 (边缘节点注册)
+ *
+ * 一个模组/地址下承载多个逻辑设备 (扩展槽、Modbus 子设备等)，
+ * 汇聚节点发往某个子设备的写入和属性查询分发到对应处理器。
+ */
+typedef struct {
+  /** 写入请求，可为 NULL */
+  void (*on_write)(void *ctx, uint16_t from, const xslot_bacnet_object_t *obj);
+  /** 属性读取，可为 NULL (应答空属性集)，语义同 xslot_property_read_cb */
+  bool (*on_property_read)(void *ctx, uint8_t object_type, uint16_t object_id,
+                           uint8_t mask, xslot_property_set_t *props);
+  void *ctx; /**< 用户上下文 */
+} xslot_sub_device_t;
+
+/**
+ * @brief 子设备数据上报回调 (汇聚节点使用)
+ * @param from 源地址 (物理节点)
+ * @param sub 子设备号 (1..XSLOT_MAX_SUB_DEVICES)
+ * @param objects 对象数组
+ * @param count 数量
+ */
+typedef void (*xslot_sub_report_cb)(uint16_t from, uint8_t sub,
+                                    const xslot_bacnet_object_t *objects,
+                                    uint8_t count);
+
+/**
+ * @brief 子设备属性查询响应回调 (汇聚节点使用)
+ */
+typedef void (*xslot_sub_property_cb)(uint16_t from, uint8_t sub,
+                                      const xslot_property_set_t *props,
+                                      uint8_t count);
+
 #ifdef __cplusplus
 }
 #endif
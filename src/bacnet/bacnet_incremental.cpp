@@ -16,6 +16,11 @@ constexpr uint8_t INCR_HEADER_SIZE = 3;
 static uint8_t get_type_hint(uint8_t obj_type) {
   uint8_t hint = INCREMENTAL_FLAG; // bit7=1 标记增量格式
 
+  // 3 位只容纳类型 0-6，其余类型不携带
+  if (obj_type < (INCREMENTAL_TYPE_MASK >> INCREMENTAL_TYPE_SHIFT)) {
+    hint |= (uint8_t)((obj_type + 1) << INCREMENTAL_TYPE_SHIFT);
+  }
+
   if (xslot_is_analog_type(obj_type)) {
     hint |= VALUE_TYPE_ANALOG;
   } else if (xslot_is_binary_type(obj_type)) {
@@ -43,10 +48,22 @@ static uint8_t get_value_size_from_hint(uint8_t type_hint) {
 }
 
 /**
- * @brief 根据 TYPE_HINT 推断对象类型 (仅用于反序列化)
- * 注意: 无法区分 AI/AO/AV 或 BI/BO/BV，默认使用 Input 类型
+ * @brief TYPE_HINT 是否携带对象类型
+ */
+static inline bool hint_has_type(uint8_t type_hint) {
+  return (type_hint & INCREMENTAL_TYPE_MASK) != 0;
+}
+
+/**
+ * @brief 根据 TYPE_HINT 获取对象类型 (仅用于反序列化)
+ * 注意: 旧版节点不携带类型，无法区分 AI/AO/AV 或 BI/BO/BV，默认使用 Input 类型
  */
 static uint8_t infer_object_type(uint8_t type_hint) {
+  if (hint_has_type(type_hint)) {
+    uint8_t type = (type_hint & INCREMENTAL_TYPE_MASK) >> INCREMENTAL_TYPE_SHIFT;
+    return (uint8_t)(type - 1);
+  }
+
   uint8_t value_type = type_hint & 0x0F;
   switch (value_type) {
   case VALUE_TYPE_ANALOG:
@@ -187,7 +204,7 @@ int bacnet_incremental_deserialize(const uint8_t *buffer, uint8_t len,
 
 int bacnet_incremental_deserialize_batch(const uint8_t *buffer, uint8_t len,
                                          xslot_bacnet_object_t *objects,
-                                         uint8_t max_count) {
+                                         uint8_t max_count, bool *typed) {
   if (!buffer || !objects || len < 1) {
     return XSLOT_ERR_PARAM;
   }
@@ -204,6 +221,8 @@ int bacnet_incremental_deserialize_batch(const uint8_t *buffer, uint8_t len,
     count = max_count;
   }
 
+  bool all_typed = true;
+
   for (uint8_t i = 0; i < count; i++) {
     auto &obj = objects[i];
 
@@ -219,6 +238,7 @@ int bacnet_incremental_deserialize_batch(const uint8_t *buffer, uint8_t len,
 
     obj.object_type = infer_object_type(type_hint);
     obj.flags = 0;
+    all_typed = all_typed && hint_has_type(type_hint);
 
     uint8_t value_type = type_hint & 0x0F;
     if (value_type == VALUE_TYPE_ANALOG) {
@@ -237,5 +257,8 @@ int bacnet_incremental_deserialize_batch(const uint8_t *buffer, uint8_t len,
     }
   }
 
+  if (typed) {
+    *typed = all_typed;
+  }
   return count;
 }
@@ -2,12 +2,16 @@
  * @file bacnet_incremental.h
  * @brief BACnet 对象增量格式序列化 (COV 上报专用)
  *
- * 增量格式仅传输 Present_Value，省略 OBJ_TYPE 和 FLAGS，节省约 25% 带宽。
+ * 增量格式仅传输 Present_Value，省略 FLAGS 并把对象类型并入 TYPE_HINT，
+ * 节省约 25% 带宽。
  * 格式: [OBJ_ID:2B][TYPE_HINT:1B][VALUE:变长]
  *
  * TYPE_HINT 编码:
  *   - bit7 = 1 表示增量格式
+ *   - bit6-4 为对象类型 + 1，0 表示未携带类型 (旧版节点)
  *   - bit3-0 表示值类型: 0=ANALOG, 1=BINARY, 2=OTHER
+ *
+ * 未携带类型时只能按值类型推断 (模拟量视为 AI，二进制量视为 BI)。
  */
 #ifndef BACNET_INCREMENTAL_H
 #define BACNET_INCREMENTAL_H
@@ -24,6 +28,8 @@ extern "C" {
 #define VALUE_TYPE_ANALOG 0x00 /**< 模拟量 (float) */
 #define VALUE_TYPE_BINARY 0x01 /**< 二进制量 (uint8) */
 #define VALUE_TYPE_OTHER 0x02  /**< 其他 (raw 16B) */
+#define INCREMENTAL_TYPE_SHIFT 4
+#define INCREMENTAL_TYPE_MASK 0x70 /**< 对象类型 + 1 */
 
 /**
  * @brief 序列化单个对象 (增量格式)
@@ -53,7 +59,7 @@ int bacnet_incremental_serialize_batch(const xslot_bacnet_object_t *objects,
  * @brief 反序列化单个对象 (增量格式)
  * @param buffer 输入缓冲区
  * @param len 缓冲区长度
- * @param obj 输出对象 (仅填充 object_id, object_type, present_value)
+ * @param obj 输出对象 (填充 object_id, object_type, present_value，flags 清零)
  * @return 消耗的字节数，失败返回负数
  */
 int bacnet_incremental_deserialize(const uint8_t *buffer, uint8_t len,
@@ -65,11 +71,12 @@ int bacnet_incremental_deserialize(const uint8_t *buffer, uint8_t len,
  * @param len 缓冲区长度
  * @param objects 输出对象数组
  * @param max_count 数组最大容量
+ * @param typed 输出所有对象是否都携带了类型 (可为 NULL)
  * @return 解析的对象数量，失败返回负数
  */
 int bacnet_incremental_deserialize_batch(const uint8_t *buffer, uint8_t len,
                                          xslot_bacnet_object_t *objects,
-                                         uint8_t max_count);
+                                         uint8_t max_count, bool *typed);
 
 /**
  * @brief 判断数据是否为增量格式
@@ -77,7 +77,7 @@ static inline void xslot_from_ai(const ANALOGINPUTOBJECT *ai,
     obj->flags |= XSLOT_FLAG_OUT_OF_SERVICE;
   /* 使用 alarm 字段判断是否变化 */
   if (ai->uidata.alarm)
-    obj->flags |= XSLOT_FLAG_CHANGED;
+    obj->flags |= XSLOT_FLAG_CHANGED | XSLOT_FLAG_IN_ALARM;
   obj->present_value.analog = ai->uidata.value;
 }
 
@@ -109,7 +109,7 @@ static inline void xslot_from_di(const DIGITALINPUTOBJECT *di,
   if (di->didata.outOfService)
     obj->flags |= XSLOT_FLAG_OUT_OF_SERVICE;
   if (di->didata.alarm)
-    obj->flags |= XSLOT_FLAG_CHANGED;
+    obj->flags |= XSLOT_FLAG_CHANGED | XSLOT_FLAG_IN_ALARM;
   obj->present_value.binary = di->didata.state ? 1 : 0;
 }
 
@@ -128,6 +128,59 @@ static inline void xslot_from_do(const DIGITALOUTPUTOBJECT *dobj,
   obj->present_value.binary = dobj->dodata.out ? 1 : 0;
 }
 
+/**
+ * @brief 从 ANALOGINPUTOBJECT 提取告警限值配置 (汇聚节点下发告警点时使用)
+ * @param ai 指向 DDC AI 对象的指针
+ * @param limit 输出的限值配置 (alarmDelay 单位为秒)
+ */
+static inline void xslot_alarm_limit_from_ai(const ANALOGINPUTOBJECT *ai,
+                                             xslot_alarm_limit_t *limit) {
+  limit->object_id = ai->uidata.index;
+  limit->object_type = XSLOT_OBJ_ANALOG_INPUT;
+  limit->limit_enable = 0;
+  if (ai->uidata.highAlarmEnable)
+    limit->limit_enable |= XSLOT_ALARM_ENABLE_HIGH;
+  if (ai->uidata.lowAlarmEnable)
+    limit->limit_enable |= XSLOT_ALARM_ENABLE_LOW;
+  limit->priority = 0;
+  limit->high_limit = ai->uidata.alarmHighLimit;
+  limit->low_limit = ai->uidata.alarmLowLimit;
+  limit->deadband = ai->uidata.alarmDeadband;
+  limit->time_delay_ms =
+      ai->uidata.alarmDelay > 0 ? (uint32_t)ai->uidata.alarmDelay * 1000 : 0;
+}
+
+/**
+ * @brief 从 ANALOGINPUTOBJECT 填写属性集 (属性读取回调中使用)
+ * @param ai 指向 DDC AI 对象的指针
+ * @param props 输出的属性集 (不含 Units/Description，由应用补充)
+ *
+ * UIDATA.reliability 映射为 BACnet Reliability 枚举，非零即置 FAULT 位。
+ */
+static inline void xslot_properties_from_ai(const ANALOGINPUTOBJECT *ai,
+                                            xslot_property_set_t *props) {
+  /* AI_NO_FAULT/OPEN/SHORT/OVERRANGE/UNDERRANGE/NOSENSOR */
+  static const uint8_t reliability_map[] = {0, 4, 5, 2, 3, 1};
+
+  props->object_id = ai->uidata.index;
+  props->object_type = XSLOT_OBJ_ANALOG_INPUT;
+  props->mask |= XSLOT_PROP_PRESENT_VALUE | XSLOT_PROP_STATUS_FLAGS |
+                 XSLOT_PROP_RELIABILITY;
+  props->present_value.analog = ai->uidata.value;
+
+  short rel = ai->uidata.reliability;
+  props->reliability =
+      (rel >= 0 && rel <= AI_NOSENSOR) ? reliability_map[rel] : 7;
+
+  props->status_flags = 0;
+  if (ai->uidata.alarm)
+    props->status_flags |= XSLOT_STATUS_IN_ALARM;
+  if (props->reliability != 0)
+    props->status_flags |= XSLOT_STATUS_FAULT;
+  if (ai->uidata.outOfService)
+    props->status_flags |= XSLOT_STATUS_OUT_OF_SERVICE;
+}
+
 /* =============================================================================
  * 简化创建接口 (直接传值)
  * =============================================================================
@@ -0,0 +1,160 @@
+/**
+ * @file bacnet_property.cpp
+ * @brief BACnet 对象属性集 TLV 编码实现
+ */
+#include "bacnet_property.h"
+#include "../core/buffer_utils.h"
+#include "bacnet_object_def.h"
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+/**
+ * @brief 写入一个 TLV
+ */
+static bool write_tlv(xslot::BufferWriter &writer, uint8_t tag,
+                      const void *value, uint8_t len) {
+  if (writer.remaining_size() < 2u + len)
+    return false;
+  writer.write(tag);
+  writer.write(len);
+  writer.write_bytes({static_cast<const uint8_t *>(value), len});
+  return true;
+}
+
+int bacnet_property_encode(const xslot_property_set_t *props, uint8_t *buffer,
+                           uint8_t buffer_size) {
+  if (!props || !buffer) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot::BufferWriter writer({buffer, buffer_size});
+
+  if (!writer.write(props->object_id))
+    return XSLOT_ERR_NO_MEM;
+  if (!writer.write(props->object_type))
+    return XSLOT_ERR_NO_MEM;
+
+  // N 稍后回填
+  size_t count_pos = writer.offset();
+  uint8_t count = 0;
+  if (!writer.write(count))
+    return XSLOT_ERR_NO_MEM;
+
+  if (props->mask & XSLOT_PROP_PRESENT_VALUE) {
+    bool ok;
+    if (xslot_is_analog_type(props->object_type)) {
+      ok = write_tlv(writer, PROP_TAG_PRESENT_VALUE,
+                     &props->present_value.analog, sizeof(float));
+    } else {
+      ok = write_tlv(writer, PROP_TAG_PRESENT_VALUE,
+                     &props->present_value.binary, 1);
+    }
+    if (!ok)
+      return XSLOT_ERR_NO_MEM;
+    count++;
+  }
+
+  if (props->mask & XSLOT_PROP_STATUS_FLAGS) {
+    if (!write_tlv(writer, PROP_TAG_STATUS_FLAGS, &props->status_flags, 1))
+      return XSLOT_ERR_NO_MEM;
+    count++;
+  }
+
+  if (props->mask & XSLOT_PROP_RELIABILITY) {
+    if (!write_tlv(writer, PROP_TAG_RELIABILITY, &props->reliability, 1))
+      return XSLOT_ERR_NO_MEM;
+    count++;
+  }
+
+  if (props->mask & XSLOT_PROP_UNITS) {
+    if (!write_tlv(writer, PROP_TAG_UNITS, &props->units, 2))
+      return XSLOT_ERR_NO_MEM;
+    count++;
+  }
+
+  if (props->mask & XSLOT_PROP_DESCRIPTION) {
+    uint8_t len =
+        (uint8_t)strnlen(props->description, XSLOT_MAX_DESCRIPTION);
+    if (!write_tlv(writer, PROP_TAG_DESCRIPTION, props->description, len))
+      return XSLOT_ERR_NO_MEM;
+    count++;
+  }
+
+  buffer[count_pos] = count;
+  return static_cast<int>(writer.offset());
+}
+
+int bacnet_property_decode(const uint8_t *buffer, uint8_t len,
+                           xslot_property_set_t *props) {
+  if (!buffer || !props) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  std::memset(props, 0, sizeof(*props));
+  xslot::BufferReader reader({buffer, len});
+
+  auto id = reader.read<uint16_t>();
+  auto type = reader.read<uint8_t>();
+  auto count = reader.read<uint8_t>();
+  if (!id || !type || !count)
+    return XSLOT_ERR_PARAM;
+
+  props->object_id = *id;
+  props->object_type = *type;
+
+  for (uint8_t i = 0; i < *count; i++) {
+    auto tag = reader.read<uint8_t>();
+    auto tlv_len = reader.read<uint8_t>();
+    if (!tag || !tlv_len || reader.remaining_size() < *tlv_len)
+      return XSLOT_ERR_PARAM;
+
+    const uint8_t *value = buffer + reader.offset();
+    reader.skip(*tlv_len);
+
+    switch (*tag) {
+    case PROP_TAG_PRESENT_VALUE:
+      if (xslot_is_analog_type(props->object_type)) {
+        if (*tlv_len != sizeof(float))
+          return XSLOT_ERR_PARAM;
+        std::memcpy(&props->present_value.analog, value, sizeof(float));
+      } else {
+        if (*tlv_len != 1)
+          return XSLOT_ERR_PARAM;
+        props->present_value.binary = value[0];
+      }
+      break;
+
+    case PROP_TAG_STATUS_FLAGS:
+    case PROP_TAG_RELIABILITY:
+      if (*tlv_len != 1)
+        return XSLOT_ERR_PARAM;
+      if (*tag == PROP_TAG_STATUS_FLAGS)
+        props->status_flags = value[0];
+      else
+        props->reliability = value[0];
+      break;
+
+    case PROP_TAG_UNITS:
+      if (*tlv_len != 2)
+        return XSLOT_ERR_PARAM;
+      std::memcpy(&props->units, value, 2);
+      break;
+
+    case PROP_TAG_DESCRIPTION: {
+      uint8_t n = *tlv_len > XSLOT_MAX_DESCRIPTION ? XSLOT_MAX_DESCRIPTION
+                                                   : *tlv_len;
+      std::memcpy(props->description, value, n);
+      props->description[n] = '\0';
+      break;
+    }
+
+    default:
+      // 未知属性: 跳过
+      continue;
+    }
+
+    props->mask |= (uint8_t)(1u << *tag);
+  }
+
+  return static_cast<int>(reader.offset());
+}
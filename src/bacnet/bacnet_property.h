@@ -0,0 +1,62 @@
+/**
+ * @file bacnet_property.h
+ * @brief BACnet 对象属性集 TLV 编码 (属性选择查询专用)
+ *
+ * 只编码查询方请求且被查询方能提供的属性，未知标签由解码端跳过，
+ * 以后增加属性无需改动旧版本。
+ * 格式: [OBJ_ID:2B][OBJ_TYPE:1B][N:1B]([TAG:1B][LEN:1B][VALUE:LEN])*N
+ *
+ * TAG 取值与属性掩码位序号一致:
+ *   - 0 Present_Value: 模拟量 float, 二进制量 uint8
+ *   - 1 Status_Flags:  uint8 (XSLOT_STATUS_*)
+ *   - 2 Reliability:   uint8
+ *   - 3 Units:         uint16
+ *   - 4 Description:   UTF-8 字符串 (无结束符)
+ */
+#ifndef BACNET_PROPERTY_H
+#define BACNET_PROPERTY_H
+
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROP_TAG_PRESENT_VALUE 0
+#define PROP_TAG_STATUS_FLAGS 1
+#define PROP_TAG_RELIABILITY 2
+#define PROP_TAG_UNITS 3
+#define PROP_TAG_DESCRIPTION 4
+
+/** 单个属性集编码后的最大长度 */
+#define BACNET_PROPERTY_MAX_SIZE                                               \
+  (4 + (2 + 4) + (2 + 1) + (2 + 1) + (2 + 2) + (2 + XSLOT_MAX_DESCRIPTION))
+
+/**
+ * @brief 编码单个属性集
+ * @param props 属性集 (只编码 props->mask 中的属性)
+ * @param buffer 输出缓冲区
+ * @param buffer_size 缓冲区大小
+ * @return 写入的字节数，空间不足返回 XSLOT_ERR_NO_MEM
+ *
+ * 单个属性集最多 BACNET_PROPERTY_MAX_SIZE 字节，总能装入一个空帧。
+ */
+int bacnet_property_encode(const xslot_property_set_t *props, uint8_t *buffer,
+                           uint8_t buffer_size);
+
+/**
+ * @brief 解码单个属性集
+ * @param buffer 输入缓冲区
+ * @param len 缓冲区长度
+ * @param props 输出
+ * @return 消耗的字节数，失败返回负数
+ */
+int bacnet_property_decode(const uint8_t *buffer, uint8_t len,
+                           xslot_property_set_t *props);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BACNET_PROPERTY_H */
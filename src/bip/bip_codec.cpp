@@ -0,0 +1,427 @@
+/**
+ * @file bip_codec.cpp
+ * @brief BACnet/IP 报文编解码实现
+ */
+#include "bip_codec.h"
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+/* =============================================================================
+ * 编码
+ * =============================================================================
+ */
+
+static int put_unsigned(uint8_t *buf, uint32_t value) {
+  if (value < 0x100) {
+    buf[0] = (uint8_t)value;
+    return 1;
+  }
+  if (value < 0x10000) {
+    buf[0] = (uint8_t)(value >> 8);
+    buf[1] = (uint8_t)value;
+    return 2;
+  }
+  if (value < 0x1000000) {
+    buf[0] = (uint8_t)(value >> 16);
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)value;
+    return 3;
+  }
+  buf[0] = (uint8_t)(value >> 24);
+  buf[1] = (uint8_t)(value >> 16);
+  buf[2] = (uint8_t)(value >> 8);
+  buf[3] = (uint8_t)value;
+  return 4;
+}
+
+static uint8_t unsigned_size(uint32_t value) {
+  if (value < 0x100)
+    return 1;
+  if (value < 0x10000)
+    return 2;
+  if (value < 0x1000000)
+    return 3;
+  return 4;
+}
+
+int bip_encode_tag(uint8_t *buf, uint8_t number, bool context,
+                   uint32_t len_value) {
+  int n = 1;
+  buf[0] = context ? 0x08 : 0x00;
+
+  if (number <= 14) {
+    buf[0] |= (uint8_t)(number << 4);
+  } else {
+    buf[0] |= 0xF0;
+    buf[n++] = number;
+  }
+
+  if (len_value <= 4) {
+    buf[0] |= (uint8_t)len_value;
+  } else {
+    buf[0] |= 5;
+    if (len_value < 254) {
+      buf[n++] = (uint8_t)len_value;
+    } else {
+      buf[n++] = 254;
+      buf[n++] = (uint8_t)(len_value >> 8);
+      buf[n++] = (uint8_t)len_value;
+    }
+  }
+
+  return n;
+}
+
+int bip_encode_opening_tag(uint8_t *buf, uint8_t number) {
+  int n = bip_encode_tag(buf, number, true, 0);
+  buf[0] |= 6;
+  return n;
+}
+
+int bip_encode_closing_tag(uint8_t *buf, uint8_t number) {
+  int n = bip_encode_tag(buf, number, true, 0);
+  buf[0] |= 7;
+  return n;
+}
+
+int bip_encode_app_null(uint8_t *buf) {
+  return bip_encode_tag(buf, BIP_TAG_NULL, false, 0);
+}
+
+int bip_encode_app_boolean(uint8_t *buf, bool value) {
+  /* 应用布尔值直接放在 L/V/T 字段 */
+  return bip_encode_tag(buf, BIP_TAG_BOOLEAN, false, value ? 1 : 0);
+}
+
+int bip_encode_app_unsigned(uint8_t *buf, uint32_t value) {
+  int n = bip_encode_tag(buf, BIP_TAG_UNSIGNED, false, unsigned_size(value));
+  return n + put_unsigned(buf + n, value);
+}
+
+int bip_encode_app_enumerated(uint8_t *buf, uint32_t value) {
+  int n = bip_encode_tag(buf, BIP_TAG_ENUMERATED, false, unsigned_size(value));
+  return n + put_unsigned(buf + n, value);
+}
+
+int bip_encode_app_real(uint8_t *buf, float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, 4);
+
+  int n = bip_encode_tag(buf, BIP_TAG_REAL, false, 4);
+  buf[n++] = (uint8_t)(bits >> 24);
+  buf[n++] = (uint8_t)(bits >> 16);
+  buf[n++] = (uint8_t)(bits >> 8);
+  buf[n++] = (uint8_t)bits;
+  return n;
+}
+
+static int put_object_id(uint8_t *buf, uint16_t type, uint32_t instance) {
+  uint32_t value = ((uint32_t)(type & 0x3FF) << 22) | (instance & 0x3FFFFF);
+  buf[0] = (uint8_t)(value >> 24);
+  buf[1] = (uint8_t)(value >> 16);
+  buf[2] = (uint8_t)(value >> 8);
+  buf[3] = (uint8_t)value;
+  return 4;
+}
+
+int bip_encode_app_object_id(uint8_t *buf, uint16_t type, uint32_t instance) {
+  int n = bip_encode_tag(buf, BIP_TAG_OBJECT_ID, false, 4);
+  return n + put_object_id(buf + n, type, instance);
+}
+
+int bip_encode_app_char_string(uint8_t *buf, const char *str) {
+  uint32_t len = (uint32_t)std::strlen(str);
+
+  int n = bip_encode_tag(buf, BIP_TAG_CHAR_STRING, false, len + 1);
+  buf[n++] = 0; /* 字符集: UTF-8 */
+  std::memcpy(buf + n, str, len);
+  return n + (int)len;
+}
+
+int bip_encode_app_bit_string(uint8_t *buf, const uint8_t *bits,
+                              uint8_t bit_count) {
+  uint8_t bytes = (uint8_t)((bit_count + 7) / 8);
+
+  int n = bip_encode_tag(buf, BIP_TAG_BIT_STRING, false, bytes + 1);
+  buf[n++] = (uint8_t)(bytes * 8 - bit_count); /* 末字节未用位数 */
+  std::memcpy(buf + n, bits, bytes);
+  return n + bytes;
+}
+
+int bip_encode_ctx_unsigned(uint8_t *buf, uint8_t tag, uint32_t value) {
+  int n = bip_encode_tag(buf, tag, true, unsigned_size(value));
+  return n + put_unsigned(buf + n, value);
+}
+
+int bip_encode_ctx_enumerated(uint8_t *buf, uint8_t tag, uint32_t value) {
+  return bip_encode_ctx_unsigned(buf, tag, value);
+}
+
+int bip_encode_ctx_object_id(uint8_t *buf, uint8_t tag, uint16_t type,
+                             uint32_t instance) {
+  int n = bip_encode_tag(buf, tag, true, 4);
+  return n + put_object_id(buf + n, type, instance);
+}
+
+int bip_encode_npdu(uint8_t *buf, const bip_npdu_t *npdu) {
+  int n = 0;
+  buf[n++] = 0x01; /* 协议版本 */
+  buf[n++] = npdu->control;
+
+  if (npdu->control & NPDU_DNET_PRESENT) {
+    buf[n++] = (uint8_t)(npdu->dnet >> 8);
+    buf[n++] = (uint8_t)npdu->dnet;
+    buf[n++] = npdu->dlen;
+    std::memcpy(buf + n, npdu->dadr, npdu->dlen);
+    n += npdu->dlen;
+  }
+
+  if (npdu->control & NPDU_SNET_PRESENT) {
+    buf[n++] = (uint8_t)(npdu->snet >> 8);
+    buf[n++] = (uint8_t)npdu->snet;
+    buf[n++] = npdu->slen;
+    std::memcpy(buf + n, npdu->sadr, npdu->slen);
+    n += npdu->slen;
+  }
+
+  if (npdu->control & NPDU_DNET_PRESENT) {
+    buf[n++] = npdu->hop_count;
+  }
+
+  if (npdu->control & NPDU_NETWORK_MSG) {
+    buf[n++] = npdu->msg_type;
+  }
+
+  return n;
+}
+
+/* =============================================================================
+ * 解码
+ * =============================================================================
+ */
+
+int bip_decode_tag(const uint8_t *buf, uint16_t len, bip_tag_t *tag) {
+  if (len < 1)
+    return XSLOT_ERR_PARAM;
+
+  int n = 1;
+  uint8_t lvt = buf[0] & 0x07;
+
+  tag->context = (buf[0] & 0x08) != 0;
+  tag->opening = tag->context && lvt == 6;
+  tag->closing = tag->context && lvt == 7;
+  tag->number = buf[0] >> 4;
+  tag->len_value = lvt;
+
+  if (tag->number == 15) {
+    if (len < n + 1)
+      return XSLOT_ERR_PARAM;
+    tag->number = buf[n++];
+  }
+
+  if (tag->opening || tag->closing) {
+    tag->len_value = 0;
+  } else if (lvt == 5) {
+    if (len < n + 1)
+      return XSLOT_ERR_PARAM;
+    uint8_t ext = buf[n++];
+    if (ext < 254) {
+      tag->len_value = ext;
+    } else {
+      uint8_t size = ext == 254 ? 2 : 4;
+      if (len < n + size)
+        return XSLOT_ERR_PARAM;
+      tag->len_value = bip_decode_unsigned(buf + n, size);
+      n += size;
+    }
+  }
+
+  return n;
+}
+
+uint32_t bip_decode_unsigned(const uint8_t *buf, uint32_t len) {
+  uint32_t value = 0;
+  for (uint32_t i = 0; i < len && i < 4; i++) {
+    value = (value << 8) | buf[i];
+  }
+  return value;
+}
+
+int bip_decode_opening_tag(const uint8_t *buf, uint16_t len, uint8_t tag) {
+  bip_tag_t t;
+  int n = bip_decode_tag(buf, len, &t);
+  if (n < 0)
+    return n;
+  return (t.opening && t.number == tag) ? n : 0;
+}
+
+int bip_decode_closing_tag(const uint8_t *buf, uint16_t len, uint8_t tag) {
+  bip_tag_t t;
+  int n = bip_decode_tag(buf, len, &t);
+  if (n < 0)
+    return n;
+  return (t.closing && t.number == tag) ? n : 0;
+}
+
+/**
+ * @brief 解码指定编号的上下文原始数据标签
+ * @return 标签头字节数，不匹配返回 0
+ */
+static int decode_ctx(const uint8_t *buf, uint16_t len, uint8_t tag,
+                      bip_tag_t *t) {
+  if (len == 0)
+    return 0;
+
+  int n = bip_decode_tag(buf, len, t);
+  if (n < 0)
+    return n;
+  if (!t->context || t->opening || t->closing || t->number != tag)
+    return 0;
+  if (len < n + t->len_value)
+    return XSLOT_ERR_PARAM;
+  return n;
+}
+
+int bip_decode_ctx_unsigned(const uint8_t *buf, uint16_t len, uint8_t tag,
+                            uint32_t *value) {
+  bip_tag_t t;
+  int n = decode_ctx(buf, len, tag, &t);
+  if (n <= 0)
+    return n;
+  if (t.len_value == 0 || t.len_value > 4)
+    return XSLOT_ERR_PARAM;
+
+  *value = bip_decode_unsigned(buf + n, t.len_value);
+  return n + (int)t.len_value;
+}
+
+int bip_decode_ctx_boolean(const uint8_t *buf, uint16_t len, uint8_t tag,
+                           bool *value) {
+  bip_tag_t t;
+  int n = decode_ctx(buf, len, tag, &t);
+  if (n <= 0)
+    return n;
+  if (t.len_value != 1)
+    return XSLOT_ERR_PARAM;
+
+  *value = buf[n] != 0;
+  return n + 1;
+}
+
+int bip_decode_ctx_object_id(const uint8_t *buf, uint16_t len, uint8_t tag,
+                             uint16_t *type, uint32_t *instance) {
+  bip_tag_t t;
+  int n = decode_ctx(buf, len, tag, &t);
+  if (n <= 0)
+    return n;
+  if (t.len_value != 4)
+    return XSLOT_ERR_PARAM;
+
+  uint32_t value = bip_decode_unsigned(buf + n, 4);
+  *type = (uint16_t)(value >> 22);
+  *instance = value & 0x3FFFFF;
+  return n + 4;
+}
+
+int bip_decode_app_value(const uint8_t *buf, uint16_t len, bip_value_t *value) {
+  bip_tag_t t;
+  int n = bip_decode_tag(buf, len, &t);
+  if (n < 0)
+    return n;
+  if (t.context)
+    return XSLOT_ERR_PARAM;
+
+  value->tag = t.number;
+  if (t.number == BIP_TAG_BOOLEAN) {
+    value->type.boolean = t.len_value != 0;
+    return n;
+  }
+  if (t.number == BIP_TAG_NULL)
+    return n;
+  if (len < n + t.len_value)
+    return XSLOT_ERR_PARAM;
+
+  switch (t.number) {
+  case BIP_TAG_UNSIGNED:
+  case BIP_TAG_ENUMERATED:
+    if (t.len_value == 0 || t.len_value > 4)
+      return XSLOT_ERR_PARAM;
+    value->type.unsigned_value = bip_decode_unsigned(buf + n, t.len_value);
+    break;
+
+  case BIP_TAG_SIGNED: {
+    if (t.len_value == 0 || t.len_value > 4)
+      return XSLOT_ERR_PARAM;
+    uint32_t raw = bip_decode_unsigned(buf + n, t.len_value);
+    /* 符号扩展 */
+    uint32_t shift = 32 - t.len_value * 8;
+    value->type.signed_value = (int32_t)(raw << shift) >> shift;
+    break;
+  }
+
+  case BIP_TAG_REAL: {
+    if (t.len_value != 4)
+      return XSLOT_ERR_PARAM;
+    uint32_t bits = bip_decode_unsigned(buf + n, 4);
+    std::memcpy(&value->type.real, &bits, 4);
+    break;
+  }
+
+  default:
+    return XSLOT_ERR_PARAM;
+  }
+
+  return n + (int)t.len_value;
+}
+
+int bip_decode_npdu(const uint8_t *buf, uint16_t len, bip_npdu_t *npdu) {
+  std::memset(npdu, 0, sizeof(*npdu));
+  if (len < 2 || buf[0] != 0x01)
+    return XSLOT_ERR_PARAM;
+
+  int n = 2;
+  npdu->control = buf[1];
+
+  if (npdu->control & NPDU_DNET_PRESENT) {
+    if (len < n + 3)
+      return XSLOT_ERR_PARAM;
+    npdu->dnet = (uint16_t)((buf[n] << 8) | buf[n + 1]);
+    npdu->dlen = buf[n + 2];
+    n += 3;
+    if (npdu->dlen > BIP_MAX_MAC_LEN || len < n + npdu->dlen)
+      return XSLOT_ERR_PARAM;
+    std::memcpy(npdu->dadr, buf + n, npdu->dlen);
+    n += npdu->dlen;
+  }
+
+  if (npdu->control & NPDU_SNET_PRESENT) {
+    if (len < n + 3)
+      return XSLOT_ERR_PARAM;
+    npdu->snet = (uint16_t)((buf[n] << 8) | buf[n + 1]);
+    npdu->slen = buf[n + 2];
+    n += 3;
+    if (npdu->slen > BIP_MAX_MAC_LEN || len < n + npdu->slen)
+      return XSLOT_ERR_PARAM;
+    std::memcpy(npdu->sadr, buf + n, npdu->slen);
+    n += npdu->slen;
+  }
+
+  if (npdu->control & NPDU_DNET_PRESENT) {
+    if (len < n + 1)
+      return XSLOT_ERR_PARAM;
+    npdu->hop_count = buf[n++];
+  }
+
+  if (npdu->control & NPDU_NETWORK_MSG) {
+    if (len < n + 1)
+      return XSLOT_ERR_PARAM;
+    npdu->msg_type = buf[n++];
+    /* 厂商私有消息带 2 字节厂商 ID */
+    if (npdu->msg_type >= 0x80)
+      n += 2;
+    if (n > len)
+      return XSLOT_ERR_PARAM;
+  }
+
+  return n;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file bip_codec.h
+ * @brief BACnet/IP 报文编解码 (BVLC/NPDU/APDU 标签)
+ *
+ * 仅实现网关所需的子集 (ASHRAE 135 第 6、20、J 章)，不依赖 bacnet-stack。
+ * 多字节字段均为大端序。编码函数返回写入字节数，调用方保证缓冲区足够；
+ * 解码函数返回消耗字节数，标签不匹配返回 0，数据不完整返回负数。
+ */
+#ifndef BIP_CODEC_H
+#define BIP_CODEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BIP_DEFAULT_PORT 47808 /**< 0xBAC0 */
+#define BIP_MAX_APDU 1476      /**< B/IP 最大 APDU */
+#define BIP_MAX_MPDU 1506      /**< BVLC + NPDU + APDU */
+#define BIP_MAX_MAC_LEN 7
+
+/* BVLC 功能码 (Annex J) */
+#define BVLC_TYPE_BIP 0x81
+#define BVLC_FORWARDED_NPDU 0x04
+#define BVLC_ORIGINAL_UNICAST 0x0A
+#define BVLC_ORIGINAL_BROADCAST 0x0B
+
+/* NPDU 控制字 */
+#define NPDU_NETWORK_MSG 0x80
+#define NPDU_DNET_PRESENT 0x20
+#define NPDU_SNET_PRESENT 0x08
+#define NPDU_EXPECTING_REPLY 0x04
+
+/* 网络层消息 */
+#define NPDU_WHO_IS_ROUTER 0x00
+#define NPDU_I_AM_ROUTER 0x01
+
+#define BIP_NET_BROADCAST 0xFFFF /**< 全局广播 DNET */
+
+/* APDU 类型 (高 4 位) */
+#define PDU_CONFIRMED_REQUEST 0x00
+#define PDU_UNCONFIRMED_REQUEST 0x10
+#define PDU_SIMPLE_ACK 0x20
+#define PDU_COMPLEX_ACK 0x30
+#define PDU_ERROR 0x50
+#define PDU_REJECT 0x60
+#define PDU_ABORT 0x70
+
+/**
+ * @brief 应用标签编号
+ */
+typedef enum {
+  BIP_TAG_NULL = 0,
+  BIP_TAG_BOOLEAN = 1,
+  BIP_TAG_UNSIGNED = 2,
+  BIP_TAG_SIGNED = 3,
+  BIP_TAG_REAL = 4,
+  BIP_TAG_DOUBLE = 5,
+  BIP_TAG_OCTET_STRING = 6,
+  BIP_TAG_CHAR_STRING = 7,
+  BIP_TAG_BIT_STRING = 8,
+  BIP_TAG_ENUMERATED = 9,
+  BIP_TAG_DATE = 10,
+  BIP_TAG_TIME = 11,
+  BIP_TAG_OBJECT_ID = 12
+} bip_app_tag_t;
+
+/**
+ * @brief 解码后的标签
+ */
+typedef struct {
+  uint8_t number;     /**< 标签编号 */
+  bool context;       /**< true=上下文标签 */
+  bool opening;       /**< 开标签 */
+  bool closing;       /**< 闭标签 */
+  uint32_t len_value; /**< 内容长度 (应用布尔标签为取值) */
+} bip_tag_t;
+
+/**
+ * @brief 解码后的应用值 (WriteProperty 使用)
+ */
+typedef struct {
+  uint8_t tag; /**< bip_app_tag_t */
+  union {
+    bool boolean;
+    uint32_t unsigned_value; /**< UNSIGNED/ENUMERATED */
+    int32_t signed_value;
+    float real;
+  } type;
+} bip_value_t;
+
+/**
+ * @brief NPDU 头
+ */
+typedef struct {
+  uint8_t control; /**< NPDU_* 控制位 (低 2 位为优先级) */
+  uint16_t dnet;
+  uint8_t dlen; /**< 0 表示 DNET 内广播 */
+  uint8_t dadr[BIP_MAX_MAC_LEN];
+  uint16_t snet;
+  uint8_t slen;
+  uint8_t sadr[BIP_MAX_MAC_LEN];
+  uint8_t hop_count;
+  uint8_t msg_type; /**< 网络层消息类型 (NPDU_NETWORK_MSG 时有效) */
+} bip_npdu_t;
+
+/* =============================================================================
+ * 编码
+ * =============================================================================
+ */
+
+int bip_encode_tag(uint8_t *buf, uint8_t number, bool context,
+                   uint32_t len_value);
+int bip_encode_opening_tag(uint8_t *buf, uint8_t number);
+int bip_encode_closing_tag(uint8_t *buf, uint8_t number);
+
+int bip_encode_app_null(uint8_t *buf);
+int bip_encode_app_boolean(uint8_t *buf, bool value);
+int bip_encode_app_unsigned(uint8_t *buf, uint32_t value);
+int bip_encode_app_enumerated(uint8_t *buf, uint32_t value);
+int bip_encode_app_real(uint8_t *buf, float value);
+int bip_encode_app_object_id(uint8_t *buf, uint16_t type, uint32_t instance);
+
+/**
+ * @brief 编码字符串 (字符集 0: UTF-8)
+ */
+int bip_encode_app_char_string(uint8_t *buf, const char *str);
+
+/**
+ * @brief 编码位串
+ * @param bits 位数据 (bit0 为第一个字节的最高位)
+ * @param bit_count 位数
+ */
+int bip_encode_app_bit_string(uint8_t *buf, const uint8_t *bits,
+                              uint8_t bit_count);
+
+int bip_encode_ctx_unsigned(uint8_t *buf, uint8_t tag, uint32_t value);
+int bip_encode_ctx_enumerated(uint8_t *buf, uint8_t tag, uint32_t value);
+int bip_encode_ctx_object_id(uint8_t *buf, uint8_t tag, uint16_t type,
+                             uint32_t instance);
+
+/**
+ * @brief 编码 NPDU 头
+ */
+int bip_encode_npdu(uint8_t *buf, const bip_npdu_t *npdu);
+
+/* =============================================================================
+ * 解码
+ * =============================================================================
+ */
+
+/**
+ * @brief 解码标签头
+ * @return 标签头字节数，失败返回负数
+ */
+int bip_decode_tag(const uint8_t *buf, uint16_t len, bip_tag_t *tag);
+
+/**
+ * @brief 解码大端无符号整数 (1-4 字节)
+ */
+uint32_t bip_decode_unsigned(const uint8_t *buf, uint32_t len);
+
+int bip_decode_opening_tag(const uint8_t *buf, uint16_t len, uint8_t tag);
+int bip_decode_closing_tag(const uint8_t *buf, uint16_t len, uint8_t tag);
+
+int bip_decode_ctx_unsigned(const uint8_t *buf, uint16_t len, uint8_t tag,
+                            uint32_t *value);
+int bip_decode_ctx_boolean(const uint8_t *buf, uint16_t len, uint8_t tag,
+                           bool *value);
+int bip_decode_ctx_object_id(const uint8_t *buf, uint16_t len, uint8_t tag,
+                             uint16_t *type, uint32_t *instance);
+
+/**
+ * @brief 解码单个应用值
+ * @return 消耗字节数，不支持的类型返回负数
+ */
+int bip_decode_app_value(const uint8_t *buf, uint16_t len, bip_value_t *value);
+
+/**
+ * @brief 解码 NPDU 头
+ * @return NPDU 头字节数 (网络层消息包含消息类型)，失败返回负数
+ */
+int bip_decode_npdu(const uint8_t *buf, uint16_t len, bip_npdu_t *npdu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BIP_CODEC_H */
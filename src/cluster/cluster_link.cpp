@@ -0,0 +1,466 @@
+/**
+ * @file cluster_link.cpp
+ * @brief 汇聚节点集群复制链路实现 (Linux)
+ */
+#include "cluster_link.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* HAL 函数声明 */
+extern "C" {
+uint32_t hal_get_timestamp_ms(void);
+}
+
+#define CLUSTER_OUT_SIZE 65536    /**< 发送缓冲区 */
+#define CLUSTER_RECONNECT_MS 2000 /**< 连接端重连间隔 */
+
+struct cluster_link {
+  int listen_fd;
+  int fd;          /* 当前连接 (-1=无) */
+  bool connecting; /* 非阻塞 connect 进行中 */
+  bool peer_up;    /* 已收到对端 HELLO */
+  char *peer_ep;
+  uint16_t local_addr;
+  cluster_handlers_t handlers;
+  uint32_t connect_ms;
+
+  /* 接收缓冲区 */
+  uint8_t in[CLUSTER_HEADER_SIZE + CLUSTER_MAX_BODY];
+  uint32_t in_len;
+
+  /* 当前 UPLINK 批 */
+  uint8_t batch[CLUSTER_MAX_BODY];
+  uint16_t batch_len;
+
+  /* 发送缓冲区 */
+  uint8_t out[CLUSTER_OUT_SIZE];
+  uint32_t out_len;
+  uint32_t dropped; /**< 对端读取过慢而丢弃的消息数 */
+};
+
+/* ============================================================================
+ * 套接字
+ * ============================================================================
+ */
+
+/**
+ * @brief 打开端点 ("主机:端口" 为 TCP，否则为 Unix 域套接字路径)
+ * @param listening true=监听，false=发起连接 (非阻塞)
+ * @return 描述符，失败返回 -1
+ */
+static int open_endpoint(const char *ep, bool listening, bool *in_progress) {
+  const char *colon = std::strrchr(ep, ':');
+  int fd = -1;
+  int ret = -1;
+
+  if (colon && ep[0] != '/') {
+    char host[256];
+    size_t host_len = colon - ep;
+    if (host_len >= sizeof(host))
+      return -1;
+    std::memcpy(host, ep, host_len);
+    host[host_len] = '\0';
+
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = listening ? AI_PASSIVE : 0;
+
+    struct addrinfo *res;
+    if (getaddrinfo(host_len ? host : nullptr, colon + 1, &hints, &res) != 0)
+      return -1;
+
+    fd = socket(res->ai_family, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                0);
+    if (fd >= 0) {
+      int one = 1;
+      if (listening) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        ret = bind(fd, res->ai_addr, res->ai_addrlen);
+      } else {
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        ret = connect(fd, res->ai_addr, res->ai_addrlen);
+      }
+    }
+    freeaddrinfo(res);
+    if (fd < 0)
+      return -1;
+  } else {
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (std::strlen(ep) >= sizeof(addr.sun_path))
+      return -1;
+    std::strcpy(addr.sun_path, ep);
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+      return -1;
+    if (listening) {
+      unlink(ep);
+      ret = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    } else {
+      ret = connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+    }
+  }
+
+  if (listening) {
+    if (ret != 0 || listen(fd, 1) != 0) {
+      close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  *in_progress = ret != 0;
+  if (ret != 0 && errno != EINPROGRESS && errno != EAGAIN) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/* ============================================================================
+ * 发送
+ * ============================================================================
+ */
+
+/**
+ * @brief 追加一条消息到发送缓冲区
+ * @return false=缓冲区满
+ */
+static bool out_append(cluster_link_t link, uint8_t type, const uint8_t *body,
+                       uint16_t len) {
+  if (link->out_len + CLUSTER_HEADER_SIZE + len > CLUSTER_OUT_SIZE) {
+    link->dropped++;
+    return false;
+  }
+
+  uint8_t *p = link->out + link->out_len;
+  p[0] = len & 0xFF;
+  p[1] = (len >> 8) & 0xFF;
+  p[2] = type;
+  std::memcpy(p + CLUSTER_HEADER_SIZE, body, len);
+  link->out_len += CLUSTER_HEADER_SIZE + len;
+  return true;
+}
+
+static void batch_finish(cluster_link_t link) {
+  if (link->batch_len == 0)
+    return;
+  out_append(link, CLUSTER_MSG_UPLINK, link->batch, link->batch_len);
+  link->batch_len = 0;
+}
+
+/**
+ * @brief 尽量发送缓冲区中的数据 (非阻塞)
+ * @return false=连接已断开
+ */
+static bool out_flush(cluster_link_t link) {
+  while (link->out_len > 0) {
+    ssize_t n = send(link->fd, link->out, link->out_len,
+                     MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return true;
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    std::memmove(link->out, link->out + n, link->out_len - n);
+    link->out_len -= n;
+  }
+  return true;
+}
+
+/* ============================================================================
+ * 连接
+ * ============================================================================
+ */
+
+static void conn_close(cluster_link_t link) {
+  if (link->fd >= 0) {
+    close(link->fd);
+    link->fd = -1;
+  }
+  link->connecting = false;
+  link->in_len = 0;
+  link->out_len = 0;
+  link->batch_len = 0;
+
+  if (link->peer_up) {
+    link->peer_up = false;
+    if (link->handlers.on_peer)
+      link->handlers.on_peer(link->handlers.ctx, 0);
+  }
+}
+
+/**
+ * @brief 连接建立: 发送 HELLO
+ */
+static void conn_ready(cluster_link_t link) {
+  uint8_t hello[2] = {(uint8_t)(link->local_addr & 0xFF),
+                      (uint8_t)(link->local_addr >> 8)};
+  out_append(link, CLUSTER_MSG_HELLO, hello, sizeof(hello));
+  if (!out_flush(link))
+    conn_close(link);
+}
+
+static void handle_message(cluster_link_t link, uint8_t type,
+                           const uint8_t *body, uint16_t len) {
+  const cluster_handlers_t *h = &link->handlers;
+
+  switch (type) {
+  case CLUSTER_MSG_HELLO:
+    if (len >= 2) {
+      link->peer_up = true;
+      if (h->on_peer)
+        h->on_peer(h->ctx, body[0] | (body[1] << 8));
+    }
+    break;
+
+  case CLUSTER_MSG_UPLINK: {
+    uint16_t pos = 0;
+    while (pos < len) {
+      uint8_t frame_len = body[pos++];
+      if (pos + frame_len > len)
+        break;
+      if (h->on_uplink)
+        h->on_uplink(h->ctx, body + pos, frame_len);
+      pos += frame_len;
+    }
+    break;
+  }
+
+  case CLUSTER_MSG_DOWNLINK:
+    if (len >= 2 && h->on_downlink)
+      h->on_downlink(h->ctx, body + 1, len - 1, body[0] != 0);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief 读取并处理完整消息
+ * @return false=连接已断开
+ */
+static bool conn_read(cluster_link_t link) {
+  ssize_t n = recv(link->fd, link->in + link->in_len,
+                   sizeof(link->in) - link->in_len, MSG_DONTWAIT);
+  if (n == 0)
+    return false;
+  if (n < 0)
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  link->in_len += n;
+
+  uint32_t pos = 0;
+  while (link->in_len - pos >= CLUSTER_HEADER_SIZE) {
+    const uint8_t *p = link->in + pos;
+    uint16_t len = p[0] | (p[1] << 8);
+    if (len > CLUSTER_MAX_BODY)
+      return false; /* 协议错误 */
+    if (link->in_len - pos < (uint32_t)(CLUSTER_HEADER_SIZE + len))
+      break;
+
+    handle_message(link, p[2], p + CLUSTER_HEADER_SIZE, len);
+    if (link->fd < 0)
+      return true; /* 处理过程中连接已关闭 */
+    pos += CLUSTER_HEADER_SIZE + len;
+  }
+
+  std::memmove(link->in, link->in + pos, link->in_len - pos);
+  link->in_len -= pos;
+  return true;
+}
+
+static void try_connect(cluster_link_t link) {
+  uint32_t now = hal_get_timestamp_ms();
+  if (link->fd >= 0 || !link->peer_ep ||
+      now - link->connect_ms < CLUSTER_RECONNECT_MS)
+    return;
+
+  link->connect_ms = now;
+  bool in_progress = false;
+  link->fd = open_endpoint(link->peer_ep, false, &in_progress);
+  if (link->fd < 0)
+    return;
+
+  link->connecting = in_progress;
+  if (!in_progress)
+    conn_ready(link);
+}
+
+/* ============================================================================
+ * 接口
+ * ============================================================================
+ */
+
+cluster_link_t cluster_link_create(const char *listen_ep, const char *peer_ep,
+                                   uint16_t local_addr,
+                                   const cluster_handlers_t *handlers) {
+  if (!handlers || (!listen_ep && !peer_ep))
+    return nullptr;
+
+  cluster_link_t link =
+      (cluster_link_t)std::calloc(1, sizeof(struct cluster_link));
+  if (!link)
+    return nullptr;
+
+  link->listen_fd = -1;
+  link->fd = -1;
+  link->local_addr = local_addr;
+  link->handlers = *handlers;
+
+  if (listen_ep) {
+    link->listen_fd = open_endpoint(listen_ep, true, nullptr);
+    if (link->listen_fd < 0) {
+      std::free(link);
+      return nullptr;
+    }
+  }
+
+  if (peer_ep) {
+    link->peer_ep = strdup(peer_ep);
+    link->connect_ms = hal_get_timestamp_ms() - CLUSTER_RECONNECT_MS;
+    try_connect(link);
+  }
+
+  return link;
+}
+
+void cluster_link_destroy(cluster_link_t link) {
+  if (!link)
+    return;
+
+  link->handlers.on_peer = nullptr;
+  conn_close(link);
+  if (link->listen_fd >= 0)
+    close(link->listen_fd);
+  std::free(link->peer_ep);
+  std::free(link);
+}
+
+int cluster_link_pollfds(cluster_link_t link, struct pollfd *pfds, int max) {
+  int n = 0;
+  if (!link)
+    return 0;
+
+  if (link->listen_fd >= 0 && n < max) {
+    pfds[n].fd = link->listen_fd;
+    pfds[n].events = POLLIN;
+    pfds[n].revents = 0;
+    n++;
+  }
+  if (link->fd >= 0 && n < max) {
+    pfds[n].fd = link->fd;
+    pfds[n].events =
+        link->connecting ? POLLOUT : POLLIN | (link->out_len ? POLLOUT : 0);
+    pfds[n].revents = 0;
+    n++;
+  }
+  return n;
+}
+
+void cluster_link_process(cluster_link_t link, const struct pollfd *pfds,
+                          int count) {
+  if (!link)
+    return;
+
+  for (int i = 0; i < count; i++) {
+    if (!pfds[i].revents)
+      continue;
+
+    if (pfds[i].fd == link->listen_fd) {
+      int fd = accept4(link->listen_fd, nullptr, nullptr,
+                       SOCK_CLOEXEC | SOCK_NONBLOCK);
+      if (fd < 0)
+        continue;
+      /* 只保留一条连接 */
+      if (link->fd >= 0) {
+        close(fd);
+        continue;
+      }
+      link->fd = fd;
+      conn_ready(link);
+    } else if (pfds[i].fd == link->fd) {
+      if (link->connecting) {
+        int err = 0;
+        socklen_t err_len = sizeof(err);
+        getsockopt(link->fd, SOL_SOCKET, SO_ERROR, &err, &err_len);
+        if (err != 0) {
+          conn_close(link);
+          continue;
+        }
+        link->connecting = false;
+        conn_ready(link);
+        continue;
+      }
+      if ((pfds[i].revents & (POLLIN | POLLHUP | POLLERR)) && !conn_read(link))
+        conn_close(link);
+    }
+  }
+
+  try_connect(link);
+}
+
+void cluster_link_uplink(cluster_link_t link, const uint8_t *frame,
+                         uint16_t len) {
+  if (!link || !link->peer_up || !frame || len == 0 || len > 255)
+    return;
+
+  if (link->batch_len + 1 + len > CLUSTER_MAX_BODY)
+    batch_finish(link);
+
+  link->batch[link->batch_len++] = (uint8_t)len;
+  std::memcpy(link->batch + link->batch_len, frame, len);
+  link->batch_len += len;
+}
+
+int cluster_link_downlink(cluster_link_t link, const uint8_t *frame,
+                          uint16_t len, bool confirmed) {
+  if (!link || !frame || len == 0 || len >= CLUSTER_MAX_BODY)
+    return XSLOT_ERR_PARAM;
+  if (!link->peer_up)
+    return XSLOT_ERR_NOT_INIT;
+
+  uint8_t body[CLUSTER_MAX_BODY];
+  body[0] = confirmed ? 1 : 0;
+  std::memcpy(body + 1, frame, len);
+
+  /* 先发出已收到的帧，保持先后顺序 */
+  batch_finish(link);
+  if (!out_append(link, CLUSTER_MSG_DOWNLINK, body, len + 1))
+    return XSLOT_ERR_NO_MEM;
+  if (!out_flush(link)) {
+    conn_close(link);
+    return XSLOT_ERR_NOT_INIT;
+  }
+  return XSLOT_OK;
+}
+
+void cluster_link_flush(cluster_link_t link) {
+  if (!link || link->fd < 0 || link->connecting)
+    return;
+
+  batch_finish(link);
+  if (!out_flush(link))
+    conn_close(link);
+}
+
+bool cluster_link_connected(cluster_link_t link) {
+  return link && link->peer_up;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file cluster_link.h
+ * @brief 汇聚节点集群复制链路 (Linux)
+ *
+ * 同一小区的两个汇聚节点 (各自运行 xslotd) 之间的流套接字链路，
+ * 本机端点为 Unix 域套接字路径，跨主机为 "主机:端口" (TCP)。
+ * 一端监听、另一端连接，断开后连接端自动重连。
+ *
+ * 消息格式 (小端): [LEN:2][TYPE:1][BODY:LEN]
+ *
+ * 复制的是无线侧收到的原始帧，上报本身已是增量格式；每轮事件循环
+ * 收到的帧合并为一条 UPLINK 消息发出。
+ */
+#ifndef CLUSTER_LINK_H
+#define CLUSTER_LINK_H
+
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLUSTER_HEADER_SIZE 3
+#define CLUSTER_MAX_BODY 4096 /**< 单条消息最大长度 */
+
+/**
+ * @brief 消息类型
+ */
+typedef enum {
+  CLUSTER_MSG_HELLO = 0x01,    /**< [ADDR:2] 连接建立后双方各发一次 */
+  CLUSTER_MSG_UPLINK = 0x02,   /**< ([LEN:1][帧])* 本机收到的帧 */
+  CLUSTER_MSG_DOWNLINK = 0x03, /**< [CONFIRMED:1][帧] 请对端发送的下行帧 */
+} cluster_msg_type_t;
+
+/**
+ * @brief 链路事件处理
+ */
+typedef struct {
+  /** 对端上线 (收到 HELLO) 或断开 (addr=0) */
+  void (*on_peer)(void *ctx, uint16_t addr);
+  void (*on_uplink)(void *ctx, const uint8_t *frame, uint16_t len);
+  void (*on_downlink)(void *ctx, const uint8_t *frame, uint16_t len,
+                      bool confirmed);
+  void *ctx;
+} cluster_handlers_t;
+
+typedef struct cluster_link *cluster_link_t;
+
+/**
+ * @brief 创建链路
+ * @param listen_ep 监听端点 (NULL=不监听)
+ * @param peer_ep 对端端点 (NULL=等待对端连接)
+ * @param local_addr 本机汇聚节点地址 (HELLO 中发送)
+ * @param handlers 事件处理 (内容被复制)
+ * @return 句柄，监听失败返回 NULL
+ */
+cluster_link_t cluster_link_create(const char *listen_ep, const char *peer_ep,
+                                   uint16_t local_addr,
+                                   const cluster_handlers_t *handlers);
+
+void cluster_link_destroy(cluster_link_t link);
+
+/**
+ * @brief 填充需要等待的描述符
+ * @return 填充数量 (最多 2)
+ */
+int cluster_link_pollfds(cluster_link_t link, struct pollfd *pfds, int max);
+
+/**
+ * @brief 处理 poll 结果 (接受连接、读取消息、按需重连)
+ * @param pfds cluster_link_pollfds 填充的描述符 (revents 已由 poll 设置)
+ */
+void cluster_link_process(cluster_link_t link, const struct pollfd *pfds,
+                          int count);
+
+/**
+ * @brief 追加本机收到的帧 (cluster_link_flush 时合并发送)
+ */
+void cluster_link_uplink(cluster_link_t link, const uint8_t *frame,
+                         uint16_t len);
+
+/**
+ * @brief 请对端发送下行帧
+ * @return 错误码，对端不在线返回 XSLOT_ERR_NOT_INIT
+ */
+int cluster_link_downlink(cluster_link_t link, const uint8_t *frame,
+                          uint16_t len, bool confirmed);
+
+/**
+ * @brief 结束当前批并尽量发出 (每轮事件循环末尾调用)
+ */
+void cluster_link_flush(cluster_link_t link);
+
+/**
+ * @brief 对端是否在线
+ */
+bool cluster_link_connected(cluster_link_t link);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLUSTER_LINK_H */
@@ -0,0 +1,359 @@
+/**
+ * @file alarm_engine.cpp
+ * @brief 汇聚节点告警评估引擎实现
+ *
+ * 限值按 SoA (结构数组) 存放，键为 (addr, object_type, object_id) 并保持有序。
+ * 每次上报先查表收集命中的告警点，再对收集到的数组做无分支的限值比较，
+ * 最后仅对状态发生变化的点做标量的延时处理和事件生成。
+ */
+#include "alarm_engine.h"
+#include "../bacnet/bacnet_object_def.h"
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+/* 单批评估的最大对象数 (栈上临时数组) */
+#define ALARM_EVAL_BATCH 32
+
+struct alarm_engine {
+  uint16_t max_points;
+  uint16_t count;
+
+  /* 配置 (SoA) */
+  uint64_t *keys;
+  float *high_limit;
+  float *low_limit;
+  float *deadband;
+  uint32_t *time_delay_ms;
+  uint8_t *limit_enable;
+  uint8_t *priority;
+
+  /* 运行状态 */
+  uint8_t *state;
+  uint8_t *pending;
+  uint32_t *pending_since;
+  float *last_value;
+};
+
+/* 不同类型的对象实例号可能相同 (AI3/AO3)，键中包含类型 */
+static inline uint64_t make_key(uint16_t addr, uint8_t object_type,
+                                uint16_t object_id) {
+  return ((uint64_t)addr << 24) | ((uint64_t)object_type << 16) | object_id;
+}
+
+/**
+ * @brief 二分查找键
+ * @return 命中返回索引; 未命中返回 -(插入位置 + 1)
+ */
+static int find_key(alarm_engine_t engine, uint64_t key) {
+  int lo = 0;
+  int hi = (int)engine->count - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    if (engine->keys[mid] == key)
+      return mid;
+    if (engine->keys[mid] < key)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+  return -(lo + 1);
+}
+
+/**
+ * @brief 按实例号在模拟量类型中查找 (对象未携带类型时使用)
+ * @return 恰好命中一个返回其索引; 未命中或命中多个返回 -1
+ */
+static int find_untyped(alarm_engine_t engine, uint16_t addr,
+                        uint16_t object_id) {
+  int found = -1;
+  for (uint8_t type = XSLOT_OBJ_ANALOG_INPUT; type <= XSLOT_OBJ_ANALOG_VALUE;
+       type++) {
+    int k = find_key(engine, make_key(addr, type, object_id));
+    if (k < 0)
+      continue;
+    if (found >= 0)
+      return -1;
+    found = k;
+  }
+  return found;
+}
+
+alarm_engine_t alarm_engine_create(uint16_t max_points) {
+  if (max_points == 0)
+    return nullptr;
+
+  alarm_engine_t engine =
+      (alarm_engine_t)std::calloc(1, sizeof(struct alarm_engine));
+  if (!engine)
+    return nullptr;
+
+  engine->max_points = max_points;
+  engine->keys = (uint64_t *)std::calloc(max_points, sizeof(uint64_t));
+  engine->high_limit = (float *)std::calloc(max_points, sizeof(float));
+  engine->low_limit = (float *)std::calloc(max_points, sizeof(float));
+  engine->deadband = (float *)std::calloc(max_points, sizeof(float));
+  engine->time_delay_ms = (uint32_t *)std::calloc(max_points, sizeof(uint32_t));
+  engine->limit_enable = (uint8_t *)std::calloc(max_points, sizeof(uint8_t));
+  engine->priority = (uint8_t *)std::calloc(max_points, sizeof(uint8_t));
+  engine->state = (uint8_t *)std::calloc(max_points, sizeof(uint8_t));
+  engine->pending = (uint8_t *)std::calloc(max_points, sizeof(uint8_t));
+  engine->pending_since = (uint32_t *)std::calloc(max_points, sizeof(uint32_t));
+  engine->last_value = (float *)std::calloc(max_points, sizeof(float));
+
+  if (!engine->keys || !engine->high_limit || !engine->low_limit ||
+      !engine->deadband || !engine->time_delay_ms || !engine->limit_enable ||
+      !engine->priority || !engine->state || !engine->pending ||
+      !engine->pending_since || !engine->last_value) {
+    alarm_engine_destroy(engine);
+    return nullptr;
+  }
+
+  return engine;
+}
+
+void alarm_engine_destroy(alarm_engine_t engine) {
+  if (!engine)
+    return;
+
+  std::free(engine->keys);
+  std::free(engine->high_limit);
+  std::free(engine->low_limit);
+  std::free(engine->deadband);
+  std::free(engine->time_delay_ms);
+  std::free(engine->limit_enable);
+  std::free(engine->priority);
+  std::free(engine->state);
+  std::free(engine->pending);
+  std::free(engine->pending_since);
+  std::free(engine->last_value);
+  std::free(engine);
+}
+
+/**
+ * @brief 在 pos 处插入/删除一个空位 (所有数组同步移动)
+ */
+static void shift_arrays(alarm_engine_t engine, int dst, int src, int n) {
+  if (n <= 0)
+    return;
+  std::memmove(&engine->keys[dst], &engine->keys[src], n * sizeof(uint64_t));
+  std::memmove(&engine->high_limit[dst], &engine->high_limit[src],
+               n * sizeof(float));
+  std::memmove(&engine->low_limit[dst], &engine->low_limit[src],
+               n * sizeof(float));
+  std::memmove(&engine->deadband[dst], &engine->deadband[src],
+               n * sizeof(float));
+  std::memmove(&engine->time_delay_ms[dst], &engine->time_delay_ms[src],
+               n * sizeof(uint32_t));
+  std::memmove(&engine->limit_enable[dst], &engine->limit_enable[src], n);
+  std::memmove(&engine->priority[dst], &engine->priority[src], n);
+  std::memmove(&engine->state[dst], &engine->state[src], n);
+  std::memmove(&engine->pending[dst], &engine->pending[src], n);
+  std::memmove(&engine->pending_since[dst], &engine->pending_since[src],
+               n * sizeof(uint32_t));
+  std::memmove(&engine->last_value[dst], &engine->last_value[src],
+               n * sizeof(float));
+}
+
+int alarm_engine_set_limit(alarm_engine_t engine, uint16_t addr,
+                           const xslot_alarm_limit_t *limit) {
+  if (!engine || !limit)
+    return XSLOT_ERR_PARAM;
+
+  uint64_t key = make_key(addr, limit->object_type, limit->object_id);
+  int idx = find_key(engine, key);
+
+  if (idx < 0) {
+    if (engine->count >= engine->max_points)
+      return XSLOT_ERR_NO_MEM;
+
+    idx = -idx - 1;
+    shift_arrays(engine, idx + 1, idx, engine->count - idx);
+    engine->count++;
+
+    engine->keys[idx] = key;
+    engine->state[idx] = XSLOT_ALARM_NORMAL;
+    engine->pending[idx] = XSLOT_ALARM_NORMAL;
+    engine->pending_since[idx] = 0;
+    engine->last_value[idx] = 0.0f;
+  }
+
+  engine->high_limit[idx] = limit->high_limit;
+  engine->low_limit[idx] = limit->low_limit;
+  engine->deadband[idx] = limit->deadband > 0.0f ? limit->deadband : 0.0f;
+  engine->time_delay_ms[idx] = limit->time_delay_ms;
+  engine->limit_enable[idx] = limit->limit_enable;
+  engine->priority[idx] = limit->priority;
+
+  return XSLOT_OK;
+}
+
+void alarm_engine_remove(alarm_engine_t engine, uint16_t addr,
+                         uint8_t object_type, uint16_t object_id) {
+  if (!engine)
+    return;
+
+  int idx = find_key(engine, make_key(addr, object_type, object_id));
+  if (idx >= 0) {
+    shift_arrays(engine, idx, idx + 1, engine->count - idx - 1);
+    engine->count--;
+  }
+}
+
+/**
+ * @brief 生成事件 (按优先级插入, 保持有序且同优先级先到先出)
+ *
+ * 事件数组已满时不改变状态，状态变化保持待定，由下一次评估或延时检查
+ * 再次产生事件，告警/恢复不会丢失。
+ */
+static void emit_event(alarm_engine_t engine, int k, uint8_t to_state,
+                       uint32_t now, xslot_alarm_event_t *events,
+                       int max_events, int *event_count) {
+  if (*event_count >= max_events)
+    return;
+
+  uint8_t from_state = engine->state[k];
+  engine->state[k] = to_state;
+
+  xslot_alarm_event_t ev;
+  ev.addr = (uint16_t)(engine->keys[k] >> 24);
+  ev.object_type = (uint8_t)((engine->keys[k] >> 16) & 0xFF);
+  ev.object_id = (uint16_t)(engine->keys[k] & 0xFFFF);
+  ev.from_state = from_state;
+  ev.to_state = to_state;
+  ev.priority = engine->priority[k];
+  ev.value = engine->last_value[k];
+  /* 恢复正常时报告刚离开的限值 */
+  uint8_t limit_state = to_state != XSLOT_ALARM_NORMAL ? to_state : from_state;
+  ev.limit = limit_state == XSLOT_ALARM_HIGH_LIMIT ? engine->high_limit[k]
+                                                   : engine->low_limit[k];
+  ev.timestamp = now;
+
+  int pos = *event_count;
+  while (pos > 0 && events[pos - 1].priority > ev.priority) {
+    events[pos] = events[pos - 1];
+    pos--;
+  }
+  events[pos] = ev;
+  (*event_count)++;
+}
+
+/**
+ * @brief 处理目标状态 (延时判断)
+ */
+static void apply_target(alarm_engine_t engine, int k, uint8_t target,
+                         uint32_t now, xslot_alarm_event_t *events,
+                         int max_events, int *event_count) {
+  if (target == engine->state[k]) {
+    engine->pending[k] = target;
+    return;
+  }
+
+  if (engine->pending[k] != target) {
+    engine->pending[k] = target;
+    engine->pending_since[k] = now;
+  }
+
+  if (now - engine->pending_since[k] >= engine->time_delay_ms[k]) {
+    emit_event(engine, k, target, now, events, max_events, event_count);
+  }
+}
+
+int alarm_engine_evaluate(alarm_engine_t engine, uint16_t addr,
+                          const xslot_bacnet_object_t *objects, uint8_t count,
+                          bool typed, uint32_t now,
+                          xslot_alarm_event_t *events, int max_events) {
+  if (!engine || !objects || !events || engine->count == 0)
+    return 0;
+
+  int event_count = 0;
+  uint8_t i = 0;
+
+  while (i < count) {
+    int idx[ALARM_EVAL_BATCH];
+    float value[ALARM_EVAL_BATCH];
+    float high[ALARM_EVAL_BATCH];
+    float low[ALARM_EVAL_BATCH];
+    float db[ALARM_EVAL_BATCH];
+    uint8_t enable[ALARM_EVAL_BATCH];
+    uint8_t state[ALARM_EVAL_BATCH];
+    uint8_t target[ALARM_EVAL_BATCH];
+    int n = 0;
+
+    /* 1. 查表并收集 (gather) */
+    for (; i < count && n < ALARM_EVAL_BATCH; i++) {
+      if (!xslot_is_analog_type(objects[i].object_type))
+        continue;
+      int k = typed ? find_key(engine, make_key(addr, objects[i].object_type,
+                                                objects[i].object_id))
+                    : find_untyped(engine, addr, objects[i].object_id);
+      if (k < 0)
+        continue;
+      idx[n] = k;
+      value[n] = objects[i].present_value.analog;
+      n++;
+    }
+
+    for (int j = 0; j < n; j++) {
+      int k = idx[j];
+      high[j] = engine->high_limit[k];
+      low[j] = engine->low_limit[k];
+      db[j] = engine->deadband[k];
+      enable[j] = engine->limit_enable[k];
+      state[j] = engine->state[k];
+    }
+
+    /* 2. 批量限值比较 (无分支) */
+    for (int j = 0; j < n; j++) {
+      float x = value[j];
+      uint8_t en_high = (enable[j] & XSLOT_ALARM_ENABLE_HIGH) ? 1 : 0;
+      uint8_t en_low = (enable[j] & XSLOT_ALARM_ENABLE_LOW) ? 1 : 0;
+      uint8_t above = en_high & (uint8_t)(x > high[j]);
+      uint8_t below = en_low & (uint8_t)(x < low[j]);
+      /* 死区: 已处于告警时需回到 限值∓死区 以内才恢复 */
+      uint8_t hold_high = en_high &
+                          (uint8_t)(state[j] == XSLOT_ALARM_HIGH_LIMIT) &
+                          (uint8_t)(x > high[j] - db[j]);
+      uint8_t hold_low = en_low & (uint8_t)(state[j] == XSLOT_ALARM_LOW_LIMIT) &
+                         (uint8_t)(x < low[j] + db[j]);
+      uint8_t is_high = above | hold_high;
+      uint8_t is_low = (below | hold_low) & (uint8_t)!is_high;
+      target[j] = (uint8_t)(is_high * XSLOT_ALARM_HIGH_LIMIT +
+                            is_low * XSLOT_ALARM_LOW_LIMIT);
+    }
+
+    /* 3. 状态变化与延时 (标量) */
+    for (int j = 0; j < n; j++) {
+      engine->last_value[idx[j]] = value[j];
+      apply_target(engine, idx[j], target[j], now, events, max_events,
+                   &event_count);
+    }
+  }
+
+  return event_count;
+}
+
+int alarm_engine_check_delays(alarm_engine_t engine, uint32_t now,
+                              xslot_alarm_event_t *events, int max_events) {
+  if (!engine || !events)
+    return 0;
+
+  int event_count = 0;
+  for (uint16_t k = 0; k < engine->count; k++) {
+    if (engine->pending[k] != engine->state[k] &&
+        now - engine->pending_since[k] >= engine->time_delay_ms[k]) {
+      emit_event(engine, k, engine->pending[k], now, events, max_events,
+                 &event_count);
+    }
+  }
+  return event_count;
+}
+
+uint8_t alarm_engine_get_state(alarm_engine_t engine, uint16_t addr,
+                               uint8_t object_type, uint16_t object_id) {
+  if (!engine)
+    return XSLOT_ALARM_NORMAL;
+
+  int idx = find_key(engine, make_key(addr, object_type, object_id));
+  return idx >= 0 ? engine->state[idx] : (uint8_t)XSLOT_ALARM_NORMAL;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file alarm_engine.h
+ * @brief 汇聚节点告警评估引擎
+ *
+ * 对收到的模拟量按 高限/低限/死区/延时 评估告警状态，
+ * 语义与 BACnet Intrinsic Reporting (High_Limit/Low_Limit/Deadband/
+ * Time_Delay) 以及 DDC UIDATA 告警字段一致。
+ */
+#ifndef ALARM_ENGINE_H
+#define ALARM_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 告警引擎句柄
+ */
+typedef struct alarm_engine *alarm_engine_t;
+
+/**
+ * @brief 创建告警引擎
+ * @param max_points 最大告警点数
+ */
+alarm_engine_t alarm_engine_create(uint16_t max_points);
+
+/**
+ * @brief 销毁告警引擎
+ */
+void alarm_engine_destroy(alarm_engine_t engine);
+
+/**
+ * @brief 设置 (新增或更新) 告警点限值
+ * @param engine 引擎
+ * @param addr 节点地址
+ * @param limit 限值配置
+ * @return 错误码
+ */
+int alarm_engine_set_limit(alarm_engine_t engine, uint16_t addr,
+                           const xslot_alarm_limit_t *limit);
+
+/**
+ * @brief 移除告警点
+ */
+void alarm_engine_remove(alarm_engine_t engine, uint16_t addr,
+                         uint8_t object_type, uint16_t object_id);
+
+/**
+ * @brief 评估一次上报中的所有对象
+ * @param engine 引擎
+ * @param addr 来源节点地址
+ * @param objects 对象数组
+ * @param count 对象数量
+ * @param typed 对象是否携带真实类型
+ * @param now 当前时间戳 (ms)
+ * @param events 事件输出数组 (按优先级排序, 数值小者在前)
+ * @param max_events 事件数组容量
+ * @return 产生的事件数量
+ *
+ * typed=false 时 (旧版节点的增量上报，类型按值类型推断为 AI) 忽略对象类型，
+ * 按 (addr, object_id) 在 AI/AO/AV 告警点中查找：恰好命中一个时照常评估；
+ * 同一实例号配置了多个模拟量类型时无法区分，跳过该对象。
+ */
+int alarm_engine_evaluate(alarm_engine_t engine, uint16_t addr,
+                          const xslot_bacnet_object_t *objects, uint8_t count,
+                          bool typed, uint32_t now,
+                          xslot_alarm_event_t *events, int max_events);
+
+/**
+ * @brief 检查延时到期的待定状态变化 (无新数据到达时使用)
+ * @return 产生的事件数量
+ *
+ * 事件数组装满后其余状态变化保持待定，返回值等于 max_events 时应再次调用。
+ */
+int alarm_engine_check_delays(alarm_engine_t engine, uint32_t now,
+                              xslot_alarm_event_t *events, int max_events);
+
+/**
+ * @brief 获取告警点当前状态
+ * @return 状态 (xslot_alarm_state_t)，未配置返回 XSLOT_ALARM_NORMAL
+ */
+uint8_t alarm_engine_get_state(alarm_engine_t engine, uint16_t addr,
+                               uint8_t object_type, uint16_t object_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ALARM_ENGINE_H */
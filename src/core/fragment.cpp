@@ -0,0 +1,192 @@
+/**
+ * @file fragment.cpp
+ * @brief 数据块分片发送与重组实现
+ */
+#include "fragment.h"
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+/* 每个传输最多 32 个分片，用位图记录已收到的分片 */
+static_assert(FRAGMENT_MAX_BLOCK / MESSAGE_FRAGMENT_CHUNK <= 32,
+              "fragment bitmap is 32 bits");
+
+/* =============================================================================
+ * 发送端
+ * =============================================================================
+ */
+
+int fragment_tx_begin(fragment_tx_t *tx, uint8_t xfer, uint8_t kind,
+                      const uint8_t *block, uint16_t len) {
+  if (!tx || !block || len == 0 || len > FRAGMENT_MAX_BLOCK)
+    return XSLOT_ERR_PARAM;
+
+  tx->block = block;
+  tx->len = len;
+  tx->hdr.xfer = xfer;
+  tx->hdr.index = 0;
+  tx->hdr.total =
+      (uint8_t)((len + MESSAGE_FRAGMENT_CHUNK - 1) / MESSAGE_FRAGMENT_CHUNK);
+  tx->hdr.kind = kind;
+  return XSLOT_OK;
+}
+
+int fragment_tx_build(const fragment_tx_t *tx, xslot_frame_t *frame,
+                      uint16_t from, uint16_t to, uint8_t seq) {
+  if (!tx || !frame || tx->hdr.index >= tx->hdr.total)
+    return XSLOT_ERR_PARAM;
+
+  uint16_t offset = tx->hdr.index * MESSAGE_FRAGMENT_CHUNK;
+  uint16_t len = tx->len - offset;
+  if (len > MESSAGE_FRAGMENT_CHUNK)
+    len = MESSAGE_FRAGMENT_CHUNK;
+
+  return message_build_fragment(frame, from, to, seq, &tx->hdr,
+                                tx->block + offset, (uint8_t)len);
+}
+
+bool fragment_tx_advance(fragment_tx_t *tx) {
+  if (!tx)
+    return true;
+  if (tx->hdr.index < tx->hdr.total)
+    tx->hdr.index++;
+  return tx->hdr.index >= tx->hdr.total;
+}
+
+/* =============================================================================
+ * 接收端
+ * =============================================================================
+ */
+
+struct rx_entry {
+  bool used;
+  bool done; /* 已交付，重复分片直接忽略 */
+  uint16_t from;
+  uint8_t xfer;
+  uint8_t kind;
+  uint8_t total;
+  uint32_t received; /* 分片位图 */
+  uint16_t len;
+  uint32_t first_ms;
+  uint8_t *buffer;
+};
+
+struct fragment_rx {
+  rx_entry *entries;
+  uint8_t count;
+};
+
+fragment_rx_t fragment_rx_create(uint8_t max_transfers) {
+  if (max_transfers == 0)
+    return nullptr;
+
+  fragment_rx_t rx = (fragment_rx_t)std::calloc(1, sizeof(struct fragment_rx));
+  if (!rx)
+    return nullptr;
+
+  rx->entries = (rx_entry *)std::calloc(max_transfers, sizeof(rx_entry));
+  if (!rx->entries) {
+    std::free(rx);
+    return nullptr;
+  }
+  rx->count = max_transfers;
+
+  for (uint8_t i = 0; i < max_transfers; i++) {
+    rx->entries[i].buffer = (uint8_t *)std::malloc(FRAGMENT_MAX_BLOCK);
+    if (!rx->entries[i].buffer) {
+      fragment_rx_destroy(rx);
+      return nullptr;
+    }
+  }
+
+  return rx;
+}
+
+void fragment_rx_destroy(fragment_rx_t rx) {
+  if (!rx)
+    return;
+
+  for (uint8_t i = 0; i < rx->count; i++) {
+    std::free(rx->entries[i].buffer);
+  }
+  std::free(rx->entries);
+  std::free(rx);
+}
+
+/**
+ * @brief 查找或分配传输条目
+ *
+ * 同一来源只保留最新的传输: 新的传输编号到达说明发送端已放弃旧传输。
+ * 没有空闲条目时复用超时或最旧的条目。
+ */
+static rx_entry *rx_lookup(fragment_rx_t rx, uint16_t from, uint32_t now_ms) {
+  rx_entry *free_entry = nullptr;
+  rx_entry *oldest = &rx->entries[0];
+
+  for (uint8_t i = 0; i < rx->count; i++) {
+    rx_entry *e = &rx->entries[i];
+    if (e->used && e->from == from)
+      return e;
+    if (!e->used || now_ms - e->first_ms > FRAGMENT_RX_TIMEOUT_MS) {
+      if (!free_entry)
+        free_entry = e;
+    } else if ((int32_t)(e->first_ms - oldest->first_ms) < 0) {
+      oldest = e;
+    }
+  }
+
+  rx_entry *e = free_entry ? free_entry : oldest;
+  e->used = false;
+  return e;
+}
+
+int fragment_rx_push(fragment_rx_t rx, const xslot_frame_t *frame,
+                     uint32_t now_ms, uint8_t *kind, const uint8_t **block,
+                     uint32_t *elapsed_ms) {
+  if (!rx || !frame || !kind || !block || !elapsed_ms)
+    return XSLOT_ERR_PARAM;
+
+  message_fragment_t hdr;
+  const uint8_t *chunk;
+  int len = message_parse_fragment(frame, &hdr, &chunk);
+  if (len < 0)
+    return len;
+  if (hdr.total > 32)
+    return XSLOT_ERR_PARAM;
+  /* 除最后一片外都应是满片 */
+  if (hdr.index + 1 < hdr.total && len != MESSAGE_FRAGMENT_CHUNK)
+    return XSLOT_ERR_PARAM;
+
+  rx_entry *e = rx_lookup(rx, frame->from, now_ms);
+  if (e->used && e->xfer == hdr.xfer && e->kind == hdr.kind &&
+      e->total == hdr.total) {
+    if (e->done)
+      return 0;
+  } else {
+    e->used = true;
+    e->done = false;
+    e->from = frame->from;
+    e->xfer = hdr.xfer;
+    e->kind = hdr.kind;
+    e->total = hdr.total;
+    e->received = 0;
+    e->len = 0;
+    e->first_ms = now_ms;
+  }
+
+  uint16_t offset = hdr.index * MESSAGE_FRAGMENT_CHUNK;
+  std::memcpy(e->buffer + offset, chunk, len);
+  e->received |= 1u << hdr.index;
+  if (hdr.index + 1 == hdr.total)
+    e->len = offset + len;
+
+  uint32_t all = hdr.total == 32 ? 0xFFFFFFFFu : (1u << hdr.total) - 1;
+  if (e->received != all)
+    return 0;
+
+  e->done = true;
+  *kind = e->kind;
+  *block = e->buffer;
+  *elapsed_ms = now_ms - e->first_ms;
+  return e->len;
+}
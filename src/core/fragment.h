@@ -0,0 +1,100 @@
+/**
+ * @file fragment.h
+ * @brief 数据块分片发送与重组
+ *
+ * 超过单帧容量的数据块 (断线补发的历史记录、趋势日志等) 切分为 FRAGMENT 帧，
+ * 发送端逐帧推进 (由调用方控制节奏实现限速)，接收端按来源和传输编号
+ * 重组，收齐后整块交付。分片丢失时整块作废，由发送端重传整块。
+ */
+#ifndef FRAGMENT_H
+#define FRAGMENT_H
+
+#include "message_codec.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 单个数据块最大长度 */
+#define FRAGMENT_MAX_BLOCK (MESSAGE_FRAGMENT_CHUNK * 32)
+
+/** 未收齐的传输超过此时间丢弃 */
+#define FRAGMENT_RX_TIMEOUT_MS 60000
+
+/**
+ * @brief 数据块类型
+ */
+typedef enum {
+  FRAGMENT_KIND_HISTORY = 1, /**< 断线期间缓存的历史样本 */
+  FRAGMENT_KIND_TREND = 2,   /**< 趋势日志 (trend_log.h) */
+} fragment_kind_t;
+
+/* =============================================================================
+ * 发送端
+ * =============================================================================
+ */
+
+/**
+ * @brief 发送状态
+ */
+typedef struct {
+  const uint8_t *block; /**< 数据块 (发送期间由调用方保持有效) */
+  uint16_t len;
+  message_fragment_t hdr; /**< 下一个分片的头 */
+} fragment_tx_t;
+
+/**
+ * @brief 开始发送数据块
+ * @return XSLOT_OK，数据块超长返回 XSLOT_ERR_PARAM
+ */
+int fragment_tx_begin(fragment_tx_t *tx, uint8_t xfer, uint8_t kind,
+                      const uint8_t *block, uint16_t len);
+
+/**
+ * @brief 构建下一个分片帧 (发送成功后调用 fragment_tx_advance)
+ */
+int fragment_tx_build(const fragment_tx_t *tx, xslot_frame_t *frame,
+                      uint16_t from, uint16_t to, uint8_t seq);
+
+/**
+ * @brief 推进到下一个分片
+ * @return true=全部分片已发送
+ */
+bool fragment_tx_advance(fragment_tx_t *tx);
+
+/* =============================================================================
+ * 接收端
+ * =============================================================================
+ */
+
+typedef struct fragment_rx *fragment_rx_t;
+
+/**
+ * @brief 创建重组器
+ * @param max_transfers 同时进行的传输数 (不同来源)
+ */
+fragment_rx_t fragment_rx_create(uint8_t max_transfers);
+
+void fragment_rx_destroy(fragment_rx_t rx);
+
+/**
+ * @brief 接收一个分片
+ * @param rx 重组器
+ * @param frame FRAGMENT 帧
+ * @param now_ms 当前时间
+ * @param kind 输出数据块类型
+ * @param block 输出完整数据块 (有效至下次调用)
+ * @param elapsed_ms 输出首个分片到达至今的毫秒数
+ * @return 收齐时返回数据块长度，未收齐返回 0，失败返回负数
+ */
+int fragment_rx_push(fragment_rx_t rx, const xslot_frame_t *frame,
+                     uint32_t now_ms, uint8_t *kind, const uint8_t **block,
+                     uint32_t *elapsed_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAGMENT_H */
@@ -0,0 +1,252 @@
+/**
+ * @file history_store.cpp
+ * @brief 边缘节点断线缓存实现
+ */
+#include "history_store.h"
+#include "report_queue.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define HISTORY_MAGIC 0x31465358 /* "XSF1" */
+
+/* 记录合并窗口的对象数 */
+#define CONFLATE_TABLE_SIZE 128
+
+struct file_header {
+  uint32_t magic;
+  uint32_t capacity;
+  uint32_t head; /* 最旧记录所在槽位 */
+  uint32_t count;
+};
+
+/* 对象最近一条记录 (绝对序号)，用于合并 */
+struct conflate_entry {
+  uint32_t key;
+  uint8_t flags;
+  uint64_t index;
+  uint64_t window_start;
+};
+
+struct history_store {
+  FILE *file;                /* NULL 表示仅内存 */
+  history_record_t *records; /* 仅内存模式 */
+  uint32_t capacity;
+  uint32_t count;
+  uint64_t head;     /* 最旧记录的绝对序号，槽位 = head % capacity */
+  uint32_t reserved; /* peek 取出、尚未 consume 的记录数 */
+  uint32_t conflate_ms;
+
+  conflate_entry table[CONFLATE_TABLE_SIZE];
+  uint8_t table_count;
+};
+
+static inline uint32_t object_key(const xslot_bacnet_object_t *obj) {
+  return ((uint32_t)obj->object_type << 16) | obj->object_id;
+}
+
+static long record_offset(uint32_t slot) {
+  return (long)(sizeof(file_header) + (size_t)slot * sizeof(history_record_t));
+}
+
+static void write_header(history_store_t store) {
+  if (!store->file)
+    return;
+
+  file_header hdr = {HISTORY_MAGIC, store->capacity,
+                     (uint32_t)(store->head % store->capacity), store->count};
+  std::fseek(store->file, 0, SEEK_SET);
+  std::fwrite(&hdr, sizeof(hdr), 1, store->file);
+  std::fflush(store->file);
+}
+
+static void write_record(history_store_t store, uint64_t index,
+                         const history_record_t *rec) {
+  uint32_t slot = (uint32_t)(index % store->capacity);
+  if (!store->file) {
+    store->records[slot] = *rec;
+    return;
+  }
+  std::fseek(store->file, record_offset(slot), SEEK_SET);
+  std::fwrite(rec, sizeof(*rec), 1, store->file);
+}
+
+static bool read_record(history_store_t store, uint64_t index,
+                        history_record_t *rec) {
+  uint32_t slot = (uint32_t)(index % store->capacity);
+  if (!store->file) {
+    *rec = store->records[slot];
+    return true;
+  }
+  std::fseek(store->file, record_offset(slot), SEEK_SET);
+  return std::fread(rec, sizeof(*rec), 1, store->file) == 1;
+}
+
+history_store_t history_store_open(const char *path, uint32_t capacity,
+                                   uint32_t conflate_ms) {
+  if (capacity == 0)
+    return nullptr;
+
+  history_store_t store =
+      (history_store_t)std::calloc(1, sizeof(struct history_store));
+  if (!store)
+    return nullptr;
+
+  store->capacity = capacity;
+  store->conflate_ms = conflate_ms;
+
+  if (!path) {
+    store->records =
+        (history_record_t *)std::calloc(capacity, sizeof(history_record_t));
+    if (!store->records) {
+      std::free(store);
+      return nullptr;
+    }
+    return store;
+  }
+
+  store->file = std::fopen(path, "r+b");
+  if (store->file) {
+    file_header hdr;
+    if (std::fread(&hdr, sizeof(hdr), 1, store->file) == 1 &&
+        hdr.magic == HISTORY_MAGIC && hdr.capacity == capacity &&
+        hdr.head < capacity && hdr.count <= capacity) {
+      /* 恢复上次未发送的记录 */
+      store->head = hdr.head;
+      store->count = hdr.count;
+      return store;
+    }
+    std::fclose(store->file);
+  }
+
+  store->file = std::fopen(path, "w+b");
+  if (!store->file) {
+    std::free(store);
+    return nullptr;
+  }
+  write_header(store);
+  return store;
+}
+
+void history_store_close(history_store_t store) {
+  if (!store)
+    return;
+
+  if (store->file) {
+    write_header(store);
+    std::fclose(store->file);
+  }
+  std::free(store->records);
+  std::free(store);
+}
+
+/**
+ * @brief 查找对象的合并条目 (不存在时分配，表满返回 NULL)
+ */
+static conflate_entry *conflate_lookup(history_store_t store, uint32_t key) {
+  conflate_entry *stale = nullptr;
+  for (uint8_t i = 0; i < store->table_count; i++) {
+    conflate_entry *e = &store->table[i];
+    if (e->key == key)
+      return e;
+    if (!stale && e->index < store->head)
+      stale = e;
+  }
+
+  if (store->table_count < CONFLATE_TABLE_SIZE)
+    stale = &store->table[store->table_count++];
+  if (stale) {
+    stale->key = key;
+    stale->index = UINT64_MAX;
+  }
+  return stale;
+}
+
+int history_store_append(history_store_t store,
+                         const xslot_bacnet_object_t *objects, uint8_t count,
+                         uint64_t time_ms) {
+  if (!store || !objects)
+    return 0;
+
+  int overwritten = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    history_record_t rec;
+    rec.time_ms = time_ms;
+    rec.object = objects[i];
+
+    conflate_entry *e =
+        store->conflate_ms ? conflate_lookup(store, object_key(&objects[i]))
+                           : nullptr;
+
+    /* 窗口内且状态未变: 覆盖该对象未发送的记录 */
+    if (e && e->index != UINT64_MAX &&
+        e->index >= store->head + store->reserved &&
+        e->index < store->head + store->count &&
+        time_ms - e->window_start < store->conflate_ms &&
+        ((e->flags ^ objects[i].flags) & REPORT_STATUS_MASK) == 0) {
+      write_record(store, e->index, &rec);
+      e->flags = objects[i].flags;
+      continue;
+    }
+
+    if (store->count == store->capacity) {
+      /* 覆盖最旧记录；若它已被 peek，发送成功后少删一条 */
+      store->head++;
+      store->count--;
+      if (store->reserved > 0)
+        store->reserved--;
+      overwritten++;
+    }
+
+    uint64_t index = store->head + store->count;
+    write_record(store, index, &rec);
+    store->count++;
+
+    if (e) {
+      e->index = index;
+      e->flags = objects[i].flags;
+      e->window_start = time_ms;
+    }
+  }
+
+  write_header(store);
+  return overwritten;
+}
+
+int history_store_peek(history_store_t store, history_record_t *out,
+                       uint16_t max_count) {
+  if (!store || !out)
+    return 0;
+
+  uint16_t n = store->count < max_count ? (uint16_t)store->count : max_count;
+  for (uint16_t i = 0; i < n; i++) {
+    if (!read_record(store, store->head + i, &out[i])) {
+      n = i;
+      break;
+    }
+  }
+
+  store->reserved = n;
+  return n;
+}
+
+void history_store_consume(history_store_t store, uint16_t count) {
+  if (!store)
+    return;
+
+  /* peek 之后被覆盖的记录已经出队 */
+  uint32_t n = count < store->reserved ? count : store->reserved;
+  store->head += n;
+  store->count -= n;
+  store->reserved = 0;
+  write_header(store);
+}
+
+void history_store_release(history_store_t store) {
+  if (store)
+    store->reserved = 0;
+}
+
+uint32_t history_store_count(history_store_t store) {
+  return store ? store->count : 0;
+}
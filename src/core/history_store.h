@@ -0,0 +1,82 @@
+/**
+ * @file history_store.h
+ * @brief 边缘节点断线缓存 (追加写环形记录)
+ *
+ * 汇聚节点不可达时，上报对象连同采样时间写入环形缓存，恢复后按先后顺序
+ * 取出补发。可选文件持久化，重启后继续补发未发送的记录。
+ *
+ * 文件布局: [头 16B][记录 * capacity]，记录按环形追加，满后覆盖最旧记录。
+ * 同一对象在合并窗口内的后续样本覆盖窗口内的记录 (状态标志变化除外)，
+ * 以窗口粒度保留趋势而不是保留每个 COV。
+ */
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 缓存记录
+ */
+typedef struct {
+  uint64_t time_ms; /**< 采样时间 (UTC 毫秒，无 RTC 时为开机毫秒) */
+  xslot_bacnet_object_t object;
+} history_record_t;
+
+typedef struct history_store *history_store_t;
+
+/**
+ * @brief 打开缓存
+ * @param path 文件路径，NULL 表示仅内存
+ * @param capacity 最大记录数
+ * @param conflate_ms 合并窗口 (0=不合并)
+ * @return 句柄，失败返回 NULL
+ *
+ * 文件已存在且容量一致时恢复其中未发送的记录，否则重新初始化。
+ */
+history_store_t history_store_open(const char *path, uint32_t capacity,
+                                   uint32_t conflate_ms);
+
+void history_store_close(history_store_t store);
+
+/**
+ * @brief 追加记录
+ * @return 因缓存已满被覆盖的旧记录数
+ */
+int history_store_append(history_store_t store,
+                         const xslot_bacnet_object_t *objects, uint8_t count,
+                         uint64_t time_ms);
+
+/**
+ * @brief 取出最旧的记录 (不删除)
+ * @return 实际数量
+ *
+ * 取出的记录在 consume 或 release 之前不参与合并，避免发送中的记录被改写。
+ */
+int history_store_peek(history_store_t store, history_record_t *out,
+                       uint16_t max_count);
+
+/**
+ * @brief 删除最旧的记录 (发送成功后调用)
+ */
+void history_store_consume(history_store_t store, uint16_t count);
+
+/**
+ * @brief 放弃 peek (发送失败，记录保留)
+ */
+void history_store_release(history_store_t store);
+
+/**
+ * @brief 待发送记录数
+ */
+uint32_t history_store_count(history_store_t store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HISTORY_STORE_H */
@@ -4,12 +4,24 @@
  */
 #include "message_codec.h"
 #include "../bacnet/bacnet_incremental.h"
+#include "../bacnet/bacnet_property.h"
 #include "../bacnet/bacnet_serializer.h"
 #include <cstring>
 #include <xslot/xslot_error.h>
 
+static void put_u32(uint8_t *p, uint32_t v) {
+  p[0] = v & 0xFF;
+  p[1] = (v >> 8) & 0xFF;
+  p[2] = (v >> 16) & 0xFF;
+  p[3] = (v >> 24) & 0xFF;
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
 int message_build_ping(xslot_frame_t *frame, uint16_t from, uint16_t to,
-                       uint8_t seq) {
+                       uint8_t seq, uint32_t time_ms) {
   if (!frame)
     return XSLOT_ERR_PARAM;
 
@@ -18,13 +30,15 @@ int message_build_ping(xslot_frame_t *frame, uint16_t from, uint16_t to,
   frame->to = to;
   frame->seq = seq;
   frame->cmd = XSLOT_CMD_PING;
-  frame->len = 0;
+  put_u32(frame->data, time_ms);
+  frame->len = 4;
 
   return XSLOT_OK;
 }
 
 int message_build_pong(xslot_frame_t *frame, uint16_t from, uint16_t to,
-                       uint8_t seq) {
+                       uint8_t seq, const xslot_frame_t *ping,
+                       uint32_t time_ms) {
   if (!frame)
     return XSLOT_ERR_PARAM;
 
@@ -35,6 +49,23 @@ int message_build_pong(xslot_frame_t *frame, uint16_t from, uint16_t to,
   frame->cmd = XSLOT_CMD_PONG;
   frame->len = 0;
 
+  if (ping && ping->len >= 4) {
+    std::memcpy(frame->data, ping->data, 4);
+    put_u32(frame->data + 4, time_ms);
+    frame->len = 8;
+  }
+
+  return XSLOT_OK;
+}
+
+int message_parse_pong(const xslot_frame_t *frame, uint32_t *ping_ms,
+                       uint32_t *peer_ms) {
+  if (!frame || !ping_ms || !peer_ms || frame->cmd != XSLOT_CMD_PONG ||
+      frame->len < 8)
+    return XSLOT_ERR_PARAM;
+
+  *ping_ms = get_u32(frame->data);
+  *peer_ms = get_u32(frame->data + 4);
   return XSLOT_OK;
 }
 
@@ -68,6 +99,35 @@ int message_build_report(xslot_frame_t *frame, uint16_t from, uint16_t to,
   return XSLOT_OK;
 }
 
+int message_report_add_times(xslot_frame_t *frame, const uint32_t *times) {
+  if (!frame || !times || frame->cmd != XSLOT_CMD_REPORT || frame->len < 1 ||
+      (frame->data[0] & MESSAGE_REPORT_TIMED))
+    return XSLOT_ERR_PARAM;
+
+  uint8_t count = frame->data[0];
+  if (frame->len + MESSAGE_REPORT_TIME_SIZE(count) > XSLOT_MAX_DATA_LEN)
+    return XSLOT_ERR_NO_MEM;
+
+  /* 以最早的采样时间为基准 (回绕安全的比较) */
+  uint32_t base = times[0];
+  for (uint8_t i = 1; i < count; i++) {
+    if ((int32_t)(times[i] - base) < 0)
+      base = times[i];
+  }
+
+  uint8_t *p = frame->data + frame->len;
+  put_u32(p, base);
+  p += 4;
+  for (uint8_t i = 0; i < count; i++) {
+    uint32_t ticks = (times[i] - base) / MESSAGE_REPORT_TICK_MS;
+    *p++ = ticks > 255 ? 255 : (uint8_t)ticks;
+  }
+
+  frame->data[0] |= MESSAGE_REPORT_TIMED;
+  frame->len += MESSAGE_REPORT_TIME_SIZE(count);
+  return XSLOT_OK;
+}
+
 int message_build_query(xslot_frame_t *frame, uint16_t from, uint16_t to,
                         uint8_t seq, const uint16_t *object_ids,
                         uint8_t count) {
@@ -122,6 +182,119 @@ int message_build_response(xslot_frame_t *frame, uint16_t from, uint16_t to,
   return XSLOT_OK;
 }
 
+int message_build_query_prop(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                             uint8_t seq, uint8_t mask,
+                             const xslot_object_ref_t *refs, uint8_t count) {
+  if (!frame || !refs || count == 0) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  // 检查长度 (MASK + COUNT + 每对象 3 字节)
+  if (2 + count * 3 > XSLOT_MAX_DATA_LEN) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot_frame_init(frame);
+  frame->from = from;
+  frame->to = to;
+  frame->seq = seq;
+  frame->cmd = XSLOT_CMD_QUERY_PROP;
+
+  uint8_t *p = frame->data;
+  *p++ = mask;
+  *p++ = count;
+  for (uint8_t i = 0; i < count; i++) {
+    *p++ = refs[i].object_id & 0xFF;
+    *p++ = (refs[i].object_id >> 8) & 0xFF;
+    *p++ = refs[i].object_type;
+  }
+
+  frame->len = (uint8_t)(p - frame->data);
+  return XSLOT_OK;
+}
+
+int message_build_subscribe(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                            uint8_t seq, uint8_t window,
+                            const xslot_object_ref_t *refs, uint8_t count) {
+  if (!frame || (!refs && count > 0)) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  // 检查长度 (WINDOW + COUNT + 每对象 3 字节)
+  if (2 + count * 3 > XSLOT_MAX_DATA_LEN) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot_frame_init(frame);
+  frame->from = from;
+  frame->to = to;
+  frame->seq = seq;
+  frame->cmd = XSLOT_CMD_SUBSCRIBE;
+
+  uint8_t *p = frame->data;
+  *p++ = window;
+  *p++ = count;
+  for (uint8_t i = 0; i < count; i++) {
+    *p++ = refs[i].object_id & 0xFF;
+    *p++ = (refs[i].object_id >> 8) & 0xFF;
+    *p++ = refs[i].object_type;
+  }
+
+  frame->len = (uint8_t)(p - frame->data);
+  return XSLOT_OK;
+}
+
+int message_build_credit(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                         uint8_t seq, uint8_t received, uint8_t window) {
+  if (!frame) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot_frame_init(frame);
+  frame->from = from;
+  frame->to = to;
+  frame->seq = seq;
+  frame->cmd = XSLOT_CMD_CREDIT;
+  frame->data[0] = received;
+  frame->data[1] = window;
+  frame->len = 2;
+
+  return XSLOT_OK;
+}
+
+int message_build_prop_response(xslot_frame_t *frame, uint16_t from,
+                                uint16_t to, uint8_t seq,
+                                const xslot_property_set_t *props,
+                                uint8_t count) {
+  if (!frame || !props || count == 0) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot_frame_init(frame);
+  frame->from = from;
+  frame->to = to;
+  frame->seq = seq;
+  frame->cmd = XSLOT_CMD_PROP_RESPONSE;
+
+  uint8_t pos = 1;
+  uint8_t fit = 0;
+  while (fit < count) {
+    int len = bacnet_property_encode(&props[fit], frame->data + pos,
+                                     XSLOT_MAX_DATA_LEN - pos);
+    if (len < 0)
+      break;
+    pos += (uint8_t)len;
+    fit++;
+  }
+  if (fit == 0) {
+    return XSLOT_ERR_NO_MEM;
+  }
+
+  frame->data[0] = fit;
+  frame->len = pos;
+  return fit;
+}
+
 int message_build_write(xslot_frame_t *frame, uint16_t from, uint16_t to,
                         uint8_t seq, const xslot_bacnet_object_t *obj) {
   if (!frame || !obj) {
@@ -144,6 +317,45 @@ int message_build_write(xslot_frame_t *frame, uint16_t from, uint16_t to,
   return XSLOT_OK;
 }
 
+int message_build_write_multi(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                              uint8_t seq,
+                              const xslot_bacnet_object_t *objects,
+                              uint8_t count) {
+  if (!frame || !objects || count == 0) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  // 计算帧内可容纳的对象数
+  uint8_t fit = 0;
+  uint16_t size = 1;
+  while (fit < count) {
+    uint8_t obj_size = bacnet_object_serialized_size(&objects[fit]);
+    if (size + obj_size > XSLOT_MAX_DATA_LEN)
+      break;
+    size += obj_size;
+    fit++;
+  }
+  if (fit == 0) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot_frame_init(frame);
+  frame->from = from;
+  frame->to = to;
+  frame->seq = seq;
+  frame->cmd = XSLOT_CMD_WRITE_MULTI;
+
+  // WRITE_MULTI 使用完整格式 (与 RESPONSE 相同)
+  int len =
+      bacnet_serialize_objects(objects, fit, frame->data, XSLOT_MAX_DATA_LEN);
+  if (len < 0) {
+    return len;
+  }
+
+  frame->len = (uint8_t)len;
+  return fit;
+}
+
 int message_build_write_ack(xslot_frame_t *frame, uint16_t from, uint16_t to,
                             uint8_t seq, uint8_t result) {
   if (!frame)
@@ -161,7 +373,8 @@ int message_build_write_ack(xslot_frame_t *frame, uint16_t from, uint16_t to,
 }
 
 int message_parse_report(const xslot_frame_t *frame,
-                         xslot_bacnet_object_t *objects, uint8_t max_count) {
+                         xslot_bacnet_object_t *objects, uint8_t max_count,
+                         uint8_t *format) {
   if (!frame || !objects || frame->cmd != XSLOT_CMD_REPORT) {
     return XSLOT_ERR_PARAM;
   }
@@ -170,20 +383,61 @@ int message_parse_report(const xslot_frame_t *frame,
     return XSLOT_ERR_PARAM;
   }
 
+  // 带采样时间: 去掉 COUNT 的标志位和末尾的时间块后按原格式解析
+  const uint8_t *data = frame->data;
+  uint16_t len = frame->len;
+  uint8_t plain[XSLOT_MAX_DATA_LEN];
+  if (data[0] & MESSAGE_REPORT_TIMED) {
+    uint8_t count = data[0] & ~MESSAGE_REPORT_TIMED;
+    if (len < 1 + MESSAGE_REPORT_TIME_SIZE(count))
+      return XSLOT_ERR_PARAM;
+    len -= MESSAGE_REPORT_TIME_SIZE(count);
+    std::memcpy(plain, data, len);
+    plain[0] = count;
+    data = plain;
+  }
+
   // 检查是否为增量格式 (通过第三个字节的 bit7)
   // 格式: [COUNT][OBJ_ID_L][OBJ_ID_H][TYPE_HINT/OBJ_TYPE]...
-  if (frame->len >= 4) {
-    uint8_t type_byte = frame->data[3]; // 第一个对象的类型字节
+  if (len >= 4) {
+    uint8_t type_byte = data[3]; // 第一个对象的类型字节
     if (type_byte & 0x80) {
       // 增量格式
-      return bacnet_incremental_deserialize_batch(frame->data, frame->len,
-                                                  objects, max_count);
+      bool typed = false;
+      int count = bacnet_incremental_deserialize_batch(data, len, objects,
+                                                       max_count, &typed);
+      if (format) {
+        *format = typed ? MESSAGE_REPORT_INCREMENTAL : MESSAGE_REPORT_UNTYPED;
+      }
+      return count;
     }
   }
 
   // 完整格式
-  return bacnet_deserialize_objects(frame->data, frame->len, objects,
-                                    max_count);
+  if (format) {
+    *format = MESSAGE_REPORT_FULL;
+  }
+  return bacnet_deserialize_objects(data, len, objects, max_count);
+}
+
+int message_parse_report_times(const xslot_frame_t *frame, uint32_t *times,
+                               uint8_t max_count) {
+  if (!frame || !times || frame->cmd != XSLOT_CMD_REPORT || frame->len < 1 ||
+      !(frame->data[0] & MESSAGE_REPORT_TIMED))
+    return 0;
+
+  uint8_t count = frame->data[0] & ~MESSAGE_REPORT_TIMED;
+  if (frame->len < 1 + MESSAGE_REPORT_TIME_SIZE(count))
+    return 0;
+
+  const uint8_t *p = frame->data + frame->len - MESSAGE_REPORT_TIME_SIZE(count);
+  uint32_t base = get_u32(p);
+  p += 4;
+  uint8_t n = count < max_count ? count : max_count;
+  for (uint8_t i = 0; i < n; i++) {
+    times[i] = base + (uint32_t)p[i] * MESSAGE_REPORT_TICK_MS;
+  }
+  return n;
 }
 
 int message_parse_query(const xslot_frame_t *frame, uint16_t *object_ids,
@@ -216,6 +470,112 @@ int message_parse_query(const xslot_frame_t *frame, uint16_t *object_ids,
   return count;
 }
 
+int message_parse_query_prop(const xslot_frame_t *frame, uint8_t *mask,
+                             xslot_object_ref_t *refs, uint8_t max_count) {
+  if (!frame || !mask || !refs || frame->cmd != XSLOT_CMD_QUERY_PROP) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  if (frame->len < 2) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  const uint8_t *p = frame->data;
+  *mask = *p++;
+  uint8_t count = *p++;
+
+  if (count > max_count) {
+    count = max_count;
+  }
+
+  // 检查长度
+  if (frame->len < 2 + count * 3) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    refs[i].object_id = p[0] | (p[1] << 8);
+    refs[i].object_type = p[2];
+    p += 3;
+  }
+
+  return count;
+}
+
+int message_parse_subscribe(const xslot_frame_t *frame, uint8_t *window,
+                            xslot_object_ref_t *refs, uint8_t max_count) {
+  if (!frame || !window || (!refs && max_count > 0) ||
+      frame->cmd != XSLOT_CMD_SUBSCRIBE) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  if (frame->len < 2) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  const uint8_t *p = frame->data;
+  *window = *p++;
+  uint8_t count = *p++;
+
+  if (count > max_count) {
+    count = max_count;
+  }
+
+  // 检查长度
+  if (frame->len < 2 + count * 3) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    refs[i].object_id = p[0] | (p[1] << 8);
+    refs[i].object_type = p[2];
+    p += 3;
+  }
+
+  return count;
+}
+
+int message_parse_credit(const xslot_frame_t *frame, uint8_t *received,
+                         uint8_t *window) {
+  if (!frame || !received || !window || frame->cmd != XSLOT_CMD_CREDIT ||
+      frame->len < 2) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  *received = frame->data[0];
+  *window = frame->data[1];
+  return XSLOT_OK;
+}
+
+int message_parse_prop_response(const xslot_frame_t *frame,
+                                xslot_property_set_t *props,
+                                uint8_t max_count) {
+  if (!frame || !props || frame->cmd != XSLOT_CMD_PROP_RESPONSE) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  if (frame->len < 1) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  uint8_t count = frame->data[0];
+  if (count > max_count) {
+    count = max_count;
+  }
+
+  uint8_t pos = 1;
+  for (uint8_t i = 0; i < count; i++) {
+    int len = bacnet_property_decode(frame->data + pos, frame->len - pos,
+                                     &props[i]);
+    if (len < 0) {
+      return len;
+    }
+    pos += (uint8_t)len;
+  }
+
+  return count;
+}
+
 int message_parse_write(const xslot_frame_t *frame,
                         xslot_bacnet_object_t *obj) {
   if (!frame || !obj || frame->cmd != XSLOT_CMD_WRITE) {
@@ -224,3 +584,199 @@ int message_parse_write(const xslot_frame_t *frame,
 
   return bacnet_deserialize_object(frame->data, frame->len, obj);
 }
+
+int message_parse_write_multi(const xslot_frame_t *frame,
+                              xslot_bacnet_object_t *objects,
+                              uint8_t max_count) {
+  if (!frame || !objects || frame->cmd != XSLOT_CMD_WRITE_MULTI) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  return bacnet_deserialize_objects(frame->data, frame->len, objects,
+                                    max_count);
+}
+
+int message_build_fragment(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                           uint8_t seq, const message_fragment_t *hdr,
+                           const uint8_t *chunk, uint8_t len) {
+  if (!frame || !hdr || !chunk || len > MESSAGE_FRAGMENT_CHUNK) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot_frame_init(frame);
+  frame->from = from;
+  frame->to = to;
+  frame->seq = seq;
+  frame->cmd = XSLOT_CMD_FRAGMENT;
+
+  uint8_t *p = frame->data;
+  *p++ = hdr->xfer;
+  *p++ = hdr->index;
+  *p++ = hdr->total;
+  *p++ = hdr->kind;
+  std::memcpy(p, chunk, len);
+
+  frame->len = MESSAGE_FRAGMENT_HEADER + len;
+  return XSLOT_OK;
+}
+
+int message_parse_fragment(const xslot_frame_t *frame, message_fragment_t *hdr,
+                           const uint8_t **chunk) {
+  if (!frame || !hdr || !chunk || frame->cmd != XSLOT_CMD_FRAGMENT) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  if (frame->len < MESSAGE_FRAGMENT_HEADER) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  hdr->xfer = frame->data[0];
+  hdr->index = frame->data[1];
+  hdr->total = frame->data[2];
+  hdr->kind = frame->data[3];
+  if (hdr->total == 0 || hdr->index >= hdr->total) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  *chunk = frame->data + MESSAGE_FRAGMENT_HEADER;
+  return frame->len - MESSAGE_FRAGMENT_HEADER;
+}
+
+int message_encode_history(const xslot_history_sample_t *samples,
+                           uint16_t count, uint8_t *buffer,
+                           uint16_t buffer_size) {
+  if (!samples || !buffer || buffer_size < 2) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  uint16_t pos = 2;
+  for (uint16_t i = 0; i < count; i++) {
+    if (pos + 4 > buffer_size) {
+      return XSLOT_ERR_NO_MEM;
+    }
+    uint32_t age = samples[i].age_ms;
+    buffer[pos++] = age & 0xFF;
+    buffer[pos++] = (age >> 8) & 0xFF;
+    buffer[pos++] = (age >> 16) & 0xFF;
+    buffer[pos++] = (age >> 24) & 0xFF;
+
+    uint16_t room = buffer_size - pos;
+    int len = bacnet_serialize_object(&samples[i].object, buffer + pos,
+                                      room > 255 ? 255 : (uint8_t)room);
+    if (len < 0) {
+      return len;
+    }
+    pos += len;
+  }
+
+  buffer[0] = count & 0xFF;
+  buffer[1] = (count >> 8) & 0xFF;
+  return pos;
+}
+
+int message_decode_history(const uint8_t *buffer, uint16_t len,
+                           uint16_t *offset, xslot_history_sample_t *samples,
+                           uint16_t max_count) {
+  if (!buffer || !offset || !samples || len < 2) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  // 首次调用跳过 COUNT，之后按位置续解直到块尾
+  if (*offset == 0) {
+    *offset = 2;
+  }
+
+  uint16_t n = 0;
+  while (n < max_count && *offset < len) {
+    uint16_t pos = *offset;
+    if (pos + 4 > len) {
+      return XSLOT_ERR_PARAM;
+    }
+    samples[n].age_ms = buffer[pos] | (buffer[pos + 1] << 8) |
+                        (buffer[pos + 2] << 16) |
+                        ((uint32_t)buffer[pos + 3] << 24);
+    pos += 4;
+
+    uint16_t room = len - pos;
+    int used = bacnet_deserialize_object(buffer + pos,
+                                         room > 255 ? 255 : (uint8_t)room,
+                                         &samples[n].object);
+    if (used <= 0) {
+      return XSLOT_ERR_PARAM;
+    }
+    *offset = pos + used;
+    n++;
+  }
+
+  return n;
+}
+
+int message_mux_begin(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                      uint8_t seq) {
+  if (!frame)
+    return XSLOT_ERR_PARAM;
+
+  xslot_frame_init(frame);
+  frame->from = from;
+  frame->to = to;
+  frame->seq = seq;
+  frame->cmd = XSLOT_CMD_MUX;
+  frame->len = 0;
+
+  return XSLOT_OK;
+}
+
+int message_mux_append(xslot_frame_t *frame, uint8_t sub, uint8_t cmd,
+                       const uint8_t *body, uint8_t len) {
+  if (!frame || (!body && len > 0) || frame->cmd != XSLOT_CMD_MUX) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  if (frame->len + MESSAGE_MUX_SEGMENT_HEADER + len > XSLOT_MAX_DATA_LEN) {
+    return XSLOT_ERR_NO_MEM;
+  }
+
+  uint8_t *p = frame->data + frame->len;
+  *p++ = sub;
+  *p++ = cmd;
+  *p++ = len;
+  if (len > 0) {
+    std::memcpy(p, body, len);
+  }
+
+  frame->len += MESSAGE_MUX_SEGMENT_HEADER + len;
+  return XSLOT_OK;
+}
+
+int message_mux_next(const xslot_frame_t *frame, uint8_t *pos, uint8_t *sub,
+                     xslot_frame_t *inner) {
+  if (!frame || !pos || !sub || !inner || frame->cmd != XSLOT_CMD_MUX) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  if (*pos >= frame->len) {
+    return 0;
+  }
+
+  if (*pos + MESSAGE_MUX_SEGMENT_HEADER > frame->len) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  const uint8_t *p = frame->data + *pos;
+  uint8_t len = p[2];
+  if (*pos + MESSAGE_MUX_SEGMENT_HEADER + len > frame->len) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  xslot_frame_init(inner);
+  inner->from = frame->from;
+  inner->to = frame->to;
+  inner->seq = frame->seq;
+  inner->cmd = p[1];
+  inner->len = len;
+  std::memcpy(inner->data, p + MESSAGE_MUX_SEGMENT_HEADER, len);
+
+  *sub = p[0];
+  *pos += MESSAGE_MUX_SEGMENT_HEADER + len;
+  return 1;
+}
@@ -14,15 +14,46 @@ extern "C" {
 
 /**
  * @brief 构建 PING 帧
+ * @param time_ms 发送方时钟 (ms)
+ *
+ * 载荷: [TIME:4]，旧版本的 PING 载荷为空。
  */
 int message_build_ping(xslot_frame_t *frame, uint16_t from, uint16_t to,
-                       uint8_t seq);
+                       uint8_t seq, uint32_t time_ms);
 
 /**
  * @brief 构建 PONG 帧
+ * @param ping 对应的 PING (带时间时回送对时信息，可为 NULL)
+ * @param time_ms 应答方时钟 (ms)
+ *
+ * 载荷: [PING_TIME:4][TIME:4]，PING 不带时间时载荷为空。
  */
 int message_build_pong(xslot_frame_t *frame, uint16_t from, uint16_t to,
-                       uint8_t seq);
+                       uint8_t seq, const xslot_frame_t *ping,
+                       uint32_t time_ms);
+
+/**
+ * @brief 解析 PONG 的对时信息
+ * @param ping_ms 输出 PING 发送时的本地时钟
+ * @param peer_ms 输出对端收到 PING 时的对端时钟
+ * @return XSLOT_OK，不带时间的 PONG 返回 XSLOT_ERR_PARAM
+ */
+int message_parse_pong(const xslot_frame_t *frame, uint32_t *ping_ms,
+                       uint32_t *peer_ms);
+
+/* REPORT 采样时间 (可选)
+ *
+ * COUNT 的 bit7 置位时载荷末尾附加 [BASE:4][DELTA:1]*COUNT。BASE 为本帧最早
+ * 的采样时间 (接收方时钟，ms)，DELTA 以 10 ms 为单位 (超过 2.55 s 取 255)。
+ */
+#define MESSAGE_REPORT_TIMED 0x80
+#define MESSAGE_REPORT_TICK_MS 10
+#define MESSAGE_REPORT_TIME_SIZE(count) (4 + (count))
+
+/* REPORT 载荷格式 (message_parse_report 输出) */
+#define MESSAGE_REPORT_FULL 0        /**< 完整格式，携带类型和状态标志 */
+#define MESSAGE_REPORT_INCREMENTAL 1 /**< 增量格式，携带类型，不携带状态标志 */
+#define MESSAGE_REPORT_UNTYPED 2     /**< 旧版增量格式，类型由值类型推断 */
 
 /**
  * @brief 构建 REPORT 帧 (数据上报)
@@ -39,6 +70,13 @@ int message_build_report(xslot_frame_t *frame, uint16_t from, uint16_t to,
                          uint8_t seq, const xslot_bacnet_object_t *objects,
                          uint8_t count, bool incremental);
 
+/**
+ * @brief 为 REPORT 帧附加采样时间
+ * @param times 各对象的采样时间 (接收方时钟，ms)
+ * @return 错误码，帧已满返回 XSLOT_ERR_NO_MEM
+ */
+int message_report_add_times(xslot_frame_t *frame, const uint32_t *times);
+
 /**
  * @brief 构建 QUERY 帧 (数据查询)
  */
@@ -52,12 +90,65 @@ int message_build_response(xslot_frame_t *frame, uint16_t from, uint16_t to,
                            uint8_t seq, const xslot_bacnet_object_t *objects,
                            uint8_t count);
 
+/**
+ * @brief 构建 QUERY_PROP 帧 (属性选择查询)
+ *
+ * 载荷: [MASK:1][COUNT:1]([OBJ_ID:2][OBJ_TYPE:1])*COUNT
+ */
+int message_build_query_prop(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                             uint8_t seq, uint8_t mask,
+                             const xslot_object_ref_t *refs, uint8_t count);
+
+/**
+ * @brief 构建 SUBSCRIBE 帧 (流式推送订阅)
+ * @param window 允许未确认的推送帧数，0 表示取消订阅
+ * @param refs 订阅的对象，count=0 表示全部对象 (可为 NULL)
+ *
+ * 载荷: [WINDOW:1][COUNT:1]([OBJ_ID:2][OBJ_TYPE:1])*COUNT
+ */
+int message_build_subscribe(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                            uint8_t seq, uint8_t window,
+                            const xslot_object_ref_t *refs, uint8_t count);
+
+/**
+ * @brief 构建 CREDIT 帧 (流式推送信用)
+ * @param received 订阅以来收到的推送帧数 (模 256)
+ * @param window 当前窗口，0 表示发送方没有该订阅 (DDC→HMI)
+ *
+ * 载荷: [RECEIVED:1][WINDOW:1]。累计计数使 CREDIT 可重复发送，丢失一帧
+ * 不影响后续的信用。
+ */
+int message_build_credit(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                         uint8_t seq, uint8_t received, uint8_t window);
+
+/**
+ * @brief 构建 PROP_RESPONSE 帧
+ * @return 装入帧的属性集数，失败返回负数
+ *
+ * 载荷: [COUNT:1][属性集 TLV]*COUNT，装不下的由调用方另行发送。
+ */
+int message_build_prop_response(xslot_frame_t *frame, uint16_t from,
+                                uint16_t to, uint8_t seq,
+                                const xslot_property_set_t *props,
+                                uint8_t count);
+
 /**
  * @brief 构建 WRITE 帧 (远程写入)
  */
 int message_build_write(xslot_frame_t *frame, uint16_t from, uint16_t to,
                         uint8_t seq, const xslot_bacnet_object_t *obj);
 
+/**
+ * @brief 构建 WRITE_MULTI 帧 (批量写入)
+ * @return 装入帧的对象数，失败返回负数
+ *
+ * 载荷为完整格式 [COUNT][OBJ]...，超出帧容量的对象需由调用方另行发送。
+ */
+int message_build_write_multi(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                              uint8_t seq,
+                              const xslot_bacnet_object_t *objects,
+                              uint8_t count);
+
 /**
  * @brief 构建 WRITE_ACK 帧 (写入确认)
  */
@@ -65,10 +156,21 @@ int message_build_write_ack(xslot_frame_t *frame, uint16_t from, uint16_t to,
                             uint8_t seq, uint8_t result);
 
 /**
- * @brief 解析 REPORT 帧载荷
+ * @brief 解析 REPORT 帧载荷 (忽略采样时间)
+ * @param format 输出载荷格式 MESSAGE_REPORT_* (可为 NULL)
+ *
+ * 增量格式不携带状态标志，对象的 flags 为 0，不代表状态已恢复正常。
  */
 int message_parse_report(const xslot_frame_t *frame,
-                         xslot_bacnet_object_t *objects, uint8_t max_count);
+                         xslot_bacnet_object_t *objects, uint8_t max_count,
+                         uint8_t *format);
+
+/**
+ * @brief 解析 REPORT 帧的采样时间
+ * @return 时间个数 (与对象一一对应)，未携带时间返回 0
+ */
+int message_parse_report_times(const xslot_frame_t *frame, uint32_t *times,
+                               uint8_t max_count);
 
 /**
  * @brief 解析 QUERY 帧载荷
@@ -76,11 +178,135 @@ int message_parse_report(const xslot_frame_t *frame,
 int message_parse_query(const xslot_frame_t *frame, uint16_t *object_ids,
                         uint8_t max_count);
 
+/**
+ * @brief 解析 QUERY_PROP 帧载荷
+ * @return 对象数量，失败返回负数
+ */
+int message_parse_query_prop(const xslot_frame_t *frame, uint8_t *mask,
+                             xslot_object_ref_t *refs, uint8_t max_count);
+
+/**
+ * @brief 解析 SUBSCRIBE 帧载荷
+ * @return 对象数量 (0=全部对象)，失败返回负数
+ */
+int message_parse_subscribe(const xslot_frame_t *frame, uint8_t *window,
+                            xslot_object_ref_t *refs, uint8_t max_count);
+
+/**
+ * @brief 解析 CREDIT 帧载荷
+ */
+int message_parse_credit(const xslot_frame_t *frame, uint8_t *received,
+                         uint8_t *window);
+
+/**
+ * @brief 解析 PROP_RESPONSE 帧载荷
+ * @return 属性集数量，失败返回负数
+ */
+int message_parse_prop_response(const xslot_frame_t *frame,
+                                xslot_property_set_t *props,
+                                uint8_t max_count);
+
 /**
  * @brief 解析 WRITE 帧载荷
  */
 int message_parse_write(const xslot_frame_t *frame, xslot_bacnet_object_t *obj);
 
+/**
+ * @brief 解析 WRITE_MULTI 帧载荷
+ * @return 对象数量，失败返回负数
+ */
+int message_parse_write_multi(const xslot_frame_t *frame,
+                              xslot_bacnet_object_t *objects,
+                              uint8_t max_count);
+
+/* =============================================================================
+ * FRAGMENT (分片传输)
+ *
+ * 载荷: [XFER:1][INDEX:1][TOTAL:1][KIND:1][CHUNK]，超过单帧的数据块
+ * 按 MESSAGE_FRAGMENT_CHUNK 切分，KIND 标识数据块内容。
+ * =============================================================================
+ */
+
+#define MESSAGE_FRAGMENT_HEADER 4
+#define MESSAGE_FRAGMENT_CHUNK (XSLOT_MAX_DATA_LEN - MESSAGE_FRAGMENT_HEADER)
+
+/**
+ * @brief 分片头
+ */
+typedef struct {
+  uint8_t xfer;  /**< 传输编号 (发送端循环递增) */
+  uint8_t index; /**< 分片序号 (0 起) */
+  uint8_t total; /**< 分片总数 */
+  uint8_t kind;  /**< 数据块类型 (fragment_kind_t) */
+} message_fragment_t;
+
+/**
+ * @brief 构建 FRAGMENT 帧
+ */
+int message_build_fragment(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                           uint8_t seq, const message_fragment_t *hdr,
+                           const uint8_t *chunk, uint8_t len);
+
+/**
+ * @brief 解析 FRAGMENT 帧
+ * @param chunk 输出分片数据指针 (指向帧内)
+ * @return 分片数据长度，失败返回负数
+ */
+int message_parse_fragment(const xslot_frame_t *frame, message_fragment_t *hdr,
+                           const uint8_t **chunk);
+
+/**
+ * @brief 编码历史样本块: [COUNT:2]([AGE_MS:4][对象完整格式])*COUNT
+ * @return 写入字节数，失败返回负数
+ */
+int message_encode_history(const xslot_history_sample_t *samples,
+                           uint16_t count, uint8_t *buffer,
+                           uint16_t buffer_size);
+
+/**
+ * @brief 解码历史样本块 (可分多次调用)
+ * @param offset 解析位置 (首次调用前置 0)
+ * @return 本次解码的样本数，失败返回负数
+ */
+int message_decode_history(const uint8_t *buffer, uint16_t len,
+                           uint16_t *offset, xslot_history_sample_t *samples,
+                           uint16_t max_count);
+
+/* =============================================================================
+ * MUX (逻辑子设备复用)
+ *
+ * 载荷: ([SUB:1][CMD:1][LEN:1][BODY:LEN])*，BODY 与同名命令的帧载荷相同，
+ * 多个子设备的消息共用一帧、一次空口事务。
+ * =============================================================================
+ */
+
+#define MESSAGE_MUX_SEGMENT_HEADER 3 /**< SUB + CMD + LEN */
+#define MESSAGE_MUX_MAX_BODY (XSLOT_MAX_DATA_LEN - MESSAGE_MUX_SEGMENT_HEADER)
+
+/**
+ * @brief 开始构建 MUX 帧 (空载荷)
+ */
+int message_mux_begin(xslot_frame_t *frame, uint16_t from, uint16_t to,
+                      uint8_t seq);
+
+/**
+ * @brief 追加一个子设备消息段
+ * @return XSLOT_OK，帧内空间不足返回 XSLOT_ERR_NO_MEM
+ */
+int message_mux_append(xslot_frame_t *frame, uint8_t sub, uint8_t cmd,
+                       const uint8_t *body, uint8_t len);
+
+/**
+ * @brief 取出下一个消息段
+ * @param frame MUX 帧
+ * @param pos 解析位置 (首次调用前置 0)
+ * @param sub 输出子设备号
+ * @param inner 输出内层帧 (FROM/TO/SEQ 同 MUX 帧)
+ * @return 1=取得一段, 0=结束, 负数=格式错误
+ */
+int message_mux_next(const xslot_frame_t *frame, uint8_t *pos, uint8_t *sub,
+                     xslot_frame_t *inner);
+
 #ifdef __cplusplus
 }
 #endif
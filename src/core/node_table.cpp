@@ -3,24 +3,45 @@
  * @brief 节点表管理实现
  */
 #include "node_table.h"
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 
 /* 获取当前时间戳 (需要 HAL 层实现) */
 extern "C" uint32_t hal_get_timestamp_ms(void);
 
+/* 到达间隔 EWMA 权重 (同 TCP RTT 估计的 1/8) */
+#define GAP_ALPHA 0.125f
+/* 短于此间隔的帧视为同一批 (如多帧上报)，不参与学习 */
+#define GAP_BURST_MS 200
+/* 默认学习间隔数 */
+#define GAP_WARMUP_DEFAULT 4
+/* 判定时间至少为平均间隔的倍数 (严格周期的节点 σ 趋近 0) */
+#define GAP_MIN_RATIO 1.5f
+
 struct node_entry {
   uint16_t addr;
   uint32_t last_seen;
   int8_t rssi;
   bool online;
   uint8_t object_count;
+
+  /* 到达间隔统计 */
+  float gap_mean; /* EWMA 均值 (ms) */
+  float gap_var;  /* EWMA 方差 (ms²) */
+  uint8_t gaps;   /* 已学习的间隔数 (饱和) */
+
+  uint8_t streak; /* 离线后连续健康的间隔数 (上线迟滞) */
 };
 
 struct node_table {
   node_entry *entries;
   uint8_t max_nodes;
   uint8_t count;
+
+  /* 离线判定 */
+  uint32_t timeout_ms;
+  xslot_liveness_config_t liveness;
 };
 
 node_table_t node_table_create(uint8_t max_nodes) {
@@ -37,6 +58,8 @@ node_table_t node_table_create(uint8_t max_nodes) {
 
   table->max_nodes = max_nodes;
   table->count = 0;
+  table->timeout_ms = 0;
+  std::memset(&table->liveness, 0, sizeof(table->liveness));
 
   return table;
 }
@@ -61,6 +84,88 @@ static int find_node_index(node_table_t table, uint16_t addr) {
   return -1;
 }
 
+/**
+ * @brief 学习一个到达间隔
+ */
+static void learn_gap(node_entry *e, uint32_t gap) {
+  float g = (float)gap;
+  if (e->gaps == 0) {
+    e->gap_mean = g;
+    e->gap_var = g * g / 4; /* 初始 σ 取均值的一半 */
+  } else {
+    float d = g - e->gap_mean;
+    e->gap_mean += GAP_ALPHA * d;
+    e->gap_var = (1 - GAP_ALPHA) * (e->gap_var + GAP_ALPHA * d * d);
+  }
+  if (e->gaps < UINT8_MAX)
+    e->gaps++;
+}
+
+static bool gap_learned(const node_table *table, const node_entry *e) {
+  uint8_t warmup = table->liveness.warmup;
+  return e->gaps >= (warmup ? warmup : GAP_WARMUP_DEFAULT);
+}
+
+/**
+ * @brief 节点当前的离线判定时间
+ * @return 毫秒，0=不判定
+ */
+static uint32_t entry_timeout(const node_table *table, const node_entry *e) {
+  const xslot_liveness_config_t *lv = &table->liveness;
+  if (lv->sigma_k <= 0 || !gap_learned(table, e))
+    return table->timeout_ms;
+
+  float t = e->gap_mean + lv->sigma_k * std::sqrt(e->gap_var);
+  if (t < e->gap_mean * GAP_MIN_RATIO)
+    t = e->gap_mean * GAP_MIN_RATIO;
+  if (lv->min_ms && t < (float)lv->min_ms)
+    t = (float)lv->min_ms;
+  if (lv->max_ms && t > (float)lv->max_ms)
+    t = (float)lv->max_ms;
+  return t < (float)UINT32_MAX ? (uint32_t)t : UINT32_MAX;
+}
+
+/**
+ * @brief 节点最后一帧之后多久判为离线 (含离线迟滞)
+ * @return 毫秒，0=不判定
+ */
+static uint32_t offline_after(const node_table *table, const node_entry *e) {
+  uint8_t misses = table->liveness.offline_misses;
+  uint64_t t = (uint64_t)entry_timeout(table, e) * (misses ? misses : 1);
+  return t < UINT32_MAX ? (uint32_t)t : UINT32_MAX;
+}
+
+/**
+ * @brief 上线所需帧数
+ */
+static uint8_t online_frames(const node_table *table) {
+  return table->liveness.online_frames ? table->liveness.online_frames : 1;
+}
+
+static void fill_info(const node_table *table, const node_entry *e,
+                      xslot_node_info_t *info) {
+  info->addr = e->addr;
+  info->last_seen = e->last_seen;
+  info->rssi = e->rssi;
+  info->online = e->online;
+  info->object_count = e->object_count;
+  info->interval_ms = e->gaps ? (uint32_t)e->gap_mean : 0;
+  info->timeout_ms = offline_after(table, e);
+}
+
+void node_table_set_timeout(node_table_t table, uint32_t timeout_ms,
+                            const xslot_liveness_config_t *liveness) {
+  if (!table)
+    return;
+
+  table->timeout_ms = timeout_ms;
+  if (liveness) {
+    table->liveness = *liveness;
+  } else {
+    std::memset(&table->liveness, 0, sizeof(table->liveness));
+  }
+}
+
 bool node_table_update(node_table_t table, uint16_t addr, int8_t rssi) {
   if (!table)
     return false;
@@ -70,9 +175,26 @@ bool node_table_update(node_table_t table, uint16_t addr, int8_t rssi) {
 
   if (idx >= 0) {
     // 已存在，更新
+    node_entry *e = &table->entries[idx];
+    uint32_t gap = now - e->last_seen;
+    /* 离线期间的间隔是故障时长而非上报周期，只在学习完成前计入
+     * (此前按固定超时判定，周期较长的节点每帧都会"重新上线") */
+    if (gap >= GAP_BURST_MS && (e->online || !gap_learned(table, e)))
+      learn_gap(e, gap);
+
     table->entries[idx].last_seen = now;
     table->entries[idx].rssi = rssi;
     if (!table->entries[idx].online) {
+      /* 只计间隔正常的帧: 同一批的帧不重复计数，间隔超过判定时间则
+       * 重新计数，零星的杂散帧或一次突发不会使抖动的节点上线 */
+      uint32_t timeout_ms = entry_timeout(table, e);
+      if (timeout_ms > 0 && gap > timeout_ms)
+        e->streak = 0;
+      else if (gap < GAP_BURST_MS && e->streak > 0)
+        return false;
+      if (++e->streak < online_frames(table))
+        return false; // 迟滞，暂不上线
+      e->streak = 0;
       table->entries[idx].online = true;
       return true; // 重新上线
     }
@@ -105,29 +227,43 @@ bool node_table_update(node_table_t table, uint16_t addr, int8_t rssi) {
   table->entries[idx].addr = addr;
   table->entries[idx].last_seen = now;
   table->entries[idx].rssi = rssi;
-  table->entries[idx].online = true;
   table->entries[idx].object_count = 0;
+  table->entries[idx].gap_mean = 0;
+  table->entries[idx].gap_var = 0;
+  table->entries[idx].gaps = 0;
+
+  /* 新节点同样需要收满 online_frames 帧 */
+  bool online = online_frames(table) <= 1;
+  table->entries[idx].online = online;
+  table->entries[idx].streak = online ? 0 : 1;
 
-  return true; // 新节点上线
+  return online; // 新节点上线
 }
 
-void node_table_check_timeout(node_table_t table, uint32_t timeout_ms,
-                              xslot_node_online_cb offline_cb) {
-  if (!table)
-    return;
+int node_table_check_timeout(node_table_t table,
+                             xslot_node_transition_t *offline, int max_count) {
+  if (!table || !offline)
+    return 0;
 
   uint32_t now = hal_get_timestamp_ms();
+  int count = 0;
 
-  for (uint8_t i = 0; i < table->count; i++) {
-    if (table->entries[i].online) {
-      if (now - table->entries[i].last_seen > timeout_ms) {
-        table->entries[i].online = false;
-        if (offline_cb) {
-          offline_cb(table->entries[i].addr, false);
-        }
-      }
+  for (uint8_t i = 0; i < table->count && count < max_count; i++) {
+    node_entry *e = &table->entries[i];
+    if (!e->online)
+      continue;
+
+    uint32_t timeout_ms = offline_after(table, e);
+    if (timeout_ms > 0 && now - e->last_seen > timeout_ms) {
+      e->online = false;
+      e->streak = 0;
+      offline[count].addr = e->addr;
+      offline[count].online = false;
+      offline[count].last_seen = e->last_seen;
+      count++;
     }
   }
+  return count;
 }
 
 bool node_table_is_online(node_table_t table, uint16_t addr) {
@@ -148,11 +284,7 @@ bool node_table_get_node(node_table_t table, uint16_t addr,
 
   int idx = find_node_index(table, addr);
   if (idx >= 0) {
-    info->addr = table->entries[idx].addr;
-    info->last_seen = table->entries[idx].last_seen;
-    info->rssi = table->entries[idx].rssi;
-    info->online = table->entries[idx].online;
-    info->object_count = table->entries[idx].object_count;
+    fill_info(table, &table->entries[idx], info);
     return true;
   }
   return false;
@@ -165,11 +297,7 @@ int node_table_get_all(node_table_t table, xslot_node_info_t *nodes,
 
   int count = 0;
   for (uint8_t i = 0; i < table->count && count < max_count; i++) {
-    nodes[count].addr = table->entries[i].addr;
-    nodes[count].last_seen = table->entries[i].last_seen;
-    nodes[count].rssi = table->entries[i].rssi;
-    nodes[count].online = table->entries[i].online;
-    nodes[count].object_count = table->entries[i].object_count;
+    fill_info(table, &table->entries[i], &nodes[count]);
     count++;
   }
   return count;
@@ -35,18 +35,28 @@ void node_table_destroy(node_table_t table);
  * @param table 节点表
  * @param addr 节点地址
  * @param rssi 信号强度
- * @return true=新节点上线, false=已存在节点
+ * @return true=节点上线 (新节点或离线节点收满 online_frames 帧)
  */
 bool node_table_update(node_table_t table, uint16_t addr, int8_t rssi);
 
+/**
+ * @brief 设置离线判定参数
+ * @param table 节点表
+ * @param timeout_ms 固定超时 (尚未学习到达间隔的节点使用，0=不判定)
+ * @param liveness 自适应判定参数，可为 NULL (全部使用固定超时)
+ */
+void node_table_set_timeout(node_table_t table, uint32_t timeout_ms,
+                            const xslot_liveness_config_t *liveness);
+
 /**
  * @brief 检查并标记超时节点
  * @param table 节点表
- * @param timeout_ms 超时时间
- * @param offline_cb 离线回调 (可为 NULL)
+ * @param offline 输出本次离线的节点
+ * @param max_count offline 容量
+ * @return 本次离线的节点数
  */
-void node_table_check_timeout(node_table_t table, uint32_t timeout_ms,
-                              xslot_node_online_cb offline_cb);
+int node_table_check_timeout(node_table_t table,
+                             xslot_node_transition_t *offline, int max_count);
 
 /**
  * @brief 检查节点是否在线
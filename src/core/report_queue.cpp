@@ -0,0 +1,193 @@
+/**
+ * @file report_queue.cpp
+ * @brief 边缘节点上报队列实现
+ */
+#include "report_queue.h"
+#include <cstdlib>
+#include <cstring>
+
+/* 记录上次状态标志的对象数 */
+#define STATUS_TABLE_SIZE 128
+
+struct report_lane {
+  xslot_bacnet_object_t objects[REPORT_QUEUE_LANE_SIZE];
+  uint32_t times[REPORT_QUEUE_LANE_SIZE]; /* 采样时间 */
+  uint8_t count;
+};
+
+struct report_queue {
+  report_lane lanes[2];
+
+  /* 每个对象最近一次入队时的状态标志 */
+  uint32_t status_keys[STATUS_TABLE_SIZE];
+  uint8_t status_flags[STATUS_TABLE_SIZE];
+  uint8_t status_count;
+};
+
+/* 不同类型的对象实例号可能相同 (AI0/BI0)，键中包含类型 */
+static inline uint32_t object_key(const xslot_bacnet_object_t *obj) {
+  return ((uint32_t)obj->object_type << 16) | obj->object_id;
+}
+
+report_queue_t report_queue_create(void) {
+  return (report_queue_t)std::calloc(1, sizeof(struct report_queue));
+}
+
+void report_queue_destroy(report_queue_t queue) { std::free(queue); }
+
+static int lane_find(const report_lane *lane, uint32_t key) {
+  for (uint8_t i = 0; i < lane->count; i++) {
+    if (object_key(&lane->objects[i]) == key)
+      return i;
+  }
+  return -1;
+}
+
+static void lane_remove(report_lane *lane, int idx) {
+  std::memmove(&lane->objects[idx], &lane->objects[idx + 1],
+               (lane->count - idx - 1) * sizeof(xslot_bacnet_object_t));
+  std::memmove(&lane->times[idx], &lane->times[idx + 1],
+               (lane->count - idx - 1) * sizeof(uint32_t));
+  lane->count--;
+}
+
+/**
+ * @brief 入队 (同一对象合并为最新值)
+ * @return true=成功, false=通道已满
+ */
+static bool lane_put(report_lane *lane, const xslot_bacnet_object_t *obj,
+                     uint32_t time_ms) {
+  int idx = lane_find(lane, object_key(obj));
+  if (idx >= 0) {
+    lane->objects[idx] = *obj;
+    lane->times[idx] = time_ms;
+    return true;
+  }
+  if (lane->count >= REPORT_QUEUE_LANE_SIZE)
+    return false;
+  lane->objects[lane->count] = *obj;
+  lane->times[lane->count] = time_ms;
+  lane->count++;
+  return true;
+}
+
+/**
+ * @brief 查找对象的状态记录
+ * @return 索引，未记录返回 -1
+ */
+static int status_find(report_queue_t queue, uint32_t key) {
+  for (uint8_t i = 0; i < queue->status_count; i++) {
+    if (queue->status_keys[i] == key)
+      return i;
+  }
+  return -1;
+}
+
+/**
+ * @brief 判断状态标志是否变化 (不修改记录)
+ *
+ * 首次出现的对象默认视为正常状态。状态表已满后未记录的对象无法比较，
+ * 一律视为变化，以完整格式发送。
+ */
+static bool status_changed(report_queue_t queue,
+                           const xslot_bacnet_object_t *obj) {
+  uint8_t flags = obj->flags & REPORT_STATUS_MASK;
+  int idx = status_find(queue, object_key(obj));
+  if (idx >= 0)
+    return queue->status_flags[idx] != flags;
+  if (queue->status_count < STATUS_TABLE_SIZE)
+    return flags != 0;
+  return true;
+}
+
+/**
+ * @brief 记录对象的新状态 (进入优先通道后调用)
+ */
+static void status_commit(report_queue_t queue,
+                          const xslot_bacnet_object_t *obj) {
+  uint32_t key = object_key(obj);
+  uint8_t flags = obj->flags & REPORT_STATUS_MASK;
+  int idx = status_find(queue, key);
+  if (idx >= 0) {
+    queue->status_flags[idx] = flags;
+  } else if (queue->status_count < STATUS_TABLE_SIZE) {
+    queue->status_keys[queue->status_count] = key;
+    queue->status_flags[queue->status_count] = flags;
+    queue->status_count++;
+  }
+}
+
+int report_queue_push(report_queue_t queue,
+                      const xslot_bacnet_object_t *objects, uint8_t count,
+                      uint32_t time_ms) {
+  if (!queue || !objects)
+    return count;
+
+  int dropped = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const xslot_bacnet_object_t *obj = &objects[i];
+
+    if (status_changed(queue, obj)) {
+      /* 优先通道已满时不记录新状态，下次入队仍判为变化 */
+      if (!lane_put(&queue->lanes[REPORT_LANE_PRIORITY], obj, time_ms)) {
+        dropped++;
+        continue;
+      }
+      status_commit(queue, obj);
+
+      /* 优先通道携带最新值，常规通道中的旧值作废 */
+      report_lane *routine = &queue->lanes[REPORT_LANE_ROUTINE];
+      int idx = lane_find(routine, object_key(obj));
+      if (idx >= 0)
+        lane_remove(routine, idx);
+    } else {
+      if (!lane_put(&queue->lanes[REPORT_LANE_ROUTINE], obj, time_ms))
+        dropped++;
+    }
+  }
+
+  return dropped;
+}
+
+int report_queue_peek(report_queue_t queue, report_lane_t lane,
+                      xslot_bacnet_object_t *out, uint8_t max_count) {
+  if (!queue || !out)
+    return 0;
+
+  const report_lane *l = &queue->lanes[lane];
+  uint8_t n = l->count < max_count ? l->count : max_count;
+  std::memcpy(out, l->objects, n * sizeof(xslot_bacnet_object_t));
+  return n;
+}
+
+int report_queue_peek_times(report_queue_t queue, report_lane_t lane,
+                            uint32_t *out, uint8_t max_count) {
+  if (!queue || !out)
+    return 0;
+
+  const report_lane *l = &queue->lanes[lane];
+  uint8_t n = l->count < max_count ? l->count : max_count;
+  std::memcpy(out, l->times, n * sizeof(uint32_t));
+  return n;
+}
+
+void report_queue_consume(report_queue_t queue, report_lane_t lane,
+                          uint8_t count) {
+  if (!queue)
+    return;
+
+  report_lane *l = &queue->lanes[lane];
+  if (count >= l->count) {
+    l->count = 0;
+    return;
+  }
+  std::memmove(&l->objects[0], &l->objects[count],
+               (l->count - count) * sizeof(xslot_bacnet_object_t));
+  std::memmove(&l->times[0], &l->times[count],
+               (l->count - count) * sizeof(uint32_t));
+  l->count -= count;
+}
+
+int report_queue_pending(report_queue_t queue, report_lane_t lane) {
+  return queue ? queue->lanes[lane].count : 0;
+}
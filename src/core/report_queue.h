@@ -0,0 +1,94 @@
+/**
+ * @file report_queue.h
+ * @brief 边缘节点上报队列 (优先通道 + 常规通道)
+ *
+ * 告警状态或 Out_Of_Service 发生变化的对象进入优先通道，
+ * 其余 COV 数据进入常规通道 (同一对象只保留最新值)。
+ * 发送时总是先清空优先通道，再继续常规数据。
+ */
+#ifndef REPORT_QUEUE_H
+#define REPORT_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 每个通道的最大待发对象数 */
+#define REPORT_QUEUE_LANE_SIZE 64
+
+/** 参与优先判断的状态标志位 */
+#define REPORT_STATUS_MASK (XSLOT_FLAG_OUT_OF_SERVICE | XSLOT_FLAG_IN_ALARM)
+
+/**
+ * @brief 通道
+ */
+typedef enum {
+  REPORT_LANE_PRIORITY = 0, /**< 告警/状态变化 */
+  REPORT_LANE_ROUTINE = 1,  /**< 常规 COV */
+} report_lane_t;
+
+/**
+ * @brief 上报队列句柄
+ */
+typedef struct report_queue *report_queue_t;
+
+/**
+ * @brief 创建上报队列
+ */
+report_queue_t report_queue_create(void);
+
+/**
+ * @brief 销毁上报队列
+ */
+void report_queue_destroy(report_queue_t queue);
+
+/**
+ * @brief 对象入队 (自动分类到优先/常规通道)
+ * @param time_ms 采样时间 (本地时钟，合并时取最新)
+ * @return 未能入队的对象数量 (通道已满)
+ *
+ * 状态变化只有进入优先通道后才记为已上报；优先通道已满时调用方重新入队
+ * 同一对象仍会判为状态变化。
+ */
+int report_queue_push(report_queue_t queue,
+                      const xslot_bacnet_object_t *objects, uint8_t count,
+                      uint32_t time_ms);
+
+/**
+ * @brief 查看通道头部对象 (不出队)
+ * @param queue 队列
+ * @param lane 通道
+ * @param out 输出数组
+ * @param max_count 最大数量
+ * @return 实际数量
+ */
+int report_queue_peek(report_queue_t queue, report_lane_t lane,
+                      xslot_bacnet_object_t *out, uint8_t max_count);
+
+/**
+ * @brief 查看通道头部对象的采样时间 (与 report_queue_peek 一一对应)
+ * @return 实际数量
+ */
+int report_queue_peek_times(report_queue_t queue, report_lane_t lane,
+                            uint32_t *out, uint8_t max_count);
+
+/**
+ * @brief 通道头部出队 (发送成功后调用)
+ */
+void report_queue_consume(report_queue_t queue, report_lane_t lane,
+                          uint8_t count);
+
+/**
+ * @brief 通道待发对象数量
+ */
+int report_queue_pending(report_queue_t queue, report_lane_t lane);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REPORT_QUEUE_H */
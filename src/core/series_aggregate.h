@@ -0,0 +1,48 @@
+/**
+ * @file series_aggregate.h
+ * @brief 时间序列窗口聚合 (降采样)
+ *
+ * 输入为按时间升序排列的列式样本 (时间戳数组 + 数值数组)，
+ * 按固定窗口输出 min/max/avg/last/count 列。
+ */
+#ifndef SERIES_AGGREGATE_H
+#define SERIES_AGGREGATE_H
+
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 对单个点的样本做窗口聚合
+ * @param series 输入序列 (时间戳需升序)
+ * @param start_ms 第一个窗口的起始时间
+ * @param bucket_ms 窗口宽度 (ms)
+ * @param bucket_count 窗口数量
+ * @param out 输出列 (每列容量 >= bucket_count, 不需要的列可为 NULL)
+ * @return 非空窗口数量，失败返回负数错误码
+ */
+int series_downsample(const xslot_series_t *series, uint64_t start_ms,
+                      uint32_t bucket_ms, uint32_t bucket_count,
+                      const xslot_series_columns_t *out);
+
+/**
+ * @brief 对多个点批量做窗口聚合
+ *
+ * 第 i 个点的结果写入 out[i]，各点之间互不依赖，
+ * 调用方可将点集切分后在多个线程中并行调用。
+ *
+ * @return 所有点的非空窗口总数，失败返回负数错误码
+ */
+int series_downsample_batch(const xslot_series_t *series,
+                            uint32_t series_count, uint64_t start_ms,
+                            uint32_t bucket_ms, uint32_t bucket_count,
+                            const xslot_series_columns_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SERIES_AGGREGATE_H */
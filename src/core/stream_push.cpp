@@ -0,0 +1,249 @@
+/**
+ * @file stream_push.cpp
+ * @brief 流式推送实现
+ */
+#include "stream_push.h"
+#include "../bacnet/bacnet_object_def.h"
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+struct stream_entry {
+  xslot_bacnet_object_t object;
+  uint8_t dirty; /* 待推送标记，按订阅者槽位 */
+};
+
+struct stream_subscriber {
+  bool active;
+  uint16_t addr;
+  uint8_t window;
+  uint8_t sent;       /* 订阅以来发出的推送帧数 (模 256) */
+  uint8_t received;   /* 订阅者最近报告的收到帧数 */
+  uint32_t credit_ms; /* 最近一次订阅/CREDIT 的时间 */
+  uint32_t keys[STREAM_PUSH_MAX_REFS];
+  uint8_t key_count; /* 0=全部对象 */
+};
+
+struct stream_push {
+  stream_entry entries[STREAM_PUSH_MAX_OBJECTS];
+  uint8_t count;
+  stream_subscriber subs[STREAM_PUSH_MAX_SUBSCRIBERS];
+};
+
+/* 不同类型的对象实例号可能相同 (AI0/BI0)，键中包含类型 */
+static inline uint32_t object_key(const xslot_bacnet_object_t *obj) {
+  return ((uint32_t)obj->object_type << 16) | obj->object_id;
+}
+
+static inline uint32_t ref_key(const xslot_object_ref_t *ref) {
+  return ((uint32_t)ref->object_type << 16) | ref->object_id;
+}
+
+stream_push_t stream_push_create(void) {
+  return (stream_push_t)std::calloc(1, sizeof(struct stream_push));
+}
+
+void stream_push_destroy(stream_push_t stream) { std::free(stream); }
+
+static bool subscribed(const stream_subscriber *sub, uint32_t key) {
+  if (sub->key_count == 0)
+    return true;
+  for (uint8_t i = 0; i < sub->key_count; i++) {
+    if (sub->keys[i] == key)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief 订阅了该对象的订阅者槽位
+ */
+static uint8_t subscriber_mask(const stream_push_t stream, uint32_t key) {
+  uint8_t mask = 0;
+  for (uint8_t i = 0; i < STREAM_PUSH_MAX_SUBSCRIBERS; i++) {
+    const stream_subscriber *sub = &stream->subs[i];
+    if (sub->active && subscribed(sub, key))
+      mask |= 1u << i;
+  }
+  return mask;
+}
+
+static bool same_value(const xslot_bacnet_object_t *a,
+                       const xslot_bacnet_object_t *b) {
+  return a->flags == b->flags &&
+         std::memcmp(&a->present_value, &b->present_value,
+                     xslot_get_value_size(a->object_type)) == 0;
+}
+
+int stream_push_update(stream_push_t stream,
+                       const xslot_bacnet_object_t *objects, uint8_t count) {
+  if (!stream || !objects)
+    return count;
+
+  int dropped = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const xslot_bacnet_object_t *obj = &objects[i];
+    uint32_t key = object_key(obj);
+
+    stream_entry *entry = nullptr;
+    for (uint8_t j = 0; j < stream->count; j++) {
+      if (object_key(&stream->entries[j].object) == key) {
+        entry = &stream->entries[j];
+        break;
+      }
+    }
+
+    if (entry) {
+      if (same_value(&entry->object, obj))
+        continue;
+    } else {
+      if (stream->count >= STREAM_PUSH_MAX_OBJECTS) {
+        dropped++;
+        continue;
+      }
+      entry = &stream->entries[stream->count++];
+    }
+
+    entry->object = *obj;
+    entry->dirty |= subscriber_mask(stream, key);
+  }
+
+  return dropped;
+}
+
+static stream_subscriber *find_subscriber(stream_push_t stream,
+                                          uint16_t addr) {
+  for (uint8_t i = 0; i < STREAM_PUSH_MAX_SUBSCRIBERS; i++) {
+    if (stream->subs[i].active && stream->subs[i].addr == addr)
+      return &stream->subs[i];
+  }
+  return nullptr;
+}
+
+static void clear_slot(stream_push_t stream, uint8_t slot) {
+  std::memset(&stream->subs[slot], 0, sizeof(stream_subscriber));
+  for (uint8_t i = 0; i < stream->count; i++) {
+    stream->entries[i].dirty &= ~(1u << slot);
+  }
+}
+
+int stream_push_subscribe(stream_push_t stream, uint16_t addr, uint8_t window,
+                          const xslot_object_ref_t *refs, uint8_t count,
+                          uint32_t now_ms) {
+  if (!stream || (!refs && count > 0) || count > STREAM_PUSH_MAX_REFS)
+    return XSLOT_ERR_PARAM;
+
+  /* 重新订阅时替换原订阅 (HMI 重连) */
+  stream_subscriber *sub = find_subscriber(stream, addr);
+  if (!sub) {
+    if (window == 0)
+      return XSLOT_OK;
+    for (uint8_t i = 0; i < STREAM_PUSH_MAX_SUBSCRIBERS; i++) {
+      if (!stream->subs[i].active) {
+        sub = &stream->subs[i];
+        break;
+      }
+    }
+    if (!sub)
+      return XSLOT_ERR_NO_MEM;
+  }
+
+  uint8_t slot = (uint8_t)(sub - stream->subs);
+  clear_slot(stream, slot);
+  if (window == 0)
+    return XSLOT_OK;
+
+  sub->active = true;
+  sub->addr = addr;
+  sub->window = window;
+  sub->credit_ms = now_ms;
+  for (uint8_t i = 0; i < count; i++) {
+    sub->keys[i] = ref_key(&refs[i]);
+  }
+  sub->key_count = count;
+
+  /* 全量快照: 已缓存的匹配对象全部待推送 */
+  for (uint8_t i = 0; i < stream->count; i++) {
+    stream_entry *entry = &stream->entries[i];
+    if (subscribed(sub, object_key(&entry->object)))
+      entry->dirty |= 1u << slot;
+  }
+
+  return XSLOT_OK;
+}
+
+int stream_push_credit(stream_push_t stream, uint16_t addr, uint8_t received,
+                       uint8_t window, uint32_t now_ms) {
+  if (!stream)
+    return XSLOT_ERR_PARAM;
+
+  stream_subscriber *sub = find_subscriber(stream, addr);
+  if (!sub)
+    return XSLOT_ERR_PARAM;
+
+  /* 乱序到达的旧 CREDIT 不回退；超过已发出帧数的部分 (重新订阅前在途
+   * 的推送帧也被计入) 按已发出帧数计 */
+  int8_t ahead = (int8_t)(received - sub->received);
+  if (ahead > 0) {
+    if ((uint8_t)ahead > (uint8_t)(sub->sent - sub->received))
+      sub->received = sub->sent;
+    else
+      sub->received = received;
+  }
+  if (window > 0)
+    sub->window = window;
+  sub->credit_ms = now_ms;
+  return XSLOT_OK;
+}
+
+int stream_push_expire(stream_push_t stream, uint32_t now_ms,
+                       uint32_t timeout_ms) {
+  if (!stream)
+    return 0;
+
+  int removed = 0;
+  for (uint8_t i = 0; i < STREAM_PUSH_MAX_SUBSCRIBERS; i++) {
+    if (stream->subs[i].active &&
+        now_ms - stream->subs[i].credit_ms >= timeout_ms) {
+      clear_slot(stream, i);
+      removed++;
+    }
+  }
+  return removed;
+}
+
+int stream_push_peek(stream_push_t stream, uint8_t slot, uint16_t *addr,
+                     xslot_bacnet_object_t *out, uint8_t max_count) {
+  if (!stream || !addr || !out || slot >= STREAM_PUSH_MAX_SUBSCRIBERS)
+    return 0;
+
+  const stream_subscriber *sub = &stream->subs[slot];
+  if (!sub->active)
+    return 0;
+
+  /* 未确认的推送帧已达窗口 */
+  if ((uint8_t)(sub->sent - sub->received) >= sub->window)
+    return 0;
+
+  *addr = sub->addr;
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < stream->count && n < max_count; i++) {
+    if (stream->entries[i].dirty & (1u << slot))
+      out[n++] = stream->entries[i].object;
+  }
+  return n;
+}
+
+void stream_push_consume(stream_push_t stream, uint8_t slot, uint8_t count) {
+  if (!stream || slot >= STREAM_PUSH_MAX_SUBSCRIBERS)
+    return;
+
+  /* 与 stream_push_peek 的顺序一致 */
+  for (uint8_t i = 0; i < stream->count && count > 0; i++) {
+    if (stream->entries[i].dirty & (1u << slot)) {
+      stream->entries[i].dirty &= ~(1u << slot);
+      count--;
+    }
+  }
+  stream->subs[slot].sent++;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file stream_push.h
+ * @brief 流式推送 (DDC 向直连 HMI 推送对象变化)
+ *
+ * 缓存应用发布的对象最新值，并为每个订阅者记录尚未推送的对象。订阅时
+ * 缓存中所有匹配的对象都标记为待推送 (全量快照)，之后只推送变化的对象。
+ * 推送受订阅者给出的窗口限制: 未确认的推送帧数达到窗口后暂停，收到
+ * CREDIT 后继续；同一对象在暂停期间多次变化只推送最新值。
+ */
+#ifndef STREAM_PUSH_H
+#define STREAM_PUSH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 缓存的最大对象数 */
+#define STREAM_PUSH_MAX_OBJECTS 128
+
+/** 最大订阅者数 */
+#define STREAM_PUSH_MAX_SUBSCRIBERS 4
+
+/** 单个订阅的最大对象引用数 (与 SUBSCRIBE 帧容量一致) */
+#define STREAM_PUSH_MAX_REFS ((XSLOT_MAX_DATA_LEN - 2) / 3)
+
+/**
+ * @brief 流式推送句柄
+ */
+typedef struct stream_push *stream_push_t;
+
+/**
+ * @brief 创建流式推送状态
+ */
+stream_push_t stream_push_create(void);
+
+/**
+ * @brief 销毁流式推送状态
+ */
+void stream_push_destroy(stream_push_t stream);
+
+/**
+ * @brief 更新对象值 (值或标志变化时对订阅者标记待推送)
+ * @return 未能缓存的对象数量 (缓存已满)
+ */
+int stream_push_update(stream_push_t stream,
+                       const xslot_bacnet_object_t *objects, uint8_t count);
+
+/**
+ * @brief 建立或替换订阅 (匹配的对象全部标记待推送)
+ * @param addr 订阅者地址
+ * @param window 窗口，0 表示取消订阅
+ * @param refs 订阅的对象，count=0 表示全部对象
+ * @param now_ms 当前时间
+ * @return 错误码，订阅者已满返回 XSLOT_ERR_NO_MEM
+ */
+int stream_push_subscribe(stream_push_t stream, uint16_t addr, uint8_t window,
+                          const xslot_object_ref_t *refs, uint8_t count,
+                          uint32_t now_ms);
+
+/**
+ * @brief 更新订阅者的信用
+ * @param received 订阅者收到的推送帧数 (模 256)
+ * @return 错误码，没有该订阅返回 XSLOT_ERR_PARAM
+ */
+int stream_push_credit(stream_push_t stream, uint16_t addr, uint8_t received,
+                       uint8_t window, uint32_t now_ms);
+
+/**
+ * @brief 移除超过 timeout_ms 未收到 CREDIT 的订阅者
+ * @return 移除的订阅者数量
+ */
+int stream_push_expire(stream_push_t stream, uint32_t now_ms,
+                       uint32_t timeout_ms);
+
+/**
+ * @brief 查看订阅者待推送的对象 (不清除标记)
+ * @param slot 订阅者槽位 (0..STREAM_PUSH_MAX_SUBSCRIBERS-1)
+ * @param addr 输出订阅者地址
+ * @return 对象数量，槽位空闲或信用用尽时返回 0
+ */
+int stream_push_peek(stream_push_t stream, uint8_t slot, uint16_t *addr,
+                     xslot_bacnet_object_t *out, uint8_t max_count);
+
+/**
+ * @brief 推送帧发送成功后清除前 count 个对象的标记，消耗一个信用
+ */
+void stream_push_consume(stream_push_t stream, uint8_t slot, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_PUSH_H */
@@ -0,0 +1,348 @@
+/**
+ * @file trend_log.cpp
+ * @brief 边缘节点趋势日志实现
+ */
+#include "trend_log.h"
+#include "../bacnet/bacnet_object_def.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+/* 每个对象的头: TYPE ID N MODE AGE0 V0 RES */
+#define SERIES_HEADER_SIZE 18
+
+/* 量化值超出此范围时改用 RAW，保证差分不溢出 int32 */
+#define QUANT_LIMIT 1.0e9f
+
+struct trend_sample {
+  uint32_t time_ms;
+  float value;
+};
+
+struct trend_series {
+  xslot_trend_object_t object;
+  trend_sample *ring;
+  uint16_t head; /* 最旧样本所在槽位 */
+  uint16_t count;
+  uint16_t sending; /* encode 取出、尚未 consume 的样本数 (从最旧算起) */
+};
+
+struct trend_log {
+  trend_series series[XSLOT_MAX_TREND_OBJECTS];
+  uint8_t count;
+};
+
+trend_log_t trend_log_create(const xslot_trend_object_t *objects,
+                             uint8_t count) {
+  if (!objects || count == 0 || count > XSLOT_MAX_TREND_OBJECTS)
+    return nullptr;
+
+  trend_log_t log = (trend_log_t)std::calloc(1, sizeof(struct trend_log));
+  if (!log)
+    return nullptr;
+
+  for (uint8_t i = 0; i < count; i++) {
+    trend_series *s = &log->series[i];
+    s->object = objects[i];
+    if (!xslot_is_analog_type(s->object.object_type))
+      s->object.resolution = 1.0f;
+    if (s->object.capacity > 0) {
+      s->ring = (trend_sample *)std::calloc(s->object.capacity,
+                                            sizeof(trend_sample));
+    }
+    if (!s->ring) {
+      log->count = i;
+      trend_log_destroy(log);
+      return nullptr;
+    }
+  }
+  log->count = count;
+  return log;
+}
+
+void trend_log_destroy(trend_log_t log) {
+  if (!log)
+    return;
+  for (uint8_t i = 0; i < log->count; i++) {
+    std::free(log->series[i].ring);
+  }
+  std::free(log);
+}
+
+int trend_log_record(trend_log_t log, const xslot_bacnet_object_t *objects,
+                     uint8_t count, uint32_t now_ms) {
+  if (!log || !objects)
+    return 0;
+
+  int overwritten = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const xslot_bacnet_object_t *obj = &objects[i];
+    for (uint8_t j = 0; j < log->count; j++) {
+      trend_series *s = &log->series[j];
+      if (s->object.object_type != obj->object_type ||
+          s->object.object_id != obj->object_id)
+        continue;
+
+      uint16_t capacity = s->object.capacity;
+      uint16_t slot = (uint16_t)((s->head + s->count) % capacity);
+      if (s->count == capacity) {
+        /* 覆盖最旧样本；发送中的样本已在数据块里，consume 时少删一个 */
+        s->head = (uint16_t)((s->head + 1) % capacity);
+        if (s->sending > 0)
+          s->sending--;
+        overwritten++;
+      } else {
+        s->count++;
+      }
+      s->ring[slot].time_ms = now_ms;
+      s->ring[slot].value = xslot_is_analog_type(obj->object_type)
+                                ? obj->present_value.analog
+                                : (float)obj->present_value.binary;
+      break;
+    }
+  }
+  return overwritten;
+}
+
+bool trend_log_due(trend_log_t log) {
+  if (!log)
+    return false;
+  for (uint8_t i = 0; i < log->count; i++) {
+    const trend_series *s = &log->series[i];
+    if (s->count - s->sending >= (s->object.capacity + 1) / 2)
+      return true;
+  }
+  return false;
+}
+
+uint32_t trend_log_pending(trend_log_t log) {
+  if (!log)
+    return 0;
+  uint32_t pending = 0;
+  for (uint8_t i = 0; i < log->count; i++) {
+    pending += log->series[i].count;
+  }
+  return pending;
+}
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = (v >> 8) & 0xFF;
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+  p[0] = v & 0xFF;
+  p[1] = (v >> 8) & 0xFF;
+  p[2] = (v >> 16) & 0xFF;
+  p[3] = (v >> 24) & 0xFF;
+}
+
+static inline uint32_t get_u32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+static inline uint32_t float_bits(float v) {
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+static inline float bits_float(uint32_t bits) {
+  float v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+static uint16_t put_varint(uint8_t *p, int32_t v) {
+  uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+  uint16_t n = 0;
+  while (z >= 0x80) {
+    p[n++] = (uint8_t)(z | 0x80);
+    z >>= 7;
+  }
+  p[n++] = (uint8_t)z;
+  return n;
+}
+
+static bool get_varint(const uint8_t *buffer, uint16_t len, uint16_t *pos,
+                       int32_t *v) {
+  uint32_t z = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (*pos >= len)
+      return false;
+    uint8_t b = buffer[(*pos)++];
+    z |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      *v = (int32_t)((z >> 1) ^ (0u - (z & 1)));
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline const trend_sample *sample_at(const trend_series *s,
+                                            uint16_t i) {
+  return &s->ring[(s->head + i) % s->object.capacity];
+}
+
+/**
+ * @brief 样本值按精度量化 (不可量化时返回 false，该对象改用 RAW)
+ */
+static bool quantize(const trend_series *s, uint16_t n, int32_t *q0) {
+  float res = s->object.resolution;
+  if (!(res > 0.0f))
+    return false;
+  for (uint16_t i = 0; i < n; i++) {
+    float q = sample_at(s, i)->value / res;
+    if (!(std::fabs(q) < QUANT_LIMIT))
+      return false;
+  }
+  *q0 = (int32_t)std::lroundf(sample_at(s, 0)->value / res);
+  return true;
+}
+
+int trend_log_encode(trend_log_t log, uint32_t now_ms, uint8_t *buffer,
+                     uint16_t buffer_size) {
+  if (!log || !buffer || buffer_size < 1)
+    return XSLOT_ERR_PARAM;
+
+  uint16_t pos = 1;
+  uint8_t series_count = 0;
+  for (uint8_t i = 0; i < log->count; i++) {
+    trend_series *s = &log->series[i];
+    s->sending = 0;
+    if (s->count == 0 || pos + SERIES_HEADER_SIZE > buffer_size)
+      continue;
+
+    /* 按最坏长度计算本块能装下的样本数 */
+    uint16_t n = s->count;
+    uint32_t room = buffer_size - pos - SERIES_HEADER_SIZE;
+    if ((uint32_t)(n - 1) > room / TREND_SAMPLE_MAX_SIZE)
+      n = (uint16_t)(room / TREND_SAMPLE_MAX_SIZE + 1);
+
+    const trend_sample *first = sample_at(s, 0);
+    int32_t q_prev = 0;
+    bool quant = quantize(s, n, &q_prev);
+
+    uint8_t *hdr = buffer + pos;
+    hdr[0] = s->object.object_type;
+    put_u16(hdr + 1, s->object.object_id);
+    put_u16(hdr + 3, n);
+    hdr[5] = quant ? TREND_MODE_QUANT : TREND_MODE_RAW;
+    put_u32(hdr + 6, now_ms - first->time_ms);
+    put_u32(hdr + 10, quant ? (uint32_t)q_prev : float_bits(first->value));
+    pos += 14;
+    if (quant) {
+      put_u32(buffer + pos, float_bits(s->object.resolution));
+      pos += 4;
+    }
+
+    uint32_t t_prev = first->time_ms;
+    uint32_t v_prev = float_bits(first->value);
+    int32_t d_prev = 0;
+    for (uint16_t k = 1; k < n; k++) {
+      const trend_sample *smp = sample_at(s, k);
+      int32_t d = (int32_t)(smp->time_ms - t_prev);
+      pos += put_varint(buffer + pos, (int32_t)((uint32_t)d - d_prev));
+      t_prev = smp->time_ms;
+      d_prev = d;
+
+      if (quant) {
+        int32_t q = (int32_t)std::lroundf(smp->value / s->object.resolution);
+        pos += put_varint(buffer + pos, (int32_t)((uint32_t)q - q_prev));
+        q_prev = q;
+      } else {
+        uint32_t bits = float_bits(smp->value);
+        pos += put_varint(buffer + pos, (int32_t)(bits - v_prev));
+        v_prev = bits;
+      }
+    }
+
+    s->sending = n;
+    series_count++;
+  }
+
+  if (series_count == 0)
+    return 0;
+  buffer[0] = series_count;
+  return pos;
+}
+
+void trend_log_consume(trend_log_t log) {
+  if (!log)
+    return;
+  for (uint8_t i = 0; i < log->count; i++) {
+    trend_series *s = &log->series[i];
+    s->head = (uint16_t)((s->head + s->sending) % s->object.capacity);
+    s->count -= s->sending;
+    s->sending = 0;
+  }
+}
+
+void trend_log_release(trend_log_t log) {
+  if (!log)
+    return;
+  for (uint8_t i = 0; i < log->count; i++) {
+    log->series[i].sending = 0;
+  }
+}
+
+int trend_log_decode(const uint8_t *buffer, uint16_t len, uint16_t *offset,
+                     uint8_t *object_type, uint16_t *object_id,
+                     uint32_t *ages, float *values, uint16_t max_count) {
+  if (!buffer || !offset || !object_type || !object_id || !ages ||
+      !values || len < 1)
+    return XSLOT_ERR_PARAM;
+
+  // 首次调用跳过 COUNT，之后按位置续解直到块尾
+  uint16_t pos = *offset == 0 ? 1 : *offset;
+  if (pos >= len)
+    return 0;
+  if (pos + 14 > len)
+    return XSLOT_ERR_PARAM;
+
+  const uint8_t *hdr = buffer + pos;
+  uint16_t n = (uint16_t)(hdr[3] | (hdr[4] << 8));
+  uint8_t mode = hdr[5];
+  if (n == 0 || mode > TREND_MODE_QUANT)
+    return XSLOT_ERR_PARAM;
+  if (n > max_count)
+    return XSLOT_ERR_NO_MEM;
+
+  *object_type = hdr[0];
+  *object_id = (uint16_t)(hdr[1] | (hdr[2] << 8));
+  uint32_t age0 = get_u32(hdr + 6);
+  uint32_t v = get_u32(hdr + 10);
+  pos += 14;
+
+  float res = 0.0f;
+  if (mode == TREND_MODE_QUANT) {
+    if (pos + 4 > len)
+      return XSLOT_ERR_PARAM;
+    res = bits_float(get_u32(buffer + pos));
+    pos += 4;
+  }
+
+  ages[0] = age0;
+  values[0] = mode == TREND_MODE_QUANT ? (float)(int32_t)v * res
+                                       : bits_float(v);
+  uint32_t elapsed = 0; /* 距首个样本的毫秒数 */
+  int32_t d = 0;
+  for (uint16_t k = 1; k < n; k++) {
+    int32_t dd, dv;
+    if (!get_varint(buffer, len, &pos, &dd) ||
+        !get_varint(buffer, len, &pos, &dv))
+      return XSLOT_ERR_PARAM;
+    d = (int32_t)((uint32_t)d + (uint32_t)dd);
+    elapsed += (uint32_t)d;
+    v += (uint32_t)dv;
+    ages[k] = age0 > elapsed ? age0 - elapsed : 0;
+    values[k] = mode == TREND_MODE_QUANT ? (float)(int32_t)v * res
+                                         : bits_float(v);
+  }
+
+  *offset = pos;
+  return n;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file trend_log.h
+ * @brief 边缘节点趋势日志 (高频采样本地缓存，整块压缩上传)
+ *
+ * 每个配置的对象一个环形样本缓存，满后覆盖最旧样本。上传时所有对象的
+ * 待发送样本编码为一个数据块，由调用方经分片发送:
+ *
+ *   [COUNT:1] 之后每个对象:
+ *   [TYPE:1][ID:2][N:2][MODE:1][AGE0:4][V0:4][RES:4 仅 QUANT]
+ *   其后 N-1 个样本: [时间二阶差分][值差分]，均为 zigzag 变长整数
+ *
+ * 时间以首个样本的"距今毫秒数"加相邻样本间隔表示，接收端无需对时；
+ * 等间隔采样的时间二阶差分为 0，每个样本只占 1 字节。MODE=QUANT 时值按
+ * resolution 量化为整数后差分，MODE=RAW 时对浮点数的位模式差分 (无损)。
+ * 多字节字段小端。
+ */
+#ifndef TREND_LOG_H
+#define TREND_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 每个样本编码后的最大长度 (两个 5 字节变长整数) */
+#define TREND_SAMPLE_MAX_SIZE 10
+
+/**
+ * @brief 样本值的编码方式
+ */
+typedef enum {
+  TREND_MODE_RAW = 0,   /**< 浮点位模式差分 */
+  TREND_MODE_QUANT = 1, /**< 按精度量化后差分 */
+} trend_mode_t;
+
+typedef struct trend_log *trend_log_t;
+
+/**
+ * @brief 创建趋势日志
+ * @param objects 记录的对象 (二进制对象固定按精度 1 量化)
+ * @param count 对象数量 (最多 XSLOT_MAX_TREND_OBJECTS)
+ * @return 句柄，参数无效或内存不足返回 NULL
+ */
+trend_log_t trend_log_create(const xslot_trend_object_t *objects,
+                             uint8_t count);
+
+void trend_log_destroy(trend_log_t log);
+
+/**
+ * @brief 记录样本 (只记录已配置的对象)
+ * @return 因缓存已满被覆盖的旧样本数
+ */
+int trend_log_record(trend_log_t log, const xslot_bacnet_object_t *objects,
+                     uint8_t count, uint32_t now_ms);
+
+/**
+ * @brief 是否有对象的缓存已过半 (应提前上传)
+ */
+bool trend_log_due(trend_log_t log);
+
+/**
+ * @brief 待发送样本总数
+ */
+uint32_t trend_log_pending(trend_log_t log);
+
+/**
+ * @brief 将待发送样本编码为数据块
+ * @return 数据块长度，没有待发送样本返回 0，缓冲区过小返回错误码
+ *
+ * 编码的样本在 consume 或 release 之前视为发送中；数据块装不下的样本
+ * 留待下一块。
+ */
+int trend_log_encode(trend_log_t log, uint32_t now_ms, uint8_t *buffer,
+                     uint16_t buffer_size);
+
+/**
+ * @brief 删除发送中的样本 (整块发送成功后调用)
+ */
+void trend_log_consume(trend_log_t log);
+
+/**
+ * @brief 放弃发送 (发送失败，样本保留)
+ */
+void trend_log_release(trend_log_t log);
+
+/**
+ * @brief 从数据块解码一个对象的样本
+ * @param offset 解码位置，首次调用传入 0
+ * @param ages 输出各样本的"距编码时毫秒数" (随样本先后递减)
+ * @param values 输出样本值
+ * @param max_count ages/values 容量
+ * @return 样本数，块尾返回 0，格式错误或容量不足返回错误码
+ */
+int trend_log_decode(const uint8_t *buffer, uint16_t len, uint16_t *offset,
+                     uint8_t *object_type, uint16_t *object_id,
+                     uint32_t *ages, float *values, uint16_t max_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TREND_LOG_H */
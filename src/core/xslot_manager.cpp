@@ -3,36 +3,274 @@
  * @brief X-Slot 协议栈核心管理器实现
  */
 #include "xslot_manager.h"
+#include "../bacnet/bacnet_incremental.h"
+#include "../bacnet/bacnet_property.h"
+#include "../bacnet/bacnet_serializer.h"
+#include "../hal/hal_interface.h"
+#include "../shm/shm_publisher.h"
 #include "../transport/i_transport.h"
+#include "alarm_engine.h"
+#include "fragment.h"
+#include "history_store.h"
 #include "message_codec.h"
+#include "report_queue.h"
+#include "stream_push.h"
+#include "trend_log.h"
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <xslot/xslot_error.h>
+#include <xslot/xslot_shm.h>
 
-/* HAL 函数声明 */
-extern "C" {
-uint32_t hal_get_timestamp_ms(void);
-void hal_sleep_ms(uint32_t ms);
-}
+/* 断线缓存补发默认参数 */
+#define HISTORY_REPLAY_INTERVAL_MS 200
+#define HISTORY_BATCH_DEFAULT 64
+#define HISTORY_BATCH_MAX 256   /* 256 * 12B 不超过 FRAGMENT_MAX_BLOCK */
+#define HISTORY_RETRY_MS 10000  /* 汇聚节点不可达时的探测间隔 */
+#define HISTORY_RX_TRANSFERS 8  /* 汇聚节点同时重组的边缘节点数 */
+#define TREND_UPLOAD_INTERVAL_MS 60000
+#define TREND_RX_SAMPLES (FRAGMENT_MAX_BLOCK / 2) /* 单个对象的最大样本数 */
+
+/* I/O 线程: 等待接收数据的最长时间 (同时决定周期任务的执行间隔) */
+#define IO_WAIT_MS 50
+/* I/O 线程: 传输层不支持等待时的轮询间隔 */
+#define IO_IDLE_MS 10
+
+/* 采样时间对时: 未对时时的 PING 间隔、对时后的重新对时间隔 */
+#define TIME_SYNC_RETRY_MS 10000
+#define TIME_RESYNC_MS 600000
+
+/* 流式推送: HMI 重发 CREDIT 的间隔、DDC 移除无 CREDIT 订阅者的时间 */
+#define STREAM_CREDIT_MS 1000
+#define STREAM_EXPIRE_MS 10000
+
+/* 切换到备用汇聚节点后回到主汇聚节点的时间 */
+#define HUB_FAILBACK_MS 60000
+
+/* 附加链路: 学习到的节点路由数、与主传输交替等待的间隔 */
+#define LINK_ROUTE_SIZE 16
+#define LINK_POLL_MS 10
+
+/* 中继: 同时等待应答的请求数、等待应答的时间 */
+#define RELAY_TABLE_SIZE 16
+#define RELAY_TIMEOUT_MS 3000
+
+/* 集群: 重复帧判定窗口与记录数 */
+#define CLUSTER_DEDUP_MS 5000
+#define CLUSTER_DEDUP_SIZE 64
+/* 集群: 未配置心跳超时时的归属有效期 */
+#define CLUSTER_OWNER_MS 60000
+
+/* 集群: 最近处理过的帧 */
+struct seen_frame {
+  uint16_t from;
+  uint8_t seq;
+  uint16_t crc;
+  uint32_t time_ms;
+};
+
+/* 集群: 节点最近被本机/对端收到的时间 (0=未收到) */
+struct cluster_node {
+  uint16_t addr;
+  uint32_t local_ms;
+  uint32_t remote_ms;
+};
+
+/* 附加链路: 最近从该链路收到帧的节点 */
+struct link_route {
+  uint16_t addr;
+  uint8_t link; /* aux 下标 */
+  uint32_t time_ms;
+};
+
+/* 中继: 已转发、等待应答的请求 */
+struct relay_entry {
+  uint16_t node;      /* 请求发往的节点 (0=空闲) */
+  uint16_t origin;    /* 请求方 */
+  uint8_t seq;        /* 转发时分配的本机序号，应答按此匹配 */
+  uint8_t origin_seq; /* 请求方的序号，应答发回时改回 */
+  uint8_t reply;      /* 期待的应答命令 */
+  uint8_t link;       /* 请求方所在链路 (0=主传输，i+1=aux[i]) */
+  uint16_t pending;   /* 尚未收到的应答单元数 (见 relay_units) */
+  uint32_t time_ms;
+};
+
+/* 中继: 一次转发 (帧头改写与转发链路) */
+struct relay_hop {
+  uint8_t link;
+  uint16_t from;
+  uint16_t to;
+  uint8_t seq;         /* 转发应答时改回的序号 */
+  relay_entry request; /* 转发请求时登记，node=0 表示转发的是应答 */
+};
+
+/* 逻辑子设备 */
+struct sub_device_slot {
+  xslot_sub_device_t dev;
+  report_queue_t queue; /* 按需创建 (首次上报时) */
+  bool registered;
+};
 
 struct xslot_manager {
   xslot_config_t config;
   xslot_run_mode_t mode;
   node_table_t node_table;
+  alarm_engine_t alarm_engine; /* 按需创建 (汇聚节点配置告警点后) */
+  report_queue_t report_queue; /* 按需创建 (边缘节点首次上报时) */
+  shm_publisher_t shm;         /* 共享内存发布 (可选) */
   i_transport_t *transport;
   bool running;
+
+  /* 附加链路 (config.aux_ports)，与主传输共用节点表 */
+  i_transport_t *aux[XSLOT_MAX_AUX_LINKS];
+  uint8_t rx_link; /* 正在交付帧的链路 (0=主传输，i+1=aux[i]) */
+  link_route routes[LINK_ROUTE_SIZE];
+  relay_entry relays[RELAY_TABLE_SIZE];
+
+  /* 线程模型 */
+  void *lock;               /* 可重入锁，串行化 API 与 I/O 线程 */
+  void *io_thread;          /* XSLOT_THREAD_IO 时的接收线程 */
+  std::atomic<bool> io_run; /* 清除后 I/O 线程退出 */
+
+  bool rx_batch;       /* 正在处理一批接收帧 */
+  bool rx_nodes_dirty; /* 本批更新过节点表，批末发布 */
+
+  /* 本次 poll 的节点状态变化，poll 结束时批量通知 */
+  xslot_node_transition_t node_events[XSLOT_MAX_NODES];
+  uint16_t node_event_count;
   uint8_t seq;
 
   /* 回调 */
   xslot_data_received_cb data_cb;
   xslot_node_online_cb node_cb;
+  xslot_node_batch_cb node_batch_cb;
   xslot_write_request_cb write_cb;
   xslot_report_received_cb report_cb;
+  xslot_history_cb timed_report_cb;
+  xslot_alarm_cb alarm_cb;
+  xslot_property_read_cb property_read_cb;
+  xslot_property_response_cb property_cb;
+
+  /* 逻辑子设备 (下标为子设备号 - 1) */
+  sub_device_slot subs[XSLOT_MAX_SUB_DEVICES];
+  xslot_sub_report_cb sub_report_cb;
+  xslot_sub_property_cb sub_property_cb;
+
+  /* 断线缓存 (边缘节点，可选) */
+  history_store_t store;
+  bool hub_reachable; /* 最近一次发往汇聚节点成功或收到其帧 */
+  uint32_t replay_interval_ms;
+  uint16_t replay_batch;
+  history_record_t *replay_records; /* 每块 replay_batch 条 */
+  xslot_history_sample_t *replay_samples;
+  uint8_t *replay_block; /* FRAGMENT_MAX_BLOCK */
+  fragment_tx_t replay_tx;
+  bool replay_active;
+  uint16_t replay_count; /* 当前块的记录数 */
+  uint8_t replay_xfer;
+  uint32_t replay_last_ms;
+
+  /* 历史样本重组 (汇聚节点，按需创建) */
+  fragment_rx_t history_rx;
+  xslot_history_cb history_cb;
+
+  /* 趋势日志 (边缘节点，可选)，与断线补发共用分片通道和传输编号 */
+  trend_log_t trend;
+  uint32_t trend_interval_ms;
+  uint32_t trend_last_ms; /* 最近一次开始上传 */
+  uint32_t trend_send_ms; /* 最近一次发送分片 */
+  uint8_t *trend_block;   /* FRAGMENT_MAX_BLOCK */
+  fragment_tx_t trend_tx;
+  bool trend_active;
+
+  /* 趋势接收 (汇聚节点，按需分配) */
+  xslot_trend_cb trend_cb;
+  uint32_t *trend_ages;  /* TREND_RX_SAMPLES */
+  uint64_t *trend_times; /* TREND_RX_SAMPLES */
+  float *trend_values;
+
+  /* 汇聚节点组 (多汇聚节点部署，可选) */
+  uint16_t hubs[XSLOT_MAX_HUBS];
+  uint8_t hub_count;
+  uint8_t hub_primary; /* 本节点归属的汇聚节点 (组内下标) */
+  uint8_t hub_index;   /* 当前使用的汇聚节点 (组内下标) */
+  uint32_t hub_failover_ms;
+  uint16_t serving_hub; /* 实际服务的汇聚节点 (0=未知) */
+
+  /* 采样时间对时 (边缘节点，config.report_time) */
+  uint16_t time_hub;     /* 已对时的汇聚节点 (0=未对时) */
+  uint32_t time_offset;  /* 汇聚节点时钟 - 本地时钟 */
+  uint32_t time_rtt;     /* 当前偏差对应的往返时间 */
+  uint32_t time_sync_ms; /* 上次采用对时结果的本地时间 */
+  uint32_t time_ping_ms; /* 上次发送对时 PING 的本地时间 */
+
+  /* 流式推送 (DDC 端，按需创建) */
+  stream_push_t stream;
+
+  /* 流式订阅 (HMI 端) */
+  uint16_t stream_target; /* 订阅的 DDC (0=未订阅) */
+  uint8_t stream_window;
+  uint8_t stream_received; /* 订阅以来收到的推送帧数 (模 256) */
+  uint8_t stream_acked;    /* 最近一次 CREDIT 报告的帧数 */
+  uint32_t stream_credit_ms;
+  xslot_object_ref_t stream_refs[STREAM_PUSH_MAX_REFS];
+  uint8_t stream_ref_count;
+
+  /* 汇聚节点集群 (可选) */
+  xslot_cluster_ops_t cluster;
+  bool cluster_attached;
+  seen_frame seen[CLUSTER_DEDUP_SIZE];
+  uint8_t seen_next;
+  cluster_node owners[XSLOT_MAX_NODES];
 };
 
 /* 前向声明 */
 static void on_frame_received(void *ctx, const uint8_t *data, uint16_t len);
+static void on_frame_decoded(void *ctx, const xslot_frame_t *frame);
+static void on_frame_batch(void *ctx, const transport_frame_view_t *frames,
+                           uint16_t count);
+static void on_route_changed(void *ctx, uint16_t addr, bool created);
+static link_route *link_find(xslot_manager_t *mgr, uint16_t addr);
+static void link_learn(xslot_manager_t *mgr, uint16_t addr);
+static bool relay_route(xslot_manager_t *mgr, uint16_t from, uint16_t to,
+                        uint8_t seq, uint8_t cmd, const uint8_t *payload,
+                        uint8_t len, relay_hop *hop);
+static void relay_forward(xslot_manager_t *mgr, const relay_hop *hop,
+                          uint8_t *buf, uint16_t len);
+static void start_aux_links(xslot_manager_t *mgr);
+static void stop_aux_links(xslot_manager_t *mgr);
+static void link_routes_clear(xslot_manager_t *mgr);
+static int poll_links(xslot_manager_t *mgr, uint32_t timeout_ms);
+static uint16_t hub_target(const xslot_manager_t *mgr);
+static bool hub_failover(xslot_manager_t *mgr, uint8_t *tried);
+static int send_reply(xslot_manager_t *mgr, const xslot_frame_t *frame);
+static bool is_hub_addr(const xslot_manager_t *mgr, uint16_t addr);
+static bool cluster_owns(xslot_manager_t *mgr, uint16_t addr);
+static void cluster_mark(xslot_manager_t *mgr, uint16_t addr, bool local);
+static bool cluster_seen(xslot_manager_t *mgr, const xslot_frame_t *frame);
+static void handle_frame(xslot_manager_t *mgr, const xslot_frame_t *frame);
 static i_transport_t *detect_and_create_transport(xslot_manager_t *mgr);
+static int send_frame(xslot_manager_t *mgr, const xslot_frame_t *frame,
+                      bool confirmed);
+static int send_encoded(xslot_manager_t *mgr, uint16_t to,
+                        const uint8_t *buffer, uint16_t len, bool confirmed);
+static uint8_t next_seq(xslot_manager_t *mgr);
+static int flush_reports(xslot_manager_t *mgr);
+static int flush_sub_reports(xslot_manager_t *mgr);
+static void replay_history(xslot_manager_t *mgr);
+static void upload_trends(xslot_manager_t *mgr);
+static uint64_t history_now(void);
+static int poll_once(xslot_manager_t *mgr, uint32_t timeout_ms);
+static void node_changed(xslot_manager_t *mgr, uint16_t addr, bool online,
+                         uint32_t last_seen);
+static void flush_node_events(xslot_manager_t *mgr);
+static void check_alarm_delays(xslot_manager_t *mgr, uint32_t now);
+static void sync_time(xslot_manager_t *mgr);
+static bool time_valid(const xslot_manager_t *mgr, uint16_t to);
+static void on_pong(xslot_manager_t *mgr, const xslot_frame_t *frame);
+static void flush_stream(xslot_manager_t *mgr);
+static int send_subscribe(xslot_manager_t *mgr);
+static void send_credit(xslot_manager_t *mgr);
 
 xslot_manager_t *xslot_manager_create(const xslot_config_t *config) {
   if (!config)
@@ -47,13 +285,24 @@ xslot_manager_t *xslot_manager_create(const xslot_config_t *config) {
   mgr->mode = XSLOT_MODE_NONE;
   mgr->running = false;
   mgr->seq = 0;
+  mgr->hub_reachable = true;
+  link_routes_clear(mgr);
+
+  mgr->lock = hal_mutex_create();
+  if (!mgr->lock) {
+    std::free(mgr);
+    return nullptr;
+  }
 
   /* 创建节点表 */
   mgr->node_table = node_table_create(XSLOT_MAX_NODES);
   if (!mgr->node_table) {
+    hal_mutex_destroy(mgr->lock);
     std::free(mgr);
     return nullptr;
   }
+  node_table_set_timeout(mgr->node_table, config->heartbeat_timeout_ms,
+                         &config->liveness);
 
   return mgr;
 }
@@ -68,12 +317,83 @@ void xslot_manager_destroy(xslot_manager_t *mgr) {
     node_table_destroy(mgr->node_table);
   }
 
+  if (mgr->alarm_engine) {
+    alarm_engine_destroy(mgr->alarm_engine);
+  }
+
+  if (mgr->report_queue) {
+    report_queue_destroy(mgr->report_queue);
+  }
+
+  for (int i = 0; i < XSLOT_MAX_SUB_DEVICES; i++) {
+    if (mgr->subs[i].queue) {
+      report_queue_destroy(mgr->subs[i].queue);
+    }
+  }
+
+  if (mgr->shm) {
+    shm_publisher_destroy(mgr->shm);
+  }
+
+  if (mgr->store) {
+    history_store_close(mgr->store);
+    std::free(mgr->replay_records);
+    std::free(mgr->replay_samples);
+    std::free(mgr->replay_block);
+  }
+
+  if (mgr->history_rx) {
+    fragment_rx_destroy(mgr->history_rx);
+  }
+
+  trend_log_destroy(mgr->trend);
+  std::free(mgr->trend_block);
+  std::free(mgr->trend_ages);
+  std::free(mgr->trend_times);
+  std::free(mgr->trend_values);
+
+  if (mgr->stream) {
+    stream_push_destroy(mgr->stream);
+  }
+
+  hal_mutex_destroy(mgr->lock);
   std::free(mgr);
 }
 
-int xslot_manager_start(xslot_manager_t *mgr) {
-  if (!mgr)
-    return XSLOT_ERR_PARAM;
+void xslot_manager_lock(xslot_manager_t *mgr) {
+  if (mgr)
+    hal_mutex_lock(mgr->lock);
+}
+
+void xslot_manager_unlock(xslot_manager_t *mgr) {
+  if (mgr)
+    hal_mutex_unlock(mgr->lock);
+}
+
+/**
+ * @brief I/O 线程: 等待数据到达后在锁内处理
+ *
+ * 等待期间不持锁，API 调用只在处理一批帧的间隙排队。
+ */
+static void io_thread_main(void *arg) {
+  xslot_manager_t *mgr = (xslot_manager_t *)arg;
+
+  while (mgr->io_run.load(std::memory_order_acquire)) {
+    hal_mutex_lock(mgr->lock);
+    int frames = poll_once(mgr, 0);
+    hal_mutex_unlock(mgr->lock);
+    if (frames > 0)
+      continue;
+
+    /* 只能等待主传输，有附加链路时缩短等待以兼顾其接收
+     * (附加链路的帧最多延迟 LINK_POLL_MS，空闲时也按此间隔唤醒) */
+    uint32_t wait = mgr->aux[0] ? LINK_POLL_MS : IO_WAIT_MS;
+    if (transport_wait(mgr->transport, wait) < 0)
+      hal_sleep_ms(IO_IDLE_MS);
+  }
+}
+
+static int start_locked(xslot_manager_t *mgr) {
   if (mgr->running)
     return XSLOT_OK;
 
@@ -86,6 +406,9 @@ int xslot_manager_start(xslot_manager_t *mgr) {
 
   /* 设置接收回调 */
   transport_set_receive_callback(mgr->transport, on_frame_received, mgr);
+  transport_set_frame_callback(mgr->transport, on_frame_decoded, mgr);
+  transport_set_batch_callback(mgr->transport, on_frame_batch, mgr);
+  transport_set_route_callback(mgr->transport, on_route_changed, mgr);
 
   /* 启动传输层 */
   int ret = transport_start(mgr->transport);
@@ -96,21 +419,60 @@ int xslot_manager_start(xslot_manager_t *mgr) {
     return ret;
   }
 
+  start_aux_links(mgr);
   mgr->running = true;
   return XSLOT_OK;
 }
 
+int xslot_manager_start(xslot_manager_t *mgr) {
+  if (!mgr)
+    return XSLOT_ERR_PARAM;
+
+  hal_mutex_lock(mgr->lock);
+  int ret = start_locked(mgr);
+  hal_mutex_unlock(mgr->lock);
+  if (ret != XSLOT_OK || mgr->io_thread ||
+      mgr->config.thread.model != XSLOT_THREAD_IO)
+    return ret;
+
+  const xslot_thread_config_t *tc = &mgr->config.thread;
+  hal_thread_attr_t attr;
+  attr.name = tc->name[0] ? tc->name : "xslot-io";
+  attr.cpu_mask = tc->cpu_mask;
+  attr.priority = tc->priority;
+
+  mgr->io_run.store(true, std::memory_order_release);
+  mgr->io_thread = hal_thread_create(io_thread_main, mgr, &attr);
+  if (!mgr->io_thread) {
+    xslot_manager_stop(mgr);
+    return XSLOT_ERR_NOT_SUPPORT;
+  }
+  return XSLOT_OK;
+}
+
 void xslot_manager_stop(xslot_manager_t *mgr) {
-  if (!mgr || !mgr->running)
+  if (!mgr)
     return;
 
-  mgr->running = false;
+  /* 先让 I/O 线程退出 (不持锁，线程可能正等待锁) */
+  if (mgr->io_thread) {
+    mgr->io_run.store(false, std::memory_order_release);
+    hal_thread_join(mgr->io_thread);
+    mgr->io_thread = nullptr;
+  }
 
-  if (mgr->transport) {
-    transport_stop(mgr->transport);
-    transport_destroy(mgr->transport);
-    mgr->transport = nullptr;
+  hal_mutex_lock(mgr->lock);
+  if (mgr->running) {
+    mgr->running = false;
+
+    if (mgr->transport) {
+      transport_stop(mgr->transport);
+      transport_destroy(mgr->transport);
+      mgr->transport = nullptr;
+    }
+    stop_aux_links(mgr);
   }
+  hal_mutex_unlock(mgr->lock);
 }
 
 xslot_run_mode_t xslot_manager_get_mode(xslot_manager_t *mgr) {
@@ -118,17 +480,117 @@ xslot_run_mode_t xslot_manager_get_mode(xslot_manager_t *mgr) {
 }
 
 int xslot_manager_send_frame(xslot_manager_t *mgr, const xslot_frame_t *frame) {
-  if (!mgr || !frame || !mgr->transport)
+  return send_frame(mgr, frame, false);
+}
+
+int xslot_manager_poll(xslot_manager_t *mgr, uint32_t timeout_ms) {
+  if (!mgr)
     return XSLOT_ERR_PARAM;
+  if (mgr->io_thread)
+    return XSLOT_ERR_BUSY; /* 由 I/O 线程处理 */
+
+  hal_mutex_lock(mgr->lock);
+  int ret = poll_once(mgr, timeout_ms);
+  hal_mutex_unlock(mgr->lock);
+  return ret;
+}
+
+/**
+ * @brief 一次接收处理与周期任务 (调用者持锁)
+ */
+static int poll_once(xslot_manager_t *mgr, uint32_t timeout_ms) {
   if (!mgr->running)
     return XSLOT_ERR_NOT_INIT;
 
-  uint8_t buffer[XSLOT_FRAME_MAX_SIZE];
-  int len = xslot_frame_encode(frame, buffer, sizeof(buffer));
-  if (len < 0)
-    return len;
+  /* 各子设备自上次 poll 以来的上报合并发送 */
+  flush_sub_reports(mgr);
 
-  return transport_send(mgr->transport, buffer, len);
+  /* 备用汇聚节点使用一段时间后回到主汇聚节点 */
+  if (mgr->hub_index != mgr->hub_primary &&
+      hal_get_timestamp_ms() - mgr->hub_failover_ms >= HUB_FAILBACK_MS) {
+    mgr->hub_index = mgr->hub_primary;
+  }
+
+  /* 断线期间缓存的记录限速补发 */
+  replay_history(mgr);
+
+  /* 趋势日志整块上传 */
+  upload_trends(mgr);
+
+  /* 上报带采样时间时与汇聚节点对时 */
+  sync_time(mgr);
+
+  /* 接收到的帧经 on_frame_received 在本调用内处理 */
+  int frames = poll_links(mgr, timeout_ms);
+
+  /* 流式推送: 移除失联的订阅者，按收到的信用推送 */
+  if (mgr->stream) {
+    stream_push_expire(mgr->stream, hal_get_timestamp_ms(), STREAM_EXPIRE_MS);
+    flush_stream(mgr);
+  }
+
+  /* 流式订阅: 定期重发 CREDIT，DDC 据此保持订阅 */
+  if (mgr->stream_target &&
+      hal_get_timestamp_ms() - mgr->stream_credit_ms >= STREAM_CREDIT_MS) {
+    send_credit(mgr);
+  }
+
+  if (mgr->config.heartbeat_timeout_ms > 0 ||
+      mgr->config.liveness.sigma_k > 0) {
+    xslot_node_transition_t offline[XSLOT_MAX_NODES];
+    int n = node_table_check_timeout(mgr->node_table, offline, XSLOT_MAX_NODES);
+    for (int i = 0; i < n; i++) {
+      node_changed(mgr, offline[i].addr, false, offline[i].last_seen);
+    }
+    if (mgr->shm) {
+      shm_publisher_update_nodes(mgr->shm, mgr->node_table,
+                                 hal_get_timestamp_ms());
+    }
+  }
+
+  if (mgr->alarm_engine) {
+    check_alarm_delays(mgr, hal_get_timestamp_ms());
+  }
+
+  flush_node_events(mgr);
+  return frames;
+}
+
+/**
+ * @brief 记录节点上下线
+ *
+ * 单节点回调立即调用；批量回调的记录在 poll 结束时一并交付，记录满时
+ * 提前交付。
+ */
+static void node_changed(xslot_manager_t *mgr, uint16_t addr, bool online,
+                         uint32_t last_seen) {
+  if (mgr->node_cb) {
+    mgr->node_cb(addr, online);
+  }
+  if (!mgr->node_batch_cb)
+    return;
+
+  if (mgr->node_event_count >= XSLOT_MAX_NODES) {
+    flush_node_events(mgr);
+  }
+  xslot_node_transition_t *ev = &mgr->node_events[mgr->node_event_count++];
+  ev->addr = addr;
+  ev->online = online;
+  ev->last_seen = last_seen;
+}
+
+static void flush_node_events(xslot_manager_t *mgr) {
+  uint16_t count = mgr->node_event_count;
+  if (count == 0)
+    return;
+
+  /* 先清零: 回调中可能再次 poll */
+  xslot_node_transition_t events[XSLOT_MAX_NODES];
+  std::memcpy(events, mgr->node_events, count * sizeof(events[0]));
+  mgr->node_event_count = 0;
+  if (mgr->node_batch_cb) {
+    mgr->node_batch_cb(events, count);
+  }
 }
 
 int xslot_manager_report(xslot_manager_t *mgr,
@@ -136,14 +598,28 @@ int xslot_manager_report(xslot_manager_t *mgr,
   if (!mgr || !objects || count == 0)
     return XSLOT_ERR_PARAM;
 
-  xslot_frame_t frame;
-  int ret =
-      message_build_report(&frame, mgr->config.local_addr, XSLOT_ADDR_HUB,
-                           mgr->seq++, objects, count, true /* 使用增量格式 */);
+  /* 汇聚节点不可达: 直接写入断线缓存，由 poll 探测恢复 */
+  if (mgr->store && !mgr->hub_reachable) {
+    int overwritten =
+        history_store_append(mgr->store, objects, count, history_now());
+    return overwritten > 0 ? XSLOT_ERR_NO_MEM : XSLOT_OK;
+  }
+
+  if (!mgr->report_queue) {
+    mgr->report_queue = report_queue_create();
+    if (!mgr->report_queue)
+      return XSLOT_ERR_NO_MEM;
+  }
+
+  /* 入队后立即发送: 告警/状态变化先于积压的常规 COV 发出 */
+  int dropped = report_queue_push(mgr->report_queue, objects, count,
+                                  hal_get_timestamp_ms());
+
+  int ret = flush_reports(mgr);
   if (ret != XSLOT_OK)
     return ret;
 
-  return xslot_manager_send_frame(mgr, &frame);
+  return dropped > 0 ? XSLOT_ERR_NO_MEM : XSLOT_OK;
 }
 
 int xslot_manager_write(xslot_manager_t *mgr, uint16_t target,
@@ -153,13 +629,41 @@ int xslot_manager_write(xslot_manager_t *mgr, uint16_t target,
 
   xslot_frame_t frame;
   int ret = message_build_write(&frame, mgr->config.local_addr, target,
-                                mgr->seq++, obj);
+                                next_seq(mgr), obj);
   if (ret != XSLOT_OK)
     return ret;
 
   return xslot_manager_send_frame(mgr, &frame);
 }
 
+int xslot_manager_write_multi(xslot_manager_t *mgr, uint16_t target,
+                              const xslot_bacnet_object_t *objects,
+                              uint8_t count) {
+  if (!mgr || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  /* 单个对象仍使用 WRITE，兼容未支持 WRITE_MULTI 的边缘节点 */
+  if (count == 1)
+    return xslot_manager_write(mgr, target, objects);
+
+  uint8_t sent = 0;
+  while (sent < count) {
+    xslot_frame_t frame;
+    int fit = message_build_write_multi(&frame, mgr->config.local_addr, target,
+                                        next_seq(mgr), objects + sent,
+                                        count - sent);
+    if (fit < 0)
+      return fit;
+
+    int ret = xslot_manager_send_frame(mgr, &frame);
+    if (ret != XSLOT_OK)
+      return ret;
+    sent += fit;
+  }
+
+  return XSLOT_OK;
+}
+
 int xslot_manager_query(xslot_manager_t *mgr, uint16_t target,
                         const uint16_t *object_ids, uint8_t count) {
   if (!mgr || !object_ids || count == 0)
@@ -167,9 +671,172 @@ int xslot_manager_query(xslot_manager_t *mgr, uint16_t target,
 
   xslot_frame_t frame;
   int ret = message_build_query(&frame, mgr->config.local_addr, target,
-                                mgr->seq++, object_ids, count);
+                                next_seq(mgr), object_ids, count);
+  if (ret != XSLOT_OK)
+    return ret;
+
+  return xslot_manager_send_frame(mgr, &frame);
+}
+
+int xslot_manager_query_properties(xslot_manager_t *mgr, uint16_t target,
+                                   uint8_t mask,
+                                   const xslot_object_ref_t *refs,
+                                   uint8_t count) {
+  if (!mgr || !refs || count == 0 || mask == 0)
+    return XSLOT_ERR_PARAM;
+
+  xslot_frame_t frame;
+  int ret = message_build_query_prop(&frame, mgr->config.local_addr, target,
+                                     next_seq(mgr), mask, refs, count);
+  if (ret != XSLOT_OK)
+    return ret;
+
+  return xslot_manager_send_frame(mgr, &frame);
+}
+
+int xslot_manager_stream_publish(xslot_manager_t *mgr,
+                                 const xslot_bacnet_object_t *objects,
+                                 uint8_t count) {
+  if (!mgr || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  if (!mgr->stream) {
+    mgr->stream = stream_push_create();
+    if (!mgr->stream)
+      return XSLOT_ERR_NO_MEM;
+  }
+
+  /* 有信用时立即推送，否则等 CREDIT 到达后在 poll 中推送 */
+  int dropped = stream_push_update(mgr->stream, objects, count);
+  flush_stream(mgr);
+
+  return dropped > 0 ? XSLOT_ERR_NO_MEM : XSLOT_OK;
+}
+
+int xslot_manager_stream_subscribe(xslot_manager_t *mgr, uint16_t target,
+                                   const xslot_object_ref_t *refs,
+                                   uint8_t count, uint8_t window) {
+  if (!mgr || (!refs && count > 0) || count > STREAM_PUSH_MAX_REFS)
+    return XSLOT_ERR_PARAM;
+
+  /* 取消时通知原订阅的 DDC */
+  if (window == 0) {
+    if (mgr->stream_target == 0)
+      return XSLOT_OK;
+    mgr->stream_window = 0;
+    mgr->stream_ref_count = 0;
+    int ret = send_subscribe(mgr);
+    mgr->stream_target = 0;
+    return ret;
+  }
+
+  mgr->stream_target = target;
+  mgr->stream_window = window;
+  if (count > 0)
+    std::memcpy(mgr->stream_refs, refs, count * sizeof(xslot_object_ref_t));
+  mgr->stream_ref_count = count;
+  return send_subscribe(mgr);
+}
+
+int xslot_manager_register_sub(xslot_manager_t *mgr, uint8_t sub,
+                               const xslot_sub_device_t *dev) {
+  if (!mgr || sub == 0 || sub > XSLOT_MAX_SUB_DEVICES)
+    return XSLOT_ERR_PARAM;
+
+  sub_device_slot *slot = &mgr->subs[sub - 1];
+  if (!dev) {
+    if (slot->queue) {
+      report_queue_destroy(slot->queue);
+    }
+    std::memset(slot, 0, sizeof(*slot));
+    return XSLOT_OK;
+  }
+
+  slot->dev = *dev;
+  slot->registered = true;
+  return XSLOT_OK;
+}
+
+int xslot_manager_report_sub(xslot_manager_t *mgr, uint8_t sub,
+                             const xslot_bacnet_object_t *objects,
+                             uint8_t count) {
+  if (!mgr || sub == 0 || sub > XSLOT_MAX_SUB_DEVICES || !objects ||
+      count == 0)
+    return XSLOT_ERR_PARAM;
+
+  sub_device_slot *slot = &mgr->subs[sub - 1];
+  if (!slot->queue) {
+    slot->queue = report_queue_create();
+    if (!slot->queue)
+      return XSLOT_ERR_NO_MEM;
+  }
+
+  /* 只入队，下次 poll 时与其他子设备的上报合并为 MUX 帧 */
+  int dropped =
+      report_queue_push(slot->queue, objects, count, hal_get_timestamp_ms());
+  return dropped > 0 ? XSLOT_ERR_NO_MEM : XSLOT_OK;
+}
+
+int xslot_manager_write_sub(xslot_manager_t *mgr, uint16_t target,
+                            uint8_t sub, const xslot_bacnet_object_t *objects,
+                            uint8_t count) {
+  if (!mgr || sub == 0 || sub > XSLOT_MAX_SUB_DEVICES || !objects ||
+      count == 0)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t body[MESSAGE_MUX_MAX_BODY];
+  uint8_t sent = 0;
+  while (sent < count) {
+    /* 按段容量截取: [COUNT] + 各对象完整格式长度 */
+    uint16_t size = 1;
+    uint8_t fit = 0;
+    while (sent + fit < count) {
+      uint8_t obj_size = bacnet_object_serialized_size(&objects[sent + fit]);
+      if (size + obj_size > MESSAGE_MUX_MAX_BODY)
+        break;
+      size += obj_size;
+      fit++;
+    }
+    if (fit == 0)
+      return XSLOT_ERR_PARAM;
+
+    int len =
+        bacnet_serialize_objects(objects + sent, fit, body, sizeof(body));
+    if (len < 0)
+      return len;
+
+    xslot_frame_t frame;
+    message_mux_begin(&frame, mgr->config.local_addr, target, next_seq(mgr));
+    message_mux_append(&frame, sub, XSLOT_CMD_WRITE_MULTI, body, (uint8_t)len);
+
+    int ret = xslot_manager_send_frame(mgr, &frame);
+    if (ret != XSLOT_OK)
+      return ret;
+    sent += fit;
+  }
+
+  return XSLOT_OK;
+}
+
+int xslot_manager_query_sub_properties(xslot_manager_t *mgr, uint16_t target,
+                                       uint8_t sub, uint8_t mask,
+                                       const xslot_object_ref_t *refs,
+                                       uint8_t count) {
+  if (!mgr || sub == 0 || sub > XSLOT_MAX_SUB_DEVICES || !refs ||
+      count == 0 || mask == 0)
+    return XSLOT_ERR_PARAM;
+
+  xslot_frame_t query;
+  int ret = message_build_query_prop(&query, mgr->config.local_addr, target,
+                                     next_seq(mgr), mask, refs, count);
   if (ret != XSLOT_OK)
     return ret;
+  if (query.len > MESSAGE_MUX_MAX_BODY)
+    return XSLOT_ERR_PARAM;
+
+  xslot_frame_t frame;
+  message_mux_begin(&frame, query.from, query.to, query.seq);
+  message_mux_append(&frame, sub, XSLOT_CMD_QUERY_PROP, query.data, query.len);
 
   return xslot_manager_send_frame(mgr, &frame);
 }
@@ -179,8 +846,8 @@ int xslot_manager_ping(xslot_manager_t *mgr, uint16_t target) {
     return XSLOT_ERR_PARAM;
 
   xslot_frame_t frame;
-  int ret =
-      message_build_ping(&frame, mgr->config.local_addr, target, mgr->seq++);
+  int ret = message_build_ping(&frame, mgr->config.local_addr, target,
+                               next_seq(mgr), hal_get_timestamp_ms());
   if (ret != XSLOT_OK)
     return ret;
 
@@ -202,6 +869,12 @@ void xslot_manager_set_node_cb(xslot_manager_t *mgr, xslot_node_online_cb cb) {
     mgr->node_cb = cb;
 }
 
+void xslot_manager_set_node_batch_cb(xslot_manager_t *mgr,
+                                     xslot_node_batch_cb cb) {
+  if (mgr)
+    mgr->node_batch_cb = cb;
+}
+
 void xslot_manager_set_write_cb(xslot_manager_t *mgr,
                                 xslot_write_request_cb cb) {
   if (mgr)
@@ -214,6 +887,55 @@ void xslot_manager_set_report_cb(xslot_manager_t *mgr,
     mgr->report_cb = cb;
 }
 
+void xslot_manager_set_property_read_cb(xslot_manager_t *mgr,
+                                        xslot_property_read_cb cb) {
+  if (mgr)
+    mgr->property_read_cb = cb;
+}
+
+void xslot_manager_set_property_cb(xslot_manager_t *mgr,
+                                   xslot_property_response_cb cb) {
+  if (mgr)
+    mgr->property_cb = cb;
+}
+
+void xslot_manager_set_sub_report_cb(xslot_manager_t *mgr,
+                                     xslot_sub_report_cb cb) {
+  if (mgr)
+    mgr->sub_report_cb = cb;
+}
+
+void xslot_manager_set_sub_property_cb(xslot_manager_t *mgr,
+                                       xslot_sub_property_cb cb) {
+  if (mgr)
+    mgr->sub_property_cb = cb;
+}
+
+void xslot_manager_set_alarm_cb(xslot_manager_t *mgr, xslot_alarm_cb cb) {
+  if (mgr)
+    mgr->alarm_cb = cb;
+}
+
+int xslot_manager_set_alarm_limit(xslot_manager_t *mgr, uint16_t addr,
+                                  const xslot_alarm_limit_t *limit) {
+  if (!mgr || !limit)
+    return XSLOT_ERR_PARAM;
+
+  if (!mgr->alarm_engine) {
+    mgr->alarm_engine = alarm_engine_create(XSLOT_MAX_ALARM_POINTS);
+    if (!mgr->alarm_engine)
+      return XSLOT_ERR_NO_MEM;
+  }
+
+  return alarm_engine_set_limit(mgr->alarm_engine, addr, limit);
+}
+
+void xslot_manager_remove_alarm_limit(xslot_manager_t *mgr, uint16_t addr,
+                                      uint8_t object_type, uint16_t object_id) {
+  if (mgr && mgr->alarm_engine)
+    alarm_engine_remove(mgr->alarm_engine, addr, object_type, object_id);
+}
+
 int xslot_manager_update_config(xslot_manager_t *mgr, uint8_t cell_id,
                                 int8_t power_dbm) {
   if (!mgr)
@@ -229,47 +951,1330 @@ int xslot_manager_update_config(xslot_manager_t *mgr, uint8_t cell_id,
   return XSLOT_OK;
 }
 
-/* ============================================================================
- * 内部实现
- * ============================================================================
- */
-
-/**
- * @brief 处理接收到的帧
- */
-static void handle_frame(xslot_manager_t *mgr, const xslot_frame_t *frame) {
-  /* 更新节点表 */
-  bool is_new = node_table_update(mgr->node_table, frame->from, 0);
-  if (is_new && mgr->node_cb) {
-    mgr->node_cb(frame->from, true);
-  }
+int xslot_manager_enable_shm(xslot_manager_t *mgr, const char *name) {
+  if (!mgr)
+    return XSLOT_ERR_PARAM;
+  if (mgr->shm)
+    return XSLOT_OK;
 
-  /* 根据命令类型处理 */
-  switch (frame->cmd) {
-  case XSLOT_CMD_PING: {
-    /* 回复 PONG */
-    xslot_frame_t pong;
-    message_build_pong(&pong, mgr->config.local_addr, frame->from, frame->seq);
-    xslot_manager_send_frame(mgr, &pong);
-    break;
+  mgr->shm = shm_publisher_create(name, XSLOT_SHM_MAX_OBJECTS);
+  if (!mgr->shm) {
+#if defined(__linux__) || defined(__APPLE__)
+    return XSLOT_ERR_NO_MEM;
+#else
+    return XSLOT_ERR_NOT_SUPPORT;
+#endif
+  }
+
+  shm_publisher_update_nodes(mgr->shm, mgr->node_table, hal_get_timestamp_ms());
+  return XSLOT_OK;
+}
+
+int xslot_manager_enable_store(xslot_manager_t *mgr,
+                               const xslot_store_config_t *config) {
+  if (!mgr || !config || config->capacity == 0)
+    return XSLOT_ERR_PARAM;
+  if (mgr->store)
+    return XSLOT_OK;
+
+  uint16_t batch = config->batch_size ? config->batch_size
+                                      : HISTORY_BATCH_DEFAULT;
+  if (batch > HISTORY_BATCH_MAX)
+    batch = HISTORY_BATCH_MAX;
+
+  mgr->replay_records =
+      (history_record_t *)std::calloc(batch, sizeof(history_record_t));
+  mgr->replay_samples = (xslot_history_sample_t *)std::calloc(
+      batch, sizeof(xslot_history_sample_t));
+  mgr->replay_block = (uint8_t *)std::malloc(FRAGMENT_MAX_BLOCK);
+  if (mgr->replay_records && mgr->replay_samples && mgr->replay_block) {
+    mgr->store =
+        history_store_open(config->path, config->capacity, config->conflate_ms);
+  }
+  if (!mgr->store) {
+    std::free(mgr->replay_records);
+    std::free(mgr->replay_samples);
+    std::free(mgr->replay_block);
+    mgr->replay_records = nullptr;
+    mgr->replay_samples = nullptr;
+    mgr->replay_block = nullptr;
+    return XSLOT_ERR_NO_MEM;
+  }
+
+  mgr->replay_batch = batch;
+  mgr->replay_interval_ms = config->replay_interval_ms
+                                ? config->replay_interval_ms
+                                : HISTORY_REPLAY_INTERVAL_MS;
+  mgr->replay_active = false;
+  return XSLOT_OK;
+}
+
+uint32_t xslot_manager_store_pending(xslot_manager_t *mgr) {
+  return mgr ? history_store_count(mgr->store) : 0;
+}
+
+void xslot_manager_set_timed_report_cb(xslot_manager_t *mgr,
+                                       xslot_history_cb cb) {
+  if (mgr)
+    mgr->timed_report_cb = cb;
+}
+
+void xslot_manager_set_history_cb(xslot_manager_t *mgr, xslot_history_cb cb) {
+  if (mgr)
+    mgr->history_cb = cb;
+}
+
+int xslot_manager_trend_configure(xslot_manager_t *mgr,
+                                  const xslot_trend_config_t *config) {
+  if (!mgr || !config)
+    return XSLOT_ERR_PARAM;
+
+  trend_log_t trend = trend_log_create(config->objects, config->count);
+  if (!trend)
+    return config->objects && config->count > 0 &&
+                   config->count <= XSLOT_MAX_TREND_OBJECTS
+               ? XSLOT_ERR_NO_MEM
+               : XSLOT_ERR_PARAM;
+
+  if (!mgr->trend_block) {
+    mgr->trend_block = (uint8_t *)std::malloc(FRAGMENT_MAX_BLOCK);
+    if (!mgr->trend_block) {
+      trend_log_destroy(trend);
+      return XSLOT_ERR_NO_MEM;
+    }
+  }
+
+  /* 发送中的块作废，汇聚节点在下一块开始时丢弃未收齐的分片 */
+  trend_log_destroy(mgr->trend);
+  mgr->trend = trend;
+  mgr->trend_active = false;
+  mgr->trend_interval_ms = config->upload_interval_ms
+                               ? config->upload_interval_ms
+                               : TREND_UPLOAD_INTERVAL_MS;
+  mgr->trend_last_ms = hal_get_timestamp_ms();
+  return XSLOT_OK;
+}
+
+int xslot_manager_trend_record(xslot_manager_t *mgr,
+                               const xslot_bacnet_object_t *objects,
+                               uint8_t count) {
+  if (!mgr || (!objects && count > 0))
+    return XSLOT_ERR_PARAM;
+  if (!mgr->trend)
+    return XSLOT_ERR_NOT_INIT;
+
+  int overwritten =
+      trend_log_record(mgr->trend, objects, count, hal_get_timestamp_ms());
+  return overwritten > 0 ? XSLOT_ERR_NO_MEM : XSLOT_OK;
+}
+
+void xslot_manager_set_trend_cb(xslot_manager_t *mgr, xslot_trend_cb cb) {
+  if (mgr)
+    mgr->trend_cb = cb;
+}
+
+int xslot_manager_set_hub_group(xslot_manager_t *mgr, const uint16_t *hubs,
+                                uint8_t count) {
+  if (!mgr || (count > 0 && !hubs) || count > XSLOT_MAX_HUBS)
+    return XSLOT_ERR_PARAM;
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (hubs[i] == XSLOT_ADDR_ANY_HUB || hubs[i] == XSLOT_ADDR_BROADCAST)
+      return XSLOT_ERR_PARAM;
+    mgr->hubs[i] = hubs[i];
+  }
+  mgr->hub_count = count;
+
+  /* 按节点地址划分归属，各节点使用相同列表即得到一致的划分 */
+  mgr->hub_primary = count > 0 ? mgr->config.local_addr % count : 0;
+  mgr->hub_index = mgr->hub_primary;
+  mgr->serving_hub = count > 0 ? hubs[mgr->hub_primary] : 0;
+  return XSLOT_OK;
+}
+
+uint16_t xslot_manager_hub_owner(xslot_manager_t *mgr, uint16_t addr) {
+  if (!mgr)
+    return 0;
+  if (mgr->hub_count == 0)
+    return hub_target(mgr);
+  return mgr->hubs[addr % mgr->hub_count];
+}
+
+int xslot_manager_cluster_attach(xslot_manager_t *mgr,
+                                 const xslot_cluster_ops_t *ops) {
+  if (!mgr)
+    return XSLOT_ERR_PARAM;
+
+  /* 断开后本机发送所有下行，去重与归属记录保留供重连使用 */
+  if (!ops) {
+    mgr->cluster_attached = false;
+    std::memset(&mgr->cluster, 0, sizeof(mgr->cluster));
+    return XSLOT_OK;
+  }
+
+  mgr->cluster = *ops;
+  mgr->cluster_attached = true;
+  return XSLOT_OK;
+}
+
+int xslot_manager_cluster_inject(xslot_manager_t *mgr, const uint8_t *data,
+                                 uint16_t len) {
+  if (!mgr || !data)
+    return XSLOT_ERR_PARAM;
+  if (!mgr->cluster_attached)
+    return XSLOT_ERR_NOT_INIT;
+
+  xslot_frame_t frame;
+  int ret = xslot_frame_decode(data, len, &frame);
+  if (ret != XSLOT_OK)
+    return ret;
+
+  cluster_mark(mgr, frame.from, false);
+  if (!cluster_seen(mgr, &frame)) {
+    handle_frame(mgr, &frame);
+  }
+  return XSLOT_OK;
+}
+
+int xslot_manager_cluster_transmit(xslot_manager_t *mgr, const uint8_t *data,
+                                   uint16_t len, bool confirmed) {
+  if (!mgr || !data || len == 0 || !mgr->transport)
+    return XSLOT_ERR_PARAM;
+  if (!mgr->running)
+    return XSLOT_ERR_NOT_INIT;
+
+  if (confirmed)
+    return transport_send_confirmed(mgr->transport, data, len);
+  return transport_send(mgr->transport, data, len);
+}
+
+bool xslot_manager_cluster_owns(xslot_manager_t *mgr, uint16_t addr) {
+  return mgr ? cluster_owns(mgr, addr) : true;
+}
+
+uint16_t xslot_manager_serving_hub(xslot_manager_t *mgr) {
+  if (!mgr)
+    return 0;
+  if (mgr->serving_hub != 0)
+    return mgr->serving_hub;
+  uint16_t target = hub_target(mgr);
+  return target == XSLOT_ADDR_ANY_HUB ? 0 : target;
+}
+
+/* ============================================================================
+ * 内部实现
+ * ============================================================================
+ */
+
+/**
+ * @brief 地址是否为集群下行归属的对象 (普通节点)
+ */
+static bool cluster_is_node(const xslot_manager_t *mgr, uint16_t addr) {
+  return addr != XSLOT_ADDR_BROADCAST && addr != XSLOT_ADDR_ANY_HUB &&
+         addr != mgr->cluster.peer_addr && !is_hub_addr(mgr, addr);
+}
+
+static cluster_node *cluster_find(xslot_manager_t *mgr, uint16_t addr) {
+  for (int i = 0; i < XSLOT_MAX_NODES; i++) {
+    if (mgr->owners[i].addr == addr)
+      return &mgr->owners[i];
+  }
+  return nullptr;
+}
+
+/**
+ * @brief 节点的下行是否归属本机
+ *
+ * 有效期内只有一端收到该节点的帧时归属该端，两端都收到时归属地址小者，
+ * 都没有收到时由本机发送。
+ */
+static bool cluster_owns(xslot_manager_t *mgr, uint16_t addr) {
+  if (!mgr->cluster_attached)
+    return true;
+
+  const cluster_node *node = cluster_find(mgr, addr);
+  if (!node)
+    return true;
+
+  uint32_t now = hal_get_timestamp_ms();
+  uint32_t window = mgr->config.heartbeat_timeout_ms
+                        ? mgr->config.heartbeat_timeout_ms
+                        : CLUSTER_OWNER_MS;
+  bool local = node->local_ms && now - node->local_ms < window;
+  bool remote = node->remote_ms && now - node->remote_ms < window;
+  if (local && remote)
+    return mgr->config.local_addr < mgr->cluster.peer_addr;
+  return local || !remote;
+}
+
+/**
+ * @brief 记录节点被本机或对端收到
+ */
+static void cluster_mark(xslot_manager_t *mgr, uint16_t addr, bool local) {
+  if (!cluster_is_node(mgr, addr))
+    return;
+
+  cluster_node *node = cluster_find(mgr, addr);
+  if (!node) {
+    /* 新节点: 取空位，表满时替换最久未收到的节点 */
+    node = &mgr->owners[0];
+    for (int i = 0; i < XSLOT_MAX_NODES; i++) {
+      cluster_node *n = &mgr->owners[i];
+      if (n->addr == 0) {
+        node = n;
+        break;
+      }
+      uint32_t last = n->local_ms > n->remote_ms ? n->local_ms : n->remote_ms;
+      uint32_t oldest =
+          node->local_ms > node->remote_ms ? node->local_ms : node->remote_ms;
+      if ((int32_t)(last - oldest) < 0)
+        node = n;
+    }
+    node->addr = addr;
+    node->local_ms = 0;
+    node->remote_ms = 0;
+  }
+
+  uint32_t now = hal_get_timestamp_ms() | 1; /* 0 表示未收到 */
+  if (local) {
+    node->local_ms = now;
+  } else {
+    node->remote_ms = now;
+  }
+}
+
+/**
+ * @brief 检查并记录帧 (两个汇聚节点都收到的同一帧只处理一次)
+ * @return true=重复帧
+ */
+static bool cluster_seen(xslot_manager_t *mgr, const xslot_frame_t *frame) {
+  uint32_t now = hal_get_timestamp_ms();
+  for (int i = 0; i < CLUSTER_DEDUP_SIZE; i++) {
+    const seen_frame *s = &mgr->seen[i];
+    if (s->time_ms && s->from == frame->from && s->seq == frame->seq &&
+        s->crc == frame->crc && now - s->time_ms < CLUSTER_DEDUP_MS)
+      return true;
+  }
+
+  seen_frame *s = &mgr->seen[mgr->seen_next];
+  mgr->seen_next = (mgr->seen_next + 1) % CLUSTER_DEDUP_SIZE;
+  s->from = frame->from;
+  s->seq = frame->seq;
+  s->crc = frame->crc;
+  s->time_ms = now | 1;
+  return false;
+}
+
+/**
+ * @brief 编码并发送帧
+ * @param confirmed 是否等待端到端送达确认 (传输层不支持时等同普通发送)
+ */
+static int send_frame(xslot_manager_t *mgr, const xslot_frame_t *frame,
+                      bool confirmed) {
+  if (!mgr || !frame || !mgr->transport)
+    return XSLOT_ERR_PARAM;
+  if (!mgr->running)
+    return XSLOT_ERR_NOT_INIT;
+
+  uint8_t buffer[XSLOT_FRAME_MAX_SIZE];
+  int len = xslot_frame_encode(frame, buffer, sizeof(buffer));
+  if (len < 0)
+    return len;
+  return send_encoded(mgr, frame->to, buffer, (uint16_t)len, confirmed);
+}
+
+/**
+ * @brief 按目标地址选择链路发送已编码的帧 (中继转发的帧同样经此发出)
+ */
+static int send_encoded(xslot_manager_t *mgr, uint16_t to,
+                        const uint8_t *buffer, uint16_t len, bool confirmed) {
+  /* 附加链路: 广播同时从各附加链路发出，附加链路上的节点只从该链路发送 */
+  if (mgr->aux[0]) {
+    if (to == XSLOT_ADDR_BROADCAST) {
+      for (int i = 0; i < XSLOT_MAX_AUX_LINKS && mgr->aux[i]; i++)
+        transport_send(mgr->aux[i], buffer, len);
+    } else if (const link_route *route = link_find(mgr, to)) {
+      i_transport_t *link = mgr->aux[route->link];
+      return confirmed ? transport_send_confirmed(link, buffer, len)
+                       : transport_send(link, buffer, len);
+    }
+  }
+
+  /* 集群: 归属对端的节点由对端的模组发送 */
+  if (mgr->cluster_attached && mgr->cluster.on_downlink &&
+      cluster_is_node(mgr, to) && !cluster_owns(mgr, to)) {
+    return mgr->cluster.on_downlink(mgr->cluster.ctx, buffer, len, confirmed);
+  }
+
+  if (confirmed)
+    return transport_send_confirmed(mgr->transport, buffer, len);
+  return transport_send(mgr->transport, buffer, len);
+}
+
+/**
+ * @brief 地址是否为汇聚节点 (默认地址、汇聚节点组成员或实际服务的汇聚节点)
+ */
+static bool is_hub_addr(const xslot_manager_t *mgr, uint16_t addr) {
+  if (addr == XSLOT_ADDR_HUB || (addr != 0 && addr == mgr->serving_hub))
+    return true;
+  for (uint8_t i = 0; i < mgr->hub_count; i++) {
+    if (mgr->hubs[i] == addr)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief 上报目标地址
+ */
+static uint16_t hub_target(const xslot_manager_t *mgr) {
+  if (mgr->hub_count > 0)
+    return mgr->hubs[mgr->hub_index];
+  return mgr->config.hub_addr ? mgr->config.hub_addr : XSLOT_ADDR_HUB;
+}
+
+/**
+ * @brief 发往汇聚节点失败: 切换到组内下一个汇聚节点
+ * @param tried 本轮已尝试的汇聚节点数
+ * @return true=已切换，可重发
+ */
+static bool hub_failover(xslot_manager_t *mgr, uint8_t *tried) {
+  if (mgr->hub_count < 2 || *tried >= mgr->hub_count)
+    return false;
+
+  mgr->hub_index = (mgr->hub_index + 1) % mgr->hub_count;
+  mgr->hub_failover_ms = hal_get_timestamp_ms();
+  mgr->serving_hub = mgr->hubs[mgr->hub_index];
+  (*tried)++;
+  return true;
+}
+
+/**
+ * @brief 断线缓存使用的时间 (无实时时钟时退化为开机毫秒)
+ */
+static uint64_t history_now(void) {
+  uint64_t utc = hal_get_utc_ms();
+  return utc ? utc : hal_get_timestamp_ms();
+}
+
+/**
+ * @brief 上报队列两个通道的全部对象转入断线缓存
+ */
+static void spill_reports(xslot_manager_t *mgr) {
+  xslot_bacnet_object_t objects[REPORT_QUEUE_LANE_SIZE];
+  uint64_t now = history_now();
+
+  const report_lane_t lanes[] = {REPORT_LANE_PRIORITY, REPORT_LANE_ROUTINE};
+  for (report_lane_t lane : lanes) {
+    int count = report_queue_peek(mgr->report_queue, lane, objects,
+                                  REPORT_QUEUE_LANE_SIZE);
+    if (count <= 0)
+      continue;
+    history_store_append(mgr->store, objects, (uint8_t)count, now);
+    report_queue_consume(mgr->report_queue, lane, count);
+  }
+}
+
+/**
+ * @brief 补发断线缓存 (每次 poll 最多发送一个分片)
+ *
+ * 最旧的一批记录编码为历史数据块，按 replay_interval_ms 逐片确认发送，
+ * 整块发送成功后才从缓存删除。任一分片失败则放弃本块并标记汇聚节点
+ * 不可达，之后每 HISTORY_RETRY_MS 重新尝试。样本时间以"距今毫秒数"
+ * 编码，汇聚节点无需与边缘节点对时。
+ */
+static void replay_history(xslot_manager_t *mgr) {
+  if (!mgr->store)
+    return;
+
+  uint32_t now = hal_get_timestamp_ms();
+  uint32_t wait =
+      mgr->hub_reachable ? mgr->replay_interval_ms : HISTORY_RETRY_MS;
+  if (now - mgr->replay_last_ms < wait)
+    return;
+
+  if (!mgr->replay_active) {
+    /* 趋势数据块发送中，汇聚节点按来源重组，不能交错 */
+    if (mgr->trend_active)
+      return;
+
+    int n = history_store_peek(mgr->store, mgr->replay_records,
+                               mgr->replay_batch);
+    if (n <= 0)
+      return;
+
+    uint64_t utc = history_now();
+    for (int i = 0; i < n; i++) {
+      uint64_t t = mgr->replay_records[i].time_ms;
+      uint64_t age = utc > t ? utc - t : 0;
+      mgr->replay_samples[i].age_ms =
+          age > UINT32_MAX ? UINT32_MAX : (uint32_t)age;
+      mgr->replay_samples[i].object = mgr->replay_records[i].object;
+    }
+
+    int len = message_encode_history(mgr->replay_samples, (uint16_t)n,
+                                     mgr->replay_block, FRAGMENT_MAX_BLOCK);
+    if (len < 0 ||
+        fragment_tx_begin(&mgr->replay_tx, mgr->replay_xfer++,
+                          FRAGMENT_KIND_HISTORY, mgr->replay_block,
+                          (uint16_t)len) != XSLOT_OK) {
+      /* 无法编码的记录直接丢弃，避免阻塞后续数据 */
+      history_store_consume(mgr->store, (uint16_t)n);
+      return;
+    }
+    mgr->replay_count = (uint16_t)n;
+    mgr->replay_active = true;
+  }
+
+  mgr->replay_last_ms = now;
+
+  xslot_frame_t frame;
+  fragment_tx_build(&mgr->replay_tx, &frame, mgr->config.local_addr,
+                    hub_target(mgr), next_seq(mgr));
+  if (send_frame(mgr, &frame, true) != XSLOT_OK) {
+    uint8_t tried = 1;
+    hub_failover(mgr, &tried);
+    history_store_release(mgr->store);
+    mgr->replay_active = false;
+    mgr->hub_reachable = false;
+    return;
+  }
+
+  mgr->hub_reachable = true;
+  if (fragment_tx_advance(&mgr->replay_tx)) {
+    history_store_consume(mgr->store, mgr->replay_count);
+    mgr->replay_active = false;
+  }
+}
+
+/**
+ * @brief 上传趋势日志 (每次 poll 最多发送一个分片)
+ *
+ * 每 trend_interval_ms，或任一对象缓存过半时，所有待发送样本编码为一个
+ * 数据块，按补发的节奏逐片确认发送，整块成功后才从缓存删除。与断线补发
+ * 互斥 (汇聚节点每个来源只重组一个传输)，失败处理与补发相同。
+ */
+static void upload_trends(xslot_manager_t *mgr) {
+  if (!mgr->trend || mgr->replay_active)
+    return;
+
+  uint32_t now = hal_get_timestamp_ms();
+  if (!mgr->trend_active) {
+    uint32_t wait =
+        mgr->hub_reachable ? mgr->trend_interval_ms : HISTORY_RETRY_MS;
+    bool due = mgr->hub_reachable && trend_log_due(mgr->trend);
+    if (now - mgr->trend_last_ms < wait && !due)
+      return;
+
+    mgr->trend_last_ms = now;
+    int len =
+        trend_log_encode(mgr->trend, now, mgr->trend_block, FRAGMENT_MAX_BLOCK);
+    if (len <= 0 ||
+        fragment_tx_begin(&mgr->trend_tx, mgr->replay_xfer++,
+                          FRAGMENT_KIND_TREND, mgr->trend_block,
+                          (uint16_t)len) != XSLOT_OK) {
+      trend_log_release(mgr->trend);
+      return;
+    }
+    mgr->trend_active = true;
+  } else {
+    uint32_t interval = mgr->replay_interval_ms ? mgr->replay_interval_ms
+                                                : HISTORY_REPLAY_INTERVAL_MS;
+    if (now - mgr->trend_send_ms < interval)
+      return;
+  }
+
+  mgr->trend_send_ms = now;
+
+  xslot_frame_t frame;
+  fragment_tx_build(&mgr->trend_tx, &frame, mgr->config.local_addr,
+                    hub_target(mgr), next_seq(mgr));
+  if (send_frame(mgr, &frame, true) != XSLOT_OK) {
+    uint8_t tried = 1;
+    hub_failover(mgr, &tried);
+    trend_log_release(mgr->trend);
+    mgr->trend_active = false;
+    mgr->hub_reachable = false;
+    return;
+  }
+
+  mgr->hub_reachable = true;
+  if (fragment_tx_advance(&mgr->trend_tx)) {
+    trend_log_consume(mgr->trend);
+    mgr->trend_active = false;
+  }
+}
+
+/**
+ * @brief 发送应答帧 (集群中只由归属本机的节点应答，另一端不重复应答)
+ */
+static int send_reply(xslot_manager_t *mgr, const xslot_frame_t *frame) {
+  if (mgr->cluster_attached && cluster_is_node(mgr, frame->to) &&
+      !cluster_owns(mgr, frame->to))
+    return XSLOT_OK;
+  return send_frame(mgr, frame, false);
+}
+
+/**
+ * @brief 发送上报队列中的数据 (优先通道先发)
+ *
+ * 优先通道使用完整格式，使 FLAGS (OOS/InAlarm) 随帧到达汇聚节点；
+ * 常规通道使用增量格式节省空口。发送失败的对象保留在队列中，
+ * 下次上报时重发。
+ */
+static int flush_reports(xslot_manager_t *mgr) {
+  xslot_bacnet_object_t objects[REPORT_QUEUE_LANE_SIZE];
+  uint32_t times[REPORT_QUEUE_LANE_SIZE];
+  uint8_t tried = 1;
+
+  for (;;) {
+    report_lane_t lane = REPORT_LANE_PRIORITY;
+    if (report_queue_pending(mgr->report_queue, lane) == 0) {
+      lane = REPORT_LANE_ROUTINE;
+      if (report_queue_pending(mgr->report_queue, lane) == 0)
+        return XSLOT_OK;
+    }
+    bool priority = lane == REPORT_LANE_PRIORITY;
+    uint16_t to = hub_target(mgr);
+    bool timed = time_valid(mgr, to);
+
+    int count = report_queue_peek(mgr->report_queue, lane, objects,
+                                  REPORT_QUEUE_LANE_SIZE);
+
+    /* 按帧容量截取: [COUNT] + 各对象序列化长度 (+ 采样时间) */
+    uint16_t size = timed ? 1 + MESSAGE_REPORT_TIME_SIZE(0) : 1;
+    int fit = 0;
+    while (fit < count) {
+      uint8_t obj_size = priority ? bacnet_object_serialized_size(&objects[fit])
+                                  : bacnet_incremental_size(&objects[fit]);
+      if (timed)
+        obj_size++;
+      if (size + obj_size > XSLOT_MAX_DATA_LEN)
+        break;
+      size += obj_size;
+      fit++;
+    }
+    if (fit == 0)
+      fit = 1;
+
+    xslot_frame_t frame;
+    int ret = message_build_report(&frame, mgr->config.local_addr, to,
+                                   next_seq(mgr), objects, fit,
+                                   !priority /* 常规数据使用增量格式 */);
+    if (ret != XSLOT_OK) {
+      /* 无法编码的对象直接丢弃，避免阻塞后续数据 */
+      report_queue_consume(mgr->report_queue, lane, fit);
+      return ret;
+    }
+
+    if (timed) {
+      /* 采样时间换算为汇聚节点时钟；装不下时不带时间发送 */
+      report_queue_peek_times(mgr->report_queue, lane, times, fit);
+      for (int i = 0; i < fit; i++) {
+        times[i] += mgr->time_offset;
+      }
+      message_report_add_times(&frame, times);
+    }
+
+    ret = send_frame(mgr, &frame, priority && mgr->config.alarm_confirm);
+    if (ret != XSLOT_OK) {
+      /* 汇聚节点组内切换到下一个后重发 */
+      if (hub_failover(mgr, &tried))
+        continue;
+      if (!mgr->store)
+        return ret;
+      /* 汇聚节点不可达: 队列中的对象转入断线缓存 */
+      mgr->hub_reachable = false;
+      spill_reports(mgr);
+      return XSLOT_OK;
+    }
+
+    mgr->hub_reachable = true;
+    report_queue_consume(mgr->report_queue, lane, fit);
+  }
+}
+
+/**
+ * @brief 对时结果是否适用于发往 to 的上报
+ */
+static bool time_valid(const xslot_manager_t *mgr, uint16_t to) {
+  if (mgr->time_hub == 0)
+    return false;
+  if (to == XSLOT_ADDR_ANY_HUB)
+    return mgr->serving_hub == mgr->time_hub;
+  return to == mgr->time_hub;
+}
+
+/**
+ * @brief 与上报目标对时 (边缘节点，config.report_time)
+ *
+ * 未对时 (或上报目标已切换) 时每 TIME_SYNC_RETRY_MS 发送一次 PING，
+ * 之后每 TIME_RESYNC_MS 重新对时以跟踪时钟漂移。
+ */
+static void sync_time(xslot_manager_t *mgr) {
+  if (!mgr->config.report_time)
+    return;
+
+  uint32_t now = hal_get_timestamp_ms();
+  bool valid = time_valid(mgr, hub_target(mgr));
+  uint32_t wait = valid ? TIME_RESYNC_MS : TIME_SYNC_RETRY_MS;
+  if (mgr->time_ping_ms != 0 && now - mgr->time_ping_ms < wait)
+    return;
+  if (valid && now - mgr->time_sync_ms < TIME_RESYNC_MS)
+    return;
+
+  mgr->time_ping_ms = now ? now : 1;
+  xslot_manager_ping(mgr, hub_target(mgr));
+}
+
+/**
+ * @brief 处理 PONG 中的对时信息
+ *
+ * 偏差取往返中点估计，误差不超过 RTT/2。RTT 不大于当前结果时才采用
+ * (多跳链路上排队较少的那次交换更准)，超过 TIME_RESYNC_MS 后无条件
+ * 更新。
+ */
+static void on_pong(xslot_manager_t *mgr, const xslot_frame_t *frame) {
+  uint32_t ping_ms, peer_ms;
+  if (!mgr->config.report_time || !is_hub_addr(mgr, frame->from) ||
+      message_parse_pong(frame, &ping_ms, &peer_ms) != XSLOT_OK)
+    return;
+
+  uint32_t now = hal_get_timestamp_ms();
+  uint32_t rtt = now - ping_ms;
+  if (rtt > TIME_RESYNC_MS)
+    return; /* 非本次会话的 PING */
+
+  bool same_hub = mgr->time_hub == frame->from;
+  if (same_hub && rtt > mgr->time_rtt &&
+      now - mgr->time_sync_ms < TIME_RESYNC_MS)
+    return;
+
+  mgr->time_hub = frame->from;
+  mgr->time_offset = peer_ms - (ping_ms + rtt / 2);
+  mgr->time_rtt = rtt;
+  mgr->time_sync_ms = now;
+}
+
+/**
+ * @brief 合并发送各子设备的上报
+ *
+ * 所有子设备的优先通道先于常规通道装帧，每个子设备每通道占一段，
+ * 一帧装满即发送。含优先数据的帧按 alarm_confirm 使用确认发送。
+ * 与 flush_reports 相同，发送成功后才出队。
+ */
+static int flush_sub_reports(xslot_manager_t *mgr) {
+  xslot_bacnet_object_t objects[REPORT_QUEUE_LANE_SIZE];
+  uint8_t body[MESSAGE_MUX_MAX_BODY];
+
+  for (;;) {
+    struct {
+      uint8_t index;
+      report_lane_t lane;
+      uint8_t count;
+    } taken[XSLOT_MAX_SUB_DEVICES * 2];
+    uint8_t ntaken = 0;
+    bool confirmed = false;
+    bool full = false;
+
+    xslot_frame_t frame;
+    message_mux_begin(&frame, mgr->config.local_addr, hub_target(mgr),
+                      next_seq(mgr));
+
+    for (int l = REPORT_LANE_PRIORITY; l <= REPORT_LANE_ROUTINE && !full;
+         l++) {
+      report_lane_t lane = (report_lane_t)l;
+      bool priority = lane == REPORT_LANE_PRIORITY;
+
+      for (uint8_t i = 0; i < XSLOT_MAX_SUB_DEVICES && !full; i++) {
+        report_queue_t queue = mgr->subs[i].queue;
+        if (!queue || report_queue_pending(queue, lane) == 0)
+          continue;
+
+        int room = XSLOT_MAX_DATA_LEN - frame.len - MESSAGE_MUX_SEGMENT_HEADER;
+        int count =
+            report_queue_peek(queue, lane, objects, REPORT_QUEUE_LANE_SIZE);
+
+        uint16_t size = 1;
+        int fit = 0;
+        while (fit < count) {
+          uint8_t obj_size = priority
+                                 ? bacnet_object_serialized_size(&objects[fit])
+                                 : bacnet_incremental_size(&objects[fit]);
+          if (size + obj_size > room)
+            break;
+          size += obj_size;
+          fit++;
+        }
+        if (fit < count)
+          full = true;
+        if (fit == 0)
+          continue;
+
+        int len = priority
+                      ? bacnet_serialize_objects(objects, fit, body, room)
+                      : bacnet_incremental_serialize_batch(objects, fit, body,
+                                                           room);
+        if (len < 0) {
+          /* 无法编码的对象直接丢弃，避免阻塞后续数据 */
+          report_queue_consume(queue, lane, fit);
+          continue;
+        }
+
+        message_mux_append(&frame, i + 1, XSLOT_CMD_REPORT, body,
+                           (uint8_t)len);
+        taken[ntaken].index = i;
+        taken[ntaken].lane = lane;
+        taken[ntaken].count = fit;
+        ntaken++;
+        confirmed |= priority;
+      }
+    }
+
+    if (ntaken == 0)
+      return XSLOT_OK;
+
+    int ret = send_frame(mgr, &frame, confirmed && mgr->config.alarm_confirm);
+    if (ret != XSLOT_OK) {
+      /* 下次 poll 发往组内下一个汇聚节点 */
+      uint8_t tried = 1;
+      hub_failover(mgr, &tried);
+      return ret;
+    }
+
+    for (uint8_t i = 0; i < ntaken; i++) {
+      report_queue_consume(mgr->subs[taken[i].index].queue, taken[i].lane,
+                           taken[i].count);
+    }
+  }
+}
+
+/**
+ * @brief 按信用推送订阅者待推送的对象 (DDC 端)
+ *
+ * 使用完整格式，使 FLAGS 随值到达 HMI。发送失败时标记保留，下次 poll
+ * 或发布时重发。
+ */
+static void flush_stream(xslot_manager_t *mgr) {
+  if (!mgr->stream)
+    return;
+
+  xslot_bacnet_object_t objects[XSLOT_MAX_DATA_LEN / 4];
+
+  for (uint8_t slot = 0; slot < STREAM_PUSH_MAX_SUBSCRIBERS; slot++) {
+    for (;;) {
+      uint16_t to;
+      int count = stream_push_peek(mgr->stream, slot, &to, objects,
+                                   XSLOT_MAX_DATA_LEN / 4);
+      if (count == 0)
+        break;
+
+      /* 按帧容量截取: [COUNT] + 各对象序列化长度 */
+      uint16_t size = 1;
+      int fit = 0;
+      while (fit < count) {
+        uint8_t obj_size = bacnet_object_serialized_size(&objects[fit]);
+        if (size + obj_size > XSLOT_MAX_DATA_LEN)
+          break;
+        size += obj_size;
+        fit++;
+      }
+
+      xslot_frame_t frame;
+      if (fit == 0 ||
+          message_build_report(&frame, mgr->config.local_addr, to,
+                               next_seq(mgr), objects, fit,
+                               false) != XSLOT_OK ||
+          send_frame(mgr, &frame, false) != XSLOT_OK)
+        break;
+
+      stream_push_consume(mgr->stream, slot, fit);
+    }
+  }
+}
+
+/**
+ * @brief 发送订阅 (HMI 端，计数从零开始)
+ */
+static int send_subscribe(xslot_manager_t *mgr) {
+  xslot_frame_t frame;
+  int ret = message_build_subscribe(&frame, mgr->config.local_addr,
+                                    mgr->stream_target, next_seq(mgr),
+                                    mgr->stream_window, mgr->stream_refs,
+                                    mgr->stream_ref_count);
+  if (ret != XSLOT_OK)
+    return ret;
+
+  mgr->stream_received = 0;
+  mgr->stream_acked = 0;
+  mgr->stream_credit_ms = hal_get_timestamp_ms();
+  return send_frame(mgr, &frame, false);
+}
+
+/**
+ * @brief 报告收到的推送帧数 (HMI 端)
+ */
+static void send_credit(xslot_manager_t *mgr) {
+  xslot_frame_t frame;
+  message_build_credit(&frame, mgr->config.local_addr, mgr->stream_target,
+                       next_seq(mgr), mgr->stream_received, mgr->stream_window);
+  if (send_frame(mgr, &frame, false) == XSLOT_OK) {
+    mgr->stream_acked = mgr->stream_received;
+  }
+  mgr->stream_credit_ms = hal_get_timestamp_ms();
+}
+
+/**
+ * @brief 交付带采样时间的上报 (汇聚节点)
+ *
+ * 样本的 age_ms 为采样至今的毫秒数；上报未携带采样时间时为 0 (以到达
+ * 时间为采样时间)。
+ */
+static void deliver_timed_report(xslot_manager_t *mgr,
+                                 const xslot_frame_t *frame,
+                                 const xslot_bacnet_object_t *objects,
+                                 int count) {
+  uint32_t times[16];
+  int n = message_parse_report_times(frame, times, 16);
+  uint32_t now = hal_get_timestamp_ms();
+
+  xslot_history_sample_t samples[16];
+  for (int i = 0; i < count; i++) {
+    uint32_t age = i < n ? now - times[i] : 0;
+    samples[i].age_ms = (int32_t)age < 0 ? 0 : age; /* 对时误差 */
+    samples[i].object = objects[i];
+  }
+  mgr->timed_report_cb(frame->from, samples, (uint16_t)count);
+}
+
+/**
+ * @brief 分发延时到期的待定告警 (事件数组装满时继续取，直到取完)
+ */
+static void check_alarm_delays(xslot_manager_t *mgr, uint32_t now) {
+  xslot_alarm_event_t events[16];
+  int n;
+  do {
+    n = alarm_engine_check_delays(mgr->alarm_engine, now, events, 16);
+    if (mgr->alarm_cb) {
+      for (int i = 0; i < n; i++) {
+        mgr->alarm_cb(&events[i]);
+      }
+    }
+  } while (n == 16);
+}
+
+/**
+ * @brief 评估告警并按优先级分发事件
+ * @param typed false 表示对象类型是按值类型推断的 (旧版节点的增量上报)
+ */
+static void evaluate_alarms(xslot_manager_t *mgr, uint16_t from,
+                            const xslot_bacnet_object_t *objects,
+                            uint8_t count, bool typed) {
+  xslot_alarm_event_t events[16];
+  uint32_t now = hal_get_timestamp_ms();
+
+  int n = alarm_engine_evaluate(mgr->alarm_engine, from, objects, count,
+                                typed, now, events, 16);
+  if (mgr->alarm_cb) {
+    for (int i = 0; i < n; i++) {
+      mgr->alarm_cb(&events[i]);
+    }
+  }
+
+  /* 顺带处理其他点延时到期的待定告警 (含本次因事件数组已满而待定的) */
+  check_alarm_delays(mgr, now);
+}
+
+/**
+ * @brief 应答属性选择查询
+ *
+ * 每批最多取 4 个对象的属性，帧装不下的部分顺延到下一帧，
+ * 所有响应帧沿用查询帧的序号，栈上只保留一小批属性集。
+ */
+static void send_properties(xslot_manager_t *mgr, const xslot_frame_t *query,
+                            uint8_t mask, const xslot_object_ref_t *refs,
+                            uint8_t count) {
+  xslot_property_set_t batch[4];
+  uint8_t n = 0;
+
+  for (uint8_t i = 0; i < count; i++) {
+    xslot_property_set_t *props = &batch[n++];
+    std::memset(props, 0, sizeof(*props));
+    props->object_id = refs[i].object_id;
+    props->object_type = refs[i].object_type;
+    /* 对象不存在时以空掩码应答 */
+    if (mgr->property_read_cb(refs[i].object_type, refs[i].object_id, mask,
+                              props)) {
+      props->mask &= mask;
+    } else {
+      props->mask = 0;
+    }
+
+    bool last = (i + 1 == count);
+    while (n == 4 || (last && n > 0)) {
+      xslot_frame_t frame;
+      int fit = message_build_prop_response(&frame, mgr->config.local_addr,
+                                            query->from, query->seq, batch, n);
+      if (fit <= 0)
+        return;
+      send_reply(mgr, &frame);
+      n -= (uint8_t)fit;
+      std::memmove(batch, batch + fit, n * sizeof(batch[0]));
+    }
+  }
+}
+
+/**
+ * @brief 向 MUX 应答帧追加一段，装不下时先发出当前应答帧
+ */
+static void mux_reply(xslot_manager_t *mgr, xslot_frame_t *reply, uint8_t sub,
+                      uint8_t cmd, const uint8_t *body, uint8_t len) {
+  if (message_mux_append(reply, sub, cmd, body, len) == XSLOT_OK)
+    return;
+
+  send_reply(mgr, reply);
+  message_mux_begin(reply, reply->from, reply->to, reply->seq);
+  message_mux_append(reply, sub, cmd, body, len);
+}
+
+/**
+ * @brief 应答发往子设备的属性选择查询
+ */
+static void reply_sub_properties(xslot_manager_t *mgr, xslot_frame_t *reply,
+                                 uint8_t sub, const xslot_sub_device_t *dev,
+                                 const xslot_frame_t *query) {
+  uint8_t mask;
+  xslot_object_ref_t refs[XSLOT_MAX_DATA_LEN / 3];
+  int count =
+      message_parse_query_prop(query, &mask, refs, XSLOT_MAX_DATA_LEN / 3);
+  if (count <= 0)
+    return;
+
+  /* [COUNT] + 属性集，段满后另起一段 */
+  uint8_t body[MESSAGE_MUX_MAX_BODY];
+  uint8_t len = 1;
+  body[0] = 0;
+
+  for (int i = 0; i < count; i++) {
+    xslot_property_set_t props;
+    std::memset(&props, 0, sizeof(props));
+    props.object_id = refs[i].object_id;
+    props.object_type = refs[i].object_type;
+    if (dev && dev->on_property_read &&
+        dev->on_property_read(dev->ctx, refs[i].object_type,
+                              refs[i].object_id, mask, &props)) {
+      props.mask &= mask;
+    } else {
+      props.mask = 0;
+    }
+
+    int n = bacnet_property_encode(&props, body + len, sizeof(body) - len);
+    if (n < 0) {
+      mux_reply(mgr, reply, sub, XSLOT_CMD_PROP_RESPONSE, body, len);
+      len = 1;
+      body[0] = 0;
+      n = bacnet_property_encode(&props, body + len, sizeof(body) - len);
+      if (n < 0)
+        continue;
+    }
+    len += (uint8_t)n;
+    body[0]++;
+  }
+
+  if (body[0] > 0) {
+    mux_reply(mgr, reply, sub, XSLOT_CMD_PROP_RESPONSE, body, len);
+  }
+}
+
+/**
+ * @brief 处理 MUX 帧
+ *
+ * 逐段分发: 上报/属性响应交给汇聚节点的子设备回调，写入/属性查询交给
+ * 边缘节点注册的子设备处理器。需要应答的段 (WRITE_ACK/PROP_RESPONSE)
+ * 合并到同序号的 MUX 应答帧中，一次空口事务完成。
+ */
+static void handle_mux(xslot_manager_t *mgr, const xslot_frame_t *frame) {
+  xslot_frame_t reply;
+  message_mux_begin(&reply, mgr->config.local_addr, frame->from, frame->seq);
+
+  uint8_t pos = 0;
+  uint8_t sub;
+  xslot_frame_t inner;
+  while (message_mux_next(frame, &pos, &sub, &inner) > 0) {
+    const xslot_sub_device_t *dev = nullptr;
+    if (sub >= 1 && sub <= XSLOT_MAX_SUB_DEVICES &&
+        mgr->subs[sub - 1].registered) {
+      dev = &mgr->subs[sub - 1].dev;
+    }
+
+    switch (inner.cmd) {
+    case XSLOT_CMD_REPORT: {
+      if (mgr->sub_report_cb) {
+        xslot_bacnet_object_t objects[XSLOT_MAX_DATA_LEN / 4];
+        int count =
+            message_parse_report(&inner, objects, XSLOT_MAX_DATA_LEN / 4,
+                                 nullptr);
+        if (count > 0) {
+          mgr->sub_report_cb(frame->from, sub, objects, (uint8_t)count);
+        }
+      }
+      break;
+    }
+
+    case XSLOT_CMD_PROP_RESPONSE: {
+      if (mgr->sub_property_cb) {
+        xslot_property_set_t props[XSLOT_MAX_DATA_LEN / 4];
+        int count = message_parse_prop_response(&inner, props,
+                                                XSLOT_MAX_DATA_LEN / 4);
+        if (count > 0) {
+          mgr->sub_property_cb(frame->from, sub, props, (uint8_t)count);
+        }
+      }
+      break;
+    }
+
+    case XSLOT_CMD_WRITE:
+    case XSLOT_CMD_WRITE_MULTI: {
+      xslot_bacnet_object_t objects[XSLOT_MAX_DATA_LEN / 4];
+      int count;
+      if (inner.cmd == XSLOT_CMD_WRITE) {
+        count = message_parse_write(&inner, objects) > 0 ? 1 : 0;
+      } else {
+        count = message_parse_write_multi(&inner, objects,
+                                          XSLOT_MAX_DATA_LEN / 4);
+      }
+      if (dev && dev->on_write) {
+        for (int i = 0; i < count; i++) {
+          dev->on_write(dev->ctx, frame->from, &objects[i]);
+        }
+      }
+      /* 未注册的子设备回复失败 */
+      uint8_t result = dev ? (uint8_t)XSLOT_OK : (uint8_t)XSLOT_ERR_PARAM;
+      mux_reply(mgr, &reply, sub, XSLOT_CMD_WRITE_ACK, &result, 1);
+      break;
+    }
+
+    case XSLOT_CMD_QUERY_PROP:
+      reply_sub_properties(mgr, &reply, sub, dev, &inner);
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  if (reply.len > 0) {
+    send_reply(mgr, &reply);
+  }
+}
+
+/**
+ * @brief 趋势数据块逐个对象回调
+ *
+ * 样本时间 = 现在 - 首个分片到达至今的时间 - 样本距编码时的毫秒数。
+ */
+static void deliver_trends(xslot_manager_t *mgr, uint16_t from,
+                           const uint8_t *block, uint16_t len,
+                           uint32_t elapsed) {
+  if (!mgr->trend_times) {
+    mgr->trend_ages =
+        (uint32_t *)std::malloc(TREND_RX_SAMPLES * sizeof(uint32_t));
+    mgr->trend_times =
+        (uint64_t *)std::malloc(TREND_RX_SAMPLES * sizeof(uint64_t));
+    mgr->trend_values = (float *)std::malloc(TREND_RX_SAMPLES * sizeof(float));
+    if (!mgr->trend_ages || !mgr->trend_times || !mgr->trend_values) {
+      std::free(mgr->trend_ages);
+      std::free(mgr->trend_times);
+      std::free(mgr->trend_values);
+      mgr->trend_ages = nullptr;
+      mgr->trend_times = nullptr;
+      mgr->trend_values = nullptr;
+      return;
+    }
+  }
+
+  uint64_t now = history_now() - elapsed;
+  uint16_t offset = 0;
+  for (;;) {
+    uint8_t type;
+    uint16_t id;
+    int n = trend_log_decode(block, len, &offset, &type, &id, mgr->trend_ages,
+                             mgr->trend_values, TREND_RX_SAMPLES);
+    if (n <= 0)
+      break;
+    for (int i = 0; i < n; i++) {
+      mgr->trend_times[i] = now - mgr->trend_ages[i];
+    }
+    xslot_series_t series = {mgr->trend_times, mgr->trend_values,
+                             (uint32_t)n};
+    mgr->trend_cb(from, type, id, &series);
+  }
+}
+
+/**
+ * @brief 处理 FRAGMENT 帧 (汇聚节点重组历史样本、趋势日志)
+ *
+ * 样本的 age_ms 加上首个分片到达至今的时间，使其相对回调时刻。
+ */
+static void handle_fragment(xslot_manager_t *mgr, const xslot_frame_t *frame) {
+  if (!mgr->history_cb && !mgr->trend_cb)
+    return;
+
+  if (!mgr->history_rx) {
+    mgr->history_rx = fragment_rx_create(HISTORY_RX_TRANSFERS);
+    if (!mgr->history_rx)
+      return;
+  }
+
+  uint8_t kind;
+  const uint8_t *block;
+  uint32_t elapsed;
+  int len = fragment_rx_push(mgr->history_rx, frame, hal_get_timestamp_ms(),
+                             &kind, &block, &elapsed);
+  if (len <= 0)
+    return;
+
+  if (kind == FRAGMENT_KIND_TREND) {
+    if (mgr->trend_cb)
+      deliver_trends(mgr, frame->from, block, (uint16_t)len, elapsed);
+    return;
+  }
+  if (kind != FRAGMENT_KIND_HISTORY || !mgr->history_cb)
+    return;
+
+  xslot_history_sample_t samples[32];
+  uint16_t offset = 0;
+  for (;;) {
+    int n = message_decode_history(block, (uint16_t)len, &offset, samples, 32);
+    if (n <= 0)
+      break;
+    for (int i = 0; i < n; i++) {
+      samples[i].age_ms += elapsed;
+    }
+    mgr->history_cb(frame->from, samples, (uint16_t)n);
+  }
+}
+
+/**
+ * @brief 处理接收到的帧
+ */
+static void handle_frame(xslot_manager_t *mgr, const xslot_frame_t *frame) {
+  /* 更新节点表 */
+  bool is_new = node_table_update(mgr->node_table, frame->from, 0);
+  if (is_new) {
+    node_changed(mgr, frame->from, true, hal_get_timestamp_ms());
+  }
+  if (mgr->shm) {
+    if (mgr->rx_batch) {
+      mgr->rx_nodes_dirty = true;
+    } else {
+      shm_publisher_update_nodes(mgr->shm, mgr->node_table,
+                                 hal_get_timestamp_ms());
+    }
+  }
+
+  /* 收到汇聚节点的帧说明链路已恢复 */
+  if (is_hub_addr(mgr, frame->from)) {
+    mgr->hub_reachable = true;
+  }
+
+  /* 根据命令类型处理 */
+  switch (frame->cmd) {
+  case XSLOT_CMD_PING: {
+    /* 回复 PONG (PING 带时间时回送本地时钟供对方对时) */
+    xslot_frame_t pong;
+    message_build_pong(&pong, mgr->config.local_addr, frame->from, frame->seq,
+                       frame, hal_get_timestamp_ms());
+    send_reply(mgr, &pong);
+    break;
   }
 
   case XSLOT_CMD_PONG:
     /* 心跳响应，节点表已更新 */
+    on_pong(mgr, frame);
     break;
 
   case XSLOT_CMD_REPORT: {
     /* 数据上报 (汇聚节点接收) */
-    if (mgr->report_cb) {
+    if (mgr->report_cb || mgr->timed_report_cb || mgr->alarm_engine ||
+        mgr->shm) {
       xslot_bacnet_object_t objects[16];
-      int count = message_parse_report(frame, objects, 16);
+      uint8_t format;
+      int count = message_parse_report(frame, objects, 16, &format);
       if (count > 0) {
-        mgr->report_cb(frame->from, objects, count);
+        if (mgr->shm) {
+          shm_publisher_update_objects(mgr->shm, frame->from, objects, count,
+                                       format, hal_get_timestamp_ms());
+        }
+        /* 接收时即评估告警，无需额外轮询整个点库 */
+        if (mgr->alarm_engine) {
+          evaluate_alarms(mgr, frame->from, objects, count,
+                          format != MESSAGE_REPORT_UNTYPED);
+        }
+        if (mgr->report_cb) {
+          mgr->report_cb(frame->from, objects, count);
+        }
+        if (mgr->timed_report_cb) {
+          deliver_timed_report(mgr, frame, objects, count);
+        }
+      }
+    }
+
+    /* 流式订阅: 处理完半个窗口的推送帧后归还信用 */
+    if (frame->from == mgr->stream_target) {
+      mgr->stream_received++;
+      uint8_t half = mgr->stream_window > 1 ? mgr->stream_window / 2 : 1;
+      if ((uint8_t)(mgr->stream_received - mgr->stream_acked) >= half) {
+        send_credit(mgr);
       }
     }
     break;
   }
 
+  case XSLOT_CMD_SUBSCRIBE: {
+    /* 流式推送订阅 (DDC 接收)，快照在本次 poll 末尾推送 */
+    uint8_t window;
+    xslot_object_ref_t refs[STREAM_PUSH_MAX_REFS];
+    int count =
+        message_parse_subscribe(frame, &window, refs, STREAM_PUSH_MAX_REFS);
+    if (count < 0)
+      break;
+    if (!mgr->stream) {
+      mgr->stream = stream_push_create();
+      if (!mgr->stream)
+        break;
+    }
+    stream_push_subscribe(mgr->stream, frame->from, window, refs,
+                          (uint8_t)count, hal_get_timestamp_ms());
+    break;
+  }
+
+  case XSLOT_CMD_CREDIT: {
+    uint8_t received, window;
+    if (message_parse_credit(frame, &received, &window) != XSLOT_OK)
+      break;
+
+    /* HMI 端: DDC 没有该订阅 (DDC 重启或订阅已过期)，重新订阅 */
+    if (frame->from == mgr->stream_target) {
+      if (window == 0)
+        send_subscribe(mgr);
+      break;
+    }
+    if (window == 0)
+      break; /* 窗口 0 只是通知，不应答 */
+
+    /* DDC 端: 未知订阅者回复窗口 0，促使其重新订阅 */
+    if (!mgr->stream ||
+        stream_push_credit(mgr->stream, frame->from, received, window,
+                           hal_get_timestamp_ms()) != XSLOT_OK) {
+      xslot_frame_t reply;
+      message_build_credit(&reply, mgr->config.local_addr, frame->from,
+                           frame->seq, 0, 0);
+      send_reply(mgr, &reply);
+    }
+    break;
+  }
+
   case XSLOT_CMD_WRITE: {
     /* 写入请求 (边缘节点接收) */
     if (mgr->write_cb) {
@@ -282,10 +2287,65 @@ static void handle_frame(xslot_manager_t *mgr, const xslot_frame_t *frame) {
     xslot_frame_t ack;
     message_build_write_ack(&ack, mgr->config.local_addr, frame->from,
                             frame->seq, XSLOT_OK);
-    xslot_manager_send_frame(mgr, &ack);
+    send_reply(mgr, &ack);
+    break;
+  }
+
+  case XSLOT_CMD_WRITE_MULTI: {
+    /* 批量写入: 逐个回调，整帧回复一个 ACK */
+    if (mgr->write_cb) {
+      xslot_bacnet_object_t objects[XSLOT_MAX_DATA_LEN / 4];
+      int count = message_parse_write_multi(frame, objects,
+                                            XSLOT_MAX_DATA_LEN / 4);
+      for (int i = 0; i < count; i++) {
+        mgr->write_cb(frame->from, &objects[i]);
+      }
+    }
+    xslot_frame_t ack;
+    message_build_write_ack(&ack, mgr->config.local_addr, frame->from,
+                            frame->seq, XSLOT_OK);
+    send_reply(mgr, &ack);
+    break;
+  }
+
+  case XSLOT_CMD_QUERY_PROP: {
+    /* 属性选择查询 (边缘节点接收): 未注册提供者时交给原始数据回调 */
+    if (!mgr->property_read_cb) {
+      if (mgr->data_cb) {
+        mgr->data_cb(frame->from, frame->data, frame->len);
+      }
+      break;
+    }
+    uint8_t mask;
+    xslot_object_ref_t refs[XSLOT_MAX_DATA_LEN / 3];
+    int count =
+        message_parse_query_prop(frame, &mask, refs, XSLOT_MAX_DATA_LEN / 3);
+    if (count <= 0)
+      break;
+    send_properties(mgr, frame, mask, refs, (uint8_t)count);
+    break;
+  }
+
+  case XSLOT_CMD_PROP_RESPONSE: {
+    if (mgr->property_cb) {
+      xslot_property_set_t props[XSLOT_MAX_DATA_LEN / 4];
+      int count = message_parse_prop_response(frame, props,
+                                               XSLOT_MAX_DATA_LEN / 4);
+      if (count > 0) {
+        mgr->property_cb(frame->from, props, (uint8_t)count);
+      }
+    }
     break;
   }
 
+  case XSLOT_CMD_MUX:
+    handle_mux(mgr, frame);
+    break;
+
+  case XSLOT_CMD_FRAGMENT:
+    handle_fragment(mgr, frame);
+    break;
+
   case XSLOT_CMD_RESPONSE:
   case XSLOT_CMD_QUERY:
     /* 原始数据回调 */
@@ -299,6 +2359,308 @@ static void handle_frame(xslot_manager_t *mgr, const xslot_frame_t *frame) {
   }
 }
 
+/* ============================================================================
+ * 中继
+ * ============================================================================
+ */
+
+/**
+ * @brief 可中继的请求及其应答命令 (0=不中继)
+ *
+ * SUBSCRIBE/CREDIT 不中继: 推送帧与节点的常规上报无法区分。
+ */
+static uint8_t relay_reply_cmd(uint8_t cmd) {
+  switch (cmd) {
+  case XSLOT_CMD_PING:
+    return XSLOT_CMD_PONG;
+  case XSLOT_CMD_QUERY:
+    return XSLOT_CMD_RESPONSE;
+  case XSLOT_CMD_QUERY_PROP:
+    return XSLOT_CMD_PROP_RESPONSE;
+  case XSLOT_CMD_WRITE:
+  case XSLOT_CMD_WRITE_MULTI:
+    return XSLOT_CMD_WRITE_ACK;
+  case XSLOT_CMD_MUX:
+    return XSLOT_CMD_MUX;
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief 请求期待的、或应答携带的应答单元数 (只读计数字节，不解码对象)
+ *
+ * 属性查询的应答可能分多帧，按属性集计数；MUX 按需要应答的段计数
+ * (写入段各一个单元，属性查询段按属性集)；其余命令一帧即一个单元。
+ */
+static uint16_t relay_units(uint8_t cmd, const uint8_t *payload, uint8_t len) {
+  switch (cmd) {
+  case XSLOT_CMD_QUERY_PROP:
+    return len >= 2 ? payload[1] : 0; /* [MASK][COUNT] */
+  case XSLOT_CMD_PROP_RESPONSE:
+    return len >= 1 ? payload[0] : 0; /* [COUNT] */
+  case XSLOT_CMD_MUX: {
+    uint16_t units = 0;
+    uint16_t pos = 0;
+    while (pos + MESSAGE_MUX_SEGMENT_HEADER <= len) {
+      uint8_t seg_cmd = payload[pos + 1];
+      uint8_t seg_len = payload[pos + 2];
+      const uint8_t *body = payload + pos + MESSAGE_MUX_SEGMENT_HEADER;
+      pos += MESSAGE_MUX_SEGMENT_HEADER + seg_len;
+      if (pos > len)
+        break;
+      if (seg_cmd == XSLOT_CMD_WRITE || seg_cmd == XSLOT_CMD_WRITE_MULTI ||
+          seg_cmd == XSLOT_CMD_WRITE_ACK)
+        units++;
+      else if (seg_cmd == XSLOT_CMD_QUERY_PROP ||
+               seg_cmd == XSLOT_CMD_PROP_RESPONSE)
+        units += relay_units(seg_cmd, body, seg_len);
+    }
+    return units;
+  }
+  default:
+    return 1;
+  }
+}
+
+/**
+ * @brief 查找等待中的请求 (超时的表项同时清除)
+ */
+static relay_entry *relay_find(xslot_manager_t *mgr, uint16_t node,
+                               uint8_t seq, uint8_t reply) {
+  uint32_t now = hal_get_timestamp_ms();
+  for (int i = 0; i < RELAY_TABLE_SIZE; i++) {
+    relay_entry *e = &mgr->relays[i];
+    if (e->node == 0)
+      continue;
+    if (now - e->time_ms >= RELAY_TIMEOUT_MS) {
+      e->node = 0;
+      continue;
+    }
+    if (e->node == node && e->seq == seq && e->reply == reply)
+      return e;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief 中继判定 (只看帧头)
+ *
+ * 发往其他节点的请求转发到该节点所在链路 (附加链路上学习到的节点或
+ * 主传输上在线的节点)，源地址改为本机、序号改为本机分配的序号，使 Mesh
+ * 上的节点能把应答发回，且不会与本机自己发出的请求的应答混淆；本机收到
+ * 的应答与登记的请求匹配时改回请求方和原序号，从请求方所在链路发出。
+ * @return true=由中继转发，不再本地处理
+ */
+static bool relay_route(xslot_manager_t *mgr, uint16_t from, uint16_t to,
+                        uint8_t seq, uint8_t cmd, const uint8_t *payload,
+                        uint8_t len, relay_hop *hop) {
+  if (!mgr->config.relay)
+    return false;
+
+  hop->request.node = 0;
+  if (to == mgr->config.local_addr) {
+    relay_entry *e = relay_find(mgr, from, seq, cmd);
+    if (!e)
+      return false;
+    hop->link = e->link;
+    hop->from = from;
+    hop->to = e->origin;
+    hop->seq = e->origin_seq;
+    /* 属性查询和 MUX 的应答可能有多帧，收齐最后一个单元才释放 */
+    uint16_t units = relay_units(cmd, payload, len);
+    if (units >= e->pending)
+      e->node = 0;
+    else
+      e->pending -= units;
+    return true;
+  }
+
+  uint8_t reply = relay_reply_cmd(cmd);
+  if (reply == 0 || to == XSLOT_ADDR_BROADCAST || to == XSLOT_ADDR_ANY_HUB)
+    return false;
+
+  uint8_t link;
+  const link_route *route = link_find(mgr, to);
+  if (route) {
+    link = (uint8_t)(route->link + 1);
+  } else if (node_table_is_online(mgr->node_table, to)) {
+    link = 0;
+  } else {
+    return false; /* 未知节点 */
+  }
+  if (link == mgr->rx_link)
+    return false; /* 同一链路上的其他节点之间的帧 */
+
+  hop->link = link;
+  hop->from = mgr->config.local_addr;
+  hop->to = to;
+  hop->request.node = to;
+  hop->request.origin = from;
+  hop->request.origin_seq = seq;
+  hop->request.reply = reply;
+  hop->request.link = mgr->rx_link;
+  /* 不需要应答的请求 (如只有上报段的 MUX) 保留到超时 */
+  hop->request.pending = relay_units(cmd, payload, len);
+  if (hop->request.pending == 0)
+    hop->request.pending = 1;
+  return true;
+}
+
+/**
+ * @brief 查找同一请求的登记 (请求方重发时沿用已分配的序号)
+ */
+static relay_entry *relay_find_request(xslot_manager_t *mgr,
+                                       const relay_entry *request) {
+  for (int i = 0; i < RELAY_TABLE_SIZE; i++) {
+    relay_entry *e = &mgr->relays[i];
+    if (e->node == request->node && e->origin == request->origin &&
+        e->origin_seq == request->origin_seq && e->reply == request->reply &&
+        e->link == request->link)
+      return e;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief 序号是否被等待应答的中继请求占用
+ */
+static bool relay_seq_held(xslot_manager_t *mgr, uint8_t seq) {
+  uint32_t now = hal_get_timestamp_ms();
+  for (int i = 0; i < RELAY_TABLE_SIZE; i++) {
+    const relay_entry *e = &mgr->relays[i];
+    if (e->node != 0 && e->seq == seq && now - e->time_ms < RELAY_TIMEOUT_MS)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief 分配本机序号
+ *
+ * 中继请求与本机请求共用 8 位序号，跳过等待应答中的中继请求占用的序号，
+ * 序号回绕后本机请求的应答不会被当作中继应答转走。
+ */
+static uint8_t next_seq(xslot_manager_t *mgr) {
+  if (mgr->config.relay) {
+    for (int i = 0; i < RELAY_TABLE_SIZE && relay_seq_held(mgr, mgr->seq);
+         i++)
+      mgr->seq++;
+  }
+  return mgr->seq++;
+}
+
+/**
+ * @brief 改写帧头地址和序号、重算 CRC 后转发 (载荷不解码)
+ *
+ * 附加链路为点对点，直接从该链路发出；发往主传输的帧经 send_encoded，
+ * 集群中归属对端的节点同样交给对端发送。
+ */
+static void relay_forward(xslot_manager_t *mgr, const relay_hop *hop,
+                          uint8_t *buf, uint16_t len) {
+  uint8_t seq = hop->seq;
+  if (hop->request.node != 0) {
+    relay_entry *slot = relay_find_request(mgr, &hop->request);
+    if (!slot) {
+      for (int i = 0; !slot && i < RELAY_TABLE_SIZE; i++) {
+        if (mgr->relays[i].node == 0)
+          slot = &mgr->relays[i];
+      }
+      if (!slot)
+        return; /* 等待应答的请求已满 */
+      uint8_t own_seq = next_seq(mgr);
+      *slot = hop->request;
+      slot->seq = own_seq;
+    }
+    /* 请求方重发时节点会重新应答全部单元 */
+    slot->pending = hop->request.pending;
+    slot->time_ms = hal_get_timestamp_ms();
+    seq = slot->seq;
+  }
+
+  buf[XSLOT_OFFSET_SEQ] = seq;
+  buf[XSLOT_OFFSET_FROM] = (uint8_t)hop->from;
+  buf[XSLOT_OFFSET_FROM + 1] = (uint8_t)(hop->from >> 8);
+  buf[XSLOT_OFFSET_TO] = (uint8_t)hop->to;
+  buf[XSLOT_OFFSET_TO + 1] = (uint8_t)(hop->to >> 8);
+  uint16_t crc = xslot_crc16(buf, len - XSLOT_FRAME_CRC_SIZE);
+  buf[len - 2] = (uint8_t)crc;
+  buf[len - 1] = (uint8_t)(crc >> 8);
+
+  if (hop->link != 0)
+    transport_send(mgr->aux[hop->link - 1], buf, len);
+  else
+    send_encoded(mgr, hop->to, buf, len, false);
+}
+
+/**
+ * @brief 中继原始帧: 只解析帧头，转发前校验 CRC (损坏的帧丢弃)
+ * @return true=已由中继处理
+ */
+static bool relay_raw(xslot_manager_t *mgr, const uint8_t *data,
+                      uint16_t len) {
+  if (!mgr->config.relay || len < XSLOT_FRAME_MIN_SIZE ||
+      data[XSLOT_OFFSET_SYNC] != XSLOT_SYNC_BYTE ||
+      data[XSLOT_OFFSET_LEN] > XSLOT_MAX_DATA_LEN)
+    return false;
+  uint16_t size = xslot_frame_total_size(data[XSLOT_OFFSET_LEN]);
+  if (len < size)
+    return false;
+
+  uint16_t from = data[XSLOT_OFFSET_FROM] | (data[XSLOT_OFFSET_FROM + 1] << 8);
+  uint16_t to = data[XSLOT_OFFSET_TO] | (data[XSLOT_OFFSET_TO + 1] << 8);
+  relay_hop hop;
+  if (!relay_route(mgr, from, to, data[XSLOT_OFFSET_SEQ],
+                   data[XSLOT_OFFSET_CMD], data + XSLOT_FRAME_HEADER_SIZE,
+                   data[XSLOT_OFFSET_LEN], &hop))
+    return false;
+
+  /* 本机处理的帧由解码时校验，只有转发的帧在此校验 */
+  if (!xslot_frame_verify_crc(data, size))
+    return true;
+
+  link_learn(mgr, from);
+  uint8_t buf[XSLOT_FRAME_MAX_SIZE];
+  std::memcpy(buf, data, size);
+  relay_forward(mgr, &hop, buf, size);
+  return true;
+}
+
+/**
+ * @brief 处理收到的帧
+ * @param raw 帧的原始字节，NULL 表示传输层只交付了解码后的帧
+ */
+static void dispatch_frame(xslot_manager_t *mgr, const xslot_frame_t *frame,
+                           const uint8_t *raw, uint16_t raw_len) {
+  link_learn(mgr, frame->from);
+
+  /* 检查目标地址 (汇聚节点同时接收发往任意汇聚节点的帧) */
+  if (frame->to != mgr->config.local_addr &&
+      frame->to != XSLOT_ADDR_BROADCAST &&
+      !(frame->to == XSLOT_ADDR_ANY_HUB &&
+        is_hub_addr(mgr, mgr->config.local_addr)))
+    return;
+
+  /* 集群: 对端已处理过的帧不再处理，新帧转发给对端 */
+  if (mgr->cluster_attached) {
+    cluster_mark(mgr, frame->from, true);
+    if (cluster_seen(mgr, frame))
+      return;
+    if (mgr->cluster.on_uplink) {
+      uint8_t buf[XSLOT_FRAME_MAX_SIZE];
+      if (!raw) {
+        int n = xslot_frame_encode(frame, buf, sizeof(buf));
+        raw = buf;
+        raw_len = n > 0 ? (uint16_t)n : 0;
+      }
+      if (raw_len > 0)
+        mgr->cluster.on_uplink(mgr->cluster.ctx, raw, raw_len);
+    }
+  }
+
+  handle_frame(mgr, frame);
+}
+
 /**
  * @brief 传输层接收回调
  */
@@ -307,13 +2669,231 @@ static void on_frame_received(void *ctx, const uint8_t *data, uint16_t len) {
   if (!mgr || !data)
     return;
 
+  if (relay_raw(mgr, data, len))
+    return;
+
+  xslot_frame_t frame;
+  if (xslot_frame_decode(data, len, &frame) != XSLOT_OK)
+    return;
+
+  dispatch_frame(mgr, &frame, data, len);
+}
+
+/**
+ * @brief 传输层已解码帧回调 (帧由传输层的接收池持有，不再复制)
+ */
+static void on_frame_decoded(void *ctx, const xslot_frame_t *frame) {
+  xslot_manager_t *mgr = (xslot_manager_t *)ctx;
+  if (!mgr || !frame)
+    return;
+
+  /* 中继: 传输层只交付了解码后的帧，重新编码后转发 */
+  relay_hop hop;
+  if (relay_route(mgr, frame->from, frame->to, frame->seq, frame->cmd,
+                  frame->data, frame->len, &hop)) {
+    link_learn(mgr, frame->from);
+    uint8_t buf[XSLOT_FRAME_MAX_SIZE];
+    int n = xslot_frame_encode(frame, buf, sizeof(buf));
+    if (n > 0)
+      relay_forward(mgr, &hop, buf, (uint16_t)n);
+    return;
+  }
+
+  dispatch_frame(mgr, frame, nullptr, 0);
+}
+
+/**
+ * @brief 传输层批量接收回调
+ *
+ * 逐帧过滤和分发，节点表在批末发布一次。
+ */
+static void on_frame_batch(void *ctx, const transport_frame_view_t *frames,
+                           uint16_t count) {
+  xslot_manager_t *mgr = (xslot_manager_t *)ctx;
+  if (!mgr || !frames)
+    return;
+
+  bool nested = mgr->rx_batch;
+  mgr->rx_batch = true;
+
   xslot_frame_t frame;
-  if (xslot_frame_decode(data, len, &frame) == XSLOT_OK) {
-    /* 检查目标地址 */
-    if (frame.to == mgr->config.local_addr ||
-        frame.to == XSLOT_ADDR_BROADCAST) {
-      handle_frame(mgr, &frame);
+  for (uint16_t i = 0; i < count; i++) {
+    if (relay_raw(mgr, frames[i].data, frames[i].len))
+      continue;
+    if (xslot_frame_decode(frames[i].data, frames[i].len, &frame) != XSLOT_OK)
+      continue;
+    dispatch_frame(mgr, &frame, frames[i].data, frames[i].len);
+  }
+
+  if (nested)
+    return;
+  mgr->rx_batch = false;
+  if (mgr->rx_nodes_dirty && mgr->shm) {
+    shm_publisher_update_nodes(mgr->shm, mgr->node_table,
+                               hal_get_timestamp_ms());
+  }
+  mgr->rx_nodes_dirty = false;
+}
+
+/**
+ * @brief 传输层路由变化回调
+ *
+ * 发往任意汇聚节点后模组建立到最近汇聚节点的路由，由此得知实际服务的
+ * 汇聚节点；该路由删除后恢复为未知，由模组重新选择。
+ */
+static void on_route_changed(void *ctx, uint16_t addr, bool created) {
+  xslot_manager_t *mgr = (xslot_manager_t *)ctx;
+  if (!mgr || hub_target(mgr) != XSLOT_ADDR_ANY_HUB)
+    return;
+
+  if (created) {
+    mgr->serving_hub = addr;
+  } else if (addr == mgr->serving_hub) {
+    mgr->serving_hub = 0;
+  }
+}
+
+/* ============================================================================
+ * 附加链路
+ * ============================================================================
+ */
+
+/**
+ * @brief 清空路由表 (空位以广播地址标记，见 link_learn)
+ */
+static void link_routes_clear(xslot_manager_t *mgr) {
+  for (int i = 0; i < LINK_ROUTE_SIZE; i++) {
+    mgr->routes[i].addr = XSLOT_ADDR_BROADCAST;
+    mgr->routes[i].time_ms = 0;
+  }
+}
+
+static link_route *link_find(xslot_manager_t *mgr, uint16_t addr) {
+  for (int i = 0; i < LINK_ROUTE_SIZE; i++) {
+    if (mgr->routes[i].addr == addr)
+      return &mgr->routes[i];
+  }
+  return nullptr;
+}
+
+/**
+ * @brief 记录节点所在的链路 (发往该节点的帧从收到其帧的链路发出)
+ */
+static void link_learn(xslot_manager_t *mgr, uint16_t addr) {
+  if (!mgr->aux[0] || addr == XSLOT_ADDR_BROADCAST)
+    return;
+
+  link_route *route = link_find(mgr, addr);
+  if (mgr->rx_link == 0) {
+    /* 从主传输收到: 节点已回到主传输 */
+    if (route)
+      route->addr = XSLOT_ADDR_BROADCAST;
+    return;
+  }
+
+  if (!route) {
+    /* 取空位，表满时替换最久未收到的节点 */
+    route = &mgr->routes[0];
+    for (int i = 0; i < LINK_ROUTE_SIZE; i++) {
+      link_route *r = &mgr->routes[i];
+      if (r->addr == XSLOT_ADDR_BROADCAST) {
+        route = r;
+        break;
+      }
+      if ((int32_t)(r->time_ms - route->time_ms) < 0)
+        route = r;
+    }
+    route->addr = addr;
+  }
+  route->link = (uint8_t)(mgr->rx_link - 1);
+  route->time_ms = hal_get_timestamp_ms();
+}
+
+/**
+ * @brief 创建并启动附加链路 (失败时返回 NULL，不影响主传输)
+ */
+static i_transport_t *create_aux_link(xslot_manager_t *mgr, const char *port) {
+  xslot_config_t config = mgr->config;
+  std::memcpy(config.uart_port, port, sizeof(config.uart_port));
+  config.uart_port[sizeof(config.uart_port) - 1] = '\0';
+  std::memset(&config.bus, 0, sizeof(config.bus)); /* 附加链路为点对点 */
+
+  i_transport_t *transport = socket_transport_match(config.uart_port)
+                                 ? socket_transport_create(&config)
+                                 : direct_transport_create(&config);
+  if (!transport)
+    return nullptr;
+
+  transport_set_receive_callback(transport, on_frame_received, mgr);
+  transport_set_frame_callback(transport, on_frame_decoded, mgr);
+  transport_set_batch_callback(transport, on_frame_batch, mgr);
+
+  if (transport_start(transport) != XSLOT_OK) {
+    transport_destroy(transport);
+    return nullptr;
+  }
+  return transport;
+}
+
+static void start_aux_links(xslot_manager_t *mgr) {
+  uint8_t count = 0;
+  for (int i = 0; i < XSLOT_MAX_AUX_LINKS; i++) {
+    if (mgr->config.aux_ports[i][0] == '\0')
+      continue;
+    i_transport_t *transport = create_aux_link(mgr, mgr->config.aux_ports[i]);
+    if (transport)
+      mgr->aux[count++] = transport;
+  }
+}
+
+static void stop_aux_links(xslot_manager_t *mgr) {
+  for (int i = 0; i < XSLOT_MAX_AUX_LINKS; i++) {
+    if (mgr->aux[i]) {
+      transport_stop(mgr->aux[i]);
+      transport_destroy(mgr->aux[i]);
+      mgr->aux[i] = nullptr;
+    }
+  }
+  link_routes_clear(mgr);
+}
+
+/**
+ * @brief 接收主传输与附加链路的帧
+ *
+ * 传输层只能各自等待: 有附加链路时主传输每次最多等待 LINK_POLL_MS，
+ * 之后取走附加链路已到达的数据，任一链路收到帧即返回。
+ */
+static int poll_links(xslot_manager_t *mgr, uint32_t timeout_ms) {
+  if (!mgr->aux[0])
+    return transport_poll(mgr->transport, timeout_ms);
+
+  uint32_t start = hal_get_timestamp_ms();
+  for (;;) {
+    uint32_t round = hal_get_timestamp_ms();
+    uint32_t elapsed = round - start;
+    uint32_t wait = elapsed < timeout_ms ? timeout_ms - elapsed : 0;
+    if (wait > LINK_POLL_MS)
+      wait = LINK_POLL_MS;
+
+    int frames = transport_poll(mgr->transport, wait);
+    if (frames < 0)
+      return frames;
+
+    for (int i = 0; i < XSLOT_MAX_AUX_LINKS && mgr->aux[i]; i++) {
+      mgr->rx_link = (uint8_t)(i + 1);
+      int ret = transport_poll(mgr->aux[i], 0);
+      mgr->rx_link = 0;
+      if (ret > 0)
+        frames += ret;
     }
+
+    uint32_t now = hal_get_timestamp_ms();
+    if (frames > 0 || now - start >= timeout_ms)
+      return frames;
+
+    /* 主传输不支持等待时补足本轮间隔，避免空转 */
+    if (now - round < wait)
+      hal_sleep_ms(wait - (now - round));
   }
 }
 
@@ -321,6 +2901,13 @@ static void on_frame_received(void *ctx, const uint8_t *data, uint16_t len) {
  * @brief 检测并创建传输层
  */
 static i_transport_t *detect_and_create_transport(xslot_manager_t *mgr) {
+  /* 套接字端点: 不探测串口 */
+  if (socket_transport_match(mgr->config.uart_port)) {
+    i_transport_t *transport = socket_transport_create(&mgr->config);
+    mgr->mode = transport ? XSLOT_MODE_SOCKET : XSLOT_MODE_NONE;
+    return transport;
+  }
+
   /* 尝试创建 TPMesh 传输层 */
   i_transport_t *transport = tpmesh_transport_create(&mgr->config);
   if (transport) {
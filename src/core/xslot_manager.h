@@ -35,9 +35,23 @@ int xslot_manager_start(xslot_manager_t *mgr);
 
 /**
  * @brief 停止管理器
+ *
+ * 会等待 I/O 线程退出，不能在协议栈回调中调用。
  */
 void xslot_manager_stop(xslot_manager_t *mgr);
 
+/**
+ * @brief 获取协议栈锁 (可重入)
+ *
+ * I/O 线程模型下 API 调用与接收处理经此串行化。
+ */
+void xslot_manager_lock(xslot_manager_t *mgr);
+
+/**
+ * @brief 释放协议栈锁
+ */
+void xslot_manager_unlock(xslot_manager_t *mgr);
+
 /**
  * @brief 获取运行模式
  */
@@ -48,6 +62,12 @@ xslot_run_mode_t xslot_manager_get_mode(xslot_manager_t *mgr);
  */
 int xslot_manager_send_frame(xslot_manager_t *mgr, const xslot_frame_t *frame);
 
+/**
+ * @brief 接收处理 (读取传输层、检查节点超时和告警延时)
+ * @return 处理的帧数；I/O 线程运行时返回 XSLOT_ERR_BUSY
+ */
+int xslot_manager_poll(xslot_manager_t *mgr, uint32_t timeout_ms);
+
 /**
  * @brief 上报对象
  */
@@ -60,12 +80,57 @@ int xslot_manager_report(xslot_manager_t *mgr,
 int xslot_manager_write(xslot_manager_t *mgr, uint16_t target,
                         const xslot_bacnet_object_t *obj);
 
+/**
+ * @brief 批量发送写入命令 (超出单帧容量时拆分为多帧)
+ */
+int xslot_manager_write_multi(xslot_manager_t *mgr, uint16_t target,
+                              const xslot_bacnet_object_t *objects,
+                              uint8_t count);
+
 /**
  * @brief 发送查询命令
  */
 int xslot_manager_query(xslot_manager_t *mgr, uint16_t target,
                         const uint16_t *object_ids, uint8_t count);
 
+/**
+ * @brief 发送属性选择查询 (结果经属性回调返回)
+ */
+int xslot_manager_query_properties(xslot_manager_t *mgr, uint16_t target,
+                                   uint8_t mask,
+                                   const xslot_object_ref_t *refs,
+                                   uint8_t count);
+
+/**
+ * @brief 流式推送: 发布对象最新值 (DDC) / 订阅推送 (HMI，window=0 取消)
+ */
+int xslot_manager_stream_publish(xslot_manager_t *mgr,
+                                 const xslot_bacnet_object_t *objects,
+                                 uint8_t count);
+int xslot_manager_stream_subscribe(xslot_manager_t *mgr, uint16_t target,
+                                   const xslot_object_ref_t *refs,
+                                   uint8_t count, uint8_t window);
+
+/**
+ * @brief 逻辑子设备 (sub 取值 1..XSLOT_MAX_SUB_DEVICES)
+ */
+int xslot_manager_register_sub(xslot_manager_t *mgr, uint8_t sub,
+                               const xslot_sub_device_t *dev);
+int xslot_manager_report_sub(xslot_manager_t *mgr, uint8_t sub,
+                             const xslot_bacnet_object_t *objects,
+                             uint8_t count);
+int xslot_manager_write_sub(xslot_manager_t *mgr, uint16_t target,
+                            uint8_t sub, const xslot_bacnet_object_t *objects,
+                            uint8_t count);
+int xslot_manager_query_sub_properties(xslot_manager_t *mgr, uint16_t target,
+                                       uint8_t sub, uint8_t mask,
+                                       const xslot_object_ref_t *refs,
+                                       uint8_t count);
+void xslot_manager_set_sub_report_cb(xslot_manager_t *mgr,
+                                     xslot_sub_report_cb cb);
+void xslot_manager_set_sub_property_cb(xslot_manager_t *mgr,
+                                       xslot_sub_property_cb cb);
+
 /**
  * @brief 发送心跳
  */
@@ -81,10 +146,25 @@ node_table_t xslot_manager_get_node_table(xslot_manager_t *mgr);
  */
 void xslot_manager_set_data_cb(xslot_manager_t *mgr, xslot_data_received_cb cb);
 void xslot_manager_set_node_cb(xslot_manager_t *mgr, xslot_node_online_cb cb);
+void xslot_manager_set_node_batch_cb(xslot_manager_t *mgr,
+                                     xslot_node_batch_cb cb);
 void xslot_manager_set_write_cb(xslot_manager_t *mgr,
                                 xslot_write_request_cb cb);
 void xslot_manager_set_report_cb(xslot_manager_t *mgr,
                                  xslot_report_received_cb cb);
+void xslot_manager_set_property_read_cb(xslot_manager_t *mgr,
+                                        xslot_property_read_cb cb);
+void xslot_manager_set_property_cb(xslot_manager_t *mgr,
+                                   xslot_property_response_cb cb);
+
+/**
+ * @brief 告警评估 (汇聚节点)
+ */
+void xslot_manager_set_alarm_cb(xslot_manager_t *mgr, xslot_alarm_cb cb);
+int xslot_manager_set_alarm_limit(xslot_manager_t *mgr, uint16_t addr,
+                                  const xslot_alarm_limit_t *limit);
+void xslot_manager_remove_alarm_limit(xslot_manager_t *mgr, uint16_t addr,
+                                      uint8_t object_type, uint16_t object_id);
 
 /**
  * @brief 更新无线配置
@@ -92,6 +172,50 @@ void xslot_manager_set_report_cb(xslot_manager_t *mgr,
 int xslot_manager_update_config(xslot_manager_t *mgr, uint8_t cell_id,
                                 int8_t power_dbm);
 
+/**
+ * @brief 启用共享内存发布
+ */
+int xslot_manager_enable_shm(xslot_manager_t *mgr, const char *name);
+
+/**
+ * @brief 断线缓存与补发 (边缘节点) / 历史样本接收 (汇聚节点)
+ */
+int xslot_manager_enable_store(xslot_manager_t *mgr,
+                               const xslot_store_config_t *config);
+uint32_t xslot_manager_store_pending(xslot_manager_t *mgr);
+void xslot_manager_set_history_cb(xslot_manager_t *mgr, xslot_history_cb cb);
+void xslot_manager_set_timed_report_cb(xslot_manager_t *mgr,
+                                       xslot_history_cb cb);
+
+/**
+ * @brief 趋势日志 (边缘节点记录上传) / 趋势接收 (汇聚节点)
+ */
+int xslot_manager_trend_configure(xslot_manager_t *mgr,
+                                  const xslot_trend_config_t *config);
+int xslot_manager_trend_record(xslot_manager_t *mgr,
+                               const xslot_bacnet_object_t *objects,
+                               uint8_t count);
+void xslot_manager_set_trend_cb(xslot_manager_t *mgr, xslot_trend_cb cb);
+
+/**
+ * @brief 汇聚节点组 (多汇聚节点部署)
+ */
+int xslot_manager_set_hub_group(xslot_manager_t *mgr, const uint16_t *hubs,
+                                uint8_t count);
+uint16_t xslot_manager_hub_owner(xslot_manager_t *mgr, uint16_t addr);
+uint16_t xslot_manager_serving_hub(xslot_manager_t *mgr);
+
+/**
+ * @brief 汇聚节点集群
+ */
+int xslot_manager_cluster_attach(xslot_manager_t *mgr,
+                                 const xslot_cluster_ops_t *ops);
+int xslot_manager_cluster_inject(xslot_manager_t *mgr, const uint8_t *data,
+                                 uint16_t len);
+int xslot_manager_cluster_transmit(xslot_manager_t *mgr, const uint8_t *data,
+                                   uint16_t len, bool confirmed);
+bool xslot_manager_cluster_owns(xslot_manager_t *mgr, uint16_t addr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,9 +39,7 @@ static const uint16_t crc16_table[256] = {
     0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8, 0x6E17, 0x7E36, 0x4E55, 0x5E74,
     0x2E93, 0x3EB2, 0x0ED1, 0x1EF0};
 
-uint16_t xslot_crc16(const uint8_t *data, uint16_t len) {
-  uint16_t crc = 0xFFFF;
-
+static uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint16_t len) {
   while (len--) {
     crc = (crc << 8) ^ crc16_table[((crc >> 8) ^ *data++) & 0xFF];
   }
@@ -49,6 +47,34 @@ uint16_t xslot_crc16(const uint8_t *data, uint16_t len) {
   return crc;
 }
 
+uint16_t xslot_crc16(const uint8_t *data, uint16_t len) {
+  return crc16_update(0xFFFF, data, len);
+}
+
+static int hex_nibble(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  c |= 0x20;
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  return -1;
+}
+
+/**
+ * @brief 十六进制解码 n 字节
+ * @return false=含非十六进制字符
+ */
+static bool hex_decode(const char *hex, uint8_t *out, uint16_t n) {
+  for (uint16_t i = 0; i < n; i++) {
+    int hi = hex_nibble(hex[i * 2]);
+    int lo = hex_nibble(hex[i * 2 + 1]);
+    if (hi < 0 || lo < 0)
+      return false;
+    out[i] = (uint8_t)((hi << 4) | lo);
+  }
+  return true;
+}
+
 void xslot_frame_init(xslot_frame_t *frame) {
   if (frame) {
     std::memset(frame, 0, sizeof(xslot_frame_t));
@@ -169,6 +195,53 @@ int xslot_frame_decode(const uint8_t *buffer, uint16_t len,
   return XSLOT_OK;
 }
 
+int xslot_frame_decode_hex(const char *hex, uint16_t len,
+                           xslot_frame_t *frame) {
+  if (!hex || !frame) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  if (len < XSLOT_FRAME_MIN_SIZE) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  uint8_t header[XSLOT_FRAME_HEADER_SIZE];
+  if (!hex_decode(hex, header, sizeof(header)))
+    return XSLOT_ERR_PARAM;
+  if (header[XSLOT_OFFSET_SYNC] != XSLOT_SYNC_BYTE)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t data_len = header[XSLOT_OFFSET_LEN];
+  if (data_len > XSLOT_MAX_DATA_LEN || len < xslot_frame_total_size(data_len))
+    return XSLOT_ERR_PARAM;
+
+  frame->sync = header[XSLOT_OFFSET_SYNC];
+  std::memcpy(&frame->from, header + XSLOT_OFFSET_FROM, sizeof(frame->from));
+  std::memcpy(&frame->to, header + XSLOT_OFFSET_TO, sizeof(frame->to));
+  frame->seq = header[XSLOT_OFFSET_SEQ];
+  frame->cmd = header[XSLOT_OFFSET_CMD];
+  frame->len = data_len;
+
+  // 载荷直接解码到 frame->data
+  hex += XSLOT_FRAME_HEADER_SIZE * 2;
+  if (!hex_decode(hex, frame->data, data_len))
+    return XSLOT_ERR_PARAM;
+
+  uint8_t crc[XSLOT_FRAME_CRC_SIZE];
+  if (!hex_decode(hex + data_len * 2, crc, sizeof(crc)))
+    return XSLOT_ERR_PARAM;
+  std::memcpy(&frame->crc, crc, sizeof(frame->crc));
+
+  // 帧头与载荷不连续，分段计算 CRC
+  uint16_t calc_crc = crc16_update(0xFFFF, header, sizeof(header));
+  calc_crc = crc16_update(calc_crc, frame->data, data_len);
+  if (calc_crc != frame->crc) {
+    return XSLOT_ERR_CRC;
+  }
+
+  return XSLOT_OK;
+}
+
 bool xslot_frame_verify_crc(const uint8_t *buffer, uint16_t len) {
   if (!buffer || len < XSLOT_FRAME_MIN_SIZE) {
     return false;
@@ -204,3 +277,52 @@ bool xslot_frame_verify_crc(const uint8_t *buffer, uint16_t len) {
 
   return calc_crc == frame_crc;
 }
+
+int xslot_cobs_encode(const uint8_t *data, uint16_t len, uint8_t *buffer,
+                      uint16_t buffer_size) {
+  if (!data || !buffer || buffer_size < XSLOT_COBS_MAX_SIZE(len)) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  // 每段以长度码开头: 到下一个 0x00 (或满 254 字节) 的距离
+  uint16_t code_pos = 0;
+  uint16_t out = 1;
+  uint8_t code = 1;
+  for (uint16_t i = 0; i < len; i++) {
+    if (data[i] != XSLOT_COBS_DELIMITER) {
+      buffer[out++] = data[i];
+      code++;
+    }
+    if (data[i] == XSLOT_COBS_DELIMITER || code == 0xFF) {
+      buffer[code_pos] = code;
+      code_pos = out++;
+      code = 1;
+    }
+  }
+  buffer[code_pos] = code;
+  buffer[out++] = XSLOT_COBS_DELIMITER;
+  return out;
+}
+
+int xslot_cobs_decode(const uint8_t *data, uint16_t len, uint8_t *out) {
+  if (!data || !out) {
+    return XSLOT_ERR_PARAM;
+  }
+
+  // 写位置始终落后于读位置，可原地解码
+  uint16_t in = 0;
+  uint16_t pos = 0;
+  while (in < len) {
+    uint8_t code = data[in++];
+    if (code == XSLOT_COBS_DELIMITER || in + code - 1 > len) {
+      return XSLOT_ERR_PARAM;
+    }
+    for (uint8_t i = 1; i < code; i++) {
+      out[pos++] = data[in++];
+    }
+    if (code != 0xFF && in < len) {
+      out[pos++] = XSLOT_COBS_DELIMITER;
+    }
+  }
+  return pos;
+}
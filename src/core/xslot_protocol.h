@@ -96,6 +96,18 @@ int xslot_frame_encode(const xslot_frame_t *frame, uint8_t *buffer,
 int xslot_frame_decode(const uint8_t *buffer, uint16_t len,
                        xslot_frame_t *frame);
 
+/**
+ * @brief 从十六进制文本解码帧 (模组 +NNMI 数据)
+ *
+ * 载荷直接写入 frame->data，不经过中间字节缓冲区。
+ * @param hex 十六进制字符，至少 2 * len 个
+ * @param len 帧字节数
+ * @param frame 输出帧
+ * @return 成功返回 XSLOT_OK，失败返回错误码
+ */
+int xslot_frame_decode_hex(const char *hex, uint16_t len,
+                           xslot_frame_t *frame);
+
 /**
  * @brief 验证帧 CRC
  * @param buffer 帧数据
@@ -113,6 +125,42 @@ static inline uint16_t xslot_frame_total_size(uint8_t data_len) {
   return XSLOT_FRAME_HEADER_SIZE + data_len + XSLOT_FRAME_CRC_SIZE;
 }
 
+/* =============================================================================
+ * COBS 编码 (串口帧定界)
+ * =============================================================================
+ */
+
+/** COBS 定界符 */
+#define XSLOT_COBS_DELIMITER 0x00
+
+/** len 字节数据 COBS 编码后的最大长度 (含定界符) */
+#define XSLOT_COBS_MAX_SIZE(len) ((len) + (len) / 254 + 2)
+
+/**
+ * @brief COBS 编码并追加定界符
+ *
+ * 编码结果中除末尾定界符外不含 0x00，接收方扫描到下一个 0x00 即完成
+ * 重新同步。
+ * @param data 原始数据
+ * @param len 数据长度
+ * @param buffer 输出缓冲区 (至少 XSLOT_COBS_MAX_SIZE(len) 字节)
+ * @param buffer_size 缓冲区大小
+ * @return 编码后的字节数 (含定界符)，失败返回负数
+ */
+int xslot_cobs_encode(const uint8_t *data, uint16_t len, uint8_t *buffer,
+                      uint16_t buffer_size);
+
+/**
+ * @brief COBS 解码 (不含定界符)
+ *
+ * 解码结果不长于输入，out 可以与 data 相同 (原地解码)。
+ * @param data 编码数据
+ * @param len 编码数据长度
+ * @param out 输出缓冲区 (至少 len 字节)
+ * @return 解码后的字节数，编码无效返回负数
+ */
+int xslot_cobs_decode(const uint8_t *data, uint16_t len, uint8_t *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,11 @@ uint32_t hal_get_timestamp_ms(void) {
   return 0;
 }
 
+uint64_t hal_get_utc_ms(void) {
+  /* TODO: 有 RTC 时返回 UTC 毫秒，否则返回 0 */
+  return 0;
+}
+
 void hal_sleep_ms(uint32_t ms) {
   /* TODO: 实现 */
   // vTaskDelay(pdMS_TO_TICKS(ms));
@@ -91,14 +96,21 @@ void hal_serial_flush(void *handle) {
   (void)handle;
 }
 
+int hal_serial_wait(void *handle, uint32_t timeout_ms) {
+  /* TODO: 可用接收中断通知 (如 ulTaskNotifyTake) 实现，不支持时返回 -1 */
+  (void)handle;
+  (void)timeout_ms;
+  return -1;
+}
+
 /* ============================================================================
  * 互斥锁
  * ============================================================================
  */
 
 void *hal_mutex_create(void) {
-  /* TODO: 实现 */
-  // return xSemaphoreCreateMutex();
+  /* TODO: 实现 (需可重入) */
+  // return xSemaphoreCreateRecursiveMutex();
   return nullptr;
 }
 
@@ -110,14 +122,40 @@ void hal_mutex_destroy(void *mutex) {
 
 void hal_mutex_lock(void *mutex) {
   /* TODO: 实现 */
-  // if (mutex) xSemaphoreTake((SemaphoreHandle_t)mutex, portMAX_DELAY);
+  // if (mutex) xSemaphoreTakeRecursive((SemaphoreHandle_t)mutex,
+  //                                    portMAX_DELAY);
   (void)mutex;
 }
 
 void hal_mutex_unlock(void *mutex) {
   /* TODO: 实现 */
-  // if (mutex) xSemaphoreGive((SemaphoreHandle_t)mutex);
+  // if (mutex) xSemaphoreGiveRecursive((SemaphoreHandle_t)mutex);
   (void)mutex;
 }
 
+/* ============================================================================
+ * 线程
+ * ============================================================================
+ */
+
+void *hal_thread_create(void (*entry)(void *arg), void *arg,
+                        const hal_thread_attr_t *attr) {
+  /* TODO: 实现 (priority 映射到任务优先级，cpu_mask 用于 SMP 端口) */
+  // TaskHandle_t task;
+  // if (xTaskCreate((TaskFunction_t)entry, attr && attr->name ? attr->name
+  //                 : "xslot", 1024, arg, tskIDLE_PRIORITY + 1,
+  //                 &task) != pdPASS)
+  //   return nullptr;
+  // return task;
+  (void)entry;
+  (void)arg;
+  (void)attr;
+  return nullptr;
+}
+
+void hal_thread_join(void *thread) {
+  /* TODO: 实现 (入口函数返回前通知，此处等待通知后删除任务) */
+  (void)thread;
+}
+
 #endif /* XSLOT_PLATFORM_FREERTOS */
@@ -24,6 +24,12 @@ extern "C" {
  */
 uint32_t hal_get_timestamp_ms(void);
 
+/**
+ * @brief 获取 UTC 时间 (自 1970-01-01 起的毫秒数)
+ * @return 无实时时钟时返回 0
+ */
+uint64_t hal_get_utc_ms(void);
+
 /**
  * @brief 延时 (毫秒)
  */
@@ -69,13 +75,19 @@ int hal_serial_read(void *handle, uint8_t *data, uint16_t max_len,
  */
 void hal_serial_flush(void *handle);
 
+/**
+ * @brief 等待串口可读 (不读取数据)
+ * @return 1=可读，0=超时，负数=不支持或错误
+ */
+int hal_serial_wait(void *handle, uint32_t timeout_ms);
+
 /* ============================================================================
  * 线程/互斥锁 (可选，用于多线程环境)
  * ============================================================================
  */
 
 /**
- * @brief 创建互斥锁
+ * @brief 创建互斥锁 (可重入: 同一线程可重复获取)
  */
 void *hal_mutex_create(void);
 
@@ -94,6 +106,30 @@ void hal_mutex_lock(void *mutex);
  */
 void hal_mutex_unlock(void *mutex);
 
+/**
+ * @brief 线程属性
+ */
+typedef struct {
+  const char *name;  /**< 线程名 (性能分析工具中显示)，可为 NULL */
+  uint32_t cpu_mask; /**< 允许运行的 CPU 核位图 (0=不限制) */
+  uint8_t priority;  /**< 实时优先级 1-99 (0=普通调度) */
+} hal_thread_attr_t;
+
+/**
+ * @brief 创建线程
+ * @param attr 线程属性，可为 NULL
+ * @return 线程句柄，失败返回 NULL
+ *
+ * 亲和性或实时优先级设置失败 (如缺少权限) 时线程仍以普通方式运行。
+ */
+void *hal_thread_create(void (*entry)(void *arg), void *arg,
+                        const hal_thread_attr_t *attr);
+
+/**
+ * @brief 等待线程结束并释放句柄
+ */
+void hal_thread_join(void *thread);
+
 #ifdef __cplusplus
 }
 #endif
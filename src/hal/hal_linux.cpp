@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <pthread.h>
+#include <sched.h>
 #include <string.h>
 #include <sys/select.h>
 #include <sys/time.h>
@@ -26,6 +27,12 @@ uint32_t hal_get_timestamp_ms(void) {
   return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
 }
 
+uint64_t hal_get_utc_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
 void hal_sleep_ms(uint32_t ms) { usleep(ms * 1000); }
 
 /* ============================================================================
@@ -163,14 +170,39 @@ void hal_serial_flush(void *handle) {
   }
 }
 
+int hal_serial_wait(void *handle, uint32_t timeout_ms) {
+  if (!handle)
+    return -1;
+
+  int fd = (int)(intptr_t)handle - 1;
+
+  fd_set readfds;
+  FD_ZERO(&readfds);
+  FD_SET(fd, &readfds);
+
+  struct timeval tv;
+  tv.tv_sec = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+  int ret = select(fd + 1, &readfds, nullptr, nullptr, &tv);
+  if (ret < 0)
+    return errno == EINTR ? 0 : -1;
+  return ret > 0 ? 1 : 0;
+}
+
 /* ============================================================================
  * 互斥锁
  * ============================================================================
  */
 
 void *hal_mutex_create(void) {
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
   pthread_mutex_t *mutex = new pthread_mutex_t;
-  pthread_mutex_init(mutex, nullptr);
+  pthread_mutex_init(mutex, &attr);
+  pthread_mutexattr_destroy(&attr);
   return mutex;
 }
 
@@ -193,4 +225,83 @@ void hal_mutex_unlock(void *mutex) {
   }
 }
 
+/* ============================================================================
+ * 线程
+ * ============================================================================
+ */
+
+struct hal_thread {
+  pthread_t tid;
+  void (*entry)(void *arg);
+  void *arg;
+  hal_thread_attr_t attr;
+  char name[16];
+};
+
+/**
+ * @brief 线程入口: 先在线程内设置名称、亲和性和调度策略
+ */
+static void *thread_main(void *p) {
+  hal_thread *t = (hal_thread *)p;
+
+#if defined(__linux__)
+  if (t->name[0])
+    pthread_setname_np(pthread_self(), t->name);
+  if (t->attr.cpu_mask) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int i = 0; i < 32; i++) {
+      if (t->attr.cpu_mask & (1u << i))
+        CPU_SET(i, &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#else
+  /* macOS 只能命名当前线程，不支持绑定 CPU */
+  if (t->name[0])
+    pthread_setname_np(t->name);
+#endif
+
+  if (t->attr.priority) {
+    struct sched_param sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.sched_priority = t->attr.priority;
+    /* 无 CAP_SYS_NICE 时失败，保持普通调度 */
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+  }
+
+  t->entry(t->arg);
+  return nullptr;
+}
+
+void *hal_thread_create(void (*entry)(void *arg), void *arg,
+                        const hal_thread_attr_t *attr) {
+  if (!entry)
+    return nullptr;
+
+  hal_thread *t = new hal_thread();
+  t->entry = entry;
+  t->arg = arg;
+  if (attr) {
+    t->attr = *attr;
+    if (attr->name) {
+      strncpy(t->name, attr->name, sizeof(t->name) - 1);
+    }
+  }
+
+  if (pthread_create(&t->tid, nullptr, thread_main, t) != 0) {
+    delete t;
+    return nullptr;
+  }
+  return t;
+}
+
+void hal_thread_join(void *thread) {
+  if (thread) {
+    hal_thread *t = (hal_thread *)thread;
+    pthread_join(t->tid, nullptr);
+    delete t;
+  }
+}
+
 #endif /* __linux__ || __APPLE__ */
@@ -15,6 +15,14 @@
 
 uint32_t hal_get_timestamp_ms(void) { return GetTickCount(); }
 
+uint64_t hal_get_utc_ms(void) {
+  /* FILETIME: 自 1601-01-01 起的 100ns 间隔数 */
+  FILETIME ft;
+  GetSystemTimeAsFileTime(&ft);
+  uint64_t t = ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+  return t / 10000 - 11644473600000ULL;
+}
+
 void hal_sleep_ms(uint32_t ms) { Sleep(ms); }
 
 /* ============================================================================
@@ -129,6 +137,25 @@ void hal_serial_flush(void *handle) {
   }
 }
 
+int hal_serial_wait(void *handle, uint32_t timeout_ms) {
+  if (!handle)
+    return -1;
+
+  /* 查询接收队列，1ms 间隔 */
+  uint32_t start = GetTickCount();
+  for (;;) {
+    COMSTAT stat;
+    DWORD errors;
+    if (!ClearCommError((HANDLE)handle, &errors, &stat))
+      return -1;
+    if (stat.cbInQue > 0)
+      return 1;
+    if (GetTickCount() - start >= timeout_ms)
+      return 0;
+    Sleep(1);
+  }
+}
+
 /* ============================================================================
  * 互斥锁
  * ============================================================================
@@ -159,4 +186,57 @@ void hal_mutex_unlock(void *mutex) {
   }
 }
 
+/* ============================================================================
+ * 线程
+ * ============================================================================
+ */
+
+struct hal_thread {
+  HANDLE handle;
+  void (*entry)(void *arg);
+  void *arg;
+};
+
+static DWORD WINAPI thread_main(LPVOID p) {
+  hal_thread *t = (hal_thread *)p;
+  t->entry(t->arg);
+  return 0;
+}
+
+void *hal_thread_create(void (*entry)(void *arg), void *arg,
+                        const hal_thread_attr_t *attr) {
+  if (!entry)
+    return nullptr;
+
+  hal_thread *t = new hal_thread();
+  t->entry = entry;
+  t->arg = arg;
+  t->handle = CreateThread(nullptr, 0, thread_main, t, CREATE_SUSPENDED,
+                           nullptr);
+  if (!t->handle) {
+    delete t;
+    return nullptr;
+  }
+
+  /* 线程名需 Windows 10 (SetThreadDescription)，此处不设置 */
+  if (attr && attr->cpu_mask) {
+    SetThreadAffinityMask(t->handle, attr->cpu_mask);
+  }
+  if (attr && attr->priority) {
+    SetThreadPriority(t->handle, THREAD_PRIORITY_TIME_CRITICAL);
+  }
+
+  ResumeThread(t->handle);
+  return t;
+}
+
+void hal_thread_join(void *thread) {
+  if (thread) {
+    hal_thread *t = (hal_thread *)thread;
+    WaitForSingleObject(t->handle, INFINITE);
+    CloseHandle(t->handle);
+    delete t;
+  }
+}
+
 #endif /* _WIN32 */
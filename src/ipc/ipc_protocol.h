@@ -0,0 +1,78 @@
+/**
+ * @file ipc_protocol.h
+ * @brief xslotd 本地 IPC 二进制协议
+ *
+ * 客户端与 xslotd 之间通过 Unix 域流套接字通信，仅限本机，
+ * 因此直接使用本机字节序和 SDK 结构体布局，无需额外编解码。
+ *
+ * 消息格式: [LEN:2][TYPE:1][SEQ:1][PAYLOAD:LEN]
+ *
+ * 请求 (客户端 -> xslotd) 均返回一条 IPC_RSP_RESULT (SEQ 相同)；
+ * 通知 (xslotd -> 客户端) 以 IPC_NOTIFY_BATCH 批量下发，SEQ 为 0。
+ */
+#ifndef IPC_PROTOCOL_H
+#define IPC_PROTOCOL_H
+
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IPC_HEADER_SIZE 4
+#define IPC_MAX_PAYLOAD 4096 /**< 单条消息最大负载 */
+
+/**
+ * @brief 消息类型
+ */
+typedef enum {
+  /* 请求 */
+  IPC_REQ_SUBSCRIBE = 0x01,   /**< [MASK:1][N:1][ADDR:2]*N (N=0 表示全部节点) */
+  IPC_REQ_REPORT = 0x02,      /**< [COUNT:1][xslot_bacnet_object_t]*COUNT */
+  IPC_REQ_WRITE = 0x03,       /**< [TARGET:2][xslot_bacnet_object_t] */
+  IPC_REQ_QUERY = 0x04,       /**< [TARGET:2][COUNT:1][ID:2]*COUNT */
+  IPC_REQ_PING = 0x05,        /**< [TARGET:2] */
+  IPC_REQ_GET_NODES = 0x06,   /**< 无负载 */
+  IPC_REQ_GET_MODE = 0x07,    /**< 无负载 */
+  IPC_REQ_WRITE_MULTI = 0x08, /**< [TARGET:2][COUNT:1][对象]*COUNT */
+  IPC_REQ_QUERY_PROP = 0x09,  /**< [TARGET:2][MASK:1][COUNT:1][引用]*COUNT */
+
+  /* 响应/通知 */
+  IPC_RSP_RESULT = 0x80,   /**< [CODE:4][DATA] */
+  IPC_NOTIFY_BATCH = 0x81, /**< [COUNT:2][ipc_event_header_t + BODY]*COUNT */
+} ipc_msg_type_t;
+
+/**
+ * @brief 消息头
+ */
+typedef struct {
+  uint16_t len;
+  uint8_t type;
+  uint8_t seq;
+} ipc_header_t;
+
+/**
+ * @brief 通知事件头 (后跟 len 字节事件体)
+ *
+ * 事件体:
+ * - XSLOT_CLIENT_EV_DATA:   原始数据
+ * - XSLOT_CLIENT_EV_NODE:   [ONLINE:1]
+ * - XSLOT_CLIENT_EV_WRITE:  xslot_bacnet_object_t
+ * - XSLOT_CLIENT_EV_REPORT: xslot_bacnet_object_t 数组
+ * - XSLOT_CLIENT_EV_ALARM:  xslot_alarm_event_t
+ * - XSLOT_CLIENT_EV_PROPERTY: xslot_property_set_t 数组
+ * - XSLOT_CLIENT_EV_HISTORY: xslot_history_sample_t 数组
+ */
+typedef struct {
+  uint8_t kind;  /**< 事件类型 (XSLOT_CLIENT_EV_*) */
+  uint8_t sub;   /**< 子设备号 (0=节点本身) */
+  uint16_t from; /**< 源地址 */
+  uint16_t len;  /**< 事件体长度 */
+} ipc_event_header_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IPC_PROTOCOL_H */
@@ -0,0 +1,454 @@
+/**
+ * @file xslot_client.cpp
+ * @brief xslotd 客户端实现
+ */
+#include "ipc_protocol.h"
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_client.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* 等待请求响应的超时 (确认发送可能需要数秒) */
+#define CLIENT_REQUEST_TIMEOUT_MS 10000
+
+/* 单次回调最多事件数 */
+#define CLIENT_EVENT_BATCH 64
+
+#define CLIENT_RX_SIZE (2 * (IPC_HEADER_SIZE + IPC_MAX_PAYLOAD))
+
+struct xslot_client {
+  int fd;
+  uint8_t seq;
+
+  xslot_client_event_cb event_cb;
+  void *event_ctx;
+
+  /* 接收缓冲区 (可能包含多条消息) */
+  uint8_t rx_buffer[CLIENT_RX_SIZE];
+  uint32_t rx_len;
+
+  /* 上报/属性/历史事件的数组 (从接收缓冲区复制以保证对齐) */
+  xslot_bacnet_object_t
+      objects[IPC_MAX_PAYLOAD / sizeof(xslot_bacnet_object_t)];
+  xslot_property_set_t props[IPC_MAX_PAYLOAD / sizeof(xslot_property_set_t)];
+  xslot_history_sample_t
+      history[IPC_MAX_PAYLOAD / sizeof(xslot_history_sample_t)];
+
+  /* 当前请求的响应 */
+  uint8_t wait_seq;
+  bool wait_done;
+  int wait_code;
+  uint8_t *wait_data;
+  uint16_t wait_data_size;
+  uint16_t wait_data_len;
+};
+
+xslot_client_t xslot_client_connect(const char *path) {
+  if (!path)
+    path = XSLOT_CLIENT_DEFAULT_PATH;
+
+  struct sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (std::strlen(path) >= sizeof(addr.sun_path))
+    return nullptr;
+  std::strcpy(addr.sun_path, path);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return nullptr;
+
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return nullptr;
+  }
+
+  xslot_client_t client =
+      (xslot_client_t)std::calloc(1, sizeof(struct xslot_client));
+  if (!client) {
+    close(fd);
+    return nullptr;
+  }
+
+  client->fd = fd;
+  return client;
+}
+
+void xslot_client_close(xslot_client_t client) {
+  if (!client)
+    return;
+
+  close(client->fd);
+  std::free(client);
+}
+
+int xslot_client_fd(xslot_client_t client) { return client ? client->fd : -1; }
+
+void xslot_client_set_event_callback(xslot_client_t client,
+                                     xslot_client_event_cb cb, void *ctx) {
+  if (client) {
+    client->event_cb = cb;
+    client->event_ctx = ctx;
+  }
+}
+
+/* ============================================================================
+ * 接收处理
+ * ============================================================================
+ */
+
+/**
+ * @brief 解析通知批并回调
+ * @return 事件数
+ */
+static int handle_notify(xslot_client_t client, const uint8_t *payload,
+                         uint16_t len) {
+  if (len < 2)
+    return 0;
+
+  uint16_t count;
+  std::memcpy(&count, payload, 2);
+  uint16_t pos = 2;
+
+  xslot_client_event_t events[CLIENT_EVENT_BATCH];
+  int n = 0;
+  int total = 0;
+  uint16_t objects_used = 0;
+  uint16_t props_used = 0;
+  uint16_t history_used = 0;
+
+  for (uint16_t i = 0; i < count; i++) {
+    ipc_event_header_t eh;
+    if (pos + sizeof(eh) > len)
+      break;
+    std::memcpy(&eh, payload + pos, sizeof(eh));
+    pos += sizeof(eh);
+    if (pos + eh.len > len)
+      break;
+    const uint8_t *body = payload + pos;
+    pos += eh.len;
+
+    xslot_client_event_t *ev = &events[n];
+    std::memset(ev, 0, sizeof(*ev));
+    ev->kind = eh.kind;
+    ev->sub = eh.sub;
+    ev->from = eh.from;
+
+    switch (eh.kind) {
+    case XSLOT_CLIENT_EV_DATA:
+      ev->u.raw.data = body;
+      ev->u.raw.len = eh.len;
+      break;
+    case XSLOT_CLIENT_EV_NODE:
+      if (eh.len < 1)
+        continue;
+      ev->u.online = body[0] != 0;
+      break;
+    case XSLOT_CLIENT_EV_WRITE:
+      if (eh.len < sizeof(xslot_bacnet_object_t))
+        continue;
+      std::memcpy(&ev->u.object, body, sizeof(xslot_bacnet_object_t));
+      break;
+    case XSLOT_CLIENT_EV_REPORT: {
+      /* 各事件体之和不超过负载长度，对象数组不会越界 */
+      uint8_t cnt = eh.len / sizeof(xslot_bacnet_object_t);
+      std::memcpy(&client->objects[objects_used], body,
+                  cnt * sizeof(xslot_bacnet_object_t));
+      ev->u.report.objects = &client->objects[objects_used];
+      ev->u.report.count = cnt;
+      objects_used += cnt;
+      break;
+    }
+    case XSLOT_CLIENT_EV_ALARM:
+      if (eh.len < sizeof(xslot_alarm_event_t))
+        continue;
+      std::memcpy(&ev->u.alarm, body, sizeof(xslot_alarm_event_t));
+      break;
+    case XSLOT_CLIENT_EV_PROPERTY: {
+      uint8_t cnt = eh.len / sizeof(xslot_property_set_t);
+      std::memcpy(&client->props[props_used], body,
+                  cnt * sizeof(xslot_property_set_t));
+      ev->u.property.props = &client->props[props_used];
+      ev->u.property.count = cnt;
+      props_used += cnt;
+      break;
+    }
+    case XSLOT_CLIENT_EV_HISTORY: {
+      uint16_t cnt = eh.len / sizeof(xslot_history_sample_t);
+      std::memcpy(&client->history[history_used], body,
+                  cnt * sizeof(xslot_history_sample_t));
+      ev->u.history.samples = &client->history[history_used];
+      ev->u.history.count = cnt;
+      history_used += cnt;
+      break;
+    }
+    default:
+      continue;
+    }
+
+    if (++n == CLIENT_EVENT_BATCH) {
+      if (client->event_cb)
+        client->event_cb(client->event_ctx, events, n);
+      total += n;
+      n = 0;
+    }
+  }
+
+  if (n > 0 && client->event_cb)
+    client->event_cb(client->event_ctx, events, n);
+
+  return total + n;
+}
+
+/**
+ * @brief 处理缓冲区中的完整消息
+ * @return 分发的事件数，协议错误时断开连接并返回 XSLOT_ERR_OFFLINE
+ */
+static int process_rx(xslot_client_t client) {
+  int events = 0;
+  uint32_t pos = 0;
+
+  while (client->rx_len - pos >= IPC_HEADER_SIZE) {
+    ipc_header_t hdr;
+    std::memcpy(&hdr, client->rx_buffer + pos, sizeof(hdr));
+    if (hdr.len > IPC_MAX_PAYLOAD) {
+      /* 协议错误: 缓冲区永远收不齐该消息，断开而不是停滞 */
+      shutdown(client->fd, SHUT_RDWR);
+      client->rx_len = 0;
+      return XSLOT_ERR_OFFLINE;
+    }
+    if (client->rx_len - pos < (uint32_t)IPC_HEADER_SIZE + hdr.len)
+      break;
+
+    const uint8_t *payload = client->rx_buffer + pos + IPC_HEADER_SIZE;
+
+    if (hdr.type == IPC_NOTIFY_BATCH) {
+      events += handle_notify(client, payload, hdr.len);
+    } else if (hdr.type == IPC_RSP_RESULT && hdr.seq == client->wait_seq &&
+               hdr.len >= 4) {
+      int32_t code;
+      std::memcpy(&code, payload, 4);
+      client->wait_code = code;
+      uint16_t n = hdr.len - 4;
+      if (n > client->wait_data_size)
+        n = client->wait_data_size;
+      if (client->wait_data && n > 0)
+        std::memcpy(client->wait_data, payload + 4, n);
+      client->wait_data_len = n;
+      client->wait_done = true;
+    }
+
+    pos += IPC_HEADER_SIZE + hdr.len;
+  }
+
+  if (pos > 0) {
+    std::memmove(client->rx_buffer, client->rx_buffer + pos,
+                 client->rx_len - pos);
+    client->rx_len -= pos;
+  }
+
+  return events;
+}
+
+/**
+ * @brief 等待可读并读取一次
+ * @return 读取字节数, 0=超时, <0=连接断开
+ */
+static int read_once(xslot_client_t client, uint32_t timeout_ms) {
+  struct pollfd pfd = {client->fd, POLLIN, 0};
+  int ret = poll(&pfd, 1, (int)timeout_ms);
+  if (ret <= 0)
+    return (ret < 0 && errno != EINTR) ? XSLOT_ERR_OFFLINE : 0;
+
+  ssize_t n = recv(client->fd, client->rx_buffer + client->rx_len,
+                   CLIENT_RX_SIZE - client->rx_len, 0);
+  if (n <= 0)
+    return XSLOT_ERR_OFFLINE;
+
+  client->rx_len += n;
+  return (int)n;
+}
+
+int xslot_client_dispatch(xslot_client_t client, uint32_t timeout_ms) {
+  if (!client)
+    return XSLOT_ERR_PARAM;
+
+  int ret = read_once(client, timeout_ms);
+  if (ret < 0)
+    return ret;
+
+  return process_rx(client);
+}
+
+/* ============================================================================
+ * 请求
+ * ============================================================================
+ */
+
+/**
+ * @brief 发送请求并等待结果
+ * @param data 响应数据 (可为 NULL)
+ * @param data_size 响应数据缓冲区大小
+ * @return 守护进程返回的错误码，或本地错误
+ */
+static int request(xslot_client_t client, uint8_t type, const void *payload,
+                   uint16_t len, void *data, uint16_t data_size) {
+  if (len > IPC_MAX_PAYLOAD)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t msg[IPC_HEADER_SIZE + IPC_MAX_PAYLOAD];
+  ipc_header_t hdr = {len, type, ++client->seq};
+  if (hdr.seq == 0)
+    hdr.seq = ++client->seq; /* SEQ 0 保留给通知 */
+  std::memcpy(msg, &hdr, sizeof(hdr));
+  if (len > 0)
+    std::memcpy(msg + IPC_HEADER_SIZE, payload, len);
+
+  client->wait_seq = hdr.seq;
+  client->wait_done = false;
+  client->wait_data = (uint8_t *)data;
+  client->wait_data_size = data ? data_size : 0;
+  client->wait_data_len = 0;
+
+  size_t total = IPC_HEADER_SIZE + len;
+  if (send(client->fd, msg, total, MSG_NOSIGNAL) != (ssize_t)total)
+    return XSLOT_ERR_OFFLINE;
+
+  /* 等待期间到达的通知照常分发 */
+  int waited = 0;
+  while (!client->wait_done && waited < CLIENT_REQUEST_TIMEOUT_MS) {
+    int ret = read_once(client, 100);
+    if (ret < 0)
+      return ret;
+    if (ret == 0)
+      waited += 100;
+    if (process_rx(client) < 0)
+      return XSLOT_ERR_OFFLINE;
+  }
+
+  client->wait_data = nullptr;
+  return client->wait_done ? client->wait_code : XSLOT_ERR_TIMEOUT;
+}
+
+int xslot_client_subscribe(xslot_client_t client, uint8_t mask,
+                           const uint16_t *addrs, uint8_t count) {
+  if (!client || count > 32 || (count > 0 && !addrs))
+    return XSLOT_ERR_PARAM;
+
+  uint8_t payload[2 + 32 * 2];
+  payload[0] = mask;
+  payload[1] = count;
+  if (count > 0)
+    std::memcpy(payload + 2, addrs, count * 2);
+
+  return request(client, IPC_REQ_SUBSCRIBE, payload, 2 + count * 2, nullptr,
+                 0);
+}
+
+int xslot_client_report(xslot_client_t client,
+                        const xslot_bacnet_object_t *objects, uint8_t count) {
+  if (!client || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t payload[1 + 255 * sizeof(xslot_bacnet_object_t)];
+  payload[0] = count;
+  std::memcpy(payload + 1, objects, count * sizeof(xslot_bacnet_object_t));
+
+  return request(client, IPC_REQ_REPORT, payload,
+                 1 + count * sizeof(xslot_bacnet_object_t), nullptr, 0);
+}
+
+int xslot_client_write(xslot_client_t client, uint16_t target,
+                       const xslot_bacnet_object_t *obj) {
+  if (!client || !obj)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t payload[2 + sizeof(xslot_bacnet_object_t)];
+  std::memcpy(payload, &target, 2);
+  std::memcpy(payload + 2, obj, sizeof(xslot_bacnet_object_t));
+
+  return request(client, IPC_REQ_WRITE, payload, sizeof(payload), nullptr, 0);
+}
+
+int xslot_client_write_objects(xslot_client_t client, uint16_t target,
+                               const xslot_bacnet_object_t *objects,
+                               uint8_t count) {
+  if (!client || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t payload[3 + 255 * sizeof(xslot_bacnet_object_t)];
+  std::memcpy(payload, &target, 2);
+  payload[2] = count;
+  std::memcpy(payload + 3, objects, count * sizeof(xslot_bacnet_object_t));
+
+  return request(client, IPC_REQ_WRITE_MULTI, payload,
+                 3 + count * sizeof(xslot_bacnet_object_t), nullptr, 0);
+}
+
+int xslot_client_query(xslot_client_t client, uint16_t target,
+                       const uint16_t *object_ids, uint8_t count) {
+  if (!client || !object_ids || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t payload[3 + 255 * 2];
+  std::memcpy(payload, &target, 2);
+  payload[2] = count;
+  std::memcpy(payload + 3, object_ids, count * 2);
+
+  return request(client, IPC_REQ_QUERY, payload, 3 + count * 2, nullptr, 0);
+}
+
+int xslot_client_query_properties(xslot_client_t client, uint16_t target,
+                                  uint8_t mask,
+                                  const xslot_object_ref_t *objects,
+                                  uint8_t count) {
+  if (!client || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  uint8_t payload[4 + 255 * sizeof(xslot_object_ref_t)];
+  std::memcpy(payload, &target, 2);
+  payload[2] = mask;
+  payload[3] = count;
+  std::memcpy(payload + 4, objects, count * sizeof(xslot_object_ref_t));
+
+  return request(client, IPC_REQ_QUERY_PROP, payload,
+                 4 + count * sizeof(xslot_object_ref_t), nullptr, 0);
+}
+
+int xslot_client_ping(xslot_client_t client, uint16_t target) {
+  if (!client)
+    return XSLOT_ERR_PARAM;
+
+  return request(client, IPC_REQ_PING, &target, 2, nullptr, 0);
+}
+
+int xslot_client_get_nodes(xslot_client_t client, xslot_node_info_t *nodes,
+                           int max_count) {
+  if (!client || !nodes || max_count <= 0)
+    return XSLOT_ERR_PARAM;
+
+  xslot_node_info_t buffer[XSLOT_MAX_NODES];
+  int ret =
+      request(client, IPC_REQ_GET_NODES, nullptr, 0, buffer, sizeof(buffer));
+  if (ret < 0)
+    return ret;
+
+  int count = client->wait_data_len / sizeof(xslot_node_info_t);
+  if (count > max_count)
+    count = max_count;
+  std::memcpy(nodes, buffer, count * sizeof(xslot_node_info_t));
+  return count;
+}
+
+xslot_run_mode_t xslot_client_get_run_mode(xslot_client_t client) {
+  if (!client)
+    return XSLOT_MODE_NONE;
+
+  int ret = request(client, IPC_REQ_GET_MODE, nullptr, 0, nullptr, 0);
+  return ret > 0 ? (xslot_run_mode_t)ret : XSLOT_MODE_NONE;
+}
@@ -0,0 +1,302 @@
+/**
+ * @file shm_publisher.cpp
+ * @brief 汇聚节点共享内存发布端实现 (POSIX shm_open/mmap)
+ */
+#include "shm_publisher.h"
+#include "../bacnet/bacnet_object_def.h"
+#include "../core/message_codec.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_shm.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define SHM_SUPPORTED 1
+#endif
+
+struct shm_publisher {
+  char name[64];
+  uint8_t *base;
+  size_t size;
+  xslot_shm_header_t *header;
+  xslot_node_info_t *nodes;
+  xslot_shm_object_t *objects;
+
+  /* 发布端私有索引: (addr, type, id) -> 槽位，开放寻址，-1=空 */
+  int32_t *index;
+  uint32_t index_mask;
+};
+
+/* ============================================================================
+ * 序号锁 (写入端)
+ * ============================================================================
+ */
+
+static inline void seq_write_begin(uint32_t *seq) {
+  std::atomic_ref<uint32_t> s(*seq);
+  s.store(s.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+static inline void seq_write_end(uint32_t *seq) {
+  std::atomic_ref<uint32_t> s(*seq);
+  s.store(s.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+/* ============================================================================
+ * 槽位索引
+ * ============================================================================
+ */
+
+static inline uint32_t key_hash(uint16_t addr, uint8_t type, uint16_t id) {
+  uint32_t h = ((uint32_t)addr << 16 | id) ^ ((uint32_t)type << 13);
+  return h * 2654435761u;
+}
+
+/**
+ * @brief 查找对象槽位
+ * @param pos 未找到时输出插入位置 (可为 NULL)
+ * @return 槽位索引，未找到返回 -1
+ */
+static int32_t slot_find(shm_publisher_t pub, uint16_t addr, uint8_t type,
+                         uint16_t id, uint32_t *pos) {
+  uint32_t i = key_hash(addr, type, id);
+
+  for (;; i++) {
+    int32_t entry = pub->index[i & pub->index_mask];
+    if (entry < 0)
+      break;
+
+    const xslot_shm_object_t *slot = &pub->objects[entry];
+    if (slot->addr == addr && slot->object.object_type == type &&
+        slot->object.object_id == id)
+      return entry;
+  }
+
+  if (pos)
+    *pos = i & pub->index_mask;
+  return -1;
+}
+
+/**
+ * @brief 按实例号在同一值类型的对象中查找 (对象未携带类型时使用)
+ * @return 恰好命中一个返回其索引; 未命中或命中多个返回 -1
+ */
+static int32_t slot_find_untyped(shm_publisher_t pub, uint16_t addr,
+                                 const xslot_bacnet_object_t *obj) {
+  uint8_t first = xslot_is_binary_type(obj->object_type)
+                      ? XSLOT_OBJ_BINARY_INPUT
+                      : XSLOT_OBJ_ANALOG_INPUT;
+  int32_t found = -1;
+  for (uint8_t type = first; type < first + 3; type++) {
+    int32_t idx = slot_find(pub, addr, type, obj->object_id, nullptr);
+    if (idx < 0)
+      continue;
+    if (found >= 0)
+      return -1;
+    found = idx;
+  }
+  return found;
+}
+
+/**
+ * @brief 查找或分配对象槽位
+ * @return 槽位索引，槽位用尽返回 -1
+ */
+static int32_t slot_acquire(shm_publisher_t pub,
+                            const xslot_bacnet_object_t *obj, uint16_t addr,
+                            uint32_t now) {
+  uint32_t pos;
+  int32_t idx = slot_find(pub, addr, obj->object_type, obj->object_id, &pos);
+  if (idx >= 0)
+    return idx;
+
+  std::atomic_ref<uint32_t> count(pub->header->object_count);
+  uint32_t n = count.load(std::memory_order_relaxed);
+  if (n >= pub->header->max_objects)
+    return -1;
+
+  /* 新槽位在计数发布前填好标识和首个值，读取端无需加锁即可查找 */
+  xslot_shm_object_t *slot = &pub->objects[n];
+  slot->addr = addr;
+  slot->update_ms = now;
+  slot->object = *obj;
+  count.store(n + 1, std::memory_order_release);
+
+  pub->index[pos] = (int32_t)n;
+  return (int32_t)n;
+}
+
+/* ============================================================================
+ * 公共接口
+ * ============================================================================
+ */
+
+#ifdef SHM_SUPPORTED
+
+shm_publisher_t shm_publisher_create(const char *name, uint32_t max_objects) {
+  if (!name)
+    name = XSLOT_SHM_DEFAULT_NAME;
+  if (max_objects == 0 || std::strlen(name) >= 64)
+    return nullptr;
+
+  shm_publisher_t pub =
+      (shm_publisher_t)std::calloc(1, sizeof(struct shm_publisher));
+  if (!pub)
+    return nullptr;
+  std::strcpy(pub->name, name);
+
+  /* 索引容量取 2 的幂且不小于槽位数的两倍 */
+  uint32_t cap = 1;
+  while (cap < max_objects * 2)
+    cap <<= 1;
+  pub->index = (int32_t *)std::malloc(cap * sizeof(int32_t));
+  if (!pub->index) {
+    std::free(pub);
+    return nullptr;
+  }
+  std::memset(pub->index, 0xFF, cap * sizeof(int32_t));
+  pub->index_mask = cap - 1;
+
+  uint32_t nodes_offset = sizeof(xslot_shm_header_t);
+  uint32_t objects_offset =
+      nodes_offset + XSLOT_MAX_NODES * sizeof(xslot_node_info_t);
+  objects_offset = (objects_offset + 63) & ~63u;
+  pub->size = objects_offset + max_objects * sizeof(xslot_shm_object_t);
+
+  /* 重新创建: 旧段上的读取端会看到 writer_alive=0 后重新打开 */
+  shm_unlink(name);
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    std::free(pub->index);
+    std::free(pub);
+    return nullptr;
+  }
+
+  if (ftruncate(fd, (off_t)pub->size) != 0) {
+    close(fd);
+    shm_unlink(name);
+    std::free(pub->index);
+    std::free(pub);
+    return nullptr;
+  }
+
+  void *base =
+      mmap(nullptr, pub->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    shm_unlink(name);
+    std::free(pub->index);
+    std::free(pub);
+    return nullptr;
+  }
+
+  pub->base = (uint8_t *)base;
+  pub->header = (xslot_shm_header_t *)base;
+  pub->nodes = (xslot_node_info_t *)(pub->base + nodes_offset);
+  pub->objects = (xslot_shm_object_t *)(pub->base + objects_offset);
+
+  /* ftruncate 已清零，填写段头后最后写入 magic */
+  xslot_shm_header_t *h = pub->header;
+  h->version = XSLOT_SHM_VERSION;
+  h->header_size = sizeof(xslot_shm_header_t);
+  h->node_size = sizeof(xslot_node_info_t);
+  h->object_size = sizeof(xslot_shm_object_t);
+  h->max_nodes = XSLOT_MAX_NODES;
+  h->max_objects = max_objects;
+  h->nodes_offset = nodes_offset;
+  h->objects_offset = objects_offset;
+  h->writer_alive = 1;
+  std::atomic_ref<uint32_t>(h->magic).store(XSLOT_SHM_MAGIC,
+                                            std::memory_order_release);
+
+  return pub;
+}
+
+void shm_publisher_destroy(shm_publisher_t pub) {
+  if (!pub)
+    return;
+
+  std::atomic_ref<uint32_t>(pub->header->writer_alive)
+      .store(0, std::memory_order_release);
+  munmap(pub->base, pub->size);
+  shm_unlink(pub->name);
+
+  std::free(pub->index);
+  std::free(pub);
+}
+
+#else /* !SHM_SUPPORTED */
+
+shm_publisher_t shm_publisher_create(const char *name, uint32_t max_objects) {
+  (void)name;
+  (void)max_objects;
+  return nullptr;
+}
+
+void shm_publisher_destroy(shm_publisher_t pub) { (void)pub; }
+
+#endif /* SHM_SUPPORTED */
+
+void shm_publisher_update_nodes(shm_publisher_t pub, node_table_t table,
+                                uint32_t now) {
+  if (!pub || !table)
+    return;
+
+  xslot_node_info_t nodes[XSLOT_MAX_NODES];
+  int count = node_table_get_all(table, nodes, XSLOT_MAX_NODES);
+
+  xslot_shm_header_t *h = pub->header;
+  seq_write_begin(&h->node_seq);
+  std::memcpy(pub->nodes, nodes, count * sizeof(xslot_node_info_t));
+  h->node_count = count;
+  seq_write_end(&h->node_seq);
+
+  std::atomic_ref<uint32_t>(h->update_ms)
+      .store(now, std::memory_order_relaxed);
+}
+
+int shm_publisher_update_objects(shm_publisher_t pub, uint16_t addr,
+                                 const xslot_bacnet_object_t *objects,
+                                 uint8_t count, uint8_t format,
+                                 uint32_t now) {
+  if (!pub || !objects)
+    return count;
+
+  int dropped = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const xslot_bacnet_object_t *obj = &objects[i];
+    int32_t idx;
+    if (format == MESSAGE_REPORT_UNTYPED) {
+      /* 推断的类型不可信: 只更新已有槽位，不分配新槽位 */
+      idx = slot_find_untyped(pub, addr, obj);
+      if (idx < 0)
+        continue;
+    } else {
+      uint32_t before = pub->header->object_count;
+      idx = slot_acquire(pub, obj, addr, now);
+      if (idx < 0) {
+        dropped++;
+        continue;
+      }
+      if ((uint32_t)idx >= before)
+        continue; /* 新槽位已写入首个值 */
+    }
+
+    xslot_shm_object_t *slot = &pub->objects[idx];
+    seq_write_begin(&slot->seq);
+    slot->update_ms = now;
+    /* 增量格式不携带状态标志，保留最近一次完整格式上报的标志 */
+    if (format == MESSAGE_REPORT_FULL)
+      slot->object.flags = obj->flags;
+    slot->object.present_value = obj->present_value;
+    seq_write_end(&slot->seq);
+  }
+
+  std::atomic_ref<uint32_t>(pub->header->update_ms)
+      .store(now, std::memory_order_relaxed);
+  return dropped;
+}
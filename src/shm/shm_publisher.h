@@ -0,0 +1,60 @@
+/**
+ * @file shm_publisher.h
+ * @brief 汇聚节点共享内存发布端
+ *
+ * 段布局见 <xslot/xslot_shm.h>。发布端是唯一的写入者。
+ */
+#ifndef SHM_PUBLISHER_H
+#define SHM_PUBLISHER_H
+
+#include "../core/node_table.h"
+#include <stdint.h>
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 发布端句柄
+ */
+typedef struct shm_publisher *shm_publisher_t;
+
+/**
+ * @brief 创建并映射共享内存段
+ * @param name 共享内存名 (NULL 使用默认名)
+ * @param max_objects 对象槽位数
+ * @return 句柄，平台不支持或创建失败返回 NULL
+ */
+shm_publisher_t shm_publisher_create(const char *name, uint32_t max_objects);
+
+/**
+ * @brief 标记段已关闭并解除映射
+ */
+void shm_publisher_destroy(shm_publisher_t pub);
+
+/**
+ * @brief 发布节点表快照
+ */
+void shm_publisher_update_nodes(shm_publisher_t pub, node_table_t table,
+                                uint32_t now);
+
+/**
+ * @brief 发布上报的对象值
+ * @param format 上报载荷格式 (MESSAGE_REPORT_*)
+ * @return 因槽位用尽未能发布的对象数量
+ *
+ * 增量格式只更新值，保留槽位中最近一次完整格式上报的状态标志。
+ * 未携带类型的增量格式 (旧版节点) 不分配新槽位，只按 (addr, id) 更新
+ * 同一值类型中唯一的已有槽位；无法确定时忽略，等待完整格式上报。
+ */
+int shm_publisher_update_objects(shm_publisher_t pub, uint16_t addr,
+                                 const xslot_bacnet_object_t *objects,
+                                 uint8_t count, uint8_t format,
+                                 uint32_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHM_PUBLISHER_H */
@@ -0,0 +1,202 @@
+/**
+ * @file xslot_shm_reader.cpp
+ * @brief 共享内存读取端实现
+ *
+ * 独立于协议栈，读取进程只需链接 xslot_shm 库。
+ */
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_shm.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SHM_SUPPORTED 1
+#endif
+
+/* 写入端持续更新同一槽位时的最大重读次数 */
+#define SHM_READ_RETRY_MAX 1000
+
+struct xslot_shm_reader {
+  const uint8_t *base;
+  size_t size;
+  const xslot_shm_header_t *header;
+  const xslot_node_info_t *nodes;
+  const xslot_shm_object_t *objects;
+};
+
+/* ============================================================================
+ * 序号锁 (读取端)
+ * ============================================================================
+ */
+
+static inline uint32_t load_relaxed(const uint32_t *p) {
+  return std::atomic_ref<uint32_t>(*const_cast<uint32_t *>(p))
+      .load(std::memory_order_relaxed);
+}
+
+static inline uint32_t seq_read_begin(const uint32_t *seq) {
+  return std::atomic_ref<uint32_t>(*const_cast<uint32_t *>(seq))
+      .load(std::memory_order_acquire);
+}
+
+static inline bool seq_read_retry(const uint32_t *seq, uint32_t start) {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return (start & 1) || load_relaxed(seq) != start;
+}
+
+/* ============================================================================
+ * 打开/关闭
+ * ============================================================================
+ */
+
+#ifdef SHM_SUPPORTED
+
+xslot_shm_reader_t xslot_shm_open(const char *name) {
+  if (!name)
+    name = XSLOT_SHM_DEFAULT_NAME;
+
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(xslot_shm_header_t)) {
+    close(fd);
+    return nullptr;
+  }
+
+  void *base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return nullptr;
+
+  /* 校验版本和布局，避免不同版本 SDK 之间误读 */
+  const xslot_shm_header_t *h = (const xslot_shm_header_t *)base;
+  if (seq_read_begin(&h->magic) != XSLOT_SHM_MAGIC ||
+      h->version != XSLOT_SHM_VERSION ||
+      h->header_size != sizeof(xslot_shm_header_t) ||
+      h->node_size != sizeof(xslot_node_info_t) ||
+      h->object_size != sizeof(xslot_shm_object_t) ||
+      h->objects_offset + (size_t)h->max_objects * h->object_size >
+          (size_t)st.st_size) {
+    munmap(base, st.st_size);
+    return nullptr;
+  }
+
+  xslot_shm_reader_t reader =
+      (xslot_shm_reader_t)std::calloc(1, sizeof(struct xslot_shm_reader));
+  if (!reader) {
+    munmap(base, st.st_size);
+    return nullptr;
+  }
+
+  reader->base = (const uint8_t *)base;
+  reader->size = st.st_size;
+  reader->header = h;
+  reader->nodes = (const xslot_node_info_t *)(reader->base + h->nodes_offset);
+  reader->objects =
+      (const xslot_shm_object_t *)(reader->base + h->objects_offset);
+
+  return reader;
+}
+
+void xslot_shm_close(xslot_shm_reader_t reader) {
+  if (!reader)
+    return;
+
+  munmap(const_cast<uint8_t *>(reader->base), reader->size);
+  std::free(reader);
+}
+
+#else /* !SHM_SUPPORTED */
+
+xslot_shm_reader_t xslot_shm_open(const char *name) {
+  (void)name;
+  return nullptr;
+}
+
+void xslot_shm_close(xslot_shm_reader_t reader) { (void)reader; }
+
+#endif /* SHM_SUPPORTED */
+
+/* ============================================================================
+ * 读取
+ * ============================================================================
+ */
+
+bool xslot_shm_is_alive(xslot_shm_reader_t reader) {
+  if (!reader)
+    return false;
+
+  return load_relaxed(&reader->header->writer_alive) != 0;
+}
+
+int xslot_shm_get_nodes(xslot_shm_reader_t reader, xslot_node_info_t *nodes,
+                        int max_count) {
+  if (!reader || !nodes || max_count <= 0)
+    return XSLOT_ERR_PARAM;
+
+  const xslot_shm_header_t *h = reader->header;
+  for (int retry = 0; retry < SHM_READ_RETRY_MAX; retry++) {
+    uint32_t seq = seq_read_begin(&h->node_seq);
+
+    uint32_t count = load_relaxed(&h->node_count);
+    if (count > h->max_nodes)
+      count = h->max_nodes;
+    if (count > (uint32_t)max_count)
+      count = max_count;
+    std::memcpy(nodes, reader->nodes, count * sizeof(xslot_node_info_t));
+
+    if (!seq_read_retry(&h->node_seq, seq))
+      return (int)count;
+  }
+
+  return XSLOT_ERR_BUSY;
+}
+
+int xslot_shm_object_count(xslot_shm_reader_t reader) {
+  if (!reader)
+    return 0;
+
+  return (int)seq_read_begin(&reader->header->object_count);
+}
+
+int xslot_shm_find_object(xslot_shm_reader_t reader, uint16_t addr,
+                          uint8_t object_type, uint16_t object_id) {
+  if (!reader)
+    return XSLOT_ERR_PARAM;
+
+  /* 已发布槽位的标识不再改变，无需序号锁 */
+  int count = xslot_shm_object_count(reader);
+  for (int i = 0; i < count; i++) {
+    const xslot_shm_object_t *slot = &reader->objects[i];
+    if (slot->addr == addr && slot->object.object_id == object_id &&
+        slot->object.object_type == object_type)
+      return i;
+  }
+
+  return XSLOT_ERR_PARAM;
+}
+
+int xslot_shm_read_object(xslot_shm_reader_t reader, int index,
+                          xslot_shm_object_t *out) {
+  if (!reader || !out || index < 0 ||
+      index >= xslot_shm_object_count(reader))
+    return XSLOT_ERR_PARAM;
+
+  const xslot_shm_object_t *slot = &reader->objects[index];
+  for (int retry = 0; retry < SHM_READ_RETRY_MAX; retry++) {
+    uint32_t seq = seq_read_begin(&slot->seq);
+    std::memcpy(out, slot, sizeof(xslot_shm_object_t));
+    if (!seq_read_retry(&slot->seq, seq)) {
+      out->seq = seq;
+      return XSLOT_OK;
+    }
+  }
+
+  return XSLOT_ERR_BUSY;
+}
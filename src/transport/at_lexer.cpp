@@ -0,0 +1,77 @@
+/**
+ * @file at_lexer.cpp
+ * @brief AT 响应行切分实现
+ */
+#include "at_lexer.h"
+#include <cstring>
+#include <string_view>
+
+void at_lexer_reset(at_lexer_t *lx) {
+  lx->len = 0;
+  lx->start = 0;
+  lx->scan = 0;
+  lx->discarding = false;
+}
+
+uint8_t *at_lexer_space(at_lexer_t *lx, uint16_t *avail) {
+  if (lx->start > 0) {
+    std::memmove(lx->buf, lx->buf + lx->start, lx->len - lx->start);
+    lx->len -= lx->start;
+    lx->scan -= lx->start;
+    lx->start = 0;
+  }
+
+  /* 缓冲区满且没有完整的行: 丢弃这一行 */
+  if (lx->len == AT_LEXER_SIZE &&
+      !std::memchr(lx->buf + lx->scan, '\n', lx->len - lx->scan)) {
+    lx->discarding = true;
+    lx->len = 0;
+    lx->scan = 0;
+  }
+
+  *avail = AT_LEXER_SIZE - lx->len;
+  return (uint8_t *)lx->buf + lx->len;
+}
+
+void at_lexer_commit(at_lexer_t *lx, uint16_t n) { lx->len += n; }
+
+static at_line_kind_t classify(std::string_view s) {
+  if (s == "OK")
+    return AT_LINE_OK;
+  if (s == "ERROR" || s.starts_with("+CME ERROR"))
+    return AT_LINE_ERROR;
+  if (s.starts_with('+'))
+    return AT_LINE_URC;
+  return AT_LINE_INFO;
+}
+
+bool at_lexer_next(at_lexer_t *lx, at_line_t *line) {
+  while (lx->scan < lx->len) {
+    const char *nl = (const char *)std::memchr(lx->buf + lx->scan, '\n',
+                                               lx->len - lx->scan);
+    if (!nl) {
+      lx->scan = lx->len;
+      return false;
+    }
+
+    uint16_t begin = lx->start;
+    uint16_t end = (uint16_t)(nl - lx->buf);
+    lx->start = end + 1;
+    lx->scan = end + 1;
+
+    if (lx->discarding) {
+      lx->discarding = false;
+      continue;
+    }
+    if (end > begin && lx->buf[end - 1] == '\r')
+      end--;
+    if (end == begin)
+      continue;
+
+    line->text = lx->buf + begin;
+    line->len = end - begin;
+    line->kind = classify(std::string_view(line->text, line->len));
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file at_lexer.h
+ * @brief AT 响应行切分 (流式)
+ *
+ * 串口数据直接读入切分器的缓冲区，按 '\n' 切出完整行并识别最终结果码
+ * (OK / ERROR) 与 URC。行内容不复制、不补 NUL，在下一次
+ * at_lexer_space() 之前有效。超过缓冲区的行整行丢弃。
+ */
+#ifndef AT_LEXER_H
+#define AT_LEXER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 行缓冲区: 400 字节数据的 +NNMI 行 (十六进制 800 字符加字段) */
+#define AT_LEXER_SIZE 1024
+
+/**
+ * @brief 行类型
+ */
+typedef enum {
+  AT_LINE_INFO,  /**< 信息行 (命令回显、查询结果等) */
+  AT_LINE_OK,    /**< 最终结果: OK */
+  AT_LINE_ERROR, /**< 最终结果: ERROR / +CME ERROR */
+  AT_LINE_URC,   /**< 以 '+' 开头的行 (URC 或查询结果) */
+} at_line_kind_t;
+
+/**
+ * @brief 一行 (不含行尾 \r\n)
+ */
+typedef struct {
+  const char *text;
+  uint16_t len;
+  at_line_kind_t kind;
+} at_line_t;
+
+/**
+ * @brief 切分状态
+ */
+typedef struct {
+  char buf[AT_LEXER_SIZE];
+  uint16_t len;    /**< 缓冲区中的字节数 */
+  uint16_t start;  /**< 当前行起点 */
+  uint16_t scan;   /**< 已查找过 '\n' 的位置 */
+  bool discarding; /**< 超长行，丢弃到下一个 '\n' */
+} at_lexer_t;
+
+void at_lexer_reset(at_lexer_t *lx);
+
+/**
+ * @brief 取得可写入区域 (先移走已处理的行)
+ * @param avail 输出可写字节数
+ * @return 写入位置，读取完成后调用 at_lexer_commit
+ */
+uint8_t *at_lexer_space(at_lexer_t *lx, uint16_t *avail);
+
+void at_lexer_commit(at_lexer_t *lx, uint16_t n);
+
+/**
+ * @brief 取出下一个完整的非空行
+ * @return false=没有完整的行
+ */
+bool at_lexer_next(at_lexer_t *lx, at_line_t *line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AT_LEXER_H */
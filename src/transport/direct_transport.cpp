@@ -2,7 +2,12 @@
  * @file direct_transport.cpp
  * @brief HMI 直连传输层实现
  *
- * 纯串口透传，直接解析 X-Slot 帧。
+ * 纯串口透传，直接解析 X-Slot 帧。配置 RS-485 多点总线时由主站轮询
+ * 仲裁: 主站依次向从站发放令牌 (BUS_TOKEN 帧)，从站持有令牌时发出缓存
+ * 的帧后交回令牌，总线上同一时刻只有一个发送者。
+ *
+ * 点对点链路可在探测时协商 COBS 帧格式 (FRAMING 帧): 帧以 0x00 定界，
+ * 数据损坏后扫描到下一个定界符即重新同步，每个候选帧只校验一次 CRC。
  */
 #include "direct_transport.h"
 #include "../core/xslot_protocol.h"
@@ -17,10 +22,27 @@ void hal_serial_close(void *handle);
 int hal_serial_write(void *handle, const uint8_t *data, uint16_t len);
 int hal_serial_read(void *handle, uint8_t *data, uint16_t max_len,
                     uint32_t timeout_ms);
+int hal_serial_wait(void *handle, uint32_t timeout_ms);
 uint32_t hal_get_timestamp_ms(void);
+void hal_sleep_ms(uint32_t ms);
 }
 
-#define RX_BUFFER_SIZE 256
+#define RX_BUFFER_SIZE 1024
+#define RX_BATCH_MAX 32 /* 单次批量交付的最大帧数 */
+
+/* 多点总线默认参数 */
+#define BUS_TX_QUEUE_SIZE 1024  /* 等待令牌期间的待发数据 */
+#define BUS_TURNAROUND_MS 2     /* 收发器切换间隔 */
+#define BUS_REPLY_TIMEOUT_MS 50 /* 从站静默多久视为无应答 */
+#define BUS_CYCLE_MS 20         /* 每轮令牌的最小间隔 */
+
+/* 帧格式协商 */
+#define FRAMING_PROBE_MS 200   /* 探测时等待对端应答 */
+#define FRAMING_MAX_ERRORS 8   /* 连续无效的 COBS 帧数，达到即回退 */
+#define FRAMING_RETRY_MS 1000  /* 回退后重新协商的间隔 */
+#define FRAMING_MAX_RETRIES 10 /* 回退后重新协商的次数 */
+#define FRAMING_OP_REQUEST 0   /* FRAMING 载荷 [OP][MODE] */
+#define FRAMING_OP_ACCEPT 1
 
 struct direct_transport_impl {
   i_transport_t base;
@@ -32,9 +54,38 @@ struct direct_transport_impl {
   transport_receive_cb recv_cb;
   void *recv_ctx;
 
+  /* 批量接收回调 */
+  transport_batch_cb batch_cb;
+  void *batch_ctx;
+
   /* 接收缓冲区 */
   uint8_t rx_buffer[RX_BUFFER_SIZE];
   uint16_t rx_len;
+  uint32_t rx_ms; /* 最近收到数据的时间 (收发切换间隔的起点) */
+
+  /* 多点总线: 等待令牌期间的待发帧 */
+  uint8_t tx_queue[BUS_TX_QUEUE_SIZE];
+  uint16_t tx_len;
+  uint8_t token_seq;
+
+  /* 多点总线主站 */
+  bool token_out;          /* 令牌在从站手中 */
+  uint16_t token_addr;     /* 持有令牌的从站 */
+  uint32_t token_ms;       /* 发出令牌或最近收到数据的时间 */
+  uint8_t token_next;      /* 下一个发放令牌的从站 (slaves 下标) */
+  uint32_t cycle_start_ms; /* 本轮令牌开始时间 */
+
+  /* 多点总线从站 */
+  bool token_held;       /* 收到令牌，poll 结束时交回 */
+  uint16_t token_master; /* 发放令牌的主站 */
+  uint32_t token_rx_ms;  /* 收到令牌的时间 */
+
+  /* 帧格式 */
+  bool cobs;               /* 已与对端协商为 COBS */
+  bool framing_pending;    /* 已发出协商请求，等待应答 */
+  uint8_t cobs_errors;     /* 连续无效的 COBS 帧数 */
+  uint8_t framing_retries; /* 剩余的重新协商次数 */
+  uint32_t framing_ms;     /* 最近一次发出协商请求的时间 */
 };
 
 /* 前向声明 */
@@ -45,6 +96,10 @@ static int direct_probe(void *impl);
 static int direct_configure(void *impl, uint8_t cell_id, int8_t power_dbm);
 static void direct_set_recv_cb(void *impl, transport_receive_cb cb, void *ctx);
 static void direct_destroy(void *impl);
+static int direct_poll(void *impl, uint32_t timeout_ms);
+static void direct_set_batch_cb(void *impl, transport_batch_cb cb, void *ctx);
+static int direct_wait(void *impl, uint32_t timeout_ms);
+static int try_parse_frame(direct_transport_impl *impl);
 
 static const i_transport_vtable_t direct_vtable = {
     .start = direct_start,
@@ -54,63 +109,473 @@ static const i_transport_vtable_t direct_vtable = {
     .configure = direct_configure,
     .set_receive_cb = direct_set_recv_cb,
     .destroy = direct_destroy,
+    .send_confirmed = nullptr, /* 串口直连无送达确认 */
+    .poll = direct_poll,
+    .set_route_cb = nullptr,
+    .set_frame_cb = nullptr,
+    .set_batch_cb = direct_set_batch_cb,
+    .wait = direct_wait,
 };
 
+/* ============================================================================
+ * RS-485 多点总线
+ * ============================================================================
+ */
+
+static inline uint16_t frame_addr(const uint8_t *p, int offset) {
+  return p[offset] | (p[offset + 1] << 8);
+}
+
 /**
- * @brief 尝试从缓冲区解析帧
+ * @brief 帧是否发往本站 (只看帧头，在 CRC 校验之前)
+ */
+static bool bus_accepts(const direct_transport_impl *impl, const uint8_t *p) {
+  uint16_t to = frame_addr(p, XSLOT_OFFSET_TO);
+  return to == impl->config.local_addr || to == XSLOT_ADDR_BROADCAST ||
+         to == XSLOT_ADDR_ANY_HUB;
+}
+
+static uint32_t bus_reply_timeout(const direct_transport_impl *impl) {
+  uint16_t ms = impl->config.bus.reply_timeout_ms;
+  return ms ? ms : BUS_REPLY_TIMEOUT_MS;
+}
+
+static uint32_t bus_cycle(const direct_transport_impl *impl) {
+  uint16_t ms = impl->config.bus.cycle_ms;
+  return ms ? ms : BUS_CYCLE_MS;
+}
+
+/**
+ * @brief 等待收发切换间隔 (对方收发器从发送切回接收)
+ */
+static void bus_turnaround(direct_transport_impl *impl) {
+  uint8_t gap = impl->config.bus.turnaround_ms;
+  if (gap == 0)
+    gap = BUS_TURNAROUND_MS;
+  uint32_t since = hal_get_timestamp_ms() - impl->rx_ms;
+  if (since < gap)
+    hal_sleep_ms(gap - since);
+}
+
+static int bus_enqueue(direct_transport_impl *impl, const uint8_t *data,
+                       uint16_t len) {
+  if (impl->tx_len + len > BUS_TX_QUEUE_SIZE)
+    return XSLOT_ERR_BUSY;
+  std::memcpy(impl->tx_queue + impl->tx_len, data, len);
+  impl->tx_len += len;
+  return XSLOT_OK;
+}
+
+static void bus_flush(direct_transport_impl *impl) {
+  if (impl->tx_len == 0)
+    return;
+  hal_serial_write(impl->serial, impl->tx_queue, impl->tx_len);
+  impl->tx_len = 0;
+}
+
+static void bus_send_token(direct_transport_impl *impl, uint16_t to) {
+  xslot_frame_t token;
+  xslot_frame_init(&token);
+  token.from = impl->config.local_addr;
+  token.to = to;
+  token.seq = impl->token_seq++;
+  token.cmd = XSLOT_CMD_BUS_TOKEN;
+
+  uint8_t buf[XSLOT_FRAME_MIN_SIZE];
+  int len = xslot_frame_encode(&token, buf, sizeof(buf));
+  if (len > 0)
+    hal_serial_write(impl->serial, buf, (uint16_t)len);
+}
+
+static void bus_on_token(direct_transport_impl *impl, const uint8_t *p) {
+  if (frame_addr(p, XSLOT_OFFSET_TO) != impl->config.local_addr)
+    return;
+
+  uint16_t from = frame_addr(p, XSLOT_OFFSET_FROM);
+  if (impl->config.bus.role == XSLOT_BUS_MASTER) {
+    /* 从站交回令牌 */
+    if (impl->token_out && from == impl->token_addr)
+      impl->token_out = false;
+  } else {
+    impl->token_held = true;
+    impl->token_master = from;
+    impl->token_rx_ms = hal_get_timestamp_ms();
+  }
+}
+
+/**
+ * @brief 从站: 发出缓存的帧并交回令牌
+ *
+ * 超过应答时间才处理的令牌已被主站放弃，此时发送会与其他站冲突，
+ * 缓存的帧留待下一个令牌。
+ */
+static void bus_release(direct_transport_impl *impl) {
+  impl->token_held = false;
+  if (hal_get_timestamp_ms() - impl->token_rx_ms >= bus_reply_timeout(impl))
+    return;
+
+  bus_turnaround(impl);
+  bus_flush(impl);
+  bus_send_token(impl, impl->token_master);
+}
+
+/**
+ * @brief 主站: 收回超时的令牌，发出缓存的帧，向下一个从站发放令牌
+ */
+static void bus_master_service(direct_transport_impl *impl) {
+  const xslot_bus_config_t *bus = &impl->config.bus;
+  uint32_t now = hal_get_timestamp_ms();
+
+  if (impl->token_out) {
+    if (now - impl->token_ms < bus_reply_timeout(impl))
+      return;
+    impl->token_out = false; /* 从站无应答或令牌丢失 */
+  }
+
+  bus_turnaround(impl);
+  bus_flush(impl);
+
+  uint8_t count = bus->slave_count < XSLOT_MAX_BUS_SLAVES
+                      ? bus->slave_count
+                      : XSLOT_MAX_BUS_SLAVES;
+  if (count == 0)
+    return;
+
+  /* 每轮开始时限制令牌频率，空闲总线不满负荷轮询 */
+  if (impl->token_next == 0) {
+    if (now - impl->cycle_start_ms < bus_cycle(impl))
+      return;
+    impl->cycle_start_ms = now;
+  }
+
+  impl->token_addr = bus->slaves[impl->token_next];
+  impl->token_next = (uint8_t)((impl->token_next + 1) % count);
+  bus_send_token(impl, impl->token_addr);
+  impl->token_out = true;
+  impl->token_ms = hal_get_timestamp_ms();
+}
+
+/**
+ * @brief 主站: 距下一次需要 bus_master_service 的时间
+ */
+static uint32_t bus_master_due(const direct_transport_impl *impl) {
+  uint32_t elapsed, limit;
+  if (impl->token_out) {
+    elapsed = hal_get_timestamp_ms() - impl->token_ms;
+    limit = bus_reply_timeout(impl);
+  } else if (impl->config.bus.slave_count == 0) {
+    return UINT32_MAX;
+  } else if (impl->token_next == 0) {
+    elapsed = hal_get_timestamp_ms() - impl->cycle_start_ms;
+    limit = bus_cycle(impl);
+  } else {
+    return 0;
+  }
+  return elapsed < limit ? limit - elapsed : 0;
+}
+
+/* ============================================================================
+ * 帧格式协商 (COBS)
+ * ============================================================================
+ */
+
+static bool framing_wanted(const direct_transport_impl *impl) {
+  /* 多点总线上各站须使用同一帧格式，不做点对点协商 */
+  return impl->config.framing == XSLOT_FRAMING_COBS &&
+         impl->config.bus.role == XSLOT_BUS_POINT;
+}
+
+/**
+ * @brief 发送 FRAMING 帧 (始终为 SYNC 定界格式，旧版本对端可解析)
+ */
+static void framing_send(direct_transport_impl *impl, uint16_t to, uint8_t op,
+                         uint8_t mode) {
+  xslot_frame_t frame;
+  xslot_frame_init(&frame);
+  frame.from = impl->config.local_addr;
+  frame.to = to;
+  frame.cmd = XSLOT_CMD_FRAMING;
+  frame.data[0] = op;
+  frame.data[1] = mode;
+  frame.len = 2;
+
+  uint8_t buf[XSLOT_FRAME_MIN_SIZE + 2];
+  int len = xslot_frame_encode(&frame, buf, sizeof(buf));
+  if (len > 0)
+    hal_serial_write(impl->serial, buf, (uint16_t)len);
+}
+
+static void framing_request(direct_transport_impl *impl) {
+  framing_send(impl, XSLOT_ADDR_BROADCAST, FRAMING_OP_REQUEST,
+               XSLOT_FRAMING_COBS);
+  impl->framing_pending = true;
+  impl->framing_ms = hal_get_timestamp_ms();
+}
+
+/**
+ * @brief 处理 FRAMING 帧: 应答请求，或按对端应答切换帧格式
+ */
+static void framing_on_frame(direct_transport_impl *impl, const uint8_t *p) {
+  if (p[XSLOT_OFFSET_LEN] < 2)
+    return;
+
+  uint8_t op = p[XSLOT_OFFSET_DATA];
+  uint8_t mode = p[XSLOT_OFFSET_DATA + 1];
+  if (op == FRAMING_OP_REQUEST) {
+    uint8_t accept = framing_wanted(impl) && mode == XSLOT_FRAMING_COBS
+                         ? XSLOT_FRAMING_COBS
+                         : XSLOT_FRAMING_RAW;
+    /* 应答以原格式发出，之后的帧使用新格式 */
+    framing_send(impl, frame_addr(p, XSLOT_OFFSET_FROM), FRAMING_OP_ACCEPT,
+                 accept);
+    impl->cobs = accept == XSLOT_FRAMING_COBS;
+    impl->framing_pending = false;
+  } else if (op == FRAMING_OP_ACCEPT && impl->framing_pending) {
+    impl->framing_pending = false;
+    impl->cobs = mode == XSLOT_FRAMING_COBS;
+  }
+}
+
+/**
+ * @brief 探测时协商帧格式，对端不应答 (旧版本) 则保持 SYNC 定界
+ */
+static void framing_negotiate(direct_transport_impl *impl) {
+  impl->rx_len = 0;
+  framing_request(impl);
+
+  uint32_t start = hal_get_timestamp_ms();
+  while (impl->framing_pending &&
+         hal_get_timestamp_ms() - start < FRAMING_PROBE_MS) {
+    int ret = hal_serial_read(impl->serial, impl->rx_buffer + impl->rx_len,
+                              RX_BUFFER_SIZE - impl->rx_len, 20);
+    if (ret <= 0)
+      continue;
+    impl->rx_len += ret;
+    try_parse_frame(impl);
+    if (impl->rx_len >= RX_BUFFER_SIZE)
+      impl->rx_len = 0;
+  }
+  impl->rx_len = 0;
+}
+
+/**
+ * @brief COBS 帧连续无效，对端可能已重启为 SYNC 定界，回退并重新协商
+ *
+ * 对端仍为 COBS 时收不到本次请求，但请求本身在对端同样计为无效帧，
+ * 重发几次后对端也会回退。
+ */
+static void framing_fallback(direct_transport_impl *impl) {
+  impl->cobs = false;
+  impl->cobs_errors = 0;
+  if (framing_wanted(impl)) {
+    impl->framing_retries = FRAMING_MAX_RETRIES;
+    framing_request(impl);
+  }
+}
+
+/**
+ * @brief 回退后按间隔重发协商请求
+ */
+static void framing_service(direct_transport_impl *impl) {
+  if (impl->cobs || !impl->framing_pending || impl->framing_retries == 0)
+    return;
+  if (hal_get_timestamp_ms() - impl->framing_ms < FRAMING_RETRY_MS)
+    return;
+  impl->framing_retries--;
+  framing_request(impl);
+}
+
+/* ============================================================================
+ * 帧解析
+ * ============================================================================
+ */
+
+/**
+ * @brief 处理链路层帧 (令牌、帧格式协商)，不交给上层
+ * @return true=已处理
  */
-static void try_parse_frame(direct_transport_impl *impl) {
-  while (impl->rx_len >= XSLOT_FRAME_MIN_SIZE) {
-    /* 查找同步字节 */
-    uint16_t sync_pos = 0;
-    while (sync_pos < impl->rx_len &&
-           impl->rx_buffer[sync_pos] != XSLOT_SYNC_BYTE) {
-      sync_pos++;
+static bool link_frame(direct_transport_impl *impl, const uint8_t *p) {
+  uint8_t cmd = p[XSLOT_OFFSET_CMD];
+  if (cmd == XSLOT_CMD_FRAMING) {
+    framing_on_frame(impl, p);
+    return true;
+  }
+  if (impl->config.bus.role != XSLOT_BUS_POINT && cmd == XSLOT_CMD_BUS_TOKEN) {
+    bus_on_token(impl, p);
+    return true;
+  }
+  return false;
+}
+
+struct frame_batch {
+  transport_frame_view_t views[RX_BATCH_MAX];
+  uint16_t count;
+};
+
+/**
+ * @brief 收集有效帧，批满时先交付 (未设置批量回调时逐帧交付)
+ */
+static void deliver_frame(direct_transport_impl *impl, frame_batch *batch,
+                          const uint8_t *p, uint16_t size) {
+  if (impl->batch_cb) {
+    batch->views[batch->count].data = p;
+    batch->views[batch->count].len = size;
+    if (++batch->count == RX_BATCH_MAX) {
+      impl->batch_cb(impl->batch_ctx, batch->views, batch->count);
+      batch->count = 0;
     }
+  } else if (impl->recv_cb) {
+    impl->recv_cb(impl->recv_ctx, p, size);
+  }
+}
+
+/**
+ * @brief 交付已收集的帧 (帧指向 rx_buffer，须在移动缓冲区之前交付)
+ */
+static void flush_batch(direct_transport_impl *impl, frame_batch *batch) {
+  if (batch->count > 0) {
+    impl->batch_cb(impl->batch_ctx, batch->views, batch->count);
+    batch->count = 0;
+  }
+}
+
+static void consume_rx(direct_transport_impl *impl, uint16_t pos) {
+  if (pos > 0) {
+    std::memmove(impl->rx_buffer, impl->rx_buffer + pos, impl->rx_len - pos);
+    impl->rx_len -= pos;
+  }
+}
 
-    /* 移除同步字节之前的数据 */
-    if (sync_pos > 0) {
-      std::memmove(impl->rx_buffer, impl->rx_buffer + sync_pos,
-                   impl->rx_len - sync_pos);
-      impl->rx_len -= sync_pos;
+/**
+ * @brief 解析 SYNC 定界的帧
+ *
+ * 同步字节可能出现在载荷和 CRC 中，数据损坏后需在每个候选位置校验。
+ */
+static int parse_sync_frames(direct_transport_impl *impl, frame_batch *batch) {
+  int frames = 0;
+  uint16_t pos = 0;
+
+  while (impl->rx_len - pos >= XSLOT_FRAME_MIN_SIZE) {
+    const uint8_t *p = impl->rx_buffer + pos;
+    uint16_t avail = impl->rx_len - pos;
+
+    /* 查找同步字节，丢弃之前的数据 */
+    if (*p != XSLOT_SYNC_BYTE) {
+      const uint8_t *sync =
+          (const uint8_t *)std::memchr(p, XSLOT_SYNC_BYTE, avail);
+      pos = sync ? (uint16_t)(sync - impl->rx_buffer) : impl->rx_len;
+      continue;
     }
 
-    if (impl->rx_len < XSLOT_FRAME_MIN_SIZE) {
-      break;
+    /* 多点总线: 发往其他站的帧不做 CRC 校验 */
+    if (impl->config.bus.role != XSLOT_BUS_POINT && !bus_accepts(impl, p)) {
+      pos++;
+      continue;
     }
 
     /* 获取数据长度 */
-    uint8_t data_len = impl->rx_buffer[XSLOT_OFFSET_LEN];
+    uint8_t data_len = p[XSLOT_OFFSET_LEN];
     if (data_len > XSLOT_MAX_DATA_LEN) {
       /* 无效长度，跳过同步字节 */
-      std::memmove(impl->rx_buffer, impl->rx_buffer + 1, impl->rx_len - 1);
-      impl->rx_len--;
+      pos++;
       continue;
     }
 
     uint16_t frame_size = xslot_frame_total_size(data_len);
-    if (impl->rx_len < frame_size) {
+    if (avail < frame_size) {
       /* 数据不完整，等待更多数据 */
       break;
     }
 
     /* 验证 CRC */
-    if (xslot_frame_verify_crc(impl->rx_buffer, frame_size)) {
-      /* 帧有效，回调上层 */
-      if (impl->recv_cb) {
-        impl->recv_cb(impl->recv_ctx, impl->rx_buffer, frame_size);
+    if (!xslot_frame_verify_crc(p, frame_size)) {
+      /* CRC 错误，跳过同步字节 */
+      pos++;
+      continue;
+    }
+    pos += frame_size;
+
+    if (link_frame(impl, p)) {
+      /* 已切换为 COBS: 其后的数据属于旧格式，丢弃 */
+      if (impl->cobs) {
+        pos = impl->rx_len;
+        break;
       }
+      continue;
+    }
 
-      /* 移除已处理的帧 */
-      std::memmove(impl->rx_buffer, impl->rx_buffer + frame_size,
-                   impl->rx_len - frame_size);
-      impl->rx_len -= frame_size;
-    } else {
-      /* CRC 错误，跳过同步字节 */
-      std::memmove(impl->rx_buffer, impl->rx_buffer + 1, impl->rx_len - 1);
-      impl->rx_len--;
+    /* 帧有效，回调上层 */
+    deliver_frame(impl, batch, p, frame_size);
+    frames++;
+  }
+
+  flush_batch(impl, batch);
+  consume_rx(impl, pos);
+  return frames;
+}
+
+/**
+ * @brief 解析 COBS 编码的帧
+ *
+ * 载荷中不含 0x00，扫描到定界符即得到一个候选帧，原地解码后只校验一次。
+ */
+static int parse_cobs_frames(direct_transport_impl *impl, frame_batch *batch) {
+  int frames = 0;
+  uint16_t pos = 0;
+
+  while (impl->cobs && pos < impl->rx_len) {
+    uint8_t *p = impl->rx_buffer + pos;
+    const uint8_t *end = (const uint8_t *)std::memchr(
+        p, XSLOT_COBS_DELIMITER, impl->rx_len - pos);
+    if (!end)
+      break; /* 数据不完整，等待定界符 */
+
+    uint16_t segment = (uint16_t)(end - p);
+    pos += segment + 1;
+    if (segment == 0)
+      continue;
+
+    int len = xslot_cobs_decode(p, segment, p);
+    if (len < XSLOT_FRAME_MIN_SIZE || p[XSLOT_OFFSET_SYNC] != XSLOT_SYNC_BYTE ||
+        p[XSLOT_OFFSET_LEN] > XSLOT_MAX_DATA_LEN ||
+        len != xslot_frame_total_size(p[XSLOT_OFFSET_LEN]) ||
+        !xslot_frame_verify_crc(p, (uint16_t)len)) {
+      if (++impl->cobs_errors >= FRAMING_MAX_ERRORS)
+        framing_fallback(impl);
+      continue;
     }
+    impl->cobs_errors = 0;
+
+    if (link_frame(impl, p))
+      continue;
+
+    deliver_frame(impl, batch, p, (uint16_t)len);
+    frames++;
   }
+
+  flush_batch(impl, batch);
+  consume_rx(impl, pos);
+  return frames;
+}
+
+/**
+ * @brief 尝试从缓冲区解析帧
+ *
+ * 完整帧按顺序收集后整批交付；每种格式解析完先交付本批，再移走已处理的
+ * 数据，交付的帧始终指向有效数据。
+ * @return 分发的帧数
+ */
+static int try_parse_frame(direct_transport_impl *impl) {
+  frame_batch batch;
+  batch.count = 0;
+
+  int frames = 0;
+  if (impl->cobs)
+    frames += parse_cobs_frames(impl, &batch);
+  /* COBS 回退后剩余数据按 SYNC 定界解析 (上一轮的帧已交付) */
+  if (!impl->cobs)
+    frames += parse_sync_frames(impl, &batch);
+  return frames;
 }
 
 i_transport_t *direct_transport_create(const xslot_config_t *config) {
@@ -148,6 +613,11 @@ static int direct_start(void *impl_ptr) {
 
   impl->running = true;
   impl->rx_len = 0;
+  impl->tx_len = 0;
+  impl->token_out = false;
+  impl->token_held = false;
+  impl->token_next = 0;
+  impl->cycle_start_ms = hal_get_timestamp_ms();
 
   return XSLOT_OK;
 }
@@ -170,6 +640,29 @@ static int direct_send(void *impl_ptr, const uint8_t *data, uint16_t len) {
   if (!impl || !impl->serial || !data || len == 0)
     return XSLOT_ERR_PARAM;
 
+  uint8_t encoded[XSLOT_COBS_MAX_SIZE(XSLOT_FRAME_MAX_SIZE)];
+  if (impl->cobs) {
+    int ret = xslot_cobs_encode(data, len, encoded, sizeof(encoded));
+    if (ret < 0)
+      return ret;
+    data = encoded;
+    len = (uint16_t)ret;
+  }
+
+  /* 多点总线: 从站持有令牌时才发送，主站在令牌发出期间同样缓存 */
+  switch (impl->config.bus.role) {
+  case XSLOT_BUS_SLAVE:
+    return bus_enqueue(impl, data, len);
+  case XSLOT_BUS_MASTER:
+    if (impl->token_out)
+      return bus_enqueue(impl, data, len);
+    bus_turnaround(impl);
+    bus_flush(impl);
+    break;
+  default:
+    break;
+  }
+
   int ret = hal_serial_write(impl->serial, data, len);
   return (ret == len) ? XSLOT_OK : XSLOT_ERR_SEND_FAIL;
 }
@@ -206,6 +699,10 @@ static int direct_probe(void *impl_ptr) {
     }
   }
 
+  /* 对端是 X-Slot 设备，协商帧格式 */
+  if (found_sync && framing_wanted(impl))
+    framing_negotiate(impl);
+
   hal_serial_close(impl->serial);
   impl->serial = nullptr;
 
@@ -230,6 +727,84 @@ static void direct_set_recv_cb(void *impl_ptr, transport_receive_cb cb,
   }
 }
 
+static void direct_set_batch_cb(void *impl_ptr, transport_batch_cb cb,
+                                void *ctx) {
+  direct_transport_impl *impl = (direct_transport_impl *)impl_ptr;
+  if (impl) {
+    impl->batch_cb = cb;
+    impl->batch_ctx = ctx;
+  }
+}
+
+static int direct_poll(void *impl_ptr, uint32_t timeout_ms) {
+  direct_transport_impl *impl = (direct_transport_impl *)impl_ptr;
+  if (!impl || !impl->serial)
+    return XSLOT_ERR_NOT_INIT;
+
+  bool master = impl->config.bus.role == XSLOT_BUS_MASTER;
+  uint32_t start = hal_get_timestamp_ms();
+  bool received = false;
+  int frames = 0;
+  for (;;) {
+    /* 首次读取后只取走已到达的数据，不再等待 */
+    uint32_t wait = 0;
+    if (!received) {
+      uint32_t elapsed = hal_get_timestamp_ms() - start;
+      wait = elapsed < timeout_ms ? timeout_ms - elapsed : 0;
+    }
+
+    /* 主站: 等待期间按时发放令牌 */
+    if (master) {
+      bus_master_service(impl);
+      uint32_t due = bus_master_due(impl);
+      if (due < wait)
+        wait = due;
+    }
+
+    int ret = hal_serial_read(impl->serial, impl->rx_buffer + impl->rx_len,
+                              RX_BUFFER_SIZE - impl->rx_len, wait);
+    if (ret <= 0) {
+      if (master && !received && hal_get_timestamp_ms() - start < timeout_ms)
+        continue;
+      break;
+    }
+    impl->rx_ms = hal_get_timestamp_ms();
+    if (impl->token_out)
+      impl->token_ms = impl->rx_ms; /* 从站仍在发送 */
+
+    impl->rx_len += ret;
+    frames += try_parse_frame(impl);
+    received = true;
+
+    /* 缓冲区满仍无法成帧，丢弃旧数据 */
+    if (impl->rx_len >= RX_BUFFER_SIZE)
+      impl->rx_len = 0;
+  }
+
+  /* 从站: 本次处理中产生的应答随令牌一并发出 */
+  if (impl->token_held)
+    bus_release(impl);
+
+  framing_service(impl);
+
+  return frames;
+}
+
+static int direct_wait(void *impl_ptr, uint32_t timeout_ms) {
+  direct_transport_impl *impl = (direct_transport_impl *)impl_ptr;
+  if (!impl || !impl->serial)
+    return XSLOT_ERR_NOT_INIT;
+
+  /* 主站: 到发放令牌的时间即返回，由 poll 处理 */
+  if (impl->config.bus.role == XSLOT_BUS_MASTER) {
+    uint32_t due = bus_master_due(impl);
+    if (due < timeout_ms)
+      timeout_ms = due;
+  }
+
+  return hal_serial_wait(impl->serial, timeout_ms);
+}
+
 static void direct_destroy(void *impl_ptr) {
   direct_transport_impl *impl = (direct_transport_impl *)impl_ptr;
   if (!impl)
@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <xslot/xslot_types.h>
 
+#include "../core/xslot_protocol.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -19,6 +21,38 @@ extern "C" {
 typedef void (*transport_receive_cb)(void *ctx, const uint8_t *data,
                                      uint16_t len);
 
+/**
+ * @brief 帧视图 (指向传输层接收缓冲区，回调返回后失效)
+ */
+typedef struct {
+  const uint8_t *data;
+  uint16_t len;
+} transport_frame_view_t;
+
+/**
+ * @brief 批量接收回调函数类型
+ *
+ * 一次读取得到多帧时 (直连高波特率、套接字) 整批交付，帧已通过 CRC 校验。
+ */
+typedef void (*transport_batch_cb)(void *ctx,
+                                   const transport_frame_view_t *frames,
+                                   uint16_t count);
+
+/**
+ * @brief 已解码帧回调函数类型
+ *
+ * 传输层收到的不是原始字节 (如模组以十六进制上报) 时直接解码为帧交付，
+ * 帧在回调返回后失效。
+ */
+typedef void (*transport_frame_cb)(void *ctx, const xslot_frame_t *frame);
+
+/**
+ * @brief 路由变化回调函数类型
+ * @param addr 路由目标地址
+ * @param created true=路由建立，false=路由删除
+ */
+typedef void (*transport_route_cb)(void *ctx, uint16_t addr, bool created);
+
 /**
  * @brief 传输层接口 (虚表)
  */
@@ -30,6 +64,18 @@ typedef struct i_transport_vtable {
   int (*configure)(void *impl, uint8_t cell_id, int8_t power_dbm);
   void (*set_receive_cb)(void *impl, transport_receive_cb cb, void *ctx);
   void (*destroy)(void *impl);
+  /* 可选: 端到端确认发送 (为 NULL 时退化为 send) */
+  int (*send_confirmed)(void *impl, const uint8_t *data, uint16_t len);
+  /* 可选: 读取串口并分发接收到的帧，返回分发的帧数 */
+  int (*poll)(void *impl, uint32_t timeout_ms);
+  /* 可选: 路由变化通知 (Mesh 传输层) */
+  void (*set_route_cb)(void *impl, transport_route_cb cb, void *ctx);
+  /* 可选: 已解码帧交付 (设置后优先于接收回调) */
+  void (*set_frame_cb)(void *impl, transport_frame_cb cb, void *ctx);
+  /* 可选: 批量接收 (设置后优先于接收回调) */
+  void (*set_batch_cb)(void *impl, transport_batch_cb cb, void *ctx);
+  /* 可选: 等待数据到达但不读取 (1=可读，0=超时)，供 I/O 线程不持锁等待 */
+  int (*wait)(void *impl, uint32_t timeout_ms);
 } i_transport_vtable_t;
 
 /**
@@ -59,6 +105,21 @@ static inline int transport_send(i_transport_t *t, const uint8_t *data,
   return t && t->vtable->send ? t->vtable->send(t->impl, data, len) : -1;
 }
 
+static inline int transport_send_confirmed(i_transport_t *t,
+                                           const uint8_t *data, uint16_t len) {
+  if (t && t->vtable->send_confirmed)
+    return t->vtable->send_confirmed(t->impl, data, len);
+  return transport_send(t, data, len);
+}
+
+static inline int transport_poll(i_transport_t *t, uint32_t timeout_ms) {
+  return t && t->vtable->poll ? t->vtable->poll(t->impl, timeout_ms) : 0;
+}
+
+static inline int transport_wait(i_transport_t *t, uint32_t timeout_ms) {
+  return t && t->vtable->wait ? t->vtable->wait(t->impl, timeout_ms) : -1;
+}
+
 static inline int transport_probe(i_transport_t *t) {
   return t && t->vtable->probe ? t->vtable->probe(t->impl) : -1;
 }
@@ -77,6 +138,27 @@ static inline void transport_set_receive_callback(i_transport_t *t,
     t->vtable->set_receive_cb(t->impl, cb, ctx);
 }
 
+static inline void transport_set_route_callback(i_transport_t *t,
+                                                transport_route_cb cb,
+                                                void *ctx) {
+  if (t && t->vtable->set_route_cb)
+    t->vtable->set_route_cb(t->impl, cb, ctx);
+}
+
+static inline void transport_set_frame_callback(i_transport_t *t,
+                                                transport_frame_cb cb,
+                                                void *ctx) {
+  if (t && t->vtable->set_frame_cb)
+    t->vtable->set_frame_cb(t->impl, cb, ctx);
+}
+
+static inline void transport_set_batch_callback(i_transport_t *t,
+                                                transport_batch_cb cb,
+                                                void *ctx) {
+  if (t && t->vtable->set_batch_cb)
+    t->vtable->set_batch_cb(t->impl, cb, ctx);
+}
+
 static inline void transport_destroy(i_transport_t *t) {
   if (t && t->vtable->destroy)
     t->vtable->destroy(t->impl);
@@ -102,6 +184,16 @@ i_transport_t *direct_transport_create(const xslot_config_t *config);
  */
 i_transport_t *null_transport_create(void);
 
+/**
+ * @brief 端点是否为套接字地址 (udp:// tcp:// unix://)
+ */
+bool socket_transport_match(const char *endpoint);
+
+/**
+ * @brief 创建套接字传输层 (端点取自 uart_port)
+ */
+i_transport_t *socket_transport_create(const xslot_config_t *config);
+
 #ifdef __cplusplus
 }
 #endif
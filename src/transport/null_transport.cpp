@@ -58,6 +58,12 @@ static const i_transport_vtable_t null_vtable = {
     .configure = null_configure,
     .set_receive_cb = null_set_recv_cb,
     .destroy = null_destroy,
+    .send_confirmed = nullptr,
+    .poll = nullptr,
+    .set_route_cb = nullptr,
+    .set_frame_cb = nullptr,
+    .set_batch_cb = nullptr,
+    .wait = nullptr,
 };
 
 i_transport_t *null_transport_create(void) {
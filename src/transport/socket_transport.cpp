@@ -0,0 +1,789 @@
+/**
+ * @file socket_transport.cpp
+ * @brief 套接字传输层实现
+ */
+#include "socket_transport.h"
+#include "../core/xslot_protocol.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <xslot/xslot_error.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#define SOCKET_SUPPORTED
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/* HAL 函数声明 */
+extern "C" {
+uint32_t hal_get_timestamp_ms(void);
+}
+
+#define SOCKET_MAX_PEERS 16      /**< 对端 (连接或 UDP 来源) 数 */
+#define SOCKET_MAX_ROUTES 128    /**< 地址学习表大小 */
+#define SOCKET_RECONNECT_MS 2000 /**< 连接端重连间隔 */
+#define SOCKET_BATCH_MAX 16      /**< 单次批量交付的最大帧数 */
+#define SOCKET_SEND_TIMEOUT_MS 100
+#define SOCKET_LEN_SIZE 2
+#define SOCKET_RX_SIZE                                                         \
+  (SOCKET_BATCH_MAX * (SOCKET_LEN_SIZE + XSLOT_FRAME_MAX_SIZE))
+
+bool socket_transport_match(const char *endpoint) {
+  return endpoint && (std::strncmp(endpoint, "udp://", 6) == 0 ||
+                      std::strncmp(endpoint, "tcp://", 6) == 0 ||
+                      std::strncmp(endpoint, "unix://", 7) == 0);
+}
+
+#ifdef SOCKET_SUPPORTED
+
+enum socket_kind { SOCKET_UDP, SOCKET_TCP, SOCKET_UNIX };
+
+struct socket_peer {
+  bool used;
+  int fd;                       /* 流套接字连接 (UDP 为 -1) */
+  struct sockaddr_storage addr; /* UDP 对端地址 */
+  socklen_t addr_len;
+
+  /* 流接收缓冲区 */
+  uint8_t rx[SOCKET_RX_SIZE];
+  uint16_t rx_len;
+};
+
+struct socket_route {
+  uint16_t addr;
+  uint8_t peer;
+};
+
+struct socket_transport_impl {
+  i_transport_t base;
+  xslot_config_t config;
+  bool running;
+
+  socket_kind kind;
+  bool listening; /* 流套接字: 监听端 */
+  char host[64];  /* 对端主机 / Unix 路径 */
+  char port[8];   /* 对端端口 */
+  char local[64]; /* 本地端口 / 监听主机:端口 / 监听路径 */
+
+  int fd; /* UDP 套接字或监听套接字 */
+  uint32_t connect_ms;
+
+  socket_peer peers[SOCKET_MAX_PEERS];
+  socket_route routes[SOCKET_MAX_ROUTES];
+  uint8_t route_count;
+
+  /* 接收回调 */
+  transport_receive_cb recv_cb;
+  void *recv_ctx;
+
+  /* 批量接收回调 */
+  transport_batch_cb batch_cb;
+  void *batch_ctx;
+};
+
+/* 待交付的一批帧 */
+struct socket_batch {
+  transport_frame_view_t frames[SOCKET_BATCH_MAX];
+  uint16_t count;
+};
+
+/* 前向声明 */
+static int socket_start(void *impl);
+static void socket_stop(void *impl);
+static int socket_send(void *impl, const uint8_t *data, uint16_t len);
+static int socket_probe(void *impl);
+static int socket_configure(void *impl, uint8_t cell_id, int8_t power_dbm);
+static void socket_set_recv_cb(void *impl, transport_receive_cb cb, void *ctx);
+static void socket_destroy(void *impl);
+static int socket_poll(void *impl, uint32_t timeout_ms);
+static void socket_set_batch_cb(void *impl, transport_batch_cb cb, void *ctx);
+static int socket_wait(void *impl, uint32_t timeout_ms);
+
+static const i_transport_vtable_t socket_vtable = {
+    .start = socket_start,
+    .stop = socket_stop,
+    .send = socket_send,
+    .probe = socket_probe,
+    .configure = socket_configure,
+    .set_receive_cb = socket_set_recv_cb,
+    .destroy = socket_destroy,
+    .send_confirmed = nullptr, /* 由下层协议 (TCP) 或上层重发保证 */
+    .poll = socket_poll,
+    .set_route_cb = nullptr,
+    .set_frame_cb = nullptr,
+    .set_batch_cb = socket_set_batch_cb,
+    .wait = socket_wait,
+};
+
+/* ============================================================================
+ * 端点
+ * ============================================================================
+ */
+
+/**
+ * @brief 拆分 "主机:端口" (主机可为空)
+ */
+static bool split_host_port(const char *s, char *host, size_t host_size,
+                            char *port, size_t port_size) {
+  const char *colon = std::strrchr(s, ':');
+  if (!colon) {
+    /* 只有端口 */
+    host[0] = '\0';
+    return std::snprintf(port, port_size, "%s", s) < (int)port_size &&
+           port[0] != '\0';
+  }
+  size_t len = colon - s;
+  if (len >= host_size || std::strlen(colon + 1) >= port_size ||
+      colon[1] == '\0')
+    return false;
+  std::memcpy(host, s, len);
+  host[len] = '\0';
+  std::strcpy(port, colon + 1);
+  return true;
+}
+
+/**
+ * @brief 解析端点 (见 socket_transport.h)
+ */
+static bool parse_endpoint(socket_transport_impl *impl, const char *ep) {
+  const char *rest = std::strstr(ep, "://") + 3;
+
+  if (std::strncmp(ep, "udp", 3) == 0) {
+    impl->kind = SOCKET_UDP;
+    const char *at = std::strchr(rest, '@');
+    if (at) {
+      if (std::snprintf(impl->local, sizeof(impl->local), "%s", at + 1) >=
+              (int)sizeof(impl->local) ||
+          impl->local[0] == '\0')
+        return false;
+    }
+    if (at == rest)
+      return true; /* 只绑定本地端口 */
+
+    char remote[64];
+    size_t len = at ? (size_t)(at - rest) : std::strlen(rest);
+    if (len >= sizeof(remote))
+      return false;
+    std::memcpy(remote, rest, len);
+    remote[len] = '\0';
+    return split_host_port(remote, impl->host, sizeof(impl->host), impl->port,
+                           sizeof(impl->port)) &&
+           impl->host[0] != '\0';
+  }
+
+  impl->kind = std::strncmp(ep, "tcp", 3) == 0 ? SOCKET_TCP : SOCKET_UNIX;
+  impl->listening = rest[0] == '@';
+  if (impl->listening)
+    rest++;
+  if (rest[0] == '\0')
+    return false;
+
+  if (impl->kind == SOCKET_UNIX || impl->listening)
+    return std::snprintf(impl->listening ? impl->local : impl->host,
+                         sizeof(impl->local), "%s",
+                         rest) < (int)sizeof(impl->local);
+
+  return split_host_port(rest, impl->host, sizeof(impl->host), impl->port,
+                         sizeof(impl->port)) &&
+         impl->host[0] != '\0';
+}
+
+/**
+ * @brief 解析 TCP/UDP 地址
+ * @param host 主机 (空串表示任意地址，用于绑定)
+ */
+static bool resolve(const char *host, const char *port, int socktype,
+                    struct sockaddr_storage *addr, socklen_t *addr_len) {
+  struct addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = socktype;
+  hints.ai_flags = host[0] ? 0 : AI_PASSIVE;
+
+  struct addrinfo *res;
+  if (getaddrinfo(host[0] ? host : nullptr, port, &hints, &res) != 0)
+    return false;
+  std::memcpy(addr, res->ai_addr, res->ai_addrlen);
+  *addr_len = res->ai_addrlen;
+  freeaddrinfo(res);
+  return true;
+}
+
+static void unix_addr(const char *path, struct sockaddr_storage *addr,
+                      socklen_t *addr_len) {
+  struct sockaddr_un *un = (struct sockaddr_un *)addr;
+  std::memset(un, 0, sizeof(*un));
+  un->sun_family = AF_UNIX;
+  std::snprintf(un->sun_path, sizeof(un->sun_path), "%s", path);
+  *addr_len = sizeof(*un);
+}
+
+static int open_socket(int family, int socktype) {
+  int fd = socket(family, socktype, 0);
+  if (fd < 0)
+    return -1;
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  return fd;
+}
+
+/* ============================================================================
+ * 对端与地址学习
+ * ============================================================================
+ */
+
+static socket_peer *peer_alloc(socket_transport_impl *impl) {
+  for (int i = 0; i < SOCKET_MAX_PEERS; i++) {
+    if (!impl->peers[i].used) {
+      socket_peer *p = &impl->peers[i];
+      std::memset(p, 0, sizeof(*p));
+      p->used = true;
+      p->fd = -1;
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+static void peer_close(socket_transport_impl *impl, socket_peer *peer) {
+  uint8_t index = (uint8_t)(peer - impl->peers);
+
+  /* 删除指向该对端的学习条目 */
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < impl->route_count; i++) {
+    if (impl->routes[i].peer != index)
+      impl->routes[n++] = impl->routes[i];
+  }
+  impl->route_count = n;
+
+  if (peer->fd >= 0)
+    close(peer->fd);
+  peer->fd = -1;
+  peer->used = false;
+}
+
+/**
+ * @brief 记录来源地址所在的对端
+ */
+static void route_learn(socket_transport_impl *impl, uint16_t addr,
+                        const socket_peer *peer) {
+  uint8_t index = (uint8_t)(peer - impl->peers);
+  if (addr == XSLOT_ADDR_BROADCAST)
+    return;
+
+  for (uint8_t i = 0; i < impl->route_count; i++) {
+    if (impl->routes[i].addr == addr) {
+      impl->routes[i].peer = index;
+      return;
+    }
+  }
+  if (impl->route_count < SOCKET_MAX_ROUTES) {
+    impl->routes[impl->route_count].addr = addr;
+    impl->routes[impl->route_count].peer = index;
+    impl->route_count++;
+  }
+}
+
+static socket_peer *route_lookup(socket_transport_impl *impl, uint16_t addr) {
+  for (uint8_t i = 0; i < impl->route_count; i++) {
+    if (impl->routes[i].addr == addr)
+      return &impl->peers[impl->routes[i].peer];
+  }
+  return nullptr;
+}
+
+static uint16_t frame_addr(const uint8_t *frame, uint8_t offset) {
+  uint16_t addr;
+  std::memcpy(&addr, frame + offset, sizeof(addr));
+  return addr;
+}
+
+static void flush(socket_transport_impl *impl, socket_batch *batch) {
+  if (batch->count > 0 && impl->batch_cb)
+    impl->batch_cb(impl->batch_ctx, batch->frames, batch->count);
+  batch->count = 0;
+}
+
+/**
+ * @brief 校验并分发一帧
+ *
+ * 设置了批量回调时先加入 batch，由调用者在缓冲区失效前 flush。
+ * @return 1=已分发，0=无效帧
+ */
+static int deliver(socket_transport_impl *impl, socket_peer *peer,
+                   socket_batch *batch, const uint8_t *frame, uint16_t len) {
+  if (len < XSLOT_FRAME_MIN_SIZE || len > XSLOT_FRAME_MAX_SIZE ||
+      frame[XSLOT_OFFSET_SYNC] != XSLOT_SYNC_BYTE ||
+      xslot_frame_total_size(frame[XSLOT_OFFSET_LEN]) != len ||
+      !xslot_frame_verify_crc(frame, len))
+    return 0;
+
+  if (peer)
+    route_learn(impl, frame_addr(frame, XSLOT_OFFSET_FROM), peer);
+  if (impl->batch_cb) {
+    batch->frames[batch->count].data = frame;
+    batch->frames[batch->count].len = len;
+    if (++batch->count == SOCKET_BATCH_MAX)
+      flush(impl, batch);
+  } else if (impl->recv_cb) {
+    impl->recv_cb(impl->recv_ctx, frame, len);
+  }
+  return 1;
+}
+
+/* ============================================================================
+ * 连接
+ * ============================================================================
+ */
+
+static void stream_setup(socket_transport_impl *impl, int fd) {
+  if (impl->kind == SOCKET_TCP) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  /* 发送阻塞但限时，避免半帧写入 */
+  struct timeval tv = {0, SOCKET_SEND_TIMEOUT_MS * 1000};
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+}
+
+/**
+ * @brief 连接端: 按间隔尝试连接对端
+ */
+static void stream_connect(socket_transport_impl *impl) {
+  if (impl->peers[0].used)
+    return;
+
+  uint32_t now = hal_get_timestamp_ms();
+  if (impl->connect_ms && now - impl->connect_ms < SOCKET_RECONNECT_MS)
+    return;
+  impl->connect_ms = now | 1;
+
+  struct sockaddr_storage addr;
+  socklen_t addr_len;
+  if (impl->kind == SOCKET_UNIX) {
+    unix_addr(impl->host, &addr, &addr_len);
+  } else if (!resolve(impl->host, impl->port, SOCK_STREAM, &addr,
+                      &addr_len)) {
+    return;
+  }
+
+  int fd = socket(addr.ss_family, SOCK_STREAM, 0);
+  if (fd < 0)
+    return;
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+  /* 本机/局域网连接很快完成，阻塞连接即可 */
+  if (connect(fd, (struct sockaddr *)&addr, addr_len) != 0) {
+    close(fd);
+    return;
+  }
+  stream_setup(impl, fd);
+
+  socket_peer *peer = peer_alloc(impl);
+  peer->fd = fd;
+}
+
+static void stream_accept(socket_transport_impl *impl) {
+  for (;;) {
+    int fd = accept(impl->fd, nullptr, nullptr);
+    if (fd < 0)
+      return;
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    socket_peer *peer = peer_alloc(impl);
+    if (!peer) {
+      close(fd);
+      continue;
+    }
+    stream_setup(impl, fd);
+    peer->fd = fd;
+  }
+}
+
+/**
+ * @brief 读取流数据并分发完整帧
+ * @return 分发的帧数，连接断开返回 -1
+ */
+static int stream_read(socket_transport_impl *impl, socket_peer *peer) {
+  ssize_t n = recv(peer->fd, peer->rx + peer->rx_len,
+                   SOCKET_RX_SIZE - peer->rx_len, MSG_DONTWAIT);
+  if (n == 0)
+    return -1;
+  if (n < 0)
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0
+                                                                       : -1;
+  peer->rx_len += n;
+
+  socket_batch batch;
+  batch.count = 0;
+  int frames = 0;
+  uint16_t pos = 0;
+  while (peer->rx_len - pos >= SOCKET_LEN_SIZE) {
+    uint16_t len = peer->rx[pos] | (peer->rx[pos + 1] << 8);
+    if (len > XSLOT_FRAME_MAX_SIZE) {
+      flush(impl, &batch);
+      return -1; /* 失步，断开重连 */
+    }
+    if (peer->rx_len - pos < SOCKET_LEN_SIZE + len)
+      break;
+    frames +=
+        deliver(impl, peer, &batch, peer->rx + pos + SOCKET_LEN_SIZE, len);
+    pos += SOCKET_LEN_SIZE + len;
+  }
+  flush(impl, &batch);
+
+  std::memmove(peer->rx, peer->rx + pos, peer->rx_len - pos);
+  peer->rx_len -= pos;
+  return frames;
+}
+
+/**
+ * @brief 读取所有已到达的 UDP 数据报
+ *
+ * 每批最多 SOCKET_BATCH_MAX 个数据报读入各自的缓冲区后一起交付。
+ */
+static int udp_read(socket_transport_impl *impl) {
+  int frames = 0;
+  uint8_t buffers[SOCKET_BATCH_MAX][XSLOT_FRAME_MAX_SIZE];
+  socket_batch batch;
+  batch.count = 0;
+
+  for (;;) {
+    /* 无效帧不入批，其缓冲区留给下一个数据报 */
+    uint8_t *buffer = buffers[batch.count];
+    struct sockaddr_storage from;
+    socklen_t from_len = sizeof(from);
+    ssize_t n = recvfrom(impl->fd, buffer, XSLOT_FRAME_MAX_SIZE, MSG_DONTWAIT,
+                         (struct sockaddr *)&from, &from_len);
+    if (n < 0)
+      break;
+
+    socket_peer *peer = nullptr;
+    for (int i = 0; i < SOCKET_MAX_PEERS; i++) {
+      socket_peer *p = &impl->peers[i];
+      if (p->used && p->addr_len == from_len &&
+          std::memcmp(&p->addr, &from, from_len) == 0) {
+        peer = p;
+        break;
+      }
+    }
+    if (!peer) {
+      peer = peer_alloc(impl);
+      if (peer) {
+        peer->addr = from;
+        peer->addr_len = from_len;
+      }
+    }
+
+    frames += deliver(impl, peer, &batch, buffer, (uint16_t)n);
+  }
+  flush(impl, &batch);
+  return frames;
+}
+
+/* ============================================================================
+ * 传输层接口
+ * ============================================================================
+ */
+
+i_transport_t *socket_transport_create(const xslot_config_t *config) {
+  if (!config || !socket_transport_match(config->uart_port))
+    return nullptr;
+
+  socket_transport_impl *impl =
+      (socket_transport_impl *)std::calloc(1, sizeof(socket_transport_impl));
+  if (!impl)
+    return nullptr;
+
+  std::memcpy(&impl->config, config, sizeof(xslot_config_t));
+  impl->fd = -1;
+  if (!parse_endpoint(impl, config->uart_port)) {
+    std::free(impl);
+    return nullptr;
+  }
+
+  /* 设置虚表 */
+  impl->base.vtable = &socket_vtable;
+  impl->base.impl = impl;
+
+  return &impl->base;
+}
+
+static int socket_start(void *impl_ptr) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (!impl)
+    return XSLOT_ERR_PARAM;
+  if (impl->running)
+    return XSLOT_OK;
+
+  struct sockaddr_storage addr;
+  socklen_t addr_len = 0;
+  std::memset(&addr, 0, sizeof(addr));
+
+  if (impl->kind == SOCKET_UDP) {
+    struct sockaddr_storage remote;
+    socklen_t remote_len = 0;
+    if (impl->host[0] &&
+        !resolve(impl->host, impl->port, SOCK_DGRAM, &remote, &remote_len))
+      return XSLOT_ERR_NO_DEVICE;
+
+    int family = remote_len ? remote.ss_family : AF_INET;
+    if (impl->local[0]) {
+      if (!resolve("", impl->local, SOCK_DGRAM, &addr, &addr_len))
+        return XSLOT_ERR_NO_DEVICE;
+      if (!remote_len)
+        family = addr.ss_family;
+    }
+
+    impl->fd = open_socket(family, SOCK_DGRAM);
+    if (impl->fd < 0)
+      return XSLOT_ERR_NO_DEVICE;
+    if (addr_len > 0 &&
+        bind(impl->fd, (struct sockaddr *)&addr, addr_len) != 0) {
+      close(impl->fd);
+      impl->fd = -1;
+      return XSLOT_ERR_NO_DEVICE;
+    }
+
+    /* 默认对端 */
+    if (remote_len) {
+      socket_peer *peer = peer_alloc(impl);
+      peer->addr = remote;
+      peer->addr_len = remote_len;
+    }
+  } else if (impl->listening) {
+    if (impl->kind == SOCKET_UNIX) {
+      unix_addr(impl->local, &addr, &addr_len);
+      unlink(impl->local);
+    } else {
+      char host[64];
+      char port[8];
+      if (!split_host_port(impl->local, host, sizeof(host), port,
+                           sizeof(port)) ||
+          !resolve(host, port, SOCK_STREAM, &addr, &addr_len))
+        return XSLOT_ERR_NO_DEVICE;
+    }
+
+    impl->fd = open_socket(addr.ss_family, SOCK_STREAM);
+    if (impl->fd < 0)
+      return XSLOT_ERR_NO_DEVICE;
+    int one = 1;
+    setsockopt(impl->fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(impl->fd, (struct sockaddr *)&addr, addr_len) != 0 ||
+        listen(impl->fd, SOCKET_MAX_PEERS) != 0) {
+      close(impl->fd);
+      impl->fd = -1;
+      return XSLOT_ERR_NO_DEVICE;
+    }
+  } else {
+    /* 对端暂未启动时在 poll 中重连 */
+    impl->connect_ms = 0;
+    stream_connect(impl);
+  }
+
+  impl->running = true;
+  return XSLOT_OK;
+}
+
+static void socket_stop(void *impl_ptr) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (!impl || !impl->running)
+    return;
+
+  impl->running = false;
+
+  for (int i = 0; i < SOCKET_MAX_PEERS; i++) {
+    if (impl->peers[i].used)
+      peer_close(impl, &impl->peers[i]);
+  }
+  if (impl->fd >= 0) {
+    close(impl->fd);
+    impl->fd = -1;
+  }
+  if (impl->listening && impl->kind == SOCKET_UNIX)
+    unlink(impl->local);
+}
+
+/**
+ * @brief 发送到一个对端
+ */
+static bool peer_send(socket_transport_impl *impl, socket_peer *peer,
+                      const uint8_t *data, uint16_t len) {
+  if (impl->kind == SOCKET_UDP) {
+    return sendto(impl->fd, data, len, MSG_NOSIGNAL,
+                  (struct sockaddr *)&peer->addr, peer->addr_len) == len;
+  }
+
+  uint8_t buffer[SOCKET_LEN_SIZE + XSLOT_FRAME_MAX_SIZE];
+  buffer[0] = len & 0xFF;
+  buffer[1] = (len >> 8) & 0xFF;
+  std::memcpy(buffer + SOCKET_LEN_SIZE, data, len);
+
+  ssize_t n = send(peer->fd, buffer, SOCKET_LEN_SIZE + len, MSG_NOSIGNAL);
+  if (n == SOCKET_LEN_SIZE + len)
+    return true;
+
+  /* 超时或部分写入: 流已失步，断开 (连接端会重连) */
+  peer_close(impl, peer);
+  return false;
+}
+
+static int socket_send(void *impl_ptr, const uint8_t *data, uint16_t len) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (!impl || !data || len < XSLOT_FRAME_MIN_SIZE ||
+      len > XSLOT_FRAME_MAX_SIZE)
+    return XSLOT_ERR_PARAM;
+  if (!impl->running)
+    return XSLOT_ERR_NOT_INIT;
+
+  uint16_t to = frame_addr(data, XSLOT_OFFSET_TO);
+  socket_peer *target =
+      to == XSLOT_ADDR_BROADCAST ? nullptr : route_lookup(impl, to);
+  if (target)
+    return peer_send(impl, target, data, len) ? XSLOT_OK : XSLOT_ERR_SEND_FAIL;
+
+  /* 广播或未知地址: 发给所有对端 */
+  bool sent = false;
+  for (int i = 0; i < SOCKET_MAX_PEERS; i++) {
+    if (impl->peers[i].used && peer_send(impl, &impl->peers[i], data, len))
+      sent = true;
+  }
+  return sent ? XSLOT_OK : XSLOT_ERR_SEND_FAIL;
+}
+
+static int socket_probe(void *impl_ptr) {
+  /* 端点已在创建时校验，无设备可探测 */
+  return impl_ptr ? XSLOT_OK : XSLOT_ERR_PARAM;
+}
+
+static int socket_configure(void *impl_ptr, uint8_t cell_id,
+                            int8_t power_dbm) {
+  (void)impl_ptr;
+  (void)cell_id;
+  (void)power_dbm;
+  /* 套接字无无线配置 */
+  return XSLOT_OK;
+}
+
+static void socket_set_recv_cb(void *impl_ptr, transport_receive_cb cb,
+                               void *ctx) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (impl) {
+    impl->recv_cb = cb;
+    impl->recv_ctx = ctx;
+  }
+}
+
+static void socket_set_batch_cb(void *impl_ptr, transport_batch_cb cb,
+                                void *ctx) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (impl) {
+    impl->batch_cb = cb;
+    impl->batch_ctx = ctx;
+  }
+}
+
+/**
+ * @brief 收集待监听的套接字
+ * @param owners 对应的对端 (UDP/监听套接字为 NULL)
+ * @return 套接字数
+ */
+static int collect_fds(socket_transport_impl *impl, struct pollfd *pfds,
+                       socket_peer **owners) {
+  int n = 0;
+  if (impl->fd >= 0) {
+    pfds[n].fd = impl->fd;
+    pfds[n].events = POLLIN;
+    owners[n++] = nullptr;
+  }
+  for (int i = 0; i < SOCKET_MAX_PEERS; i++) {
+    if (impl->peers[i].used && impl->peers[i].fd >= 0) {
+      pfds[n].fd = impl->peers[i].fd;
+      pfds[n].events = POLLIN;
+      owners[n++] = &impl->peers[i];
+    }
+  }
+  return n;
+}
+
+static int socket_wait(void *impl_ptr, uint32_t timeout_ms) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (!impl || !impl->running)
+    return XSLOT_ERR_NOT_INIT;
+
+  /* 无套接字 (等待重连) 时 poll 仅延时 */
+  struct pollfd pfds[1 + SOCKET_MAX_PEERS];
+  socket_peer *owners[1 + SOCKET_MAX_PEERS];
+  int n = collect_fds(impl, pfds, owners);
+  int ret = poll(pfds, n, (int)timeout_ms);
+  if (ret < 0)
+    return errno == EINTR ? 0 : -1;
+  return ret > 0 ? 1 : 0;
+}
+
+static int socket_poll(void *impl_ptr, uint32_t timeout_ms) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (!impl || !impl->running)
+    return XSLOT_ERR_NOT_INIT;
+
+  if (impl->kind != SOCKET_UDP && !impl->listening)
+    stream_connect(impl);
+
+  struct pollfd pfds[1 + SOCKET_MAX_PEERS];
+  socket_peer *owners[1 + SOCKET_MAX_PEERS];
+  int n = collect_fds(impl, pfds, owners);
+  if (n == 0)
+    return 0;
+
+  if (poll(pfds, n, (int)timeout_ms) <= 0)
+    return 0;
+
+  int frames = 0;
+  for (int i = 0; i < n; i++) {
+    if (!pfds[i].revents)
+      continue;
+    if (!owners[i]) {
+      if (impl->kind == SOCKET_UDP)
+        frames += udp_read(impl);
+      else
+        stream_accept(impl);
+      continue;
+    }
+    int ret = stream_read(impl, owners[i]);
+    if (ret < 0)
+      peer_close(impl, owners[i]);
+    else
+      frames += ret;
+  }
+  return frames;
+}
+
+static void socket_destroy(void *impl_ptr) {
+  socket_transport_impl *impl = (socket_transport_impl *)impl_ptr;
+  if (!impl)
+    return;
+
+  socket_stop(impl);
+  std::free(impl);
+}
+
+#else /* !SOCKET_SUPPORTED */
+
+i_transport_t *socket_transport_create(const xslot_config_t *config) {
+  (void)config;
+  return nullptr;
+}
+
+#endif /* SOCKET_SUPPORTED */
@@ -0,0 +1,42 @@
+/**
+ * @file socket_transport.h
+ * @brief 套接字传输层 (UDP/TCP/Unix 域)
+ *
+ * 网关间回传、以太网 HMI 和本机回环测试使用。端点写在
+ * xslot_config_t.uart_port 中 ("@" 表示本机一侧):
+ *
+ * - udp://主机:端口[@本地端口]  UDP，默认对端为 主机:端口
+ * - udp://@本地端口             UDP，只绑定本地端口
+ * - tcp://主机:端口 / tcp://@[主机:]端口  TCP 连接 / 监听
+ * - unix://路径 / unix://@路径  Unix 域套接字连接 / 监听
+ *
+ * UDP 每个数据报一帧；流套接字每帧前加 [LEN:2 小端]。收到的帧按来源地址
+ * 学习对端，发往已学习地址的帧只发给该对端，广播和未知地址发给所有对端。
+ * 连接端断开后自动重连。
+ */
+#ifndef SOCKET_TRANSPORT_H
+#define SOCKET_TRANSPORT_H
+
+#include "i_transport.h"
+#include <xslot/xslot_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 端点是否为套接字地址 (udp:// tcp:// unix://)
+ */
+bool socket_transport_match(const char *endpoint);
+
+/**
+ * @brief 创建套接字传输层
+ * @return 端点格式错误或平台不支持时返回 NULL
+ */
+i_transport_t *socket_transport_create(const xslot_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOCKET_TRANSPORT_H */
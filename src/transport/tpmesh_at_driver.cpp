@@ -3,9 +3,12 @@
  * @brief TPMesh AT 驱动层实现
  */
 #include "tpmesh_at_driver.h"
+#include "at_lexer.h"
+#include <charconv>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string_view>
 #include <xslot/xslot_error.h>
 
 /* HAL 函数声明 */
@@ -15,12 +18,13 @@ void hal_serial_close(void *handle);
 int hal_serial_write(void *handle, const uint8_t *data, uint16_t len);
 int hal_serial_read(void *handle, uint8_t *data, uint16_t max_len,
                     uint32_t timeout_ms);
+int hal_serial_wait(void *handle, uint32_t timeout_ms);
 uint32_t hal_get_timestamp_ms(void);
 void hal_sleep_ms(uint32_t ms);
 }
 
-#define AT_BUFFER_SIZE 512
 #define AT_DEFAULT_TIMEOUT 1000
+#define AT_READ_SLICE_MS 10
 
 struct tpmesh_at_driver {
   void *serial;
@@ -32,70 +36,138 @@ struct tpmesh_at_driver {
   tpmesh_urc_cb urc_cb;
   void *urc_ctx;
 
-  /* 接收缓冲区 */
-  char rx_buffer[AT_BUFFER_SIZE];
-  uint16_t rx_len;
+  /* 接收行切分 */
+  at_lexer_t lexer;
+
+  /* 命令等待期间到达的 URC，下次 poll 时分发 */
+  at_lexer_t deferred;
+
+  /* 命令阶段读到的 +SEND:<SN>,HANDLE OK/ERROR */
+  int send_sn;
+  bool send_rejected;
 };
 
+/* ============================================================================
+ * URC 解析
+ * ============================================================================
+ */
+
+/**
+ * @brief 逗号分隔字段读取 (一次遍历，不复制)
+ */
+struct field_reader {
+  const char *p;
+  const char *end;
+};
+
+static bool read_hex(field_reader *r, unsigned int *value) {
+  if (r->end - r->p >= 2 && r->p[0] == '0' && (r->p[1] | 0x20) == 'x')
+    r->p += 2;
+  auto res = std::from_chars(r->p, r->end, *value, 16);
+  if (res.ec != std::errc())
+    return false;
+  r->p = res.ptr;
+  return true;
+}
+
+template <typename T> static bool read_dec(field_reader *r, T *value) {
+  auto res = std::from_chars(r->p, r->end, *value, 10);
+  if (res.ec != std::errc())
+    return false;
+  r->p = res.ptr;
+  return true;
+}
+
+static bool skip(field_reader *r, char c) {
+  if (r->p >= r->end || *r->p != c)
+    return false;
+  r->p++;
+  return true;
+}
+
+static void copy_result(tpmesh_urc_t *urc, std::string_view s) {
+  size_t n = s.size() < sizeof(urc->result) - 1 ? s.size()
+                                                 : sizeof(urc->result) - 1;
+  std::memcpy(urc->result, s.data(), n);
+  urc->result[n] = '\0';
+}
+
 /**
  * @brief 解析 URC
  */
-static bool parse_urc(const char *line, tpmesh_urc_t *urc) {
-  if (std::strncmp(line, "+NNMI:", 6) == 0) {
+static bool parse_urc(const at_line_t *line, tpmesh_urc_t *urc) {
+  std::string_view s(line->text, line->len);
+  field_reader r = {line->text, line->text + line->len};
+
+  if (s.starts_with("+NNMI:")) {
     urc->type = URC_NNMI;
     /* +NNMI:<SRC>,<DEST>,<RSSI>,<LEN>,<DATA> */
     unsigned int src, dest, len;
     int rssi;
-    if (std::sscanf(line + 6, "%X,%X,%d,%u,", &src, &dest, &rssi, &len) == 4) {
-      urc->src_addr = src;
-      urc->dest_addr = dest;
-      urc->rssi = rssi;
-      urc->data_len = len;
-
-      /* 找到数据部分 */
-      const char *data_start = std::strchr(line + 6, ',');
-      for (int i = 0; i < 4 && data_start; i++) {
-        data_start = std::strchr(data_start + 1, ',');
-      }
-      if (data_start) {
-        data_start++;
-        /* 解析十六进制数据 */
-        for (uint16_t i = 0; i < len && data_start[i * 2]; i++) {
-          unsigned int byte;
-          if (std::sscanf(data_start + i * 2, "%2X", &byte) == 1) {
-            urc->data[i] = byte;
-          }
-        }
-      }
-      return true;
-    }
-  } else if (std::strncmp(line, "+SEND:", 6) == 0) {
+    r.p += 6;
+    if (!read_hex(&r, &src) || !skip(&r, ',') || !read_hex(&r, &dest) ||
+        !skip(&r, ',') || !read_dec(&r, &rssi) || !skip(&r, ',') ||
+        !read_dec(&r, &len) || !skip(&r, ','))
+      return false;
+    if (len > TPMESH_MAX_PAYLOAD || (size_t)(r.end - r.p) < len * 2)
+      return false;
+
+    /* 数据不在此解码，由接收方直接解码到目标缓冲区 */
+    urc->hex = r.p;
+    urc->src_addr = src;
+    urc->dest_addr = dest;
+    urc->rssi = rssi;
+    urc->data_len = len;
+    return true;
+  }
+
+  if (s.starts_with("+SEND:")) {
     urc->type = URC_SEND;
+    /* +SEND:<SN>,<RESULT>，RESULT 可能含空格 (如 "SEND OK") */
     unsigned int sn;
-    char result[32];
-    if (std::sscanf(line + 6, "%u,%31s", &sn, result) >= 1) {
-      urc->sn = sn;
-      std::strncpy(urc->result, result, sizeof(urc->result) - 1);
-      return true;
-    }
-  } else if (std::strncmp(line, "+ROUTE:", 7) == 0) {
+    r.p += 6;
+    if (!read_dec(&r, &sn))
+      return false;
+    urc->sn = sn;
+    if (skip(&r, ','))
+      copy_result(urc, std::string_view(r.p, r.end - r.p));
+    return true;
+  }
+
+  if (s.starts_with("+ROUTE:")) {
     urc->type = URC_ROUTE;
-    std::strncpy(urc->result, line + 7, sizeof(urc->result) - 1);
+    /* +ROUTE:CREATE ADDR[0xFFFE] / +ROUTE:DELETE ADDR[0xFFFE] */
+    copy_result(urc, s.substr(7));
+    size_t pos = s.find("ADDR[");
+    unsigned int dst;
+    if (pos != std::string_view::npos) {
+      r.p = line->text + pos + 5;
+      if (read_hex(&r, &dst))
+        urc->dest_addr = dst;
+    }
     return true;
-  } else if (std::strncmp(line, "+ACK:", 5) == 0) {
+  }
+
+  if (s.starts_with("+ACK:")) {
     urc->type = URC_ACK;
+    /* +ACK:<SRC>,<RSSI>,<SN> */
     unsigned int src, sn;
     int rssi;
-    if (std::sscanf(line + 5, "%X,%d,%u", &src, &rssi, &sn) == 3) {
-      urc->src_addr = src;
-      urc->rssi = rssi;
-      urc->sn = sn;
-      return true;
-    }
-  } else if (std::strncmp(line, "+BOOT", 5) == 0) {
+    r.p += 5;
+    if (!read_hex(&r, &src) || !skip(&r, ',') || !read_dec(&r, &rssi) ||
+        !skip(&r, ',') || !read_dec(&r, &sn))
+      return false;
+    urc->src_addr = src;
+    urc->rssi = rssi;
+    urc->sn = sn;
+    return true;
+  }
+
+  if (s.starts_with("+BOOT")) {
     urc->type = URC_BOOT;
     return true;
-  } else if (std::strncmp(line, "+READY", 6) == 0) {
+  }
+  if (s.starts_with("+READY")) {
     urc->type = URC_READY;
     return true;
   }
@@ -103,21 +175,53 @@ static bool parse_urc(const char *line, tpmesh_urc_t *urc) {
   return false;
 }
 
+/* ============================================================================
+ * 行处理
+ * ============================================================================
+ */
+
 /**
- * @brief 处理接收到的行
+ * @brief 从串口批量读入切分器
+ * @return 读到的字节数
  */
-static void process_line(tpmesh_at_driver_t drv, const char *line) {
-  if (!line || !*line)
-    return;
+static int fill(tpmesh_at_driver_t drv, uint32_t timeout_ms) {
+  uint16_t avail;
+  uint8_t *p = at_lexer_space(&drv->lexer, &avail);
+  int ret = hal_serial_read(drv->serial, p, avail, timeout_ms);
+  if (ret > 0)
+    at_lexer_commit(&drv->lexer, (uint16_t)ret);
+  return ret;
+}
 
-  /* 检查是否为 URC */
-  if (line[0] == '+') {
-    tpmesh_urc_t urc;
-    std::memset(&urc, 0, sizeof(urc));
-    if (parse_urc(line, &urc) && drv->urc_cb) {
-      drv->urc_cb(drv->urc_ctx, &urc);
-    }
-  }
+/**
+ * @brief 分发 URC 行
+ * @return true=URC 已分发
+ */
+static bool dispatch_urc(tpmesh_at_driver_t drv, const at_line_t *line) {
+  if (line->kind != AT_LINE_URC || !drv->urc_cb)
+    return false;
+
+  tpmesh_urc_t urc;
+  std::memset(&urc, 0, sizeof(urc));
+  if (!parse_urc(line, &urc))
+    return false;
+  drv->urc_cb(drv->urc_ctx, &urc);
+  return true;
+}
+
+/**
+ * @brief 暂存命令等待期间到达的 URC 行
+ *
+ * 等待期间直接分发会在回调中嵌套发送命令，读走外层命令的结果码。
+ */
+static void defer_line(tpmesh_at_driver_t drv, const at_line_t *line) {
+  uint16_t avail;
+  uint8_t *p = at_lexer_space(&drv->deferred, &avail);
+  if (line->len + 1u > avail)
+    return; /* 积压过多，丢弃 */
+  std::memcpy(p, line->text, line->len);
+  p[line->len] = '\n';
+  at_lexer_commit(&drv->deferred, line->len + 1);
 }
 
 tpmesh_at_driver_t tpmesh_at_create(const char *port, uint32_t baudrate) {
@@ -152,7 +256,8 @@ int tpmesh_at_start(tpmesh_at_driver_t drv) {
   }
 
   drv->running = true;
-  drv->rx_len = 0;
+  at_lexer_reset(&drv->lexer);
+  at_lexer_reset(&drv->deferred);
 
   return XSLOT_OK;
 }
@@ -177,6 +282,43 @@ void tpmesh_at_set_urc_callback(tpmesh_at_driver_t drv, tpmesh_urc_cb cb,
   }
 }
 
+int tpmesh_at_poll(tpmesh_at_driver_t drv, uint32_t timeout_ms) {
+  if (!drv || !drv->serial)
+    return XSLOT_ERR_NOT_INIT;
+
+  int urcs = 0;
+  at_line_t line;
+  while (at_lexer_next(&drv->deferred, &line)) {
+    if (dispatch_urc(drv, &line))
+      urcs++;
+  }
+
+  uint32_t wait = timeout_ms;
+  for (;;) {
+    while (at_lexer_next(&drv->lexer, &line)) {
+      if (dispatch_urc(drv, &line))
+        urcs++;
+    }
+    if (fill(drv, wait) <= 0)
+      break;
+
+    /* 首次读取后只取走已到达的数据，不再等待 */
+    wait = 0;
+  }
+
+  return urcs;
+}
+
+int tpmesh_at_wait(tpmesh_at_driver_t drv, uint32_t timeout_ms) {
+  if (!drv || !drv->serial)
+    return XSLOT_ERR_NOT_INIT;
+
+  /* 命令等待期间暂存的 URC 无需等串口 */
+  if (drv->deferred.len > drv->deferred.start)
+    return 1;
+  return hal_serial_wait(drv->serial, timeout_ms);
+}
+
 int tpmesh_at_send_cmd(tpmesh_at_driver_t drv, const char *cmd,
                        uint32_t timeout_ms) {
   char response[128];
@@ -191,41 +333,119 @@ int tpmesh_at_send_cmd_resp(tpmesh_at_driver_t drv, const char *cmd,
     return XSLOT_ERR_PARAM;
 
   /* 构建完整命令 */
-  char full_cmd[256];
+  char full_cmd[1024];
   int len = std::snprintf(full_cmd, sizeof(full_cmd), "AT%s\r\n", cmd);
   if (len < 0 || len >= (int)sizeof(full_cmd))
     return XSLOT_ERR_PARAM;
 
+  /* 之前未处理的 URC 留待 poll 分发 */
+  at_line_t line;
+  while (at_lexer_next(&drv->lexer, &line)) {
+    if (line.kind == AT_LINE_URC)
+      defer_line(drv, &line);
+  }
+
   /* 发送命令 */
   if (hal_serial_write(drv->serial, (uint8_t *)full_cmd, len) != len) {
     return XSLOT_ERR_SEND_FAIL;
   }
 
-  /* 等待响应 */
-  uint32_t start = hal_get_timestamp_ms();
-  drv->rx_len = 0;
+  uint16_t resp_len = 0;
+  if (response && resp_size > 0)
+    response[0] = '\0';
 
+  /* 等待最终结果码 */
+  uint32_t start = hal_get_timestamp_ms();
   while (hal_get_timestamp_ms() - start < timeout_ms) {
-    uint8_t byte;
-    int ret = hal_serial_read(drv->serial, &byte, 1, 10);
-    if (ret > 0) {
-      if (drv->rx_len < AT_BUFFER_SIZE - 1) {
-        drv->rx_buffer[drv->rx_len++] = byte;
-        drv->rx_buffer[drv->rx_len] = '\0';
-      }
+    while (at_lexer_next(&drv->lexer, &line)) {
+      if (line.kind == AT_LINE_OK)
+        return XSLOT_OK;
+      if (line.kind == AT_LINE_ERROR)
+        return XSLOT_ERR_PARAM;
 
-      /* 检查是否收到完整响应 */
-      if (std::strstr(drv->rx_buffer, "OK\r\n")) {
-        if (response && resp_size > 0) {
-          std::strncpy(response, drv->rx_buffer, resp_size - 1);
-          response[resp_size - 1] = '\0';
+      if (line.kind == AT_LINE_URC) {
+        tpmesh_urc_t urc;
+        std::memset(&urc, 0, sizeof(urc));
+        if (parse_urc(&line, &urc)) {
+          if (urc.type == URC_SEND &&
+              std::strcmp(urc.result, "HANDLE OK") == 0) {
+            drv->send_sn = urc.sn;
+          } else if (urc.type == URC_SEND &&
+                     std::strcmp(urc.result, "HANDLE ERROR") == 0) {
+            drv->send_rejected = true;
+          } else {
+            defer_line(drv, &line);
+          }
+          continue;
         }
-        return XSLOT_OK;
+        /* 其余 '+' 行为查询结果 */
       }
-      if (std::strstr(drv->rx_buffer, "ERROR")) {
-        return XSLOT_ERR_PARAM;
+
+      /* 信息行追加到响应 (以 \r\n 分隔) */
+      if (response && resp_len + line.len + 3u <= resp_size) {
+        std::memcpy(response + resp_len, line.text, line.len);
+        resp_len += line.len;
+        response[resp_len++] = '\r';
+        response[resp_len++] = '\n';
+        response[resp_len] = '\0';
+      }
+    }
+    fill(drv, AT_READ_SLICE_MS);
+  }
+
+  return XSLOT_ERR_TIMEOUT;
+}
+
+int tpmesh_at_send_data_confirmed(tpmesh_at_driver_t drv, uint16_t addr,
+                                  const uint8_t *data, uint16_t len,
+                                  uint32_t timeout_ms) {
+  if (!drv)
+    return XSLOT_ERR_PARAM;
+
+  drv->send_sn = -1;
+  drv->send_rejected = false;
+  int ret = tpmesh_at_send_data(drv, addr, data, len, 1 /* AM */);
+  if (ret != XSLOT_OK)
+    return ret;
+  if (drv->send_rejected)
+    return XSLOT_ERR_BUSY;
+
+  /* 等待目标节点的 +ACK。SN 来自 +SEND:<SN>,HANDLE OK (可能在命令阶段
+   * 已读到)，模组未给出 SN 时按来源地址匹配。 */
+  int sn = drv->send_sn;
+  uint32_t start = hal_get_timestamp_ms();
+
+  while (hal_get_timestamp_ms() - start < timeout_ms) {
+    at_line_t line;
+    while (at_lexer_next(&drv->lexer, &line)) {
+      if (line.kind != AT_LINE_URC)
+        continue;
+
+      tpmesh_urc_t urc;
+      std::memset(&urc, 0, sizeof(urc));
+      if (!parse_urc(&line, &urc))
+        continue;
+
+      if (urc.type == URC_SEND) {
+        if (std::strcmp(urc.result, "HANDLE OK") == 0 && sn < 0) {
+          sn = urc.sn;
+        } else if (std::strcmp(urc.result, "HANDLE ERROR") == 0) {
+          return XSLOT_ERR_BUSY;
+        } else if (std::strcmp(urc.result, "SEND ERROR") == 0 &&
+                   (sn < 0 || urc.sn == sn)) {
+          return XSLOT_ERR_SEND_FAIL;
+        }
+      } else if (urc.type == URC_ACK) {
+        bool match = sn >= 0 ? urc.sn == sn
+                             : (addr == 0xFFFF || urc.src_addr == addr);
+        if (match)
+          return XSLOT_OK;
+      } else {
+        /* 等待期间收到的其他 URC (如数据) 留待 poll 上报 */
+        defer_line(drv, &line);
       }
     }
+    fill(drv, AT_READ_SLICE_MS);
   }
 
   return XSLOT_ERR_TIMEOUT;
@@ -256,7 +476,7 @@ int tpmesh_at_set_power(tpmesh_at_driver_t drv, int8_t power_dbm) {
 
 int tpmesh_at_send_data(tpmesh_at_driver_t drv, uint16_t addr,
                         const uint8_t *data, uint16_t len, uint8_t type) {
-  if (!drv || !data || len == 0 || len > 400)
+  if (!drv || !data || len == 0 || len > TPMESH_MAX_PAYLOAD)
     return XSLOT_ERR_PARAM;
 
   /* 构建命令: AT+SEND=<ADDR>,<LEN>,<DATA>,<TYPE> */
@@ -14,6 +14,9 @@
 extern "C" {
 #endif
 
+/** 模组单次收发的最大数据字节数 */
+#define TPMESH_MAX_PAYLOAD 400
+
 /**
  * @brief URC 类型
  */
@@ -35,8 +38,8 @@ typedef struct {
   uint16_t dest_addr;
   int8_t rssi;
   uint8_t sn;
-  uint8_t data[256];
-  uint16_t data_len;
+  const char *hex;   /**< +NNMI 数据的十六进制文本 (回调返回后失效) */
+  uint16_t data_len; /**< 数据字节数 (hex 含 2 * data_len 个字符) */
   char result[32];
 } tpmesh_urc_t;
 
@@ -79,6 +82,20 @@ void tpmesh_at_stop(tpmesh_at_driver_t drv);
 void tpmesh_at_set_urc_callback(tpmesh_at_driver_t drv, tpmesh_urc_cb cb,
                                 void *ctx);
 
+/**
+ * @brief 读取串口数据并分发完整的 URC 行
+ * @param drv 驱动
+ * @param timeout_ms 无数据时的最长等待时间 (0=不等待)
+ * @return 处理的 URC 数量, <0=错误
+ */
+int tpmesh_at_poll(tpmesh_at_driver_t drv, uint32_t timeout_ms);
+
+/**
+ * @brief 等待串口数据或暂存的 URC (不读取、不分发)
+ * @return 1=有待处理数据，0=超时，<0=错误
+ */
+int tpmesh_at_wait(tpmesh_at_driver_t drv, uint32_t timeout_ms);
+
 /**
  * @brief 发送 AT 命令 (同步等待响应)
  * @param drv 驱动
@@ -135,6 +152,19 @@ int tpmesh_at_set_power(tpmesh_at_driver_t drv, int8_t power_dbm);
 int tpmesh_at_send_data(tpmesh_at_driver_t drv, uint16_t addr,
                         const uint8_t *data, uint16_t len, uint8_t type);
 
+/**
+ * @brief 以 AM 方式发送数据并等待目标节点送达确认 (+ACK)
+ * @param drv 驱动
+ * @param addr 目标地址
+ * @param data 数据
+ * @param len 长度
+ * @param timeout_ms 等待送达确认的超时时间
+ * @return 0=已送达, <0=失败或超时
+ */
+int tpmesh_at_send_data_confirmed(tpmesh_at_driver_t drv, uint16_t addr,
+                                  const uint8_t *data, uint16_t len,
+                                  uint32_t timeout_ms);
+
 #ifdef __cplusplus
 }
 #endif
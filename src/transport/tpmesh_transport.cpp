@@ -4,10 +4,17 @@
  */
 #include "tpmesh_transport.h"
 #include "tpmesh_at_driver.h"
+#include "../core/xslot_protocol.h"
 #include <cstdlib>
 #include <cstring>
 #include <xslot/xslot_error.h>
 
+/* AM 送达确认等待时间 (多跳场景需数秒) */
+#define TPMESH_CONFIRM_TIMEOUT_MS 5000
+
+/* 接收帧池深度 (上层回调中再次 poll 时嵌套分配) */
+#define TPMESH_RX_POOL_SIZE 4
+
 struct tpmesh_transport_impl {
   i_transport_t base;
   tpmesh_at_driver_t at_driver;
@@ -16,6 +23,18 @@ struct tpmesh_transport_impl {
   /* 接收回调 */
   transport_receive_cb recv_cb;
   void *recv_ctx;
+
+  /* 已解码帧回调 */
+  transport_frame_cb frame_cb;
+  void *frame_ctx;
+
+  /* 接收帧池，按后进先出分配 */
+  xslot_frame_t rx_pool[TPMESH_RX_POOL_SIZE];
+  uint8_t rx_depth;
+
+  /* 路由变化回调 */
+  transport_route_cb route_cb;
+  void *route_ctx;
 };
 
 /* 前向声明 */
@@ -26,6 +45,11 @@ static int tpmesh_probe(void *impl);
 static int tpmesh_configure(void *impl, uint8_t cell_id, int8_t power_dbm);
 static void tpmesh_set_recv_cb(void *impl, transport_receive_cb cb, void *ctx);
 static void tpmesh_destroy(void *impl);
+static int tpmesh_send_confirmed(void *impl, const uint8_t *data, uint16_t len);
+static int tpmesh_poll(void *impl, uint32_t timeout_ms);
+static void tpmesh_set_route_cb(void *impl, transport_route_cb cb, void *ctx);
+static void tpmesh_set_frame_cb(void *impl, transport_frame_cb cb, void *ctx);
+static int tpmesh_wait(void *impl, uint32_t timeout_ms);
 
 static const i_transport_vtable_t tpmesh_vtable = {
     .start = tpmesh_start,
@@ -35,8 +59,42 @@ static const i_transport_vtable_t tpmesh_vtable = {
     .configure = tpmesh_configure,
     .set_receive_cb = tpmesh_set_recv_cb,
     .destroy = tpmesh_destroy,
+    .send_confirmed = tpmesh_send_confirmed,
+    .poll = tpmesh_poll,
+    .set_route_cb = tpmesh_set_route_cb,
+    .set_frame_cb = tpmesh_set_frame_cb,
+    .set_batch_cb = nullptr, /* 已解码的帧经 set_frame_cb 逐帧交付 */
+    .wait = tpmesh_wait,
 };
 
+/**
+ * @brief 交付 +NNMI 数据
+ *
+ * 十六进制文本直接解码到帧池中的帧，已解码帧回调不再复制。只设置了
+ * 接收回调时重新编码为字节。
+ */
+static void deliver_nnmi(tpmesh_transport_impl *impl, const tpmesh_urc_t *urc) {
+  if (!impl->frame_cb && !impl->recv_cb)
+    return;
+  if (impl->rx_depth >= TPMESH_RX_POOL_SIZE)
+    return; /* 嵌套过深，丢弃 */
+
+  xslot_frame_t *frame = &impl->rx_pool[impl->rx_depth];
+  if (xslot_frame_decode_hex(urc->hex, urc->data_len, frame) != XSLOT_OK)
+    return;
+
+  impl->rx_depth++;
+  if (impl->frame_cb) {
+    impl->frame_cb(impl->frame_ctx, frame);
+  } else {
+    uint8_t raw[XSLOT_FRAME_MAX_SIZE];
+    int len = xslot_frame_encode(frame, raw, sizeof(raw));
+    if (len > 0)
+      impl->recv_cb(impl->recv_ctx, raw, (uint16_t)len);
+  }
+  impl->rx_depth--;
+}
+
 /**
  * @brief URC 回调处理
  */
@@ -48,9 +106,7 @@ static void on_urc_received(void *ctx, const tpmesh_urc_t *urc) {
   switch (urc->type) {
   case URC_NNMI:
     /* 数据接收，转发给上层 */
-    if (impl->recv_cb && urc->data_len > 0) {
-      impl->recv_cb(impl->recv_ctx, urc->data, urc->data_len);
-    }
+    deliver_nnmi(impl, urc);
     break;
 
   case URC_SEND:
@@ -58,7 +114,14 @@ static void on_urc_received(void *ctx, const tpmesh_urc_t *urc) {
     break;
 
   case URC_ROUTE:
-    /* 路由变化 */
+    /* 路由变化: 向任意汇聚节点发送后由此得知实际的汇聚节点 */
+    if (impl->route_cb && urc->dest_addr != 0) {
+      if (std::strncmp(urc->result, "CREATE", 6) == 0) {
+        impl->route_cb(impl->route_ctx, urc->dest_addr, true);
+      } else if (std::strncmp(urc->result, "DELETE", 6) == 0) {
+        impl->route_cb(impl->route_ctx, urc->dest_addr, false);
+      }
+    }
     break;
 
   case URC_ACK:
@@ -148,6 +211,36 @@ static int tpmesh_send(void *impl_ptr, const uint8_t *data, uint16_t len) {
   return tpmesh_at_send_data(impl->at_driver, dest_addr, data, len, 0);
 }
 
+static int tpmesh_send_confirmed(void *impl_ptr, const uint8_t *data,
+                                 uint16_t len) {
+  tpmesh_transport_impl *impl = (tpmesh_transport_impl *)impl_ptr;
+  if (!impl || !data || len < 5)
+    return XSLOT_ERR_PARAM;
+
+  uint16_t dest_addr = data[3] | (data[4] << 8);
+
+  /* 使用 Type 1 (AM) 发送并等待 +ACK */
+  return tpmesh_at_send_data_confirmed(impl->at_driver, dest_addr, data, len,
+                                       TPMESH_CONFIRM_TIMEOUT_MS);
+}
+
+static int tpmesh_poll(void *impl_ptr, uint32_t timeout_ms) {
+  tpmesh_transport_impl *impl = (tpmesh_transport_impl *)impl_ptr;
+  if (!impl)
+    return XSLOT_ERR_PARAM;
+
+  /* URC 经 on_urc_received 分发 */
+  return tpmesh_at_poll(impl->at_driver, timeout_ms);
+}
+
+static int tpmesh_wait(void *impl_ptr, uint32_t timeout_ms) {
+  tpmesh_transport_impl *impl = (tpmesh_transport_impl *)impl_ptr;
+  if (!impl)
+    return XSLOT_ERR_PARAM;
+
+  return tpmesh_at_wait(impl->at_driver, timeout_ms);
+}
+
 static int tpmesh_probe(void *impl_ptr) {
   tpmesh_transport_impl *impl = (tpmesh_transport_impl *)impl_ptr;
   if (!impl)
@@ -196,6 +289,24 @@ static void tpmesh_set_recv_cb(void *impl_ptr, transport_receive_cb cb,
   }
 }
 
+static void tpmesh_set_route_cb(void *impl_ptr, transport_route_cb cb,
+                                void *ctx) {
+  tpmesh_transport_impl *impl = (tpmesh_transport_impl *)impl_ptr;
+  if (impl) {
+    impl->route_cb = cb;
+    impl->route_ctx = ctx;
+  }
+}
+
+static void tpmesh_set_frame_cb(void *impl_ptr, transport_frame_cb cb,
+                                void *ctx) {
+  tpmesh_transport_impl *impl = (tpmesh_transport_impl *)impl_ptr;
+  if (impl) {
+    impl->frame_cb = cb;
+    impl->frame_ctx = ctx;
+  }
+}
+
 static void tpmesh_destroy(void *impl_ptr) {
   tpmesh_transport_impl *impl = (tpmesh_transport_impl *)impl_ptr;
   if (!impl)
@@ -3,12 +3,33 @@
  * @brief X-Slot C API 实现
  */
 #include "bacnet/bacnet_serializer.h"
+#include "core/series_aggregate.h"
 #include "core/xslot_manager.h"
 #include <xslot/xslot.h>
 
 /* 版本字符串 */
 static const char VERSION_STRING[] = "1.0.0";
 
+/**
+ * @brief API 调用期间持有协议栈锁
+ *
+ * I/O 线程模型下与 I/O 线程互斥；锁可重入，回调中可再调用 API。
+ */
+class manager_guard {
+public:
+  explicit manager_guard(xslot_handle_t handle)
+      : mgr_((xslot_manager_t *)handle) {
+    xslot_manager_lock(mgr_);
+  }
+  ~manager_guard() { xslot_manager_unlock(mgr_); }
+
+  manager_guard(const manager_guard &) = delete;
+  manager_guard &operator=(const manager_guard &) = delete;
+
+private:
+  xslot_manager_t *mgr_;
+};
+
 /* ============================================================================
  * 初始化与控制
  * ============================================================================
@@ -40,6 +61,13 @@ void xslot_stop(xslot_handle_t handle) {
   }
 }
 
+int xslot_poll(xslot_handle_t handle, uint32_t timeout_ms) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  return xslot_manager_poll((xslot_manager_t *)handle, timeout_ms);
+}
+
 xslot_run_mode_t xslot_get_run_mode(xslot_handle_t handle) {
   if (!handle)
     return XSLOT_MODE_NONE;
@@ -59,6 +87,7 @@ int xslot_report_objects(xslot_handle_t handle,
   if (!handle || !objects || count == 0)
     return XSLOT_ERR_PARAM;
 
+  manager_guard guard(handle);
   return xslot_manager_report((xslot_manager_t *)handle, objects, count);
 }
 
@@ -67,18 +96,41 @@ int xslot_write_object(xslot_handle_t handle, uint16_t target,
   if (!handle || !obj)
     return XSLOT_ERR_PARAM;
 
+  manager_guard guard(handle);
   return xslot_manager_write((xslot_manager_t *)handle, target, obj);
 }
 
+int xslot_write_objects(xslot_handle_t handle, uint16_t target,
+                        const xslot_bacnet_object_t *objects, uint8_t count) {
+  if (!handle || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_write_multi((xslot_manager_t *)handle, target, objects,
+                                   count);
+}
+
 int xslot_query_objects(xslot_handle_t handle, uint16_t target,
                         const uint16_t *object_ids, uint8_t count) {
   if (!handle || !object_ids || count == 0)
     return XSLOT_ERR_PARAM;
 
+  manager_guard guard(handle);
   return xslot_manager_query((xslot_manager_t *)handle, target, object_ids,
                              count);
 }
 
+int xslot_query_properties(xslot_handle_t handle, uint16_t target,
+                           uint8_t mask, const xslot_object_ref_t *objects,
+                           uint8_t count) {
+  if (!handle || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_query_properties((xslot_manager_t *)handle, target,
+                                        mask, objects, count);
+}
+
 /* ============================================================================
  * 节点管理
  * ============================================================================
@@ -88,6 +140,7 @@ int xslot_send_ping(xslot_handle_t handle, uint16_t target) {
   if (!handle)
     return XSLOT_ERR_PARAM;
 
+  manager_guard guard(handle);
   return xslot_manager_ping((xslot_manager_t *)handle, target);
 }
 
@@ -96,6 +149,7 @@ int xslot_get_nodes(xslot_handle_t handle, xslot_node_info_t *nodes,
   if (!handle || !nodes || max_count <= 0)
     return XSLOT_ERR_PARAM;
 
+  manager_guard guard(handle);
   node_table_t table = xslot_manager_get_node_table((xslot_manager_t *)handle);
   if (!table)
     return 0;
@@ -107,6 +161,7 @@ bool xslot_is_node_online(xslot_handle_t handle, uint16_t addr) {
   if (!handle)
     return false;
 
+  manager_guard guard(handle);
   node_table_t table = xslot_manager_get_node_table((xslot_manager_t *)handle);
   if (!table)
     return false;
@@ -122,6 +177,7 @@ bool xslot_is_node_online(xslot_handle_t handle, uint16_t addr) {
 void xslot_set_data_callback(xslot_handle_t handle,
                              xslot_data_received_cb callback) {
   if (handle) {
+    manager_guard guard(handle);
     xslot_manager_set_data_cb((xslot_manager_t *)handle, callback);
   }
 }
@@ -129,13 +185,23 @@ void xslot_set_data_callback(xslot_handle_t handle,
 void xslot_set_node_callback(xslot_handle_t handle,
                              xslot_node_online_cb callback) {
   if (handle) {
+    manager_guard guard(handle);
     xslot_manager_set_node_cb((xslot_manager_t *)handle, callback);
   }
 }
 
+void xslot_set_node_batch_callback(xslot_handle_t handle,
+                                   xslot_node_batch_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_node_batch_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
 void xslot_set_write_callback(xslot_handle_t handle,
                               xslot_write_request_cb callback) {
   if (handle) {
+    manager_guard guard(handle);
     xslot_manager_set_write_cb((xslot_manager_t *)handle, callback);
   }
 }
@@ -143,20 +209,273 @@ void xslot_set_write_callback(xslot_handle_t handle,
 void xslot_set_report_callback(xslot_handle_t handle,
                                xslot_report_received_cb callback) {
   if (handle) {
+    manager_guard guard(handle);
     xslot_manager_set_report_cb((xslot_manager_t *)handle, callback);
   }
 }
 
+void xslot_set_timed_report_callback(xslot_handle_t handle,
+                                     xslot_history_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_timed_report_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
+void xslot_set_alarm_callback(xslot_handle_t handle, xslot_alarm_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_alarm_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
+void xslot_set_property_read_callback(xslot_handle_t handle,
+                                      xslot_property_read_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_property_read_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
+void xslot_set_property_callback(xslot_handle_t handle,
+                                 xslot_property_response_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_property_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
+/* ============================================================================
+ * 告警评估
+ * ============================================================================
+ */
+
+int xslot_set_alarm_limit(xslot_handle_t handle, uint16_t addr,
+                          const xslot_alarm_limit_t *limit) {
+  if (!handle || !limit)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_set_alarm_limit((xslot_manager_t *)handle, addr, limit);
+}
+
+void xslot_remove_alarm_limit(xslot_handle_t handle, uint16_t addr,
+                              uint8_t object_type, uint16_t object_id) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_remove_alarm_limit((xslot_manager_t *)handle, addr,
+                                     object_type, object_id);
+  }
+}
+
+/* ============================================================================
+ * 逻辑子设备
+ * ============================================================================
+ */
+
+int xslot_register_sub_device(xslot_handle_t handle, uint8_t sub,
+                              const xslot_sub_device_t *dev) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_register_sub((xslot_manager_t *)handle, sub, dev);
+}
+
+int xslot_report_sub_objects(xslot_handle_t handle, uint8_t sub,
+                             const xslot_bacnet_object_t *objects,
+                             uint8_t count) {
+  if (!handle || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_report_sub((xslot_manager_t *)handle, sub, objects,
+                                  count);
+}
+
+int xslot_write_sub_objects(xslot_handle_t handle, uint16_t target,
+                            uint8_t sub, const xslot_bacnet_object_t *objects,
+                            uint8_t count) {
+  if (!handle || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_write_sub((xslot_manager_t *)handle, target, sub,
+                                 objects, count);
+}
+
+int xslot_query_sub_properties(xslot_handle_t handle, uint16_t target,
+                               uint8_t sub, uint8_t mask,
+                               const xslot_object_ref_t *objects,
+                               uint8_t count) {
+  if (!handle || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_query_sub_properties((xslot_manager_t *)handle, target,
+                                            sub, mask, objects, count);
+}
+
+void xslot_set_sub_report_callback(xslot_handle_t handle,
+                                   xslot_sub_report_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_sub_report_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
+void xslot_set_sub_property_callback(xslot_handle_t handle,
+                                     xslot_sub_property_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_sub_property_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
+/* ============================================================================
+ * 流式推送
+ * ============================================================================
+ */
+
+int xslot_stream_publish(xslot_handle_t handle,
+                         const xslot_bacnet_object_t *objects, uint8_t count) {
+  if (!handle || !objects || count == 0)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_stream_publish((xslot_manager_t *)handle, objects,
+                                      count);
+}
+
+int xslot_stream_subscribe(xslot_handle_t handle, uint16_t target,
+                           const xslot_object_ref_t *objects, uint8_t count,
+                           uint8_t window) {
+  if (!handle || (!objects && count > 0))
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_stream_subscribe((xslot_manager_t *)handle, target,
+                                        objects, count, window);
+}
+
 /* ============================================================================
  * 运行时配置
  * ============================================================================
  */
 
+int xslot_enable_shm_publish(xslot_handle_t handle, const char *name) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_enable_shm((xslot_manager_t *)handle, name);
+}
+
+int xslot_enable_store_forward(xslot_handle_t handle,
+                               const xslot_store_config_t *config) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_enable_store((xslot_manager_t *)handle, config);
+}
+
+uint32_t xslot_store_forward_pending(xslot_handle_t handle) {
+  manager_guard guard(handle);
+  return xslot_manager_store_pending((xslot_manager_t *)handle);
+}
+
+int xslot_set_hub_group(xslot_handle_t handle, const uint16_t *hubs,
+                        uint8_t count) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_set_hub_group((xslot_manager_t *)handle, hubs, count);
+}
+
+uint16_t xslot_get_hub_owner(xslot_handle_t handle, uint16_t addr) {
+  manager_guard guard(handle);
+  return xslot_manager_hub_owner((xslot_manager_t *)handle, addr);
+}
+
+uint16_t xslot_get_serving_hub(xslot_handle_t handle) {
+  manager_guard guard(handle);
+  return xslot_manager_serving_hub((xslot_manager_t *)handle);
+}
+
+int xslot_cluster_attach(xslot_handle_t handle,
+                         const xslot_cluster_ops_t *ops) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_cluster_attach((xslot_manager_t *)handle, ops);
+}
+
+int xslot_cluster_inject(xslot_handle_t handle, const uint8_t *frame,
+                         uint16_t len) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_cluster_inject((xslot_manager_t *)handle, frame, len);
+}
+
+int xslot_cluster_transmit(xslot_handle_t handle, const uint8_t *frame,
+                           uint16_t len, bool confirmed) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_cluster_transmit((xslot_manager_t *)handle, frame, len,
+                                        confirmed);
+}
+
+bool xslot_cluster_is_owner(xslot_handle_t handle, uint16_t addr) {
+  manager_guard guard(handle);
+  return xslot_manager_cluster_owns((xslot_manager_t *)handle, addr);
+}
+
+void xslot_set_history_callback(xslot_handle_t handle,
+                                xslot_history_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_history_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
+int xslot_trend_configure(xslot_handle_t handle,
+                          const xslot_trend_config_t *config) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_trend_configure((xslot_manager_t *)handle, config);
+}
+
+int xslot_trend_record(xslot_handle_t handle,
+                       const xslot_bacnet_object_t *objects, uint8_t count) {
+  if (!handle)
+    return XSLOT_ERR_PARAM;
+
+  manager_guard guard(handle);
+  return xslot_manager_trend_record((xslot_manager_t *)handle, objects, count);
+}
+
+void xslot_set_trend_callback(xslot_handle_t handle, xslot_trend_cb callback) {
+  if (handle) {
+    manager_guard guard(handle);
+    xslot_manager_set_trend_cb((xslot_manager_t *)handle, callback);
+  }
+}
+
 int xslot_update_wireless_config(xslot_handle_t handle, uint8_t cell_id,
                                  int8_t power_dbm) {
   if (!handle)
     return XSLOT_ERR_PARAM;
 
+  manager_guard guard(handle);
   return xslot_manager_update_config((xslot_manager_t *)handle, cell_id,
                                      power_dbm);
 }
@@ -175,6 +494,14 @@ int xslot_deserialize_objects(const uint8_t *data, uint8_t len,
   return bacnet_deserialize_objects(data, len, objects, max_count);
 }
 
+int xslot_series_downsample(const xslot_series_t *series,
+                            uint32_t series_count, uint64_t start_ms,
+                            uint32_t bucket_ms, uint32_t bucket_count,
+                            const xslot_series_columns_t *out) {
+  return series_downsample_batch(series, series_count, start_ms, bucket_ms,
+                                 bucket_count, out);
+}
+
 /* ============================================================================
  * 错误码描述
  * ============================================================================
@@ -202,6 +529,8 @@ const char *xslot_strerror(xslot_error_t err) {
     return "Not initialized";
   case XSLOT_ERR_SEND_FAIL:
     return "Send failed";
+  case XSLOT_ERR_NOT_SUPPORT:
+    return "Not supported on this platform";
   default:
     return "Unknown error";
   }
@@ -0,0 +1,226 @@
+/**
+ * @file bench_at_lexer.cpp
+ * @brief AT 行切分测试与 400 字节 +NNMI 行吞吐基准
+ *
+ * 串口由内存桩代替 (每次最多读 64 字节，模拟 UART 驱动的分段)，
+ * 基准结果只反映切分与 URC 解析的开销。
+ *
+ * 用法: bench_at_lexer [行数]   (默认 2000，ctest 以默认值运行)
+ * 吞吐数字以 -DCMAKE_BUILD_TYPE=Release 构建为准。
+ */
+#include "hal/hal_interface.h"
+#include "test_util.h"
+#include "transport/at_lexer.h"
+#include "transport/tpmesh_at_driver.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/* ============================================================================
+ * 串口桩
+ * ============================================================================
+ */
+
+#define STUB_READ_CHUNK 64
+
+static std::string g_rx;
+static size_t g_rx_pos;
+static uint32_t g_clock_ms;
+
+extern "C" {
+
+void *hal_serial_open(const char *port, uint32_t baudrate) {
+  (void)port;
+  (void)baudrate;
+  return &g_rx;
+}
+
+void hal_serial_close(void *handle) { (void)handle; }
+
+int hal_serial_write(void *handle, const uint8_t *data, uint16_t len) {
+  (void)handle;
+  (void)data;
+  return len;
+}
+
+int hal_serial_read(void *handle, uint8_t *data, uint16_t max_len,
+                    uint32_t timeout_ms) {
+  (void)handle;
+  (void)timeout_ms;
+  size_t n = g_rx.size() - g_rx_pos;
+  if (n > max_len)
+    n = max_len;
+  if (n > STUB_READ_CHUNK)
+    n = STUB_READ_CHUNK;
+  std::memcpy(data, g_rx.data() + g_rx_pos, n);
+  g_rx_pos += n;
+  return (int)n;
+}
+
+int hal_serial_wait(void *handle, uint32_t timeout_ms) {
+  (void)handle;
+  (void)timeout_ms;
+  return g_rx_pos < g_rx.size() ? 1 : 0;
+}
+
+uint32_t hal_get_timestamp_ms(void) { return ++g_clock_ms; }
+
+void hal_sleep_ms(uint32_t ms) { g_clock_ms += ms; }
+
+} // extern "C"
+
+static void feed(const std::string &data) {
+  g_rx = data;
+  g_rx_pos = 0;
+}
+
+/* ============================================================================
+ * 切分器
+ * ============================================================================
+ */
+
+/* 以固定分段写入并取出所有行，行内容以 '|' 拼接，类型逐字符记录 */
+static void lex_all(const std::string &input, uint16_t chunk,
+                    std::string *lines, std::string *kinds) {
+  at_lexer_t lx;
+  at_lexer_reset(&lx);
+  size_t pos = 0;
+  for (;;) {
+    at_line_t line;
+    while (at_lexer_next(&lx, &line)) {
+      lines->append(line.text, line.len);
+      lines->push_back('|');
+      kinds->push_back((char)('0' + line.kind));
+    }
+    if (pos == input.size())
+      break;
+
+    uint16_t avail;
+    uint8_t *dst = at_lexer_space(&lx, &avail);
+    size_t n = input.size() - pos;
+    if (n > chunk)
+      n = chunk;
+    if (n > avail)
+      n = avail;
+    std::memcpy(dst, input.data() + pos, n);
+    at_lexer_commit(&lx, (uint16_t)n);
+    pos += n;
+  }
+}
+
+static void test_lexer() {
+  std::string input = "AT+CFUN?\r\n+CFUN:1\r\n\r\nOK\r\nERROR\r\n"
+                      "+CME ERROR: 3\r\nready\n";
+  input += std::string(AT_LEXER_SIZE + 10, 'x') + "\r\n";
+  input += "+ROUTE:CREATE ADDR[0x0012]\r\n";
+
+  const char *expect_lines = "AT+CFUN?|+CFUN:1|OK|ERROR|+CME ERROR: 3|ready|"
+                             "+ROUTE:CREATE ADDR[0x0012]|";
+  const char expect_kinds[] = {'0' + AT_LINE_INFO,  '0' + AT_LINE_URC,
+                               '0' + AT_LINE_OK,    '0' + AT_LINE_ERROR,
+                               '0' + AT_LINE_ERROR, '0' + AT_LINE_INFO,
+                               '0' + AT_LINE_URC,   0};
+
+  const uint16_t chunks[] = {1, 7, 64, 1000};
+  for (uint16_t chunk : chunks) {
+    std::string lines, kinds;
+    lex_all(input, chunk, &lines, &kinds);
+    CHECK(lines == expect_lines);
+    CHECK(kinds == expect_kinds);
+  }
+}
+
+/* ============================================================================
+ * +NNMI 基准
+ * ============================================================================
+ */
+
+struct nnmi_stats {
+  int count;
+  int bad;
+};
+
+static int hex_nibble(char c) {
+  return c <= '9' ? c - '0' : (c & ~0x20) - 'A' + 10;
+}
+
+static void on_urc(void *ctx, const tpmesh_urc_t *urc) {
+  nnmi_stats *st = (nnmi_stats *)ctx;
+  if (urc->type != URC_NNMI)
+    return;
+  st->count++;
+  if (urc->data_len != TPMESH_MAX_PAYLOAD || urc->src_addr != 0x0012) {
+    st->bad++;
+    return;
+  }
+  for (uint16_t i = 0; i < urc->data_len; i++) {
+    int b = hex_nibble(urc->hex[2 * i]) << 4 | hex_nibble(urc->hex[2 * i + 1]);
+    if (b != (i & 0xFF)) {
+      st->bad++;
+      return;
+    }
+  }
+}
+
+static std::string nnmi_line(uint16_t len) {
+  static const char digits[] = "0123456789ABCDEF";
+  std::string line = "+NNMI:0012,FFFE,-45," + std::to_string(len) + ",";
+  for (uint16_t i = 0; i < len; i++) {
+    line.push_back(digits[(i >> 4) & 0x0F]);
+    line.push_back(digits[i & 0x0F]);
+  }
+  line += "\r\n";
+  return line;
+}
+
+static void bench_nnmi(int lines) {
+  tpmesh_at_driver_t drv = tpmesh_at_create("stub", 115200);
+  CHECK(drv != nullptr);
+  if (!drv)
+    return;
+  tpmesh_at_start(drv);
+  nnmi_stats st = {0, 0};
+  tpmesh_at_set_urc_callback(drv, on_urc, &st);
+
+  std::string line = nnmi_line(TPMESH_MAX_PAYLOAD);
+  std::string input;
+  input.reserve(line.size() * lines);
+  for (int i = 0; i < lines; i++) {
+    input += line;
+  }
+  feed(input);
+
+  auto t0 = std::chrono::steady_clock::now();
+  while (g_rx_pos < g_rx.size()) {
+    tpmesh_at_poll(drv, 0);
+  }
+  tpmesh_at_poll(drv, 0);
+  double s = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                           t0)
+                 .count();
+
+  CHECK(st.count == lines);
+  CHECK(st.bad == 0);
+  std::printf("+NNMI %u B x %d lines (%zu B/line): %.3f s, %.1f MB/s, "
+              "%.0f lines/s\n",
+              TPMESH_MAX_PAYLOAD, lines, line.size(), s,
+              input.size() / s / 1e6, lines / s);
+
+  /* 命令等待期间到达的 URC 暂存，下一次 poll 交付 */
+  st.count = 0;
+  feed(nnmi_line(TPMESH_MAX_PAYLOAD) + "OK\r\n");
+  CHECK(tpmesh_at_send_cmd(drv, "CSQ", 100) == 0);
+  CHECK(st.count == 0);
+  tpmesh_at_poll(drv, 0);
+  CHECK(st.count == 1);
+
+  tpmesh_at_destroy(drv);
+}
+
+int main(int argc, char **argv) {
+  int lines = argc > 1 ? std::atoi(argv[1]) : 2000;
+  test_lexer();
+  bench_nnmi(lines > 0 ? lines : 2000);
+  return TEST_RESULT();
+}
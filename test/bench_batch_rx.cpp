@@ -0,0 +1,259 @@
+/**
+ * @file bench_batch_rx.cpp
+ * @brief 批量接收测试与汇聚节点接收基准
+ *
+ * 1. 直连传输 (pty): 帧以 37 字节分段写入，读取经常止于帧中间，检查批量
+ *    交付的每个帧视图在回调中都指向完整、未被移动的数据。
+ * 2. 汇聚节点经 Unix 流套接字接收 200 个节点的 REPORT 帧 (启用共享内存
+ *    发布)，先按 50k 帧/秒定速发送并检查无丢失，再不限速测最大吞吐。
+ *
+ * 用法: bench_batch_rx [帧数]   (默认 50000，ctest 以默认值运行)
+ * 吞吐数字以 -DCMAKE_BUILD_TYPE=Release 构建为准。
+ */
+#include "core/message_codec.h"
+#include "core/xslot_protocol.h"
+#include "test_util.h"
+#include "transport/direct_transport.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <unistd.h>
+#include <xslot/xslot.h>
+
+#define BENCH_RATE 50000 /* 定速阶段的帧速率 (帧/秒) */
+#define BENCH_NODES 200
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double seconds_since(bench_clock::time_point t0) {
+  return std::chrono::duration<double>(bench_clock::now() - t0).count();
+}
+
+/* ============================================================================
+ * 直连传输批量交付
+ * ============================================================================
+ */
+
+struct batch_stats {
+  int frames;
+  int bad;
+  int batches;
+  int single;
+};
+
+static void on_batch(void *ctx, const transport_frame_view_t *frames,
+                     uint16_t count) {
+  batch_stats *st = (batch_stats *)ctx;
+  st->batches++;
+  for (uint16_t i = 0; i < count; i++) {
+    xslot_frame_t f;
+    bool ok = xslot_frame_decode(frames[i].data, frames[i].len, &f) ==
+                  XSLOT_OK &&
+              f.seq == (uint8_t)st->frames && f.len == st->frames % 20;
+    for (uint8_t k = 0; ok && k < f.len; k++) {
+      ok = f.data[k] == (uint8_t)(st->frames + k);
+    }
+    if (!ok)
+      st->bad++;
+    st->frames++;
+  }
+}
+
+static void on_single(void *ctx, const uint8_t *data, uint16_t len) {
+  (void)data;
+  (void)len;
+  ((batch_stats *)ctx)->single++;
+}
+
+static void test_direct_batch() {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  CHECK(master >= 0);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    close(master);
+    return;
+  }
+
+  xslot_config_t config = {};
+  std::strncpy(config.uart_port, ptsname(master),
+               sizeof(config.uart_port) - 1);
+  i_transport_t *tr = direct_transport_create(&config);
+  CHECK(tr != nullptr && transport_start(tr) == XSLOT_OK);
+  if (!tr) {
+    close(master);
+    return;
+  }
+
+  batch_stats st = {0, 0, 0, 0};
+  transport_set_receive_callback(tr, on_single, &st);
+  transport_set_batch_callback(tr, on_batch, &st);
+
+  /* 帧间夹杂噪声和 CRC 错误的帧 */
+  const int count = 300;
+  std::string out;
+  for (int i = 0; i < count; i++) {
+    xslot_frame_t f;
+    xslot_frame_init(&f);
+    f.from = 1;
+    f.to = 2;
+    f.seq = (uint8_t)i;
+    f.cmd = XSLOT_CMD_REPORT;
+    f.len = (uint8_t)(i % 20);
+    for (uint8_t k = 0; k < f.len; k++) {
+      f.data[k] = (uint8_t)(i + k);
+    }
+    uint8_t raw[XSLOT_FRAME_MAX_SIZE];
+    int n = xslot_frame_encode(&f, raw, sizeof(raw));
+    if (i % 7 == 0)
+      out += "\x01\xAA\x02";
+    if (i % 11 == 0) {
+      std::string bad((const char *)raw, n);
+      bad[n - 1] ^= 0x55;
+      out += bad;
+    }
+    out.append((const char *)raw, n);
+  }
+
+  /* 每次写入后立即读取，使读取经常止于帧中间 */
+  for (size_t off = 0; off < out.size();) {
+    size_t n = out.size() - off < 37 ? out.size() - off : 37;
+    ssize_t w = write(master, out.data() + off, n);
+    if (w > 0)
+      off += (size_t)w;
+    transport_poll(tr, 1);
+  }
+  for (int i = 0; i < 50 && st.frames < count; i++) {
+    transport_poll(tr, 5);
+  }
+
+  CHECK(st.frames == count);
+  CHECK(st.bad == 0);
+  CHECK(st.single == 0);
+  std::printf("direct: %d frames in %d batches, %d bad\n", st.frames,
+              st.batches, st.bad);
+
+  transport_destroy(tr);
+  close(master);
+}
+
+/* ============================================================================
+ * 汇聚节点接收基准
+ * ============================================================================
+ */
+
+static long g_reports;
+
+static void on_report(uint16_t from, const xslot_bacnet_object_t *objects,
+                      uint8_t count) {
+  (void)from;
+  (void)objects;
+  g_reports += count;
+}
+
+/* 预先编码 [LEN:2][帧] 流 */
+static std::string encode_reports(int count) {
+  std::string out;
+  for (int i = 0; i < count; i++) {
+    xslot_bacnet_object_t obj = {};
+    obj.object_id = (uint16_t)(i % 50);
+    obj.object_type = XSLOT_OBJ_ANALOG_INPUT;
+    obj.present_value.analog = (float)i;
+
+    xslot_frame_t f;
+    message_build_report(&f, (uint16_t)(1 + i % BENCH_NODES), XSLOT_ADDR_HUB,
+                         (uint8_t)i, &obj, 1, true);
+    uint8_t raw[XSLOT_FRAME_MAX_SIZE];
+    int n = xslot_frame_encode(&f, raw, sizeof(raw));
+    out.push_back((char)(n & 0xFF));
+    out.push_back((char)(n >> 8));
+    out.append((const char *)raw, n);
+  }
+  return out;
+}
+
+/**
+ * @brief 发送整个流并轮询汇聚节点直到收齐
+ * @param rate 帧速率 (0=不限速)
+ * @return 耗时 (秒)，超时返回负数
+ */
+static double run_stream(xslot_handle_t hub, int fd, const std::string &out,
+                         int frames, int rate) {
+  size_t frame_size = out.size() / frames;
+  g_reports = 0;
+  auto t0 = bench_clock::now();
+  size_t off = 0;
+  while (g_reports < frames) {
+    size_t limit = out.size();
+    if (rate > 0) {
+      size_t due = (size_t)(seconds_since(t0) * rate + 1) * frame_size;
+      limit = due < limit ? due : limit;
+    }
+    if (off < limit) {
+      size_t n = limit - off < 8192 ? limit - off : 8192;
+      ssize_t w = send(fd, out.data() + off, n, MSG_DONTWAIT);
+      if (w > 0)
+        off += (size_t)w;
+    }
+    xslot_poll(hub, 0);
+    if (seconds_since(t0) > 30.0)
+      return -1.0;
+  }
+  return seconds_since(t0);
+}
+
+static void bench_hub(int frames) {
+  char path[48];
+  char shm_name[32];
+  std::snprintf(path, sizeof(path), "/tmp/xslot_bench_%d.sock", (int)getpid());
+  std::snprintf(shm_name, sizeof(shm_name), "/xslot_bench_%d", (int)getpid());
+  unlink(path);
+
+  xslot_config_t config = {};
+  config.local_addr = XSLOT_ADDR_HUB;
+  std::snprintf(config.uart_port, sizeof(config.uart_port), "unix://@%s",
+                path);
+  xslot_handle_t hub = xslot_init(&config);
+  CHECK(hub != nullptr && xslot_start(hub) == XSLOT_OK);
+  if (!hub)
+    return;
+  xslot_set_report_callback(hub, on_report);
+  xslot_enable_shm_publish(hub, shm_name);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  CHECK(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+  for (int i = 0; i < 5; i++) {
+    xslot_poll(hub, 1);
+  }
+
+  std::string out = encode_reports(frames);
+
+  double paced = run_stream(hub, fd, out, frames, BENCH_RATE);
+  CHECK(paced > 0);
+  /* 跟得上定速发送: 收齐时间不超过发送时间的 125% */
+  CHECK(paced < (double)frames / BENCH_RATE * 1.25 + 0.1);
+  std::printf("hub paced %d frames/s: %ld reports in %.3f s\n", BENCH_RATE,
+              g_reports, paced);
+
+  double burst = run_stream(hub, fd, out, frames, 0);
+  CHECK(burst > 0);
+  std::printf("hub burst: %ld reports in %.3f s, %.0f frames/s\n", g_reports,
+              burst, g_reports / burst);
+
+  close(fd);
+  xslot_deinit(hub);
+  unlink(path);
+}
+
+int main(int argc, char **argv) {
+  int frames = argc > 1 ? std::atoi(argv[1]) : 50000;
+  test_direct_batch();
+  bench_hub(frames > 0 ? frames : 50000);
+  return TEST_RESULT();
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_alarm_engine.cpp
+ * @brief 告警引擎与增量上报类型测试
+ */
+#include "core/alarm_engine.h"
+#include "core/message_codec.h"
+#include "test_util.h"
+
+#define NODE 0x0012
+
+static xslot_alarm_limit_t make_limit(uint8_t type, uint16_t id,
+                                      uint32_t delay_ms) {
+  xslot_alarm_limit_t limit = {};
+  limit.object_id = id;
+  limit.object_type = type;
+  limit.limit_enable = XSLOT_ALARM_ENABLE_HIGH | XSLOT_ALARM_ENABLE_LOW;
+  limit.high_limit = 30.0f;
+  limit.low_limit = 10.0f;
+  limit.deadband = 2.0f;
+  limit.time_delay_ms = delay_ms;
+  return limit;
+}
+
+static xslot_bacnet_object_t analog(uint8_t type, uint16_t id, float value) {
+  xslot_bacnet_object_t obj = {};
+  obj.object_id = id;
+  obj.object_type = type;
+  obj.present_value.analog = value;
+  return obj;
+}
+
+static int feed(alarm_engine_t engine, uint8_t type, uint16_t id, float value,
+                bool typed, uint32_t now, xslot_alarm_event_t *events) {
+  xslot_bacnet_object_t obj = analog(type, id, value);
+  return alarm_engine_evaluate(engine, NODE, &obj, 1, typed, now, events, 4);
+}
+
+/* 高限触发后需回到 高限-死区 以内才恢复 */
+static void test_deadband() {
+  alarm_engine_t engine = alarm_engine_create(8);
+  xslot_alarm_limit_t limit = make_limit(XSLOT_OBJ_ANALOG_INPUT, 1, 0);
+  CHECK(alarm_engine_set_limit(engine, NODE, &limit) == 0);
+
+  xslot_alarm_event_t ev[4];
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 25.0f, true, 0, ev) == 0);
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 31.0f, true, 10, ev) == 1);
+  CHECK(ev[0].to_state == XSLOT_ALARM_HIGH_LIMIT);
+  CHECK(ev[0].limit == 30.0f);
+
+  /* 死区内不恢复 */
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 29.0f, true, 20, ev) == 0);
+  CHECK(alarm_engine_get_state(engine, NODE, XSLOT_OBJ_ANALOG_INPUT, 1) ==
+        XSLOT_ALARM_HIGH_LIMIT);
+
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 27.5f, true, 30, ev) == 1);
+  CHECK(ev[0].from_state == XSLOT_ALARM_HIGH_LIMIT);
+  CHECK(ev[0].to_state == XSLOT_ALARM_NORMAL);
+
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 9.0f, true, 40, ev) == 1);
+  CHECK(ev[0].to_state == XSLOT_ALARM_LOW_LIMIT);
+  alarm_engine_destroy(engine);
+}
+
+/* 状态保持满延时才产生事件，回到原状态则取消待定 */
+static void test_time_delay() {
+  alarm_engine_t engine = alarm_engine_create(8);
+  xslot_alarm_limit_t limit = make_limit(XSLOT_OBJ_ANALOG_INPUT, 1, 1000);
+  alarm_engine_set_limit(engine, NODE, &limit);
+
+  xslot_alarm_event_t ev[4];
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 35.0f, true, 100, ev) == 0);
+  CHECK(alarm_engine_check_delays(engine, 900, ev, 4) == 0);
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 20.0f, true, 1000, ev) == 0);
+  CHECK(alarm_engine_check_delays(engine, 2000, ev, 4) == 0);
+
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 1, 35.0f, true, 3000, ev) == 0);
+  CHECK(alarm_engine_check_delays(engine, 3999, ev, 4) == 0);
+  CHECK(alarm_engine_check_delays(engine, 4000, ev, 4) == 1);
+  CHECK(ev[0].to_state == XSLOT_ALARM_HIGH_LIMIT);
+  CHECK(ev[0].value == 35.0f);
+  alarm_engine_destroy(engine);
+}
+
+/* 事件数组已满时状态保持待定，不丢失 */
+static void test_events_full() {
+  alarm_engine_t engine = alarm_engine_create(8);
+  for (uint16_t id = 1; id <= 3; id++) {
+    xslot_alarm_limit_t limit = make_limit(XSLOT_OBJ_ANALOG_INPUT, id, 0);
+    limit.priority = (uint8_t)(4 - id);
+    alarm_engine_set_limit(engine, NODE, &limit);
+  }
+
+  xslot_bacnet_object_t objs[3] = {analog(XSLOT_OBJ_ANALOG_INPUT, 1, 40.0f),
+                                   analog(XSLOT_OBJ_ANALOG_INPUT, 2, 40.0f),
+                                   analog(XSLOT_OBJ_ANALOG_INPUT, 3, 40.0f)};
+  xslot_alarm_event_t ev[4];
+  CHECK(alarm_engine_evaluate(engine, NODE, objs, 3, true, 0, ev, 2) == 2);
+  CHECK(ev[0].priority <= ev[1].priority);
+  CHECK(alarm_engine_check_delays(engine, 1, ev, 4) == 1);
+  CHECK(ev[0].object_id == 3);
+  alarm_engine_destroy(engine);
+}
+
+/* 同一实例号的不同类型互不影响 */
+static void test_type_keyed() {
+  alarm_engine_t engine = alarm_engine_create(8);
+  xslot_alarm_limit_t limit = make_limit(XSLOT_OBJ_ANALOG_OUTPUT, 5, 0);
+  alarm_engine_set_limit(engine, NODE, &limit);
+
+  xslot_alarm_event_t ev[4];
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 5, 50.0f, true, 0, ev) == 0);
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_VALUE, 5, 50.0f, true, 0, ev) == 0);
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_OUTPUT, 5, 50.0f, true, 0, ev) == 1);
+  CHECK(ev[0].object_type == XSLOT_OBJ_ANALOG_OUTPUT);
+  alarm_engine_destroy(engine);
+}
+
+/* 未携带类型: 唯一的模拟量告警点照常评估，多个类型同号时跳过 */
+static void test_untyped() {
+  alarm_engine_t engine = alarm_engine_create(8);
+  xslot_alarm_limit_t limit = make_limit(XSLOT_OBJ_ANALOG_VALUE, 7, 0);
+  alarm_engine_set_limit(engine, NODE, &limit);
+
+  xslot_alarm_event_t ev[4];
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 7, 50.0f, false, 0, ev) == 1);
+  CHECK(ev[0].object_type == XSLOT_OBJ_ANALOG_VALUE);
+
+  limit = make_limit(XSLOT_OBJ_ANALOG_INPUT, 8, 0);
+  alarm_engine_set_limit(engine, NODE, &limit);
+  limit = make_limit(XSLOT_OBJ_ANALOG_OUTPUT, 8, 0);
+  alarm_engine_set_limit(engine, NODE, &limit);
+  CHECK(feed(engine, XSLOT_OBJ_ANALOG_INPUT, 8, 50.0f, false, 0, ev) == 0);
+  CHECK(alarm_engine_get_state(engine, NODE, XSLOT_OBJ_ANALOG_INPUT, 8) ==
+        XSLOT_ALARM_NORMAL);
+  alarm_engine_destroy(engine);
+}
+
+/* 增量上报携带对象类型，旧版 HINT 报告为 UNTYPED */
+static void test_report_format() {
+  xslot_bacnet_object_t objs[2] = {analog(XSLOT_OBJ_ANALOG_OUTPUT, 3, 1.5f),
+                                   {}};
+  objs[1].object_id = 4;
+  objs[1].object_type = XSLOT_OBJ_BINARY_VALUE;
+  objs[1].present_value.binary = 1;
+
+  xslot_frame_t frame;
+  xslot_bacnet_object_t out[4];
+  uint8_t format = 0xFF;
+
+  CHECK(message_build_report(&frame, NODE, 1, 0, objs, 2, true) == 0);
+  CHECK(message_parse_report(&frame, out, 4, &format) == 2);
+  CHECK(format == MESSAGE_REPORT_INCREMENTAL);
+  CHECK(out[0].object_type == XSLOT_OBJ_ANALOG_OUTPUT);
+  CHECK(out[0].present_value.analog == 1.5f);
+  CHECK(out[1].object_type == XSLOT_OBJ_BINARY_VALUE);
+  CHECK(out[1].present_value.binary == 1);
+
+  /* 旧版节点: HINT 只有增量标志和值类型 */
+  frame.data[3] &= 0x8F;
+  frame.data[3 + 4 + 3] &= 0x8F;
+  CHECK(message_parse_report(&frame, out, 4, &format) == 2);
+  CHECK(format == MESSAGE_REPORT_UNTYPED);
+  CHECK(out[0].object_type == XSLOT_OBJ_ANALOG_INPUT);
+  CHECK(out[1].object_type == XSLOT_OBJ_BINARY_INPUT);
+
+  CHECK(message_build_report(&frame, NODE, 1, 0, objs, 2, false) == 0);
+  CHECK(message_parse_report(&frame, out, 4, &format) == 2);
+  CHECK(format == MESSAGE_REPORT_FULL);
+}
+
+int main() {
+  test_deadband();
+  test_time_delay();
+  test_events_full();
+  test_type_keyed();
+  test_untyped();
+  test_report_format();
+  return TEST_RESULT();
+}
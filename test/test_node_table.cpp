@@ -0,0 +1,178 @@
+/**
+ * @file test_node_table.cpp
+ * @brief 节点表离线判定测试 (到达间隔学习与上下线迟滞)
+ *
+ * 时钟由测试内的桩代替，不链接 xslot。
+ */
+#include "core/node_table.h"
+#include "test_util.h"
+
+static uint32_t g_clock_ms = 1000;
+
+extern "C" uint32_t hal_get_timestamp_ms(void) { return g_clock_ms; }
+
+#define FIXED_TIMEOUT 5000
+
+static node_table_t make_table(const xslot_liveness_config_t *lv) {
+  node_table_t table = node_table_create(8);
+  node_table_set_timeout(table, FIXED_TIMEOUT, lv);
+  return table;
+}
+
+/* 按固定周期收帧 */
+static void arrive(node_table_t table, uint16_t addr, uint32_t period,
+                   int frames) {
+  for (int i = 0; i < frames; i++) {
+    g_clock_ms += period;
+    node_table_update(table, addr, -50);
+  }
+}
+
+static xslot_node_info_t info_of(node_table_t table, uint16_t addr) {
+  xslot_node_info_t info = {};
+  CHECK(node_table_get_node(table, addr, &info));
+  return info;
+}
+
+/* 学习完成前使用固定超时，之后按 μ + k·σ 判定 */
+static void test_learning() {
+  xslot_liveness_config_t lv = {};
+  lv.sigma_k = 3.0f;
+  node_table_t table = make_table(&lv);
+
+  node_table_update(table, 1, -50);
+  arrive(table, 1, 1000, 3);
+  CHECK(info_of(table, 1).interval_ms == 1000);
+  CHECK(info_of(table, 1).timeout_ms == FIXED_TIMEOUT);
+
+  arrive(table, 1, 1000, 1);
+  xslot_node_info_t info = info_of(table, 1);
+  CHECK(info.timeout_ms > 1500 && info.timeout_ms < 2500);
+
+  /* 严格周期的节点 σ 趋近 0，判定时间不低于 1.5μ */
+  arrive(table, 1, 1000, 100);
+  CHECK(info_of(table, 1).timeout_ms == 1500);
+
+  /* 同一批的帧不参与学习 */
+  arrive(table, 1, 10, 5);
+  CHECK(info_of(table, 1).interval_ms == 1000);
+
+  xslot_node_transition_t off[4];
+  g_clock_ms += 1500;
+  CHECK(node_table_check_timeout(table, off, 4) == 0);
+  g_clock_ms += 1;
+  CHECK(node_table_check_timeout(table, off, 4) == 1);
+  CHECK(off[0].addr == 1 && !off[0].online);
+
+  /* 离线期间的间隔是故障时长，不计入 */
+  g_clock_ms += 60000;
+  CHECK(node_table_update(table, 1, -50));
+  CHECK(info_of(table, 1).interval_ms == 1000);
+  node_table_destroy(table);
+}
+
+/* 长周期节点学习后不再按固定超时误报离线 */
+static void test_slow_node() {
+  xslot_liveness_config_t lv = {};
+  lv.sigma_k = 3.0f;
+  node_table_t table = make_table(&lv);
+
+  node_table_update(table, 2, -50);
+  arrive(table, 2, 600000, 4);
+  CHECK(node_table_is_online(table, 2));
+  CHECK(info_of(table, 2).timeout_ms >= 900000);
+
+  xslot_node_transition_t off[4];
+  g_clock_ms += 600000;
+  CHECK(node_table_check_timeout(table, off, 4) == 0);
+  node_table_destroy(table);
+}
+
+/* 判定时间上下限 */
+static void test_limits() {
+  xslot_liveness_config_t lv = {};
+  lv.sigma_k = 3.0f;
+  lv.warmup = 2;
+  lv.min_ms = 3000;
+  lv.max_ms = 20000;
+  node_table_t table = make_table(&lv);
+
+  node_table_update(table, 3, -50);
+  arrive(table, 3, 1000, 2);
+  CHECK(info_of(table, 3).timeout_ms == 3000);
+
+  node_table_update(table, 4, -50);
+  arrive(table, 4, 60000, 2);
+  CHECK(info_of(table, 4).timeout_ms == 20000);
+
+  /* sigma_k=0 关闭自适应 */
+  node_table_set_timeout(table, FIXED_TIMEOUT, nullptr);
+  CHECK(info_of(table, 4).timeout_ms == FIXED_TIMEOUT);
+  node_table_destroy(table);
+}
+
+/* 连续 offline_misses 个判定时间未收到帧才离线 */
+static void test_offline_misses() {
+  xslot_liveness_config_t lv = {};
+  lv.offline_misses = 2;
+  node_table_t table = make_table(&lv);
+
+  node_table_update(table, 5, -50);
+  CHECK(info_of(table, 5).timeout_ms == 2 * FIXED_TIMEOUT);
+
+  xslot_node_transition_t off[4];
+  g_clock_ms += FIXED_TIMEOUT + 1;
+  CHECK(node_table_check_timeout(table, off, 4) == 0);
+  g_clock_ms += FIXED_TIMEOUT;
+  CHECK(node_table_check_timeout(table, off, 4) == 1);
+  CHECK(!node_table_is_online(table, 5));
+  node_table_destroy(table);
+}
+
+/* 收满 online_frames 个间隔正常的帧才上线，突发和杂散帧不计 */
+static void test_online_frames() {
+  xslot_liveness_config_t lv = {};
+  lv.online_frames = 3;
+  node_table_t table = make_table(&lv);
+
+  CHECK(!node_table_update(table, 6, -50));
+  g_clock_ms += 1000;
+  CHECK(!node_table_update(table, 6, -50));
+  g_clock_ms += 1000;
+  CHECK(node_table_update(table, 6, -50));
+
+  xslot_node_transition_t off[4];
+  g_clock_ms += FIXED_TIMEOUT + 1;
+  CHECK(node_table_check_timeout(table, off, 4) == 1);
+
+  int up = 0;
+  for (int i = 0; i < 5; i++) {
+    g_clock_ms += 10;
+    up += node_table_update(table, 6, -50);
+  }
+  for (int i = 0; i < 5; i++) {
+    g_clock_ms += 3600000;
+    up += node_table_update(table, 6, -50);
+  }
+  CHECK(up == 0);
+  CHECK(!node_table_is_online(table, 6));
+
+  g_clock_ms += 1000;
+  up += node_table_update(table, 6, -50);
+  g_clock_ms += 1000;
+  up += node_table_update(table, 6, -50);
+  g_clock_ms += 1000;
+  up += node_table_update(table, 6, -50);
+  CHECK(up == 1);
+  CHECK(node_table_is_online(table, 6));
+  node_table_destroy(table);
+}
+
+int main() {
+  test_learning();
+  test_slow_node();
+  test_limits();
+  test_offline_misses();
+  test_online_frames();
+  return TEST_RESULT();
+}
@@ -0,0 +1,199 @@
+/**
+ * @file test_relay.cpp
+ * @brief 中继测试 (序号映射、多帧应答的登记释放、序号回绕)
+ *
+ * 三个协议栈经 UDP 回环互连: HMI --附加链路-- 汇聚节点 --主传输-- 边缘节点。
+ */
+#include "test_util.h"
+#include <cstdio>
+#include <unistd.h>
+#include <xslot/xslot.h>
+
+#define EDGE 0x0020
+
+static int g_hmi_props;
+static int g_hmi_sub_props;
+static int g_hub_props;
+static int g_hub_reports;
+
+static bool on_read(uint8_t type, uint16_t id, uint8_t mask,
+                    xslot_property_set_t *props) {
+  props->object_type = type;
+  props->object_id = id;
+  props->mask = mask;
+  props->present_value.analog = id * 1.5f;
+  return true;
+}
+
+static void on_hmi_props(uint16_t from, const xslot_property_set_t *props,
+                         uint8_t count) {
+  (void)props;
+  if (from == EDGE)
+    g_hmi_props += count;
+}
+
+static void on_hmi_sub_props(uint16_t from, uint8_t sub,
+                             const xslot_property_set_t *props, uint8_t count) {
+  (void)sub;
+  (void)props;
+  if (from == EDGE)
+    g_hmi_sub_props += count;
+}
+
+static void on_hub_props(uint16_t from, const xslot_property_set_t *props,
+                         uint8_t count) {
+  (void)props;
+  if (from == EDGE)
+    g_hub_props += count;
+}
+
+static void on_hub_report(uint16_t from, const xslot_bacnet_object_t *objects,
+                          uint8_t count) {
+  (void)from;
+  (void)objects;
+  g_hub_reports += count;
+}
+
+static xslot_handle_t make_stack(uint16_t addr, int port, int peer, int aux,
+                                 int aux_peer) {
+  xslot_config_t config = {};
+  config.local_addr = addr;
+  config.heartbeat_timeout_ms = 60000;
+  std::snprintf(config.uart_port, sizeof(config.uart_port),
+                "udp://127.0.0.1:%d@%d", peer, port);
+  if (aux) {
+    config.relay = 1;
+    std::snprintf(config.aux_ports[0], sizeof(config.aux_ports[0]),
+                  "udp://127.0.0.1:%d@%d", aux_peer, aux);
+  }
+  xslot_handle_t h = xslot_init(&config);
+  CHECK(h != nullptr && xslot_start(h) == XSLOT_OK);
+  return h;
+}
+
+struct stacks {
+  xslot_handle_t hub;
+  xslot_handle_t hmi;
+  xslot_handle_t edge;
+};
+
+/* 轮询三端直到计数达到目标 (最多约 1 秒) */
+static bool pump_until(const stacks *s, const int *counter, int target) {
+  for (int i = 0; i < 1000 && *counter < target; i++) {
+    xslot_poll(s->hmi, 0);
+    xslot_poll(s->hub, 0);
+    xslot_poll(s->edge, 1);
+  }
+  return *counter >= target;
+}
+
+static void pump(const stacks *s, int rounds) {
+  for (int i = 0; i < rounds; i++) {
+    xslot_poll(s->hmi, 1);
+    xslot_poll(s->hub, 1);
+    xslot_poll(s->edge, 1);
+  }
+}
+
+/* 多帧属性应答和 MUX 应答收齐后释放登记: 3 秒内连续的请求多于登记表容量 */
+static void test_release(const stacks *s) {
+  xslot_object_ref_t refs[10];
+  for (int i = 0; i < 10; i++) {
+    refs[i].object_type = XSLOT_OBJ_ANALOG_INPUT;
+    refs[i].object_id = (uint16_t)i;
+  }
+
+  int answered = 0;
+  for (int r = 0; r < 24; r++) {
+    int target = g_hmi_props + 10;
+    xslot_query_properties(s->hmi, EDGE, XSLOT_PROP_PRESENT_VALUE, refs, 10);
+    answered += pump_until(s, &g_hmi_props, target);
+  }
+  CHECK(answered == 24);
+
+  answered = 0;
+  for (int r = 0; r < 24; r++) {
+    int target = g_hmi_sub_props + 2;
+    xslot_query_sub_properties(s->hmi, EDGE, 1, XSLOT_PROP_PRESENT_VALUE,
+                               refs, 2);
+    answered += pump_until(s, &g_hmi_sub_props, target);
+  }
+  CHECK(answered == 24);
+}
+
+/* 汇聚节点与 HMI 交替查询同一节点，应答各回各处 */
+static void test_interleaved(const stacks *s) {
+  xslot_object_ref_t refs[3];
+  for (int i = 0; i < 3; i++) {
+    refs[i].object_type = XSLOT_OBJ_ANALOG_INPUT;
+    refs[i].object_id = (uint16_t)i;
+  }
+
+  int hmi = g_hmi_props;
+  int hub = g_hub_props;
+  for (int r = 0; r < 5; r++) {
+    xslot_query_properties(s->hmi, EDGE, XSLOT_PROP_PRESENT_VALUE, refs, 2);
+    xslot_query_properties(s->hub, EDGE, XSLOT_PROP_PRESENT_VALUE, refs, 3);
+    pump(s, 10);
+  }
+  CHECK(g_hmi_props - hmi == 10);
+  CHECK(g_hub_props - hub == 15);
+}
+
+/*
+ * 节点不应答的中继请求保留到超时，其间本机序号回绕一圈以上，
+ * 本机请求不得分到该序号 (否则应答被当作中继应答发给 HMI)
+ */
+static void test_seq_wrap(const stacks *s) {
+  xslot_object_ref_t ref = {};
+  ref.object_type = XSLOT_OBJ_ANALOG_INPUT;
+  ref.object_id = 1;
+
+  xslot_set_property_read_callback(s->edge, nullptr);
+  xslot_query_properties(s->hmi, EDGE, XSLOT_PROP_PRESENT_VALUE, &ref, 1);
+  pump(s, 5);
+  xslot_set_property_read_callback(s->edge, on_read);
+
+  int hmi = g_hmi_props;
+  int hub = g_hub_props;
+  int answered = 0;
+  for (int r = 0; r < 300; r++) {
+    xslot_query_properties(s->hub, EDGE, XSLOT_PROP_PRESENT_VALUE, &ref, 1);
+    answered += pump_until(s, &g_hub_props, hub + r + 1);
+  }
+  CHECK(answered == 300);
+  CHECK(g_hub_props - hub == 300);
+  CHECK(g_hmi_props == hmi);
+}
+
+int main() {
+  int base = 40000 + (int)(getpid() % 5000) * 4;
+  stacks s;
+  s.hub = make_stack(XSLOT_ADDR_HUB, base, base + 1, base + 2, base + 3);
+  s.hmi = make_stack(XSLOT_ADDR_HMI, base + 3, base + 2, 0, 0);
+  s.edge = make_stack(EDGE, base + 1, base, 0, 0);
+  if (!s.hub || !s.hmi || !s.edge)
+    return TEST_RESULT();
+
+  xslot_set_report_callback(s.hub, on_hub_report);
+  xslot_set_property_callback(s.hub, on_hub_props);
+  xslot_set_property_callback(s.hmi, on_hmi_props);
+  xslot_set_sub_property_callback(s.hmi, on_hmi_sub_props);
+  xslot_set_property_read_callback(s.edge, on_read);
+
+  /* 边缘节点上报一次，汇聚节点记为在线后才中继发往它的请求 */
+  xslot_bacnet_object_t obj = {};
+  obj.object_id = 7;
+  obj.flags = XSLOT_FLAG_CHANGED;
+  xslot_report_objects(s.edge, &obj, 1);
+  CHECK(pump_until(&s, &g_hub_reports, 1));
+
+  test_release(&s);
+  test_interleaved(&s);
+  test_seq_wrap(&s);
+
+  xslot_deinit(s.edge);
+  xslot_deinit(s.hmi);
+  xslot_deinit(s.hub);
+  return TEST_RESULT();
+}
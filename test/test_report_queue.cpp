@@ -0,0 +1,110 @@
+/**
+ * @file test_report_queue.cpp
+ * @brief 上报队列通道分类与状态记录测试
+ */
+#include "core/report_queue.h"
+#include "test_util.h"
+
+static xslot_bacnet_object_t analog(uint16_t id, float value, uint8_t flags) {
+  xslot_bacnet_object_t obj = {};
+  obj.object_id = id;
+  obj.object_type = XSLOT_OBJ_ANALOG_INPUT;
+  obj.flags = flags;
+  obj.present_value.analog = value;
+  return obj;
+}
+
+static int push(report_queue_t queue, xslot_bacnet_object_t obj,
+                uint32_t time_ms) {
+  return report_queue_push(queue, &obj, 1, time_ms);
+}
+
+/* 常规通道同一对象只保留最新值和最新采样时间 */
+static void test_routine_merge() {
+  report_queue_t queue = report_queue_create();
+  CHECK(push(queue, analog(1, 1.0f, 0), 100) == 0);
+  CHECK(push(queue, analog(2, 2.0f, 0), 110) == 0);
+  CHECK(push(queue, analog(1, 3.0f, 0), 120) == 0);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 2);
+  CHECK(report_queue_pending(queue, REPORT_LANE_PRIORITY) == 0);
+
+  xslot_bacnet_object_t out[4];
+  uint32_t times[4];
+  CHECK(report_queue_peek(queue, REPORT_LANE_ROUTINE, out, 4) == 2);
+  CHECK(report_queue_peek_times(queue, REPORT_LANE_ROUTINE, times, 4) == 2);
+  CHECK(out[0].object_id == 1 && out[0].present_value.analog == 3.0f);
+  CHECK(times[0] == 120);
+
+  report_queue_consume(queue, REPORT_LANE_ROUTINE, 1);
+  CHECK(report_queue_peek(queue, REPORT_LANE_ROUTINE, out, 4) == 1);
+  CHECK(out[0].object_id == 2);
+  report_queue_destroy(queue);
+}
+
+/* 状态变化进入优先通道并作废常规通道中的旧值，恢复正常同样优先 */
+static void test_status_change() {
+  report_queue_t queue = report_queue_create();
+  push(queue, analog(1, 1.0f, 0), 0);
+  push(queue, analog(1, 50.0f, XSLOT_FLAG_IN_ALARM), 10);
+  CHECK(report_queue_pending(queue, REPORT_LANE_PRIORITY) == 1);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 0);
+  report_queue_consume(queue, REPORT_LANE_PRIORITY, 1);
+
+  /* 状态不变: 常规通道 (CHANGED 位不参与判断) */
+  push(queue, analog(1, 51.0f, XSLOT_FLAG_IN_ALARM | XSLOT_FLAG_CHANGED), 20);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 1);
+  CHECK(report_queue_pending(queue, REPORT_LANE_PRIORITY) == 0);
+
+  push(queue, analog(1, 20.0f, 0), 30);
+  CHECK(report_queue_pending(queue, REPORT_LANE_PRIORITY) == 1);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 0);
+
+  /* 不同类型的同号对象分别记录 */
+  xslot_bacnet_object_t bi = analog(1, 0.0f, 0);
+  bi.object_type = XSLOT_OBJ_BINARY_INPUT;
+  bi.present_value.binary = 1;
+  push(queue, bi, 40);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 1);
+  report_queue_destroy(queue);
+}
+
+/* 优先通道已满时状态变化不记为已上报，腾出空间后重新入队仍走优先通道 */
+static void test_priority_full() {
+  report_queue_t queue = report_queue_create();
+  for (uint16_t id = 0; id < REPORT_QUEUE_LANE_SIZE; id++) {
+    CHECK(push(queue, analog(id, 50.0f, XSLOT_FLAG_IN_ALARM), 0) == 0);
+  }
+  CHECK(push(queue, analog(100, 50.0f, XSLOT_FLAG_IN_ALARM), 0) == 1);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 0);
+
+  report_queue_consume(queue, REPORT_LANE_PRIORITY, 1);
+  CHECK(push(queue, analog(100, 51.0f, XSLOT_FLAG_IN_ALARM), 10) == 0);
+  CHECK(report_queue_pending(queue, REPORT_LANE_PRIORITY) ==
+        REPORT_QUEUE_LANE_SIZE);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 0);
+  report_queue_destroy(queue);
+}
+
+/* 状态表已满后未记录的对象一律走优先通道 */
+static void test_status_table_full() {
+  report_queue_t queue = report_queue_create();
+  for (uint16_t id = 0; id < 128; id++) {
+    push(queue, analog(id, 50.0f, XSLOT_FLAG_OUT_OF_SERVICE), 0);
+    report_queue_consume(queue, REPORT_LANE_PRIORITY, 1);
+  }
+  push(queue, analog(200, 1.0f, 0), 0);
+  CHECK(report_queue_pending(queue, REPORT_LANE_PRIORITY) == 1);
+
+  /* 已记录的对象照常分类 */
+  push(queue, analog(5, 1.0f, XSLOT_FLAG_OUT_OF_SERVICE), 0);
+  CHECK(report_queue_pending(queue, REPORT_LANE_ROUTINE) == 1);
+  report_queue_destroy(queue);
+}
+
+int main() {
+  test_routine_merge();
+  test_status_change();
+  test_priority_full();
+  test_status_table_full();
+  return TEST_RESULT();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_shm.cpp
+ * @brief 共享内存发布端/读取端测试 (槽位语义与序号锁)
+ */
+#include "core/message_codec.h"
+#include "shm/shm_publisher.h"
+#include "test_util.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+#include <xslot/xslot_shm.h>
+
+#define NODE 0x0021
+
+static xslot_bacnet_object_t analog(uint8_t type, uint16_t id, float value,
+                                    uint8_t flags) {
+  xslot_bacnet_object_t obj = {};
+  obj.object_id = id;
+  obj.object_type = type;
+  obj.flags = flags;
+  obj.present_value.analog = value;
+  return obj;
+}
+
+static void publish(shm_publisher_t pub, xslot_bacnet_object_t obj,
+                    uint8_t format, uint32_t now) {
+  shm_publisher_update_objects(pub, NODE, &obj, 1, format, now);
+}
+
+static bool read_slot(xslot_shm_reader_t reader, uint8_t type, uint16_t id,
+                      xslot_shm_object_t *out) {
+  int idx = xslot_shm_find_object(reader, NODE, type, id);
+  return idx >= 0 && xslot_shm_read_object(reader, idx, out) == XSLOT_OK;
+}
+
+/* 增量上报只更新值，保留类型和状态标志；未携带类型时不分配槽位 */
+static void test_slot_semantics(shm_publisher_t pub,
+                                xslot_shm_reader_t reader) {
+  xslot_shm_object_t slot;
+
+  publish(pub, analog(XSLOT_OBJ_ANALOG_OUTPUT, 1, 5.0f, XSLOT_FLAG_IN_ALARM),
+          MESSAGE_REPORT_FULL, 100);
+  CHECK(xslot_shm_object_count(reader) == 1);
+
+  publish(pub, analog(XSLOT_OBJ_ANALOG_OUTPUT, 1, 6.0f, 0),
+          MESSAGE_REPORT_INCREMENTAL, 200);
+  CHECK(read_slot(reader, XSLOT_OBJ_ANALOG_OUTPUT, 1, &slot));
+  CHECK(slot.object.present_value.analog == 6.0f);
+  CHECK(slot.object.flags == XSLOT_FLAG_IN_ALARM);
+  CHECK(slot.update_ms == 200);
+
+  /* 旧版节点: 类型推断为 AI，更新唯一的同号模拟量槽位 */
+  publish(pub, analog(XSLOT_OBJ_ANALOG_INPUT, 1, 7.0f, 0),
+          MESSAGE_REPORT_UNTYPED, 300);
+  CHECK(xslot_shm_object_count(reader) == 1);
+  CHECK(read_slot(reader, XSLOT_OBJ_ANALOG_OUTPUT, 1, &slot));
+  CHECK(slot.object.present_value.analog == 7.0f);
+  CHECK(slot.object.flags == XSLOT_FLAG_IN_ALARM);
+
+  publish(pub, analog(XSLOT_OBJ_ANALOG_INPUT, 9, 1.0f, 0),
+          MESSAGE_REPORT_UNTYPED, 300);
+  CHECK(xslot_shm_object_count(reader) == 1);
+
+  /* 同号的多个模拟量类型无法区分，忽略 */
+  publish(pub, analog(XSLOT_OBJ_ANALOG_INPUT, 2, 1.0f, 0),
+          MESSAGE_REPORT_FULL, 400);
+  publish(pub, analog(XSLOT_OBJ_ANALOG_VALUE, 2, 2.0f, 0),
+          MESSAGE_REPORT_FULL, 400);
+  publish(pub, analog(XSLOT_OBJ_ANALOG_INPUT, 2, 3.0f, 0),
+          MESSAGE_REPORT_UNTYPED, 500);
+  CHECK(read_slot(reader, XSLOT_OBJ_ANALOG_INPUT, 2, &slot));
+  CHECK(slot.object.present_value.analog == 1.0f);
+  CHECK(read_slot(reader, XSLOT_OBJ_ANALOG_VALUE, 2, &slot));
+  CHECK(slot.object.present_value.analog == 2.0f);
+
+  /* 完整格式更新状态标志 */
+  publish(pub, analog(XSLOT_OBJ_ANALOG_OUTPUT, 1, 8.0f, 0),
+          MESSAGE_REPORT_FULL, 600);
+  CHECK(read_slot(reader, XSLOT_OBJ_ANALOG_OUTPUT, 1, &slot));
+  CHECK(slot.object.flags == 0);
+
+  /* 携带类型的增量上报可以分配新槽位 */
+  publish(pub, analog(XSLOT_OBJ_ANALOG_VALUE, 3, 1.0f, 0),
+          MESSAGE_REPORT_INCREMENTAL, 700);
+  CHECK(read_slot(reader, XSLOT_OBJ_ANALOG_VALUE, 3, &slot));
+  CHECK(xslot_shm_object_count(reader) == 4);
+}
+
+/* 读取端与写入端并发时快照始终一致 (值与时间同步写入) */
+static void test_seqlock(shm_publisher_t pub, xslot_shm_reader_t reader) {
+  const uint32_t rounds = 200000;
+  publish(pub, analog(XSLOT_OBJ_ANALOG_INPUT, 50, 0.0f, 0),
+          MESSAGE_REPORT_FULL, 0);
+  int idx = xslot_shm_find_object(reader, NODE, XSLOT_OBJ_ANALOG_INPUT, 50);
+  CHECK(idx >= 0);
+
+  std::atomic<bool> done(false);
+  std::thread writer([&] {
+    for (uint32_t i = 1; i <= rounds; i++) {
+      publish(pub, analog(XSLOT_OBJ_ANALOG_INPUT, 50, (float)i, 0),
+              MESSAGE_REPORT_INCREMENTAL, i);
+    }
+    done.store(true);
+  });
+
+  uint32_t torn = 0;
+  uint32_t last = 0;
+  bool monotonic = true;
+  while (!done.load()) {
+    xslot_shm_object_t slot;
+    if (xslot_shm_read_object(reader, idx, &slot) != XSLOT_OK)
+      continue;
+    if (slot.object.present_value.analog != (float)slot.update_ms)
+      torn++;
+    if (slot.update_ms < last)
+      monotonic = false;
+    last = slot.update_ms;
+  }
+  writer.join();
+
+  CHECK(torn == 0);
+  CHECK(monotonic);
+  xslot_shm_object_t slot;
+  CHECK(xslot_shm_read_object(reader, idx, &slot) == XSLOT_OK);
+  CHECK(slot.update_ms == rounds);
+}
+
+int main() {
+  char name[32];
+  std::snprintf(name, sizeof(name), "/xslot_test_%d", (int)getpid());
+
+  shm_publisher_t pub = shm_publisher_create(name, 64);
+  CHECK(pub != nullptr);
+  xslot_shm_reader_t reader = pub ? xslot_shm_open(name) : nullptr;
+  CHECK(reader != nullptr);
+  if (!pub || !reader) {
+    shm_publisher_destroy(pub);
+    return TEST_RESULT();
+  }
+
+  test_slot_semantics(pub, reader);
+  test_seqlock(pub, reader);
+
+  CHECK(xslot_shm_is_alive(reader));
+  xslot_shm_close(reader);
+  shm_publisher_destroy(pub);
+  CHECK(xslot_shm_open(name) == nullptr);
+  return TEST_RESULT();
+}
@@ -0,0 +1,25 @@
+/**
+ * @file test_util.h
+ * @brief 单元测试断言
+ *
+ * CHECK 失败时打印位置并继续执行，main 以 TEST_RESULT() 作为退出码。
+ */
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdio>
+
+static int g_test_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,   \
+                   #cond);                                                     \
+      g_test_failures++;                                                       \
+    }                                                                          \
+  } while (0)
+
+#define TEST_RESULT() (g_test_failures == 0 ? 0 : 1)
+
+#endif /* TEST_UTIL_H */